@@ -5,6 +5,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include <mutex>
+
 namespace Omni {
 
 	struct EditorLogPanelEntry {
@@ -28,9 +30,13 @@ namespace Omni {
 		~LogsPanel();
 
 		void Update() override;
+
+		// Called by editor log sinks on the logger thread, messages are shown on the next update
 		void PushMessage(const EditorLogPanelEntry& msg);
 
 	private:
+		std::mutex m_PendingMessagesMutex;
+		std::vector<EditorLogPanelEntry> m_PendingMessages;
 
 		// The simplest implementation, though probably the worst one
 		// TODO: implement ring buffer
@@ -36,6 +36,17 @@ namespace Omni {
 
 	void LogsPanel::Update()
 	{
+		{
+			std::lock_guard lock(m_PendingMessagesMutex);
+
+			for (EditorLogPanelEntry& msg : m_PendingMessages)
+				m_Messages.push_back(std::move(msg));
+			m_PendingMessages.clear();
+		}
+
+		if (m_Messages.size() > 256)
+			m_Messages.erase(m_Messages.begin(), m_Messages.end() - 256);
+
 		if (m_IsOpen) {
 			ImGui::Begin("Logs", &m_IsOpen);
 
@@ -128,9 +139,11 @@ namespace Omni {
 
 	void LogsPanel::PushMessage(const EditorLogPanelEntry& msg)
 	{
-		m_Messages.push_back(msg);
-		if (m_Messages.size() > 256)
-			m_Messages.erase(m_Messages.begin());
+		std::lock_guard lock(m_PendingMessagesMutex);
+
+		m_PendingMessages.push_back(msg);
+		if (m_PendingMessages.size() > 256)
+			m_PendingMessages.erase(m_PendingMessages.begin());
 	}
 
 }
\ No newline at end of file
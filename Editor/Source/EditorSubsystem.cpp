@@ -90,6 +90,24 @@ public:
 		ImGui::Begin("Debug");
 		ImGui::Text(fmt::format("Delta time: {}", step * 1000.0f).c_str());
 		ImGui::Text(fmt::format("FPS: {}", (uint32)(1000.0f / (step * 1000.0f))).c_str());
+
+		if (ImGui::Button("Dump memory telemetry"))
+			MemoryTelemetry::DumpJSON(FileSystem::GetWorkingDirectory() / "MemoryTelemetry.json");
+
+		bool recording_tasks = JobSystem::IsRecordingTasks();
+		if (ImGui::Button(recording_tasks ? "Stop task recording" : "Start task recording"))
+			recording_tasks ? JobSystem::StopTaskRecording() : JobSystem::StartTaskRecording();
+
+		if (ImGui::Button("Dump task statistics"))
+			JobSystem::DumpTaskStatistics(FileSystem::GetWorkingDirectory() / "TaskStatistics.json");
+
+#if OMNIFORCE_PROFILER_ENABLED
+		if (Profiler::IsCapturing())
+			ImGui::Text(fmt::format("Profiler capture: {} events", Profiler::GetNumCapturedEvents()).c_str());
+		else if (ImGui::Button("Capture 300 frames"))
+			Profiler::CaptureFrames(300, FileSystem::GetWorkingDirectory() / "ProfilerCapture.json");
+#endif
+
 		ImGui::End();
 
 		// Utils
@@ -232,7 +250,7 @@ public:
 			};
 
 			if (m_EntitySelected) {
-				entt::entity entity_id = m_CurrentScene->GetEntities().at(selected_node);
+				entt::entity entity_id = m_CurrentScene->GetEntities().At(selected_node);
 				m_SelectedEntity = Entity(m_SelectedEntity, m_CurrentScene);
 			}
 			m_HierarchyPanel->SetContext(m_CurrentScene);
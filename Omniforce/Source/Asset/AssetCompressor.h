@@ -5,6 +5,8 @@
 #include <Asset/AssetBase.h>
 #include <Asset/AssetFile.h>
 
+#include <span>
+
 namespace Omni {
 
 	/*
@@ -38,6 +40,15 @@ namespace Omni {
 		*/
 		static uint64 DecompressGDeflateCPU(std::istream* in, uint64 size, std::ostream* out);
 
+		/*
+		*  @brief Decompresses data using single core CPU GDeflate decompression implementation.
+		*  Pages are decompressed straight from input memory into output memory, no intermediate copies are made.
+		*  @param[in] in: compressed pages
+		*  @param[out] out: memory to write decompressed data in, must be large enough to fit whole data
+		*  @return Size of decompressed data, 0 if data is malformed
+		*/
+		static uint64 DecompressGDeflateCPU(std::span<const byte> in, std::span<byte> out);
+
 		/*
 		*  @brief Updates given CRC32 checksum for a given stream of data
 		*  @return Updated CRC32 checksum
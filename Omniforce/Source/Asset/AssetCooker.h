@@ -0,0 +1,131 @@
+#pragma once
+
+#include <Foundation/Common.h>
+#include <Asset/AssetType.h>
+#include <Asset/Importers/GLTFReader.h>
+#include <Rendering/Meshlet.h>
+#include <Core/BitStream.h>
+
+#include <array>
+#include <filesystem>
+#include <span>
+
+namespace Omni {
+
+	enum class AssetCookStage : uint8 {
+		IMAGE_DECODE,
+		MIP_GENERATION,
+		BC7_ENCODING,
+		MESH_PARSE,				// Parsing glTF source, once per model
+		VERTEX_READ,			// Reading vertex and index data of a primitive
+		MESH_OPTIMIZATION,
+		CLUSTER_GRAPH_BUILD,
+		QUANTIZATION,			// Vertex remap, geometry and attribute split, position quantization
+		GDEFLATE_COMPRESSION,
+		WRITE,
+		COUNT
+	};
+
+	struct AssetCookStageStatistics {
+		Atomic<uint64> num_items = 0;
+		Atomic<uint64> input_size = 0;	// Bytes
+		Atomic<uint64> output_size = 0;	// Bytes
+		Atomic<uint64> time = 0;		// Nanoseconds, summed over all assets which passed the stage, so it can exceed wall time
+	};
+
+	/*
+	*	@brief Per-stage statistics of asset cooking, can be shared by assets cooked concurrently
+	*/
+	class OMNIFORCE_API AssetCookStatistics {
+	public:
+		// `begin` and `end` are profiler timestamps
+		void Record(AssetCookStage stage, uint64 begin, uint64 end, uint64 input_size, uint64 output_size);
+
+		const AssetCookStageStatistics& GetStage(AssetCookStage stage) const { return m_Stages[(uint32)stage]; }
+
+		static const char* GetStageName(AssetCookStage stage);
+
+	private:
+		std::array<AssetCookStageStatistics, (uint32)AssetCookStage::COUNT> m_Stages;
+	};
+
+	struct CookedImage {
+		std::vector<byte> bc7_encoded_data; // All mip levels, mip 0 first
+		uint32 width = 0;
+		uint32 height = 0;
+		uint32 num_mip_levels = 0;
+	};
+
+	// Virtual geometry of a mesh, ready to be uploaded or serialized
+	struct CookedVirtualMesh {
+		Ptr<BitStream> geometry;
+		std::vector<byte> attributes;
+		std::vector<RenderableMeshlet> meshlets;
+		std::vector<byte> local_indices;
+		std::vector<MeshClusterBounds> cull_data;
+		int32 quantization_grid_size = 0;
+		uint32 vertex_stride = 0;
+		Bounds bounds = {};
+	};
+
+	// Subresources of a cooked mesh file, header additional data stores vertex stride in low and quantization grid size in high 32 bits
+	enum class CookedMeshSubresource : uint8 {
+		GEOMETRY,		// Quantized positions bit stream storage
+		MESHLETS,
+		LOCAL_INDICES,
+		CULL_DATA,
+		BOUNDS,			// Single `Bounds` of the whole mesh
+		ATTRIBUTES,		// Empty for position-only meshes, so it goes last and does not cut off extraction of other subresources
+		COUNT
+	};
+
+	/*
+	*	@brief Offline asset processing which needs no window, renderer or asset manager, so it is used both by the editor
+	*	importers and by headless cooking tools. Functions are thread safe and may be called from job system workers,
+	*	heavy stages are parallelized on background lane.
+	*/
+	class OMNIFORCE_API AssetCooker {
+	public:
+		// Sets up global state of source decoders, called by asset manager and by tools which run without it
+		static void Init();
+
+		/*
+		*	@brief Image pipeline: decode -> mip generation -> BC7 encoding -> GDeflate -> .oft file
+		*	@return false if source could not be read, decoded or output could not be written
+		*/
+		static bool CookImage(const std::filesystem::path& source_path, const std::filesystem::path& output_path, AssetCookStatistics* statistics = nullptr);
+
+		/*
+		*	@brief Decodes image source file data, generates mips and encodes them to BC7
+		*	@return false if data could not be decoded or image is too small for BC7
+		*/
+		static bool EncodeImage(std::span<const byte> source_data, CookedImage* out_image, AssetCookStatistics* statistics = nullptr);
+
+		/*
+		*	@brief Compresses BC7 encoded image with mips into .oft file
+		*/
+		static bool WriteImage(const std::filesystem::path& output_path, const CookedImage& image, AssetCookStatistics* statistics = nullptr);
+
+		/*
+		*	@brief Mesh pipeline for every triangle primitive of a glTF model: optimization -> cluster graph -> quantization -> .ofm file.
+		*	Primitive files are named `<model name>_<mesh index>_<primitive index>.ofm`. Unsupported primitives are skipped
+		*	@return false if source could not be parsed or any of the primitives failed to cook
+		*/
+		static bool CookModel(const std::filesystem::path& source_path, const std::filesystem::path& output_directory, AssetCookStatistics* statistics = nullptr);
+
+		/*
+		*	@brief Builds virtual geometry from interleaved vertex data, position is expected at 0 offset
+		*/
+		static CookedVirtualMesh CookVirtualMesh(const std::vector<byte>& vertex_data, const std::vector<uint32>& index_data, uint32 vertex_stride,
+			const VertexAttributeMetadataTable& vertex_metadata, AssetCookStatistics* statistics = nullptr);
+
+		static bool WriteVirtualMesh(const std::filesystem::path& output_path, const CookedVirtualMesh& mesh, AssetCookStatistics* statistics = nullptr);
+
+		/*
+		*	@brief Writes Omniforce asset file. Subresources larger than half of a GDeflate page are compressed
+		*/
+		static bool WriteAssetFile(const std::filesystem::path& output_path, AssetType type, uint64 additional_data,
+			std::span<const std::span<const byte>> subresources, AssetCookStatistics* statistics = nullptr);
+	};
+
+}
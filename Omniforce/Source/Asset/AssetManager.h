@@ -2,9 +2,12 @@
 
 #include <Foundation/Common.h>
 #include <RHI/Image.h>
+#include <Threading/Task.h>
 
 #include <filesystem>
 #include <shared_mutex>
+#include <mutex>
+#include <coroutine>
 
 #include <robin_hood.h>
 
@@ -23,10 +26,16 @@ namespace Omni {
 
 		AssetHandle LoadAssetSource(std::filesystem::path path, const AssetHandle& id = AssetHandle());
 		AssetHandle RegisterAsset(Ref<AssetBase> asset, const AssetHandle& id = AssetHandle());
-		bool HasAsset(AssetHandle id) { return m_AssetRegistry.contains(id); }
+
+		/*
+		*	@brief Reads, compresses and uploads image source without blocking job system workers.
+		*	Compressed image file is written to "assets/compressed" concurrently with image creation
+		*/
+		Task<AssetHandle> ImportImageSourceAsync(std::filesystem::path path, AssetHandle handle = AssetHandle());
+		bool HasAsset(AssetHandle id) { return m_AssetRegistry.Contains(id); }
 
 		template<typename ResourceType> // where ResourceType is child of AssetType: Image, Mesh, Material etc.
-		Ref<ResourceType> GetAsset(AssetHandle id) { return m_AssetRegistry.at(id); }
+		Ref<ResourceType> GetAsset(AssetHandle id) { return m_AssetRegistry.At(id); }
 		AssetHandle GetHandle(std::filesystem::path path) const { return m_UUIDs.at(path.string()); }
 		auto* GetAssetRegistry() const { return &m_AssetRegistry; }
 
@@ -34,11 +43,27 @@ namespace Omni {
 		AssetHandle ImportImage(std::filesystem::path path, AssetHandle handle);
 		AssetHandle ImportMeshSource(std::filesystem::path path, AssetHandle handle);
 		AssetHandle ImportImageSource(std::filesystem::path path, AssetHandle handle);
+		Task<AssetHandle> CookImageSource(std::filesystem::path path, AssetHandle handle);
+
+		/*
+		*	@brief Import of an image source which is in flight. Concurrent imports of the same path await it
+		*	instead of decoding and registering the image once again
+		*/
+		struct PendingImport {
+			std::mutex mutex;
+			std::vector<std::coroutine_handle<>> waiters;
+			AssetHandle result = AssetHandle(0);
+			bool completed = false;
+
+			auto Wait();
+			void Complete(AssetHandle handle);
+		};
 
 	private:
 		inline static AssetManager* s_Instance;
-		robin_hood::unordered_map<AssetHandle, Ref<AssetBase>> m_AssetRegistry;
+		FlatHashMap<AssetHandle, Ref<AssetBase>> m_AssetRegistry;
 		robin_hood::unordered_map<std::filesystem::path, UUID> m_UUIDs;
+		robin_hood::unordered_map<std::filesystem::path, std::shared_ptr<PendingImport>> m_PendingImports;
 		std::shared_mutex m_Mutex;
 	};
 
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Foundation/Common.h>
+#include <Filesystem/MappedFile.h>
+
+#include <filesystem>
+#include <map>
+
+namespace fastgltf {
+	class Asset;
+	class Mesh;
+	class Material;
+	class Primitive;
+}
+
+namespace Omni {
+
+	namespace ftf = fastgltf;
+
+	using VertexAttributeMetadataTable = std::map<std::string, uint8>;
+
+	/*
+	*	@brief glTF parsing and vertex reading shared by model importer and asset cooker. Creates no GPU resources,
+	*	so it is a part of renderer-independent engine code
+	*/
+	class OMNIFORCE_API GLTFReader {
+	public:
+		/*
+		*  Extract and validate fastgltf::Asset. Source file is mapped, copied once into the parser buffer and unmapped right away
+		*  @param source_size - optional, receives size of the source file in bytes
+		*  @return true on success
+		*/
+		static bool ExtractAsset(ftf::Asset* asset, std::filesystem::path path, uint64* source_size = nullptr);
+
+		/*
+		*  Used to validate support of the mesh and use returned result further for conditional tasking
+		*/
+		static bool ValidateSubmesh(const ftf::Mesh* mesh, const ftf::Primitive* primitive, const ftf::Material* material);
+
+		/*
+		*  Evaluate attribute offsets and vertex stride
+		*/
+		static void ReadVertexMetadata(VertexAttributeMetadataTable* out_table, uint32* out_size, const ftf::Asset* asset, const ftf::Primitive* mesh);
+
+		/*
+		*  Read vertex and index data to buffers
+		*/
+		static void ReadVertexAttributes(std::vector<byte>* out_vertex_data, std::vector<uint32>* out_index_data, const ftf::Asset* asset,
+			const ftf::Primitive* mesh, const VertexAttributeMetadataTable* metadata, uint32 vertex_stride);
+	};
+
+}
@@ -3,9 +3,11 @@
 #include <Foundation/Common.h>
 #include <Asset/AssetBase.h>
 #include <RHI/Pipeline.h>
+#include <RHI/ShaderMacroTable.h>
 
 #include <variant>
-#include <map>
+#include <vector>
+#include <algorithm>
 
 // Undefine OPAQUE macro to prevent conflicts with enum values
 #ifdef OPAQUE
@@ -17,6 +19,72 @@ namespace Omni {
 	using MaterialTextureProperty = std::pair<AssetHandle, uint32>; // texture id - uv channel
 	using MaterialProperty = std::variant<MaterialTextureProperty, float32, uint32, glm::vec4>;
 
+	/*
+	*	@brief Material properties keyed by interned names. Entries are kept in lexical key order, since
+	*	runtime material layout is packed in iteration order. Materials have a handful of properties,
+	*	so lookup is a linear scan with pointer compares, no strings are compared.
+	*/
+	class MaterialPropertyTable {
+	public:
+		using Entry = std::pair<Name, MaterialProperty>;
+
+		// Adds a property if key is not present yet. @return true if property was added
+		bool Emplace(Name key, const MaterialProperty& property) {
+			if (Contains(key))
+				return false;
+
+			auto iterator = std::upper_bound(m_Entries.begin(), m_Entries.end(), key, [](const Name& key, const Entry& entry) {
+				return Name::LexicalLess(key, entry.first);
+			});
+			m_Entries.insert(iterator, { key, property });
+
+			return true;
+		}
+
+		void Remove(Name key) {
+			auto iterator = Find(key);
+			if (iterator != m_Entries.end())
+				m_Entries.erase(iterator);
+		}
+
+		bool Contains(Name key) const { return Find(key) != m_Entries.end(); }
+
+		const MaterialProperty& At(Name key) const {
+			auto iterator = Find(key);
+			OMNIFORCE_ASSERT_TAGGED(iterator != m_Entries.end(), "Material property not found");
+			return iterator->second;
+		}
+
+		MaterialProperty& At(Name key) {
+			return const_cast<MaterialProperty&>(std::as_const(*this).At(key));
+		}
+
+		MaterialProperty& operator[](Name key) {
+			Emplace(key, MaterialProperty());
+			return Find(key)->second;
+		}
+
+		uint64 Size() const { return m_Entries.size(); }
+		bool IsEmpty() const { return m_Entries.empty(); }
+
+		auto begin() { return m_Entries.begin(); }
+		auto end() { return m_Entries.end(); }
+		auto begin() const { return m_Entries.begin(); }
+		auto end() const { return m_Entries.end(); }
+
+	private:
+		std::vector<Entry>::const_iterator Find(Name key) const {
+			return std::find_if(m_Entries.begin(), m_Entries.end(), [key](const Entry& entry) { return entry.first == key; });
+		}
+
+		std::vector<Entry>::iterator Find(Name key) {
+			return std::find_if(m_Entries.begin(), m_Entries.end(), [key](const Entry& entry) { return entry.first == key; });
+		}
+
+	private:
+		std::vector<Entry> m_Entries;
+	};
+
 	enum class META(ShaderExpose, Module = "RenderingGenerated") SurfaceDomain {
 		OPAQUE,
 		MASKED,
@@ -39,11 +107,11 @@ namespace Omni {
 		void Destroy() override;
 
 		template<typename T>
-		void AddProperty(std::string_view key, T property) { m_Properties.emplace(key, property); }
-		void RemoveResource(std::string_view key) { m_Properties.erase(key.data()); }
+		void AddProperty(Name key, T property) { m_Properties.Emplace(key, property); }
+		void RemoveResource(Name key) { m_Properties.Remove(key); }
 
-		void AddShaderMacro(const std::string& macro, const std::string& value = "") {
-			m_Macros.emplace(macro, value);
+		void AddShaderMacro(Name macro, std::string_view value = {}) {
+			m_Macros.Set(macro, value);
 		}
 
 		static uint8 GetRuntimeEntrySize(uint8 variant_index);
@@ -57,7 +125,7 @@ namespace Omni {
 		MaterialDomain GetDomain() const { return m_Domain; }
 	private:
 		std::string m_Name;
-		std::map<std::string, MaterialProperty> m_Properties;
+		MaterialPropertyTable m_Properties;
 		ShaderMacroTable m_Macros;
 		Ref<Pipeline> m_Pipeline;
 		MaterialDomain m_Domain;
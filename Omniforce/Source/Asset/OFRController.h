@@ -3,25 +3,21 @@
 #include <Foundation/Common.h>
 #include <Asset/AssetCompressor.h>
 #include <Asset/AssetFile.h>
+#include <Filesystem/MappedFile.h>
 
 namespace Omni {
 
 class OMNIFORCE_API OFRController {
 public:
 	OFRController(std::filesystem::path path, uint64 offset = 0)
-		: m_Filepath(path), m_OriginalOffset(0), m_Dirty(true)
+		: m_Filepath(path), m_OriginalOffset(offset), m_Dirty(true)
 	{
-		if (!std::filesystem::exists(path))
-		{
-			m_FileStream.open(path, std::fstream::out);
-			m_FileStream.close();
-		}
-
-		m_FileStream.open(path, std::fstream::binary | std::fstream::in | std::fstream::out);
-
-		m_FileStream.seekg(offset);
-		m_FileStream.seekp(offset);
+	}
 
+	// Reads file which is already loaded into memory, e.g. by `IOService`. Memory must outlive the controller
+	OFRController(std::span<const byte> file_data, uint64 offset = 0)
+		: m_FileData(file_data), m_OriginalOffset(offset), m_Dirty(true)
+	{
 	}
 
 	Ptr<AssetFile> Build(std::array<AssetFileSubresourceMetadata, 16> metadata, std::vector<byte> data, uint64 additional_data);
@@ -55,7 +51,7 @@ public:
 	}
 
 	// Helper functions
-	inline static uint32 GetOFTHeaderSize() { return sizeof AssetFileHeader; }
+	inline static uint32 GetOFTHeaderSize() { return sizeof(AssetFileHeader); }
 
 	inline static uint32 GetMaxSubresources() { return AssetFile().subresources_metadata.size(); }
 
@@ -67,19 +63,18 @@ public:
 	inline bool Dirty() const { return m_Dirty; }
 
 private:
-	void LoadHeaderAndMetadata() {
-		uint32 current_p = m_FileStream.tellg();
-		m_FileStream.seekg(m_OriginalOffset);
-		m_FileStream.read((char*)&m_Header, sizeof AssetFileHeader);
-		m_FileStream.read((char*)m_Metadata.data(), sizeof AssetFileSubresourceMetadata * m_Metadata.size());
-		m_FileStream.seekg(current_p);
-
-		m_Dirty = false;
-	}
+	void LoadHeaderAndMetadata();
+
+	// Maps file on first read, reads go straight to mapped memory instead of stream copies
+	bool AcquireFileData();
+
+	// @return view of file data clamped to the end of a file
+	std::span<const byte> GetFileView(uint64 offset, uint64 size) const;
 
 private:
 	// Precached data
-	std::fstream m_FileStream;
+	Ref<MappedFile> m_MappedFile;
+	std::span<const byte> m_FileData;
 	uint64 m_OriginalOffset;
 	std::filesystem::path m_Filepath;
 	AssetFileHeader m_Header;
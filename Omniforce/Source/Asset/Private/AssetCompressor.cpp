@@ -41,13 +41,15 @@ namespace Omni {
 
 	std::vector<RGBA32> AssetCompressor::GenerateMipMaps(const std::vector<RGBA32>& mip0_data, uint32 image_width, uint32 image_height)
 	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
 		// create storage for mip levels
-		uint32 storage_size = Utils::ComputeMipLevelsStorage<sizeof RGBA32>(image_width, image_height);
+		uint32 storage_size = Utils::ComputeMipLevelsStorage<sizeof(RGBA32)>(image_width, image_height);
 		std::vector<RGBA32> storage;
-		storage.resize(storage_size / sizeof RGBA32);
+		storage.resize(storage_size / sizeof(RGBA32));
 
 		// copy first mip to storage
-		memcpy(storage.data(), mip0_data.data(), image_width * image_height * sizeof RGBA32);
+		memcpy(storage.data(), mip0_data.data(), image_width * image_height * sizeof(RGBA32));
 
 		// current image (from which we're computing next level)
 		uint32 current_image_width = image_width;
@@ -63,14 +65,12 @@ namespace Omni {
 		// Per mip level
 		for (int i = 0; i < num_mip_levels; i++) {
 
-			// First y - improve caching
-			tf::Taskflow taskflow;
-			
 			// Calculate the number of rows to process
 			uint32 num_rows = current_image_height / 2;
-			
-			for (uint32 row_idx = 0; row_idx < num_rows; row_idx++) {
-				taskflow.emplace([&, row_idx, current_image_width, current_image_height, src_mip_pointer, dst_mip_pointer]() {
+
+			// Rows are split into chunks, so a level is processed by a few chunk tasks instead of a task per row
+			JobSystem::ParallelFor(num_rows, [&](uint32 first_row, uint32 last_row) {
+				for (uint32 row_idx = first_row; row_idx < last_row; row_idx++) {
 					int y = row_idx * 2;
 					for (int x = 0; x < current_image_width; x += 2) {
 						// Fetch current 2x2 block (left upper pixel)
@@ -94,11 +94,8 @@ namespace Omni {
 						uint32 offset = (y / 2 * (current_image_width / 2)) + (x / 2);
 						*(dst_mip_pointer + offset) = result;
 					}
-				});
-			}
-			
-			// Execute all tasks and wait for completion
-			JobSystem::GetExecutor()->run(taskflow).wait();
+				}
+			}, { JobPriority::BACKGROUND, 0, "Generate Mip Rows" });
 
 			// Also update the pointer
 			src_mip_pointer += current_image_width * current_image_height;
@@ -114,6 +111,8 @@ namespace Omni {
 
 	std::vector<Omni::byte> AssetCompressor::CompressBC7(const std::vector<RGBA32>& source, uint32 image_width, uint32 image_height, uint8 mip_levels_count)
 	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
 		std::vector<byte> output_data(image_width * image_height * mip_levels_count);
 		uint32 current_mip_offset = 0;
 		for(int i = 0; i < mip_levels_count; i++) {
@@ -240,6 +239,53 @@ namespace Omni {
 
 	}
 
+	uint64 AssetCompressor::DecompressGDeflateCPU(std::span<const byte> in, std::span<byte> out)
+	{
+		auto d = libdeflate_alloc_gdeflate_decompressor();
+
+		if (d == nullptr) return 0;
+
+		uint64 input_offset = 0;
+		uint64 output_offset = 0;
+
+		while (input_offset != in.size())
+		{
+			// Read a compressed page header
+			AssetCompressor::GDeflatePageHeader page_header;
+
+			if (in.size() - input_offset < sizeof(page_header)) {
+				output_offset = 0;
+				break;
+			}
+
+			memcpy(&page_header, in.data() + input_offset, sizeof(page_header));
+			input_offset += sizeof(page_header);
+
+			if (in.size() - input_offset < page_header.compressed_size) {
+				output_offset = 0;
+				break;
+			}
+
+			// Decompress page directly from input memory
+			libdeflate_gdeflate_in_page page{ in.data() + input_offset, page_header.compressed_size };
+			size_t out_size = 0;
+
+			libdeflate_result result = libdeflate_gdeflate_decompress(d, &page, 1, out.data() + output_offset, out.size() - output_offset, &out_size);
+
+			if (result != LIBDEFLATE_SUCCESS) {
+				output_offset = 0;
+				break;
+			}
+
+			input_offset += page_header.compressed_size;
+			output_offset += out_size;
+		}
+
+		libdeflate_free_gdeflate_decompressor(d);
+
+		return output_offset;
+	}
+
 	uint32 AssetCompressor::GDeflateCRC32(uint32 crc32, const std::vector<byte>& data)
 	{
 		return libdeflate_crc32(crc32, data.data(), data.size());
@@ -0,0 +1,489 @@
+#include <Foundation/Common.h>
+#include <Asset/AssetCooker.h>
+
+#include <Asset/AssetCompressor.h>
+#include <Asset/AssetFile.h>
+#include <Asset/MeshPreprocessor.h>
+#include <Asset/VertexQuantizer.h>
+#include <Asset/VirtualMeshBuilder.h>
+#include <Asset/Importers/GLTFReader.h>
+#include <Filesystem/Filesystem.h>
+#include <Threading/JobSystem.h>
+#include <Core/Utils.h>
+
+#include <fstream>
+#include <sstream>
+
+#include <glm/glm.hpp>
+#include <fastgltf/parser.hpp>
+#include <spdlog/fmt/fmt.h>
+#include <stb_image.h>
+
+namespace Omni {
+
+	// just an alias for readability
+	namespace ftf = fastgltf;
+
+	static const char* s_CookStageNames[] = {
+		"Image decode",
+		"Mip generation",
+		"BC7 encoding",
+		"Mesh parse",
+		"Vertex read",
+		"Mesh optimization",
+		"Cluster graph build",
+		"Quantization",
+		"GDeflate compression",
+		"Write"
+	};
+
+	static_assert(std::size(s_CookStageNames) == (uint32)AssetCookStage::COUNT);
+
+	void AssetCookStatistics::Record(AssetCookStage stage, uint64 begin, uint64 end, uint64 input_size, uint64 output_size)
+	{
+		AssetCookStageStatistics& stage_statistics = m_Stages[(uint32)stage];
+
+		stage_statistics.num_items.fetch_add(1, std::memory_order_relaxed);
+		stage_statistics.input_size.fetch_add(input_size, std::memory_order_relaxed);
+		stage_statistics.output_size.fetch_add(output_size, std::memory_order_relaxed);
+		stage_statistics.time.fetch_add(end > begin ? end - begin : 0, std::memory_order_relaxed);
+	}
+
+	const char* AssetCookStatistics::GetStageName(AssetCookStage stage)
+	{
+		return s_CookStageNames[(uint32)stage];
+	}
+
+	// Statistics are optional, stage ends at the moment of the call
+	static void RecordCookStage(AssetCookStatistics* statistics, AssetCookStage stage, uint64 begin, uint64 input_size, uint64 output_size)
+	{
+		if (statistics)
+			statistics->Record(stage, begin, Profiler::Now(), input_size, output_size);
+	}
+
+	template<typename T>
+	static std::span<const byte> AsByteSpan(std::span<const T> data)
+	{
+		return { (const byte*)data.data(), data.size_bytes() };
+	}
+
+	void AssetCooker::Init()
+	{
+		stbi_set_flip_vertically_on_load(true);
+	}
+
+	bool AssetCooker::CookImage(const std::filesystem::path& source_path, const std::filesystem::path& output_path, AssetCookStatistics* statistics)
+	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
+		Ref<MappedFile> source_file = FileSystem::MapFile(&g_AssetAllocator, source_path, MappedFileAccessHint::SEQUENTIAL);
+
+		if (!source_file || !source_file->GetSize()) {
+			OMNIFORCE_CORE_ERROR("Failed to open image source \"{}\"", source_path.string());
+			return false;
+		}
+
+		CookedImage image = {};
+		if (!EncodeImage(source_file->GetView(), &image, statistics)) {
+			OMNIFORCE_CORE_ERROR("Failed to decode image source \"{}\"", source_path.string());
+			return false;
+		}
+
+		// Source is not needed anymore, so it is unmapped before the output is written
+		source_file = nullptr;
+
+		return WriteImage(output_path, image, statistics);
+	}
+
+	bool AssetCooker::EncodeImage(std::span<const byte> source_data, CookedImage* out_image, AssetCookStatistics* statistics)
+	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
+		uint64 stage_begin = Profiler::Now();
+
+		uint32 image_width, image_height;
+		int32 channels;
+		RGBA32* raw_image_data = (RGBA32*)stbi_load_from_memory((const stbi_uc*)source_data.data(), (int32)source_data.size(), (int32*)&image_width, (int32*)&image_height, &channels, STBI_rgb_alpha);
+
+		if (!raw_image_data)
+			return false;
+
+		// BC7 works with 4x4 blocks and mip chain is cut at 4 pixels, so smaller images have no valid mip count
+		if (std::min(image_width, image_height) < 4) {
+			OMNIFORCE_CORE_ERROR("Image of {}x{} is too small for BC7 encoding", image_width, image_height);
+			stbi_image_free(raw_image_data);
+			return false;
+		}
+
+		std::vector<RGBA32> image_data;
+		image_data.assign(raw_image_data, raw_image_data + (image_width * image_height));
+		stbi_image_free(raw_image_data);
+
+		RecordCookStage(statistics, AssetCookStage::IMAGE_DECODE, stage_begin, source_data.size(), image_data.size() * sizeof(RGBA32));
+
+		out_image->width = image_width;
+		out_image->height = image_height;
+		out_image->num_mip_levels = Utils::ComputeNumMipLevelsBC7(image_width, image_height) + 1;
+
+		// Generate mip map
+		stage_begin = Profiler::Now();
+
+		std::vector<RGBA32> image_data_with_mips = AssetCompressor::GenerateMipMaps(image_data, image_width, image_height);
+
+		RecordCookStage(statistics, AssetCookStage::MIP_GENERATION, stage_begin, image_data.size() * sizeof(RGBA32), image_data_with_mips.size() * sizeof(RGBA32));
+
+		// Encode all mips
+		stage_begin = Profiler::Now();
+
+		out_image->bc7_encoded_data = AssetCompressor::CompressBC7(image_data_with_mips, image_width, image_height, out_image->num_mip_levels);
+
+		RecordCookStage(statistics, AssetCookStage::BC7_ENCODING, stage_begin, image_data_with_mips.size() * sizeof(RGBA32), out_image->bc7_encoded_data.size());
+
+		return true;
+	}
+
+	bool AssetCooker::WriteImage(const std::filesystem::path& output_path, const CookedImage& image, AssetCookStatistics* statistics)
+	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
+		OMNIFORCE_ASSERT_TAGGED(image.num_mip_levels <= 16, "Image file can't hold more than 16 mip levels");
+
+		// Every mip level is a separate subresource. BC7 takes a byte per pixel
+		std::array<std::span<const byte>, 16> subresources = {};
+
+		uint64 mip_offset = 0;
+		for (uint32 i = 0; i < image.num_mip_levels; i++) {
+			uint64 mip_size = (uint64)(image.width >> i) * (image.height >> i);
+
+			OMNIFORCE_ASSERT_TAGGED(mip_offset + mip_size <= image.bc7_encoded_data.size(), "Mip level is out of encoded data bounds");
+
+			subresources[i] = { image.bc7_encoded_data.data() + mip_offset, mip_size };
+			mip_offset += mip_size;
+		}
+
+		return WriteAssetFile(
+			output_path,
+			AssetType::IMAGE_SRC,
+			(uint64)image.width | (uint64)image.height << 32,
+			std::span(subresources.data(), image.num_mip_levels),
+			statistics
+		);
+	}
+
+	// Only attributes which `GLTFReader::ReadVertexAttributes` can read
+	static bool IsCookableVertexAttribute(std::string_view attribute_name)
+	{
+		return attribute_name == "POSITION" ||
+			attribute_name.find("TEXCOORD") != std::string_view::npos ||
+			attribute_name.find("NORMAL") != std::string_view::npos ||
+			attribute_name.find("TANGENT") != std::string_view::npos ||
+			attribute_name.find("COLOR") != std::string_view::npos;
+	}
+
+	bool AssetCooker::CookModel(const std::filesystem::path& source_path, const std::filesystem::path& output_directory, AssetCookStatistics* statistics)
+	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
+		uint64 stage_begin = Profiler::Now();
+
+		ftf::Asset asset;
+		uint64 source_size = 0;
+
+		if (!GLTFReader::ExtractAsset(&asset, source_path, &source_size))
+			return false;
+
+		RecordCookStage(statistics, AssetCookStage::MESH_PARSE, stage_begin, source_size, 0);
+
+		struct PrimitiveReference {
+			uint32 mesh_index;
+			uint32 primitive_index;
+		};
+
+		std::vector<PrimitiveReference> primitives;
+
+		for (uint32 mesh_idx = 0; mesh_idx < asset.meshes.size(); mesh_idx++) {
+			const ftf::Mesh& mesh = asset.meshes[mesh_idx];
+
+			for (uint32 primitive_idx = 0; primitive_idx < mesh.primitives.size(); primitive_idx++) {
+				const ftf::Primitive& primitive = mesh.primitives[primitive_idx];
+
+				if (!primitive.indicesAccessor.has_value() || primitive.type != ftf::PrimitiveType::Triangles) {
+					OMNIFORCE_CORE_WARNING("Skipping primitive {} of mesh {} in \"{}\": only indexed triangle lists are supported",
+						primitive_idx, mesh_idx, source_path.string());
+					continue;
+				}
+
+				bool has_unsupported_attributes = false;
+				for (const auto& attribute : primitive.attributes) {
+					std::string_view attribute_name = attribute.first;
+
+					if (!IsCookableVertexAttribute(attribute_name)) {
+						OMNIFORCE_CORE_WARNING("Skipping primitive {} of mesh {} in \"{}\": attribute \"{}\" is not supported",
+							primitive_idx, mesh_idx, source_path.string(), attribute_name);
+						has_unsupported_attributes = true;
+						break;
+					}
+				}
+
+				if (!has_unsupported_attributes)
+					primitives.push_back({ mesh_idx, primitive_idx });
+			}
+		}
+
+		if (primitives.empty()) {
+			OMNIFORCE_CORE_WARNING("Model \"{}\" has no primitives which can be cooked", source_path.string());
+			return true;
+		}
+
+		std::string model_name = source_path.stem().string();
+		Atomic<uint32> num_failed_primitives = 0;
+
+		// Primitives are heavy, so every primitive is a separate chunk
+		JobSystem::ParallelFor((uint32)primitives.size(), [&](uint32 first_primitive, uint32 last_primitive) {
+			for (uint32 i = first_primitive; i < last_primitive; i++) {
+				const PrimitiveReference& reference = primitives[i];
+				const ftf::Primitive& primitive = asset.meshes[reference.mesh_index].primitives[reference.primitive_index];
+
+				uint64 read_begin = Profiler::Now();
+
+				VertexAttributeMetadataTable vertex_metadata;
+				uint32 vertex_stride = 0;
+				std::vector<byte> vertex_data;
+				std::vector<uint32> index_data;
+
+				GLTFReader::ReadVertexMetadata(&vertex_metadata, &vertex_stride, &asset, &primitive);
+				GLTFReader::ReadVertexAttributes(&vertex_data, &index_data, &asset, &primitive, &vertex_metadata, vertex_stride);
+
+				uint64 vertex_data_size = vertex_data.size() + index_data.size() * sizeof(uint32);
+				RecordCookStage(statistics, AssetCookStage::VERTEX_READ, read_begin, vertex_data_size, vertex_data_size);
+
+				if (index_data.size() < 3) {
+					OMNIFORCE_CORE_WARNING("Skipping primitive {} of mesh {} in \"{}\": primitive has no triangles",
+						reference.primitive_index, reference.mesh_index, source_path.string());
+					continue;
+				}
+
+				CookedVirtualMesh cooked_mesh = CookVirtualMesh(vertex_data, index_data, vertex_stride, vertex_metadata, statistics);
+
+				std::filesystem::path output_path = output_directory / fmt::format("{}_{}_{}.ofm", model_name, reference.mesh_index, reference.primitive_index);
+
+				if (!WriteVirtualMesh(output_path, cooked_mesh, statistics))
+					num_failed_primitives.fetch_add(1, std::memory_order_relaxed);
+			}
+		}, { JobPriority::BACKGROUND, 1, "Cook Primitive" });
+
+		return num_failed_primitives.load() == 0;
+	}
+
+	CookedVirtualMesh AssetCooker::CookVirtualMesh(const std::vector<byte>& vertex_data, const std::vector<uint32>& index_data, uint32 vertex_stride,
+		const VertexAttributeMetadataTable& vertex_metadata, AssetCookStatistics* statistics)
+	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
+		CookedVirtualMesh cooked_mesh = {};
+		cooked_mesh.vertex_stride = vertex_stride;
+
+		MeshPreprocessor mesh_preprocessor = {};
+
+		// Optimize mesh (remove redundant vertices, optimize for vertex cache etc.)
+		uint64 stage_begin = Profiler::Now();
+
+		std::vector<byte> optimized_vertices;
+		std::vector<uint32> optimized_indices;
+
+		mesh_preprocessor.OptimizeMesh(&optimized_vertices, &optimized_indices, &vertex_data, &index_data, vertex_stride);
+
+		uint64 optimized_data_size = optimized_vertices.size() + optimized_indices.size() * sizeof(uint32);
+		RecordCookStage(statistics, AssetCookStage::MESH_OPTIMIZATION, stage_begin, vertex_data.size() + index_data.size() * sizeof(uint32), optimized_data_size);
+
+		// Build cluster hierarchy
+		stage_begin = Profiler::Now();
+
+		VirtualMeshBuilder vmesh_builder = {};
+		VirtualMesh vmesh = vmesh_builder.BuildClusterGraph(optimized_vertices, optimized_indices, vertex_stride, vertex_metadata);
+
+		OMNIFORCE_ASSERT_TAGGED(vmesh.meshlets.size(), "No virtual mesh clusters generated");
+		OMNIFORCE_ASSERT_TAGGED(vmesh.indices.size() >= 3, "No virtual mesh indices generated");
+		OMNIFORCE_ASSERT_TAGGED(vmesh.local_indices.size() >= 3, "No virtual mesh local indices generated");
+
+		RecordCookStage(statistics, AssetCookStage::CLUSTER_GRAPH_BUILD, stage_begin, optimized_data_size,
+			vmesh.indices.size() * sizeof(uint32) + vmesh.local_indices.size() +
+			vmesh.meshlets.size() * sizeof(RenderableMeshlet) + vmesh.cull_bounds.size() * sizeof(MeshClusterBounds));
+
+		stage_begin = Profiler::Now();
+
+		// Remap vertices to get rid of generated index buffer after generation of meshlets
+		std::vector<byte> remapped_vertices(vmesh.indices.size() * vertex_stride);
+		mesh_preprocessor.RemapVertices(&remapped_vertices, &optimized_vertices, vertex_stride, &vmesh.indices);
+
+		// Split vertex data into two data streams: geometry and attributes.
+		// It is an optimization used for depth-prepass and shadow maps rendering to speed up data reads.
+		std::vector<glm::vec3> deinterleaved_vertex_data(remapped_vertices.size() / vertex_stride);
+		cooked_mesh.attributes.resize(remapped_vertices.size() / vertex_stride * (vertex_stride - sizeof(glm::vec3)));
+		mesh_preprocessor.SplitVertexData(&deinterleaved_vertex_data, &cooked_mesh.attributes, &remapped_vertices, vertex_stride);
+
+		// Generate mesh bounds
+		cooked_mesh.bounds = mesh_preprocessor.GenerateMeshBounds(&deinterleaved_vertex_data);
+
+		// Copy data
+		cooked_mesh.meshlets = std::move(vmesh.meshlets);
+		cooked_mesh.local_indices = std::move(vmesh.local_indices);
+		cooked_mesh.cull_data = std::move(vmesh.cull_bounds);
+
+		// test on OOB
+		for (auto& meshlet : cooked_mesh.meshlets) {
+			OMNIFORCE_ASSERT_TAGGED(meshlet.vertex_offset + meshlet.metadata.vertex_count <= deinterleaved_vertex_data.size(), "OOB");
+
+			OMNIFORCE_ASSERT_TAGGED(meshlet.triangle_offset + meshlet.metadata.triangle_count <= cooked_mesh.local_indices.size(), "OOB");
+
+			for (uint32 local_index_idx = 0; local_index_idx < meshlet.metadata.triangle_count * 3; local_index_idx++) {
+				OMNIFORCE_ASSERT_TAGGED(meshlet.triangle_offset + local_index_idx < cooked_mesh.local_indices.size(), "OOB");
+				uint32 local_index = cooked_mesh.local_indices[meshlet.triangle_offset + local_index_idx];
+				OMNIFORCE_ASSERT_TAGGED(local_index < meshlet.metadata.vertex_count, "OOB");
+			}
+		}
+
+		// Quantize vertex positions
+		VertexDataQuantizer quantizer;
+		const uint32 vertex_bitrate = quantizer.ComputeOptimalVertexBitrate(cooked_mesh.bounds.aabb);
+		cooked_mesh.quantization_grid_size = vertex_bitrate;
+		uint32 mesh_bitrate = quantizer.ComputeMeshBitrate(vertex_bitrate, cooked_mesh.bounds.aabb);
+		uint32 vertex_bitstream_bit_size = deinterleaved_vertex_data.size() * mesh_bitrate * 3;
+		uint32 grid_size = 1u << vertex_bitrate;
+
+		// byte size is aligned by 4 bytes. So if we have 17 bits worth of data, we create a 4 bytes long bit stream.
+		// if we have 67 bits worth of data, we create 12 bytes long bit stream
+		// We reserve worse case memory size
+		Ptr<BitStream> vertex_stream = CreatePtr<BitStream>(&g_PoolAllocator, (vertex_bitstream_bit_size + BitStream::StorageTypeBitSize - 1) / BitStream::StorageTypeBitSize * 4u);
+		uint32 meshlet_idx = 0;
+
+		for (auto& meshlet_bounds : cooked_mesh.cull_data) {
+			uint32 meshlet_bitrate = std::clamp((uint32)std::ceil(std::log2(meshlet_bounds.vis_culling_sphere.radius * 2 * grid_size)), 1u, BitStream::StorageTypeBitSize); // we need diameter of a sphere, not radius
+
+			OMNIFORCE_ASSERT_TAGGED(meshlet_bitrate <= BitStream::StorageTypeBitSize, "Bit stream overflow");
+
+			RenderableMeshlet& meshlet = cooked_mesh.meshlets[meshlet_idx];
+
+			meshlet.vertex_bit_offset = vertex_stream->GetNumBitsUsed();
+			meshlet.metadata.bitrate = meshlet_bitrate;
+
+			meshlet_bounds.vis_culling_sphere.center = glm::round(meshlet_bounds.vis_culling_sphere.center * float32(grid_size)) / float32(grid_size);
+
+			uint32 base_vertex_offset = cooked_mesh.meshlets[meshlet_idx].vertex_offset;
+			for (uint32 vertex_idx = 0; vertex_idx < meshlet.metadata.vertex_count; vertex_idx++) {
+				for (uint32 vertex_channel = 0; vertex_channel < 3; vertex_channel++) {
+					float32 original_vertex = deinterleaved_vertex_data[base_vertex_offset + vertex_idx][vertex_channel];
+					float32 meshlet_space_value = original_vertex - meshlet_bounds.vis_culling_sphere.center[vertex_channel];
+
+					uint32 value = quantizer.QuantizeVertexChannel(
+						meshlet_space_value,
+						vertex_bitrate,
+						meshlet_bitrate
+					);
+
+					vertex_stream->Append(meshlet_bitrate, value);
+				}
+			}
+			meshlet_idx++;
+		}
+
+		cooked_mesh.geometry = std::move(vertex_stream);
+
+		RecordCookStage(statistics, AssetCookStage::QUANTIZATION, stage_begin, remapped_vertices.size(),
+			cooked_mesh.geometry->GetNumStorageBytesUsed() + cooked_mesh.attributes.size());
+
+		return cooked_mesh;
+	}
+
+	bool AssetCooker::WriteVirtualMesh(const std::filesystem::path& output_path, const CookedVirtualMesh& mesh, AssetCookStatistics* statistics)
+	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
+		OMNIFORCE_ASSERT_TAGGED(mesh.geometry, "Virtual mesh has no geometry");
+
+		std::array<std::span<const byte>, (uint32)CookedMeshSubresource::COUNT> subresources = {};
+		subresources[(uint32)CookedMeshSubresource::GEOMETRY] = { (const byte*)mesh.geometry->GetStorage(), mesh.geometry->GetNumStorageBytesUsed() };
+		subresources[(uint32)CookedMeshSubresource::MESHLETS] = AsByteSpan(std::span(mesh.meshlets));
+		subresources[(uint32)CookedMeshSubresource::LOCAL_INDICES] = mesh.local_indices;
+		subresources[(uint32)CookedMeshSubresource::CULL_DATA] = AsByteSpan(std::span(mesh.cull_data));
+		subresources[(uint32)CookedMeshSubresource::BOUNDS] = AsByteSpan(std::span(&mesh.bounds, 1));
+		subresources[(uint32)CookedMeshSubresource::ATTRIBUTES] = mesh.attributes;
+
+		return WriteAssetFile(
+			output_path,
+			AssetType::OMNI_MESH,
+			(uint64)mesh.vertex_stride | (uint64)(uint32)mesh.quantization_grid_size << 32,
+			subresources,
+			statistics
+		);
+	}
+
+	bool AssetCooker::WriteAssetFile(const std::filesystem::path& output_path, AssetType type, uint64 additional_data,
+		std::span<const std::span<const byte>> subresources, AssetCookStatistics* statistics)
+	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
+		std::array<AssetFileSubresourceMetadata, 16> subresources_metadata = {};
+
+		OMNIFORCE_ASSERT_TAGGED(subresources.size() <= subresources_metadata.size(), "Asset file can't hold more than 16 subresources");
+
+		uint64 stage_begin = Profiler::Now();
+
+		// Configure file header
+		AssetFileHeader file_header = {};
+		file_header.header_size = sizeof(AssetFileHeader);
+		file_header.asset_type = type;
+		file_header.uncompressed_data_size = 0;
+		file_header.subresources_size = 0;
+		file_header.additional_data = additional_data;
+
+		// Compress subresources, offsets are relative to the beginning of subresource data in the file
+		std::ostringstream subresource_data_stream;
+
+		for (uint32 i = 0; i < subresources.size(); i++) {
+			std::span<const byte> subresource = subresources[i];
+			AssetFileSubresourceMetadata& metadata = subresources_metadata[i];
+
+			metadata.offset = (uint32)file_header.subresources_size;
+			metadata.compressed = subresource.size() >= AssetCompressor::GDEFLATE_PAGE_SIZE / 2;
+			metadata.decompressed_size = (uint32)subresource.size();
+
+			if (metadata.compressed) {
+				metadata.size = AssetCompressor::CompressGDeflate({ subresource.begin(), subresource.end() }, &subresource_data_stream);
+			}
+			else {
+				metadata.size = (uint32)subresource.size();
+				subresource_data_stream.write((const char*)subresource.data(), subresource.size());
+			}
+
+			file_header.uncompressed_data_size += subresource.size();
+			file_header.subresources_size += metadata.size;
+		}
+
+		RecordCookStage(statistics, AssetCookStage::GDEFLATE_COMPRESSION, stage_begin, file_header.uncompressed_data_size, file_header.subresources_size);
+
+		stage_begin = Profiler::Now();
+
+		std::ofstream fout(output_path, std::ios::binary | std::ios::out | std::ios::trunc);
+
+		// Write header, subresource metadata and data
+		fout.write((const char*)&file_header, sizeof(file_header));
+		fout.write((const char*)subresources_metadata.data(), sizeof(AssetFileSubresourceMetadata) * subresources_metadata.size());
+
+		std::string_view subresources_data = subresource_data_stream.view();
+		fout.write(subresources_data.data(), subresources_data.size());
+
+		fout.close();
+
+		if (!fout) {
+			OMNIFORCE_CORE_ERROR("Failed to write asset file \"{}\"", output_path.string());
+			return false;
+		}
+
+		uint64 file_size = sizeof(file_header) + sizeof(AssetFileSubresourceMetadata) * subresources_metadata.size() + subresources_data.size();
+		RecordCookStage(statistics, AssetCookStage::WRITE, stage_begin, file_size, file_size);
+
+		return true;
+	}
+
+}
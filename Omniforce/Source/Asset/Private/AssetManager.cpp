@@ -1,15 +1,14 @@
 ﻿#include <Foundation/Common.h>
 #include <Asset/AssetManager.h>
 
-#include <Asset/AssetCompressor.h>
+#include <Asset/AssetCooker.h>
 #include <Core/Utils.h>
 #include <Filesystem/Filesystem.h>
 #include <Threading/JobSystem.h>
+#include <Filesystem/AsyncIO.h>
 
 #include <fstream>
 
-#include <stb_image.h>
-
 namespace Omni {
 
 	AssetManager::AssetManager()
@@ -24,7 +23,7 @@ namespace Omni {
 
 	void AssetManager::Init()
 	{
-		stbi_set_flip_vertically_on_load(true);
+		AssetCooker::Init();
 		s_Instance = new AssetManager;
 	}
 
@@ -37,7 +36,7 @@ namespace Omni {
 	{
 		for (auto& [id, asset] : m_AssetRegistry)
 			asset->Destroy();
-		m_AssetRegistry.clear();
+		m_AssetRegistry.Clear();
 		m_UUIDs.clear();
 	}
 
@@ -62,7 +61,7 @@ namespace Omni {
 	{
 		asset->Handle = id;
 		m_Mutex.lock();
-		m_AssetRegistry.emplace(id, asset);
+		m_AssetRegistry.Emplace(id, asset);
 		m_Mutex.unlock();
 
 		return id;
@@ -77,103 +76,158 @@ namespace Omni {
 
 	AssetHandle AssetManager::ImportImageSource(std::filesystem::path path, AssetHandle handle)
 	{
-		if (m_UUIDs.contains(path.string()))
-			return m_UUIDs.at(path.string());
+		return SyncWait(ImportImageSourceAsync(std::move(path), handle));
+	}
 
+	auto AssetManager::PendingImport::Wait()
+	{
+		struct Awaiter {
+			bool await_ready() const noexcept { return false; }
 
-		uint32 image_width, image_height;
-		int32 channels;
-		RGBA32* raw_image_data = (RGBA32*)stbi_load(path.string().c_str(), (int32*)&image_width, (int32*)&image_height, &channels, STBI_rgb_alpha);
-		uint32 num_mip_levels = Utils::ComputeNumMipLevelsBC7(image_width, image_height) + 1;
-		
-		std::vector<RGBA32> image_data;
-		image_data.assign(raw_image_data, raw_image_data + (image_width * image_height));
-
-		// Generate mip map
-		std::vector<RGBA32> image_data_with_mips = AssetCompressor::GenerateMipMaps(image_data, image_width, image_height);
-		std::vector<byte> bc7_encoded_data = AssetCompressor::CompressBC7(image_data_with_mips, image_width, image_height, num_mip_levels);
-
-		// Compress by GDeflate and write to a file
-		auto executor = JobSystem::GetExecutor();
-
-		tf::Taskflow taskflow;
-		taskflow.emplace([bc7_encoded_data, path, num_mip_levels, image_width, image_height]() mutable {
-			// Open file stream
-			std::filesystem::path final_path = FileSystem::GetWorkingDirectory() / "assets/compressed" / (path.stem().string() + ".oft");
-			std::ofstream fout(final_path, std::ios::binary | std::ios::out | std::ios::beg);
-			
-			std::stringstream subresource_data_stream;
-
-			// Configure file header
-			AssetFileHeader file_header = {};
-			file_header.header_size = sizeof(AssetFileHeader);
-			file_header.asset_type = AssetType::IMAGE_SRC;
-			file_header.uncompressed_data_size = bc7_encoded_data.size();
-			file_header.subresources_size = 0;
-			file_header.additional_data = (uint64)image_width | (uint64)image_height << 32;
-
-			// Compute metadata for subresources
-			std::array<AssetFileSubresourceMetadata, 16> subresources_metadata = {};
-
-			uint32 current_subresource_offset = 0;
-			for (uint32 i = 0; i < num_mip_levels; i++) {
-				uint32 current_mip_size = (image_width >> i) * (image_height >> i);
-				subresources_metadata[i].offset = current_subresource_offset;
-				subresources_metadata[i].compressed = current_mip_size >= AssetCompressor::GDEFLATE_PAGE_SIZE / 2;
-				subresources_metadata[i].decompressed_size = current_mip_size;
-				subresources_metadata[i].size = 0; // TODO
-				
-				auto subresource_source_data_begin = bc7_encoded_data.begin() + current_subresource_offset;
-				auto subresource_source_data_end = subresource_source_data_begin + current_mip_size;
-
-				if (subresources_metadata[i].compressed) {
-					subresources_metadata[i].size = AssetCompressor::CompressGDeflate(
-						{ subresource_source_data_begin, subresource_source_data_end },
-						&subresource_data_stream
-					);
-					std::vector<char> test(subresource_data_stream.tellp());
-					subresource_data_stream.read(test.data(), subresource_data_stream.tellp());
-
-					file_header.subresources_size += subresources_metadata[i].size;
-					current_subresource_offset += subresources_metadata[i].size;
-				}
-				else {
-					subresources_metadata[i].size = current_mip_size;
-					current_subresource_offset += subresources_metadata[i].size;
-					file_header.subresources_size += current_mip_size;
-					subresource_data_stream.write((const char*)&(*subresource_source_data_begin), subresource_source_data_end - subresource_source_data_begin);
-				}
+			bool await_suspend(std::coroutine_handle<> handle) {
+				std::lock_guard lock(pending->mutex);
+
+				if (pending->completed)
+					return false;
+
+				pending->waiters.push_back(handle);
+				return true;
 			}
-			
-			// Write header and subresource metadata
-			fout.write((const char*)&file_header, sizeof(file_header));
-			fout.write((const char*)subresources_metadata.data(), sizeof(AssetFileSubresourceMetadata) * subresources_metadata.size());
-			
-			std::vector<char> subresources_data(subresource_data_stream.tellp());
-			subresource_data_stream.read(subresources_data.data(), subresource_data_stream.tellp());
-			fout.write(subresources_data.data(), subresources_data.size());
-
-			fout.close();
-		});
-
-		executor->run(taskflow);
-
-		ImageSpecification texture_spec = {};
-		texture_spec.pixels = std::move(bc7_encoded_data);
-		texture_spec.format = ImageFormat::RGBA32_UNORM;
-		texture_spec.type = ImageType::TYPE_2D;
-		texture_spec.usage = ImageUsage::TEXTURE;
-		texture_spec.extent = { (uint32)image_width, (uint32)image_height, 1 };
-		texture_spec.array_layers = 1;
-		texture_spec.mip_levels = Utils::ComputeNumMipLevelsBC7(image_width, image_height) + 1;
-		texture_spec.path = path;
-
-		Ref<Image> image = Image::Create(&g_PersistentAllocator, texture_spec, handle);
-
-		m_AssetRegistry.emplace(image->Handle, image);
-		m_UUIDs.emplace(path.string(), image->Handle);
-
-		return image->Handle;
+
+			AssetHandle await_resume() const noexcept { return pending->result; }
+
+			PendingImport* pending;
+		};
+
+		return Awaiter{ this };
+	}
+
+	void AssetManager::PendingImport::Complete(AssetHandle handle)
+	{
+		std::vector<std::coroutine_handle<>> resumed_waiters;
+		{
+			std::lock_guard lock(mutex);
+			result = handle;
+			completed = true;
+			resumed_waiters.swap(waiters);
+		}
+
+		for (std::coroutine_handle<> waiter : resumed_waiters)
+			waiter.resume();
+	}
+
+	Task<AssetHandle> AssetManager::ImportImageSourceAsync(std::filesystem::path path, AssetHandle handle)
+	{
+		// Pending import is published under the same lock as the check, so only one import of a path cooks it
+		std::shared_ptr<PendingImport> pending;
+		bool owns_import = false;
+		{
+			std::lock_guard lock(m_Mutex);
+
+			if (auto uuid = m_UUIDs.find(path); uuid != m_UUIDs.end())
+				co_return uuid->second;
+
+			auto [entry, inserted] = m_PendingImports.try_emplace(path, nullptr);
+			if (inserted)
+				entry->second = std::make_shared<PendingImport>();
+
+			pending = entry->second;
+			owns_import = inserted;
+		}
+
+		if (!owns_import)
+			co_return co_await pending->Wait();
+
+		AssetHandle result = AssetHandle(0);
+		std::exception_ptr exception;
+
+		try {
+			result = co_await CookImageSource(path, handle);
+		}
+		catch (...) {
+			exception = std::current_exception();
+		}
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_PendingImports.erase(path);
+		}
+
+		pending->Complete(result);
+
+		if (exception)
+			std::rethrow_exception(exception);
+
+		co_return result;
+	}
+
+	Task<AssetHandle> AssetManager::CookImageSource(std::filesystem::path path, AssetHandle handle)
+	{
+		std::error_code error;
+		uint64 file_size = std::filesystem::file_size(path, error);
+
+		if (error) {
+			OMNIFORCE_CORE_ERROR("Failed to open image source \"{}\"", path.string());
+			co_return AssetHandle(0);
+		}
+
+		// Read source file without occupying a worker
+		std::vector<byte> file_data(file_size);
+
+		std::vector<IOReadRequest> read_requests(1);
+		read_requests[0].path = path;
+		read_requests[0].destination = file_data;
+
+		Ref<IOBatch> read_batch = co_await IOService::Get()->Submit(std::move(read_requests));
+
+		if (!read_batch->Succeeded()) {
+			OMNIFORCE_CORE_ERROR("Failed to read image source \"{}\"", path.string());
+			co_return AssetHandle(0);
+		}
+
+		// Decoding and compression are import work, so they must not take frame workers
+		co_await ScheduleOn(JobPriority::BACKGROUND);
+
+		CookedImage cooked_image = {};
+		if (!AssetCooker::EncodeImage(file_data, &cooked_image)) {
+			OMNIFORCE_CORE_ERROR("Failed to decode image source \"{}\"", path.string());
+			co_return AssetHandle(0);
+		}
+
+		// Compressed file is written while image is created
+		std::tuple<std::monostate, Ref<Image>> results = co_await WhenAll(
+			RunOn(JobPriority::BACKGROUND, [&]() {
+				AssetCooker::WriteImage(FileSystem::GetWorkingDirectory() / "assets/compressed" / (path.stem().string() + ".oft"), cooked_image);
+			}),
+			RunOn(JobPriority::BACKGROUND, [&]() {
+				ImageSpecification texture_spec = {};
+				texture_spec.pixels = cooked_image.bc7_encoded_data;
+				texture_spec.format = ImageFormat::RGBA32_UNORM;
+				texture_spec.type = ImageType::TYPE_2D;
+				texture_spec.usage = ImageUsage::TEXTURE;
+				texture_spec.extent = { cooked_image.width, cooked_image.height, 1 };
+				texture_spec.array_layers = 1;
+				texture_spec.mip_levels = cooked_image.num_mip_levels;
+				texture_spec.path = path;
+
+				return Image::Create(&g_AssetAllocator, texture_spec, handle);
+			})
+		);
+
+		Ref<Image> image = std::get<1>(results);
+
+		std::lock_guard lock(m_Mutex);
+
+		// Path might have been registered bypassing pending imports while this one was cooked
+		if (auto uuid = m_UUIDs.find(path); uuid != m_UUIDs.end()) {
+			image->Destroy();
+			co_return uuid->second;
+		}
+
+		m_AssetRegistry.Emplace(image->Handle, image);
+		m_UUIDs.emplace(path, image->Handle);
+
+		co_return image->Handle;
 	}
 
 }
\ No newline at end of file
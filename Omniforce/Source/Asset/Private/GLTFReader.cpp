@@ -0,0 +1,201 @@
+#include <Foundation/Common.h>
+#include <Asset/Importers/GLTFReader.h>
+
+#include <Asset/VertexQuantizer.h>
+#include <Filesystem/Filesystem.h>
+
+#include <cstring>
+
+#include <glm/gtc/type_precision.hpp>
+#include <glm/glm.hpp>
+#include <fastgltf/glm_element_traits.hpp>
+#include <fastgltf/parser.hpp>
+#include <fastgltf/tools.hpp>
+
+namespace Omni {
+
+	bool GLTFReader::ExtractAsset(ftf::Asset* asset, std::filesystem::path path, uint64* source_size)
+	{
+		// Allocate crucial fastgltf objects
+		ftf::Parser gltf_parser;
+		ftf::GltfDataBuffer data_buffer;
+
+		// Map source file instead of reading it into a heap buffer
+		Ref<MappedFile> source_file = FileSystem::MapFile(&g_AssetAllocator, path, MappedFileAccessHint::SEQUENTIAL);
+
+		if (!source_file || !source_file->GetSize()) {
+			OMNIFORCE_CORE_ERROR("Failed to load glTF model with path: {}. Aborting import.", path.string());
+			return false;
+		}
+
+		// Parser zero-fills its padding past the end of data, so the read-only mapping can not be handed out as a byte view
+		std::span<const byte> source_data = source_file->GetView();
+		bool source_loaded = data_buffer.copyBytes(source_data.data(), source_data.size());
+
+		if (source_size)
+			*source_size = source_file->GetSize();
+
+		// Parser works on its own copy from now on, so release the mapping instead of keeping it for the whole import
+		source_file = nullptr;
+
+		if (!source_loaded) {
+			OMNIFORCE_CORE_ERROR("Failed to load glTF model with path: {}. Aborting import.", path.string());
+			return false;
+		}
+
+		// Evaluate glTF type (glTF / GLB)
+		ftf::GltfType source_type = ftf::determineGltfFileType(&data_buffer);
+
+		// If invalid, abort loading
+		if (source_type == ftf::GltfType::Invalid) {
+			OMNIFORCE_CORE_ERROR("Failed to determine glTF file type with path: {}. Aborting import.", path.string());
+			return false;
+		}
+
+		// Setup options
+		constexpr ftf::Options options = ftf::Options::DontRequireValidAssetMember |
+			ftf::Options::LoadGLBBuffers | ftf::Options::LoadExternalBuffers |
+			ftf::Options::LoadExternalImages | ftf::Options::GenerateMeshIndices | ftf::Options::DecomposeNodeMatrices;
+
+		ftf::Expected<ftf::Asset> expected_asset(ftf::Error::None);
+
+		// Call corresponding function to load either glTF or GLB asset
+		source_type == ftf::GltfType::glTF ? expected_asset = gltf_parser.loadGltf(&data_buffer, path.parent_path(), options) :
+			expected_asset = gltf_parser.loadGltfBinary(&data_buffer, path.parent_path(), options);
+
+		// If errors are present, abort loading
+		if (const auto error = expected_asset.error(); error != ftf::Error::None) {
+			OMNIFORCE_CORE_ERROR("Failed to load asset source with path: {}. [{}]: {} Aborting import.", path.string(),
+				ftf::getErrorName(error), ftf::getErrorMessage(error));
+			return false;
+		}
+
+		*asset = std::move(expected_asset.get());
+
+		return true;
+	}
+
+	bool GLTFReader::ValidateSubmesh(const ftf::Mesh* mesh, const ftf::Primitive* primitive, const ftf::Material* material)
+	{
+		// Check if material is PBR-compatible. Currently engine supports only PBR materials
+		//if (!material->pbrData.baseColorTexture.has_value()) {
+		//	OMNIFORCE_CORE_WARNING("One of the submeshes \"{}\" has no PBR material. Skipping submesh", mesh->name);
+		//	OMNIFORCE_CUSTOM_LOGGER_WARN("OmniEditor", "One of the submeshes has no PBR material. Skipping submesh");
+		//	return true;
+		//}
+		// Check if mesh data is indexed
+		if (!primitive->indicesAccessor.has_value()) {
+			OMNIFORCE_CORE_ERROR("One of the submeshes has no indices. Unindexed meshes are not supported. Skipping submesh");
+			OMNIFORCE_CUSTOM_LOGGER_ERROR("OmniEditor", "One of the submeshes has no indices. Unindexed meshes are not supported. Skipping submesh");
+			return true;
+		}
+		// Check if topology is triangle list. Currently only triangle lists are supported
+		else if (primitive->type != ftf::PrimitiveType::Triangles) {
+			OMNIFORCE_CORE_ERROR("One of the submeshes primitive type is other than triangle list - currently only triangle list is supported. Skipping submesh");
+			OMNIFORCE_CUSTOM_LOGGER_ERROR("OmniEditor", "One of the submeshes primitive type is other than triangle list - currently only triangle list is supported. Skipping submesh");
+			return true;
+		}
+		return false;
+	}
+
+	void GLTFReader::ReadVertexMetadata(VertexAttributeMetadataTable* out_table, uint32* out_size, const ftf::Asset* asset, const ftf::Primitive* primitive)
+	{
+		uint32 attribute_stride = 12;
+
+		// Iterate through attributes and add them to map, effectively sorting them
+		for (auto attribute : primitive->attributes) {
+			// If on "POSIIION" attribute - skip iteration, since geometry is not considered as vertex attribute and is always at 0 offset
+			if (attribute.first == "POSITION")
+				continue;
+
+			// Get fastgltf accesor
+			auto& attrib_accessor = asset->accessors[attribute.second];
+			out_table->emplace(attribute.first, 0);
+		}
+
+		// Now evaluate offsets for sorted attributes
+		for (auto& attribute : *out_table) {
+			attribute.second = attribute_stride;
+
+			const auto& attribute_accessor = asset->accessors[primitive->findAttribute(attribute.first)->second];
+
+			attribute_stride += VertexDataQuantizer::GetRuntimeAttributeSize(attribute.first);
+		}
+		*out_size = attribute_stride;
+	}
+
+	void GLTFReader::ReadVertexAttributes(std::vector<byte>* out_vertex_data, std::vector<uint32>* out_index_data, const ftf::Asset* asset,
+		const ftf::Primitive* primitive, const VertexAttributeMetadataTable* metadata, uint32 vertex_stride)
+	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
+		// Load indices
+		{
+			const auto& indices_accessor = asset->accessors[primitive->indicesAccessor.value()];
+			out_index_data->resize(indices_accessor.count);
+			{
+				ftf::iterateAccessorWithIndex<uint32>(*asset, indices_accessor,
+					[&](uint32 index, std::size_t idx) { (*out_index_data)[idx] = index; });
+			}
+		}
+
+		// Load geometry
+		VertexDataQuantizer quantizer;
+		{
+			const auto& vertices_accessor = asset->accessors[primitive->findAttribute("POSITION")->second];
+			out_vertex_data->resize(vertices_accessor.count * vertex_stride);
+			{
+				ftf::iterateAccessorWithIndex<glm::vec3>(*asset, vertices_accessor,
+					[&](const glm::vec3 position, std::size_t idx) { memcpy(out_vertex_data->data() + idx * vertex_stride, &position, sizeof position); });
+			}
+		}
+
+		// Load attributes iterating through attribute metadata table to retrieve corresponding offset in data buffer
+		for (auto& attrib : *metadata) {
+			const auto& accessor = asset->accessors[primitive->findAttribute(attrib.first)->second];
+
+			if (attrib.first.find("TEXCOORD") != std::string::npos) {
+				ftf::iterateAccessorWithIndex<glm::vec2>(*asset, accessor,
+					[&](const glm::vec2 value, std::size_t idx) { 
+						const glm::u16vec2 quantized_uv = quantizer.QuantizeUV(value);
+						memcpy(out_vertex_data->data() + idx * vertex_stride + attrib.second, &quantized_uv, sizeof(quantized_uv));
+					}
+				);
+			}
+			else if (attrib.first.find("NORMAL") != std::string::npos) {
+				ftf::iterateAccessorWithIndex<glm::vec3>(*asset, accessor,
+					[&](const glm::vec3 value, std::size_t idx) {
+						const glm::u16vec2 quantized_normal = quantizer.QuantizeNormal(value);
+						memcpy(out_vertex_data->data() + idx * vertex_stride + attrib.second, &quantized_normal, sizeof(quantized_normal));
+					}
+				);
+			}
+			else if (attrib.first.find("TANGENT") != std::string::npos) {
+				ftf::iterateAccessorWithIndex<glm::vec4>(*asset, accessor,
+					[&](const glm::vec4 value, std::size_t idx) {
+						const glm::u16vec2 quantized_tangent = quantizer.QuantizeTangent(value);
+						memcpy(out_vertex_data->data() + idx * vertex_stride + attrib.second, &quantized_tangent, sizeof(quantized_tangent));
+					}
+				);
+			}
+			else if (attrib.first.find("COLOR") != std::string::npos) {
+				ftf::iterateAccessorWithIndex<glm::vec4>(*asset, accessor,
+					[&](const glm::vec4 value, std::size_t idx) {
+						const glm::u8vec4 quantized_color = quantizer.QuantizeColor(value);
+						memcpy(out_vertex_data->data() + idx * vertex_stride + attrib.second, &quantized_color, sizeof(quantized_color));
+					}
+				);
+			}
+			else if (attrib.first.find("JOINTS") != std::string::npos) {
+				OMNIFORCE_ASSERT_TAGGED(false, "Skinned meshes are not supported");
+			}
+			else if (attrib.first.find("WEIGHTS") != std::string::npos) {
+				OMNIFORCE_ASSERT_TAGGED(false, "Skinned meshes are not supported");
+			}
+			else {
+				OMNIFORCE_ASSERT_TAGGED(false, "Unknown attribute");
+			}
+		}
+	}
+
+}
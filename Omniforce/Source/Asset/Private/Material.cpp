@@ -38,7 +38,7 @@ namespace Omni {
 
 		// add device pipeline id as a macro
 		UUID pipeline_id;
-		m_Macros.emplace("__OMNI_PIPELINE_LOCAL_HASH", std::to_string(Pipeline::ComputeDeviceID(pipeline_id)));
+		m_Macros.Set("__OMNI_PIPELINE_LOCAL_HASH", std::to_string(Pipeline::ComputeDeviceID(pipeline_id)));
 
 		if (!shader) {
 			shader_library->LoadShader("Resources/Shaders/Source/GBufferOpaque.ofs", m_Macros);
@@ -54,9 +54,9 @@ namespace Omni {
 		pipeline_spec.depth_write_enable = false;
 		pipeline_spec.debug_name = fmt::format("Material pipeline {:X}", pipeline_id.Get());
 
-		m_Pipeline = PipelineLibrary::HasPipeline(pipeline_spec) ? PipelineLibrary::GetPipeline(pipeline_spec) : m_Pipeline = Pipeline::Create(&g_PersistentAllocator, pipeline_spec, pipeline_id);
+		m_Pipeline = PipelineLibrary::HasPipeline(pipeline_spec) ? PipelineLibrary::GetPipeline(pipeline_spec) : m_Pipeline = Pipeline::Create(&g_RendererAllocator, pipeline_spec, pipeline_id);
 
-		m_Macros.clear();
+		m_Macros.Clear();
 	}
 
 }
\ No newline at end of file
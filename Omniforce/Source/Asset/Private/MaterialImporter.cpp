@@ -139,7 +139,7 @@ namespace Omni {
 		image_spec.pixels = std::move(image_data);
 		image_spec.mip_levels = mip_levels_count;
 
-		AssetHandle asset_handle = AssetManager::Get()->RegisterAsset(Image::Create(&g_PersistentAllocator, image_spec));
+		AssetHandle asset_handle = AssetManager::Get()->RegisterAsset(Image::Create(&g_AssetAllocator, image_spec));
 
 		return asset_handle;
 	}
@@ -149,7 +149,7 @@ namespace Omni {
 		// Check if such material is already loaded.
 		// Check under mutex lock, if two threads are attemping to load exact same material
 		AssetHandle id = rh::hash<std::string>()(in_material->name.c_str());
-		Ref<Material> material = Material::Create(&g_PersistentAllocator, in_material->name.c_str(), id);
+		Ref<Material> material = Material::Create(&g_AssetAllocator, in_material->name.c_str(), id);
 
 		AssetManager::Get()->RegisterAsset(material, id);
 
@@ -160,14 +160,14 @@ namespace Omni {
 
 		material->AddProperty("DOUBLE_SIDED", (uint32)in_material->doubleSided);
 
-		subflow.emplace([=]() { HandleProperty("ALPHA_CUTOFF", in_material->alphaCutoff, material, root, m_Mutex); });
-		subflow.emplace([=]() { HandleProperty("BASE_COLOR_FACTOR", c(in_material->pbrData.baseColorFactor), material, root, m_Mutex); });
-		subflow.emplace([=]() { HandleProperty("METALLIC_FACTOR", in_material->pbrData.metallicFactor, material, root, m_Mutex); });
-		subflow.emplace([=]() { HandleProperty("ROUGHNESS_FACTOR", in_material->pbrData.roughnessFactor, material, root, m_Mutex); });
-		subflow.emplace([=]() { HandleProperty("BASE_COLOR_MAP", in_material->pbrData.baseColorTexture, material, root, m_Mutex); });
-		subflow.emplace([=]() { HandleProperty("METALLIC_ROUGHNESS_MAP", in_material->pbrData.metallicRoughnessTexture, material, root, m_Mutex); });
-		subflow.emplace([=]() { HandleProperty("NORMAL_MAP", in_material->normalTexture, material, root, m_Mutex); });
-		subflow.emplace([=]() { HandleProperty("OCCLUSION_MAP", in_material->occlusionTexture, material, root, m_Mutex); });
+		subflow.emplace([=]() { HandleProperty("ALPHA_CUTOFF", in_material->alphaCutoff, material, root, m_Mutex); }).name("Material Property");
+		subflow.emplace([=]() { HandleProperty("BASE_COLOR_FACTOR", c(in_material->pbrData.baseColorFactor), material, root, m_Mutex); }).name("Material Property");
+		subflow.emplace([=]() { HandleProperty("METALLIC_FACTOR", in_material->pbrData.metallicFactor, material, root, m_Mutex); }).name("Material Property");
+		subflow.emplace([=]() { HandleProperty("ROUGHNESS_FACTOR", in_material->pbrData.roughnessFactor, material, root, m_Mutex); }).name("Material Property");
+		subflow.emplace([=]() { HandleProperty("BASE_COLOR_MAP", in_material->pbrData.baseColorTexture, material, root, m_Mutex); }).name("Material Texture");
+		subflow.emplace([=]() { HandleProperty("METALLIC_ROUGHNESS_MAP", in_material->pbrData.metallicRoughnessTexture, material, root, m_Mutex); }).name("Material Texture");
+		subflow.emplace([=]() { HandleProperty("NORMAL_MAP", in_material->normalTexture, material, root, m_Mutex); }).name("Material Texture");
+		subflow.emplace([=]() { HandleProperty("OCCLUSION_MAP", in_material->occlusionTexture, material, root, m_Mutex); }).name("Material Texture");
 
 		MaterialDomain domain = MaterialDomain::NONE;
 
@@ -9,7 +9,7 @@ namespace Omni {
 
 	Ptr<ClusterizedMesh> MeshPreprocessor::GenerateMeshlets(const std::vector<byte>* vertices, const std::vector<uint32>* indices, uint32 vertex_stride)
 	{
-		Ptr<ClusterizedMesh> meshlets_data = CreatePtr<ClusterizedMesh>(&g_PersistentAllocator);
+		Ptr<ClusterizedMesh> meshlets_data = CreatePtr<ClusterizedMesh>(&g_PoolAllocator);
 
 		uint64 num_meshlets = meshopt_buildMeshletsBound(indices->size(), 64, 124);
 
@@ -187,7 +187,7 @@ namespace Omni {
 	void MeshPreprocessor::SplitVertexData(std::vector<glm::vec3>* geometry, std::vector<byte>* attributes, const std::vector<byte>* in_vertex_data, uint32 vertex_stride)
 	{
 		uint32 num_iterations = in_vertex_data->size() / vertex_stride;
-		uint32 deinterleaved_stride = vertex_stride - sizeof glm::vec3;
+		uint32 deinterleaved_stride = vertex_stride - sizeof(glm::vec3);
 
 		for (int i = 0; i < num_iterations; i++) {
 			memcpy(geometry->data() + i, in_vertex_data->data() + i * vertex_stride, sizeof(glm::vec3));
@@ -1,13 +1,17 @@
 #include <Foundation/Common.h>
 #include <Asset/OFRController.h>
 
+#include <Filesystem/Filesystem.h>
+
 namespace Omni {
 
 	Ptr<AssetFile> OFRController::Build(std::array<AssetFileSubresourceMetadata, 16> metadata, std::vector<byte> data, uint64 additional_data) {
+		OMNIFORCE_ASSERT_TAGGED(!m_Filepath.empty(), "Can't build OFR file which was loaded from memory");
+
 		m_Dirty = true;
 
 		AssetFileHeader file_header = {};
-		file_header.header_size = sizeof AssetFileHeader;
+		file_header.header_size = sizeof(AssetFileHeader);
 		file_header.additional_data = additional_data;
 		file_header.asset_type = AssetType::OMNI_IMAGE;
 		file_header.uncompressed_data_size = data.size();
@@ -44,20 +48,30 @@ namespace Omni {
 		uint32 tellp = subresource_data_stream.tellp();
 		subresource_data_stream.read((char*)subresources_data_vector.data(), tellp);
 
-		Ptr<AssetFile> file = CreatePtr<AssetFile>(&g_PersistentAllocator);
+		Ptr<AssetFile> file = CreatePtr<AssetFile>(&g_PoolAllocator);
 		file->header = file_header;
-		memcpy(file->subresources_metadata.data(), metadata.data(), sizeof AssetFileSubresourceMetadata * file->subresources_metadata.size());
+		memcpy(file->subresources_metadata.data(), metadata.data(), sizeof(AssetFileSubresourceMetadata) * file->subresources_metadata.size());
 		file->subresources_data = new byte[file_header.subresources_size];
 		memcpy(file->subresources_data, subresources_data_vector.data(), subresources_data_vector.size());
 
-		m_FileStream << *file;
+		// Mapping must be released before file is modified
+		m_MappedFile = nullptr;
+		m_FileData = {};
+
+		if (!std::filesystem::exists(m_Filepath))
+			std::ofstream(m_Filepath).close();
+
+		std::fstream file_stream(m_Filepath, std::fstream::binary | std::fstream::in | std::fstream::out);
+		file_stream.seekp(m_OriginalOffset);
+		file_stream << *file;
 
 		return std::move(file);
 	}
 
 	bool OFRController::DestroyOfflineStorage()
 	{
-		m_FileStream.close();
+		m_MappedFile = nullptr;
+		m_FileData = {};
 		m_Header = {};
 		m_Metadata = {};
 		m_Dirty = true;
@@ -70,31 +84,88 @@ namespace Omni {
 
 		if (Dirty()) LoadHeaderAndMetadata();
 
-		std::stringstream subresources_stream;
+		if (m_FileData.empty())
+			return {};
+
+		uint64 out_size = 0;
+		for (uint32 i = first; i < last; i++) {
+			if (!m_Metadata[i].size)
+				break;
+			out_size += m_Metadata[i].decompressed_size;
+		}
 
-		auto position = GetOFTHeaderSize() + GetMaxSubresources() * sizeof AssetFileSubresourceMetadata + m_Metadata[first].offset;
+		std::vector<byte> out(out_size);
 
-		m_FileStream.seekg(position);
+		uint64 position = m_OriginalOffset + GetOFTHeaderSize() + GetMaxSubresources() * sizeof(AssetFileSubresourceMetadata);
+		uint64 out_offset = 0;
 
-		for (int i = first; i < last; i++) {
+		for (uint32 i = first; i < last; i++) {
 			if (!m_Metadata[i].size)
 				break;
 
-			if (m_Metadata[i].compressed)
-				AssetCompressor::DecompressGDeflateCPU(&m_FileStream, m_Metadata[i].size, &subresources_stream);
-			else {
-				std::vector<byte> staging(m_Metadata[i].size);
-				m_FileStream.read((char*)staging.data(), staging.size());
-				subresources_stream.write((const char*)staging.data(), staging.size());
+			std::span<const byte> subresource = GetFileView(position + m_Metadata[i].offset, m_Metadata[i].size);
+			std::span<byte> destination(out.data() + out_offset, m_Metadata[i].decompressed_size);
+
+			if (m_Metadata[i].compressed) {
+				uint64 decompressed_size = AssetCompressor::DecompressGDeflateCPU(subresource, destination);
+
+				if (decompressed_size != destination.size()) {
+					OMNIFORCE_CORE_ERROR("Failed to decompress subresource {} of \"{}\": got {} bytes, expected {}", i,
+						m_Filepath.string(), decompressed_size, destination.size());
+					return {};
+				}
 			}
-		}
+			else if (!subresource.empty())
+				memcpy(destination.data(), subresource.data(), std::min(subresource.size(), destination.size()));
 
-		std::vector<byte> out(subresources_stream.tellp());
-		subresources_stream.read((char*)out.data(), m_Header.uncompressed_data_size);
+			out_offset += m_Metadata[i].decompressed_size;
+		}
 
 		return out;
 	}
 
+	void OFRController::LoadHeaderAndMetadata()
+	{
+		m_Header = {};
+		m_Metadata = {};
+		m_Dirty = false;
+
+		if (!AcquireFileData())
+			return;
+
+		std::span<const byte> header = GetFileView(m_OriginalOffset, sizeof(AssetFileHeader));
+		std::span<const byte> metadata = GetFileView(m_OriginalOffset + sizeof(AssetFileHeader), sizeof(AssetFileSubresourceMetadata) * m_Metadata.size());
+
+		// File is truncated
+		if (header.size() != sizeof(AssetFileHeader) || metadata.size() != sizeof(AssetFileSubresourceMetadata) * m_Metadata.size())
+			return;
+
+		memcpy(&m_Header, header.data(), header.size());
+		memcpy(m_Metadata.data(), metadata.data(), metadata.size());
+	}
+
+	bool OFRController::AcquireFileData()
+	{
+		if (!m_FileData.empty() || m_Filepath.empty())
+			return !m_FileData.empty();
+
+		if (!m_MappedFile)
+			m_MappedFile = FileSystem::MapFile(&g_AssetAllocator, m_Filepath, MappedFileAccessHint::SEQUENTIAL);
+
+		if (m_MappedFile)
+			m_FileData = m_MappedFile->GetView();
+
+		return !m_FileData.empty();
+	}
+
+	std::span<const byte> OFRController::GetFileView(uint64 offset, uint64 size) const
+	{
+		if (offset >= m_FileData.size())
+			return {};
+
+		return m_FileData.subspan(offset, std::min(size, m_FileData.size() - offset));
+	}
+
 	Omni::uint32 OFRController::GetNumSubresources()
 	{
 		if (m_Dirty) {
@@ -4,7 +4,7 @@
 #include <Rendering/Meshlet.h>
 
 #include <Core/KDTree.h>
-#include <Asset/Importers/ModelImporter.h>
+#include <Asset/Importers/GLTFReader.h>
 
 #include <span>
 #include <shared_mutex>
@@ -2,6 +2,7 @@
 #include <Core/Application.h>
 
 #include <Core/RuntimeExecutionContext.h>
+#include <Core/EngineConfig.h>
 #include <Core/Events/ApplicationEvents.h>
 #include <Core/Input/Input.h>
 #include <RHI/Renderer.h>
@@ -11,6 +12,7 @@
 #include <Scripting/ScriptEngine.h>
 #include <Audio/AudioEngine.h>
 #include <Threading/JobSystem.h>
+#include <Filesystem/AsyncIO.h>
 #include <DebugUtils/DebugRenderer.h>
 
 #include <chrono>
@@ -20,6 +22,8 @@ namespace Omni
 
 	Application* Application::s_Instance = nullptr;
 
+	static EngineConfigValue<int32> s_ProfilerStartupFrames("Core.Profiler.CaptureStartupFrames", "Number of frames captured by profiler after startup and exported to working directory, 0 to disable");
+
 	Application::Application() 
 		: m_RootSystem(nullptr), m_Running(true), m_WindowSystem(), m_ImGuiRenderer(nullptr) {}
 
@@ -28,7 +32,9 @@ namespace Omni
 	void Application::Launch(Options& options)
 	{
 		OMNIFORCE_CORE_INFO("Engine startup initiated");
+		Profiler::Init();
 		RuntimeExecutionContext::Init();
+		IOService::Init();
 
 		s_Instance = this;
 		m_RootSystem = std::move(options.root_system);
@@ -53,6 +59,9 @@ namespace Omni
 		renderer_config.frames_in_flight = 2;
 		renderer_config.vsync = false;
 
+		// Keep transient data alive until GPU is done with the frame it was allocated in
+		g_TransientAllocator.SetFramesInFlight(renderer_config.frames_in_flight);
+
 		auto task_executor = JobSystem::GetExecutor();
 
 		tf::Taskflow taskflow;
@@ -80,11 +89,25 @@ namespace Omni
 	{
 		m_RootSystem->Launch();
 		OMNIFORCE_CORE_INFO("Entering engine loop");
+
+#if OMNIFORCE_PROFILER_ENABLED
+		if (int32 num_capture_frames = s_ProfilerStartupFrames.Get(); num_capture_frames > 0)
+			Profiler::CaptureFrames(num_capture_frames, FileSystem::GetWorkingDirectory() / "ProfilerCapture.json");
+#endif
+
 		while (m_Running) {
-			PreFrame();
-			if (!m_WindowSystem->GetWindow("main")->Minimized())
-				m_RootSystem->OnUpdate(m_DeltaTimeData.delta_time);
-			PostFrame();
+			{
+				OMNIFORCE_PROFILE_ZONE("Frame");
+
+				PreFrame();
+				if (!m_WindowSystem->GetWindow("main")->Minimized()) {
+					OMNIFORCE_PROFILE_ZONE("Root System Update");
+					m_RootSystem->OnUpdate(m_DeltaTimeData.delta_time);
+				}
+				PostFrame();
+			}
+
+			OMNIFORCE_PROFILE_FRAME();
 		}
 		OMNIFORCE_CORE_INFO("Exiting engine loop");
 		m_RootSystem.ForceRelease();
@@ -96,6 +119,7 @@ namespace Omni
 
 		m_ImGuiRenderer->Destroy();
 		AssetManager::Shutdown();
+		IOService::Shutdown();
 		DebugRenderer::Shutdown();
 		Renderer::Shutdown();
 
@@ -104,6 +128,7 @@ namespace Omni
 		OMNIFORCE_CORE_INFO("Engine shutdown success");
 
 		RuntimeExecutionContext::Shutdown();
+		Profiler::Shutdown();
 	}
 
 	void Application::OnEvent(Event* e)
@@ -117,7 +142,9 @@ namespace Omni
 
 	void Application::PreFrame()
 	{
-		g_TransientAllocator.Clear();
+		OMNIFORCE_PROFILE_FUNCTION();
+
+		g_TransientAllocator.BeginFrame();
 
 		if (!m_WindowSystem->GetWindow("main")->Minimized()) {
 			m_DeltaTimeData.delta_time = (m_DeltaTimeData.current_frame_time - m_DeltaTimeData.last_frame_time);
@@ -133,6 +160,8 @@ namespace Omni
 
 	void Application::PostFrame()
 	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
 		if (!m_WindowSystem->GetWindow("main")->Minimized()) {
 			m_ImGuiRenderer->EndFrame();
 			Renderer::Render();
@@ -145,6 +174,10 @@ namespace Omni
 		m_DeltaTimeData.current_frame_time = Input::Time();
 
 		RuntimeExecutionContext::Get().Update();
+
+		// Frame statistics cover everything since the end of previous frame, before transient memory is recycled
+		MemoryTelemetry::OnFrameEnd();
+		JobSystem::OnFrameEnd();
 	}
 
 	Ref<AppWindow> Application::GetWindow(const std::string& tag) const
@@ -25,7 +25,7 @@ namespace Omni {
 
 		~BitStream()
 		{
-			delete m_Storage;
+			delete[] m_Storage;
 		}
 
 		void Append(uint32 num_bits, uint32 data) {
@@ -4,9 +4,45 @@
 
 #include <Filesystem/Filesystem.h>
 
+#include <mutex>
+#include <stdexcept>
+#include <shared_mutex>
+
 namespace Omni {
 	using nlohmann::json;
 
+	/*
+	*	@brief Dot-separated config key (e.g. "Renderer.UseVirtualGeometry"), split into interned blocks once on creation
+	*	so config lookups do not parse or allocate
+	*/
+	class ConfigPath {
+	public:
+		ConfigPath(std::string_view key)
+			: m_Key(key)
+		{
+			uint64 start = 0;
+			uint64 end = key.find('.');
+
+			while (end != std::string::npos) {
+				m_Blocks.Add(key.substr(start, end - start));
+				start = end + 1;
+				end = key.find('.', start);
+			}
+			m_Blocks.Add(key.substr(start));
+		}
+
+		Name GetKey() const { return m_Key; }
+		uint32 GetNumBlocks() const { return (uint32)m_Blocks.Size(); }
+		bool IsEmpty() const { return m_Key.IsNone(); }
+
+		auto begin() const { return m_Blocks.begin(); }
+		auto end() const { return m_Blocks.end(); }
+
+	private:
+		Name m_Key;
+		InlineArray<Name, 8> m_Blocks{ &g_PersistentAllocator };
+	};
+
 	class OMNIFORCE_API EngineConfig {
 	public:
 		static bool Load() {
@@ -18,7 +54,7 @@ namespace Omni {
 
 			try {
 				if (!FileSystem::CheckDirectory("Config.json")) {
-					throw std::exception("Failed to locate `Config.json`");
+					throw std::runtime_error("Failed to locate `Config.json`");
 				}
 
 				std::ifstream in_stream("Config.json");
@@ -31,6 +67,8 @@ namespace Omni {
 				return false;
 			}
 
+			m_Generation.fetch_add(1, std::memory_order_release);
+
 			OMNIFORCE_CORE_INFO("Loaded engine config");
 			return true;
 		}
@@ -43,6 +81,7 @@ namespace Omni {
 			}
 
 			try {
+				std::shared_lock lock(m_Mutex);
 				out_stream << m_Config->dump(4);
 			}
 			catch (std::exception* e) {
@@ -52,112 +91,144 @@ namespace Omni {
 			OMNIFORCE_CORE_INFO("Saved engine config");
 		}
 
-		template<typename T>
-		static T Get(std::string_view key) {
-			OMNIFORCE_ASSERT_TAGGED(key.size(), "Invalid config entry key");
-			Array<std::string_view> blocks(&g_PersistentAllocator);
-
-			uint64 start = 0;
-			uint64 end = key.find('.');
-
-			while (end != std::string::npos) {
-				blocks.Add(key.substr(start, end - start));
-				start = end + 1;
-				end = key.find('.', start);
-			}
-			blocks.Add(key.substr(start));
-
-			T value = T();
-
-			// Start traversal from the root
-			json* node = m_Config;
+		// Incremented every time config is loaded or modified, used to invalidate cached values
+		static uint64 GetGeneration() {
+			return m_Generation.load(std::memory_order_acquire);
+		}
 
-			uint32 i = 0;
+		template<typename T>
+		static T Get(const ConfigPath& path) {
+			std::shared_lock lock(m_Mutex);
+			return Traverse(path)->get<T>();
+		}
 
-			for (const auto& subkey : blocks) {
-				// If not at the last node
-				if (i != blocks.Size() - 1) {
-					// Sanity check
-					OMNIFORCE_ASSERT_TAGGED(node->contains(subkey), "Tried to get a config value with non-existent key ");
-				}
-				node = &node->at(std::string(subkey));
-				i++;
-			}
+		template<typename T>
+		static T Get(std::string_view key) {
+			return Get<T>(ConfigPath(key));
+		}
 
-			return node->get<T>();
+		template<typename T>
+		static void Set(const ConfigPath& path, const T& value) {
+			std::unique_lock lock(m_Mutex);
+			*Traverse(path) = value;
+			m_Generation.fetch_add(1, std::memory_order_release);
 		}
 
 		template<typename T>
 		static void Set(std::string_view key, const T& value) {
-			OMNIFORCE_ASSERT_TAGGED(key.size(), "Invalid config entry key");
-			Array<std::string_view> blocks(&g_PersistentAllocator);
-
-			uint64 start = 0;
-			uint64 end = key.find('.');
+			Set(ConfigPath(key), value);
+		}
 
-			while (end != std::string::npos) {
-				blocks.Add(key.substr(start, end - start));
-				start = end + 1;
-				end = key.find('.', start);
-			}
-			blocks.Add(key.substr(start));
+	private:
+		static json* Traverse(const ConfigPath& path) {
+			OMNIFORCE_ASSERT_TAGGED(!path.IsEmpty(), "Invalid config entry key");
 
 			// Start traversal from the root
 			json* node = m_Config;
 
 			uint32 i = 0;
-			for (const auto& subkey : blocks) {
+			for (const Name& block : path) {
 				// If not at the last node
-				if (i != blocks.Size() - 1) {
+				if (i != path.GetNumBlocks() - 1) {
 					// Sanity check
-					OMNIFORCE_ASSERT_TAGGED(node->contains(subkey), "Tried to get a config value with non-existent key ");
+					OMNIFORCE_ASSERT_TAGGED(node->contains(block.View()), "Tried to get a config value with non-existent key ");
 				}
 
-				node = &node->at(std::string(subkey));
+				node = &node->at(block.View());
 				i++;
 			}
 
-			*node = value;
+			return node;
 		}
 
 	private:
 		inline static json* m_Config = nullptr;
+		inline static Atomic<uint64> m_Generation = 1;
+		inline static std::shared_mutex m_Mutex;
 	};
 
+	/*
+	*	@brief Typed config entry. Value is resolved from config once and cached, the cache is invalidated
+	*	when config generation changes (on `EngineConfig::Load` or `EngineConfig::Set`), so reading a value
+	*	is an atomic load and a compare in common case
+	*/
 	template<typename T>
 	class OMNIFORCE_API EngineConfigValue {
 	public:
 		EngineConfigValue(const std::string& name, const std::string& description)
-			: m_Name(name)
+			: m_Path(name)
 			, m_Description(description)
 		{
-			OMNIFORCE_ASSERT_TAGGED(m_Name.size(), "Invalid config entry key");
+			OMNIFORCE_ASSERT_TAGGED(!m_Path.IsEmpty(), "Invalid config entry key");
 			OMNIFORCE_ASSERT_TAGGED(m_Description.size(), "Invalid config entry description");
 		}
 
 		T Get() const {
-			return EngineConfig::Get<T>(m_Name);
+			uint64 generation = EngineConfig::GetGeneration();
+
+			if (m_CachedGeneration.load(std::memory_order_acquire) != generation) {
+				return Resolve(generation);
+			}
+
+			if constexpr (IS_ATOMIC_SLOT) {
+				return m_CachedValue.load(std::memory_order_relaxed);
+			}
+			else {
+				std::lock_guard lock(m_Mutex);
+				return m_CachedValue;
+			}
 		}
 
 		void Set(const T& value) {
-			EngineConfig::Set(m_Name, value);
+			EngineConfig::Set(m_Path, value);
 		}
 
 		std::string_view GetName() const {
-			return m_Name;
+			return m_Path.GetKey().View();
 		}
 
 		std::string_view GetDescription() const {
 			return m_Description;
 		}
 
-		operator T() {
-			return EngineConfig::Get<T>(m_Name);
+		operator T() const {
+			return Get();
 		}
 
 	private:
-		std::string m_Name;
+		// Small trivially copyable values (bool, integers, floats) are cached in an atomic, others are guarded by a mutex
+		inline static constexpr bool IS_ATOMIC_SLOT = [] {
+			if constexpr (std::is_trivially_copyable_v<T>)
+				return std::atomic<T>::is_always_lock_free;
+			else
+				return false;
+		}();
+
+		T Resolve(uint64 generation) const {
+			std::lock_guard lock(m_Mutex);
+
+			T value = EngineConfig::Get<T>(m_Path);
+
+			if constexpr (IS_ATOMIC_SLOT) {
+				m_CachedValue.store(value, std::memory_order_relaxed);
+			}
+			else {
+				m_CachedValue = value;
+			}
+
+			// Publish generation the value was resolved for. If config has changed meanwhile, next read resolves again
+			m_CachedGeneration.store(generation, std::memory_order_release);
+
+			return value;
+		}
+
+	private:
+		ConfigPath m_Path;
 		std::string m_Description;
+
+		mutable std::conditional_t<IS_ATOMIC_SLOT, Atomic<T>, T> m_CachedValue = {};
+		mutable Atomic<uint64> m_CachedGeneration = 0;
+		mutable std::mutex m_Mutex;
 	};
 
 }
\ No newline at end of file
@@ -45,4 +45,6 @@ int main()
 	}
 
 	EngineConfig::Save();
+
+	Logger::Get()->Flush();
 }
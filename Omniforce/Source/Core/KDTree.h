@@ -53,7 +53,7 @@ namespace Omni {
 				});
 
 			size_t medianIndex = points.size() / 2;
-			Ptr<KDTreeNode> node = CreatePtr<KDTreeNode>(&g_PersistentAllocator, points[medianIndex].first, points[medianIndex].second);
+			Ptr<KDTreeNode> node = CreatePtr<KDTreeNode>(&g_PoolAllocator, points[medianIndex].first, points[medianIndex].second);
 
 			std::vector<std::pair<glm::vec3, uint32_t>> leftPoints(points.begin(), points.begin() + medianIndex);
 			std::vector<std::pair<glm::vec3, uint32_t>> rightPoints(points.begin() + medianIndex + 1, points.end());
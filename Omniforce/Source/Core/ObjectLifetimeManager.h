@@ -11,12 +11,27 @@ namespace Omni {
 		inline static const uint32 NUM_WAITING_FRAMES = 3;
 		inline static const uint32 NUM_DELETION_QUEUES = NUM_WAITING_FRAMES + 1;
 
+		// Deletion procedures capture a few handles, so 48 bytes of storage keep a whole procedure in a single cache line
+		using DeletionProcedure = InplaceFunction<void(), 48>;
+		using DeletionQueue = MPSCQueue<DeletionProcedure>;
+
+		struct Statistics {
+			uint64 retired_objects = 0;			// Objects deleted by the last executed queue
+			uint64 total_retired_objects = 0;
+			float32 execution_time = 0.0f;		// Time spent executing the last queue, in milliseconds
+		};
+
 		ObjectLifetimeManager()
 			: m_CoreObjectDeletionQueue(&g_DedicatedMemoryAllocator)
 			, m_DeletionQueues(&g_DedicatedMemoryAllocator)
+			, m_ExecutingQueues(&g_DedicatedMemoryAllocator)
 		{
 			for (auto& queue : m_DeletionQueues) {
-				queue = Stack<std::function<void()>>(&g_PersistentAllocator);
+				queue = DeletionQueue(&g_PersistentAllocator);
+			}
+
+			for (auto& queue : m_ExecutingQueues) {
+				queue = DeletionQueue(&g_PersistentAllocator);
 			}
 		}
 
@@ -25,14 +40,23 @@ namespace Omni {
 			m_CurrentPendingDeletionQueue++;
 			m_CurrentPendingDeletionQueue = m_CurrentPendingDeletionQueue % NUM_DELETION_QUEUES;
 
-			m_CurrentDeletionQueue++;
-			m_CurrentDeletionQueue = m_CurrentDeletionQueue % NUM_DELETION_QUEUES;
+			m_CurrentDeletionQueue.store((m_CurrentDeletionQueue.load(std::memory_order_relaxed) + 1) % NUM_DELETION_QUEUES, std::memory_order_release);
 		};
 
+		// Retirement statistics of the last executed deletion queue
+		Statistics GetStatistics() const {
+			Statistics statistics = {};
+			statistics.retired_objects = m_RetiredObjects.load(std::memory_order_relaxed);
+			statistics.total_retired_objects = m_TotalRetiredObjects.load(std::memory_order_relaxed);
+			statistics.execution_time = m_ExecutionTime.load(std::memory_order_relaxed);
+
+			return statistics;
+		}
+
 		// CAUTION: must only be called for core objects that must be deleted in a strong order ONLY when engine
 		// is shutting down. The best example is Vulkan's instance or device
-		void EnqueueCoreObjectDelection(std::function<void()> callable) {
-			m_CoreObjectDeletionQueue.Push(callable);
+		void EnqueueCoreObjectDelection(DeletionProcedure callable) {
+			m_CoreObjectDeletionQueue.Add(std::move(callable));
 		}
 
 		// Deletes all core objects that were registered by `EnqueueCoreObjectDelection()`, also waits on all
@@ -44,48 +68,76 @@ namespace Omni {
 
 			FlushDeletionQueues();
 
-			while (!m_CoreObjectDeletionQueue.IsEmpty()) {
-				auto callable = m_CoreObjectDeletionQueue.Top();
-				callable();
-				m_CoreObjectDeletionQueue.Pop();
+			// Core objects are deleted in reverse order of registration
+			for (uint32 i = m_CoreObjectDeletionQueue.Size(); i > 0; i--) {
+				m_CoreObjectDeletionQueue[i - 1]();
 			}
+			m_CoreObjectDeletionQueue.Clear();
 
 			OMNI_DEBUG_ONLY_CODE(m_CoreObjectQueueExecuted = true);
 		}
 
 		// Adds an object to the deletion queue. Queue will be executed after 3 frames in async mode.
-		void EnqueueObjectDeletion(std::function<void()> deleting_procedure) {
-			std::lock_guard lock(m_Mtx);
-			m_DeletionQueues[m_CurrentDeletionQueue].Push(deleting_procedure);
+		// Lock-free, can be called from any thread
+		void EnqueueObjectDeletion(DeletionProcedure deleting_procedure) {
+			uint32 queue_index = m_CurrentDeletionQueue.load(std::memory_order_acquire);
+			m_DeletionQueues[queue_index].Push(std::move(deleting_procedure));
 		}
 
 		// Flushes pending queue in async mode. Also supports sync mode, 
 		// but must be used with caution - may lead to performance penalties
 		void ExecutePendingDeletionQueue(bool wait = false) {
-			if (wait) {
-				auto& pending_queue = m_DeletionQueues[m_CurrentPendingDeletionQueue];
+			auto& pending_queue = m_DeletionQueues[m_CurrentPendingDeletionQueue];
 
-				while (!pending_queue.IsEmpty()) {
-					auto deletion_procedure = pending_queue.Top();
-					deletion_procedure();
-					pending_queue.Pop();
-				}
+			if (wait) {
+				ExecuteQueue(pending_queue);
+				return;
 			}
-			else [[likely]] {
-				JobSystem::GetExecutor()->async(
-					[pending_queue = m_DeletionQueues[m_CurrentPendingDeletionQueue]]() mutable {
-						while (!pending_queue.IsEmpty()) {
-							auto deletion_procedure = pending_queue.Top();
-							deletion_procedure();
-							pending_queue.Pop();
-						}
-					}
-				);
+
+			if (pending_queue.IsEmpty()) {
+				return;
 			}
 
-			m_DeletionQueues[m_CurrentPendingDeletionQueue].Clear();
+			// Hand the whole batch over to a job by swapping storage with an idle executing queue, so procedures are
+			// neither copied nor moved one by one. Both queues keep their capacity, so steady state does not allocate
+			const uint32 batch_index = m_CurrentPendingDeletionQueue;
+			WaitForBatch(batch_index);
+
+			std::swap(pending_queue, m_ExecutingQueues[batch_index]);
+			m_ExecutingBatches.fetch_or(1u << batch_index, std::memory_order_relaxed);
+
+			JobSystem::SilentAsync(JobPriority::BACKGROUND, [this, batch_index]() {
+				ExecuteQueue(m_ExecutingQueues[batch_index]);
+
+				m_ExecutingBatches.fetch_and(~(1u << batch_index), std::memory_order_release);
+				m_ExecutingBatches.notify_all();
+			});
 		}
 	private:
+		// Executes and clears a queue, the last enqueued procedure first. Records retirement statistics
+		void ExecuteQueue(DeletionQueue& queue) {
+			Timer timer;
+
+			uint64 retired_objects = queue.ConsumeAllReversed([](DeletionProcedure& deletion_procedure) {
+				deletion_procedure();
+			});
+
+			m_RetiredObjects.store(retired_objects, std::memory_order_relaxed);
+			m_TotalRetiredObjects.fetch_add(retired_objects, std::memory_order_relaxed);
+			m_ExecutionTime.store(timer.ElapsedMilliseconds(), std::memory_order_relaxed);
+		}
+
+		// Waits until a batch that was previously dispatched from the same queue slot is executed.
+		// Batch was dispatched `NUM_DELETION_QUEUES` frames ago, so in practice it never blocks
+		void WaitForBatch(uint32 batch_index) {
+			uint32 executing_batches = m_ExecutingBatches.load(std::memory_order_acquire);
+
+			while (executing_batches & (1u << batch_index)) {
+				m_ExecutingBatches.wait(executing_batches, std::memory_order_acquire);
+				executing_batches = m_ExecutingBatches.load(std::memory_order_acquire);
+			}
+		}
+
 		// Flushes all queues, should only be called once when engine is shutting down
 		void FlushDeletionQueues() {
 			for (uint32 i = 0; i < NUM_DELETION_QUEUES; i++) {
@@ -96,20 +148,27 @@ namespace Omni {
 
 	private:
 		// A single queue of core objects
-		Stack<std::function<void()>> m_CoreObjectDeletionQueue;
+		Array<DeletionProcedure> m_CoreObjectDeletionQueue;
 
 		// A queue index that we write to in current frame
-		uint32 m_CurrentDeletionQueue = 0;
+		Atomic<uint32> m_CurrentDeletionQueue = 0;
 
 		// A queue index that must be executed at the end of the frame
 		uint32 m_CurrentPendingDeletionQueue = 1;
 
 		// Deletion queues
-		StaticArray<Stack<std::function<void()>>, NUM_DELETION_QUEUES> m_DeletionQueues;
-		std::shared_mutex m_Mtx;
+		StaticArray<DeletionQueue, NUM_DELETION_QUEUES> m_DeletionQueues;
+
+		// Queues that are being executed by jobs, one per deletion queue. Bit N of the mask is set while N-th queue is executed
+		StaticArray<DeletionQueue, NUM_DELETION_QUEUES> m_ExecutingQueues;
+		Atomic<uint32> m_ExecutingBatches = 0;
+
+		Atomic<uint64> m_RetiredObjects = 0;
+		Atomic<uint64> m_TotalRetiredObjects = 0;
+		Atomic<float32> m_ExecutionTime = 0.0f;
 
 		OMNI_DEBUG_ONLY_FIELD(bool m_CoreObjectQueueExecuted = false);
 
 	};
 
-}
\ No newline at end of file
+}
@@ -34,8 +34,8 @@ namespace Omni {
 		void FlushEventBuffer() { 
 			for (const auto& e : m_EventBuffer)
 				m_EventCallback(e);
+			// Event memory is recycled by the engine on frame begin
 			m_EventBuffer.Clear();
-			m_EventAllocator->Clear();
 		}
 
 		bool Minimized() const { return m_Minimized; }
@@ -51,7 +51,10 @@ namespace Omni {
 		Ref<DeviceBuffer> m_IcosphereMesh;
 		Ref<DeviceBuffer> m_CubeMesh;
 
-		std::vector<std::function<void()>> m_DebugRequests;
+		// Requests capture transform and color by value, 64 bytes of storage fit the largest one
+		using DebugRequest = InplaceFunction<void(), 64>;
+
+		Array<DebugRequest> m_DebugRequests;
 
 	};
 
@@ -24,6 +24,7 @@ namespace Omni {
 	}
 
 	DebugRenderer::DebugRenderer()
+		: m_DebugRequests(&g_RendererAllocator)
 	{
 		// Init pipeline
 		ShaderLibrary* shader_library = ShaderLibrary::Get();
@@ -50,7 +51,7 @@ namespace Omni {
 		pipeline_spec.depth_test_enable = true;
 		pipeline_spec.color_blending_enable = false;
 
-		m_WireframePipeline = Pipeline::Create(&g_PersistentAllocator, pipeline_spec);
+		m_WireframePipeline = Pipeline::Create(&g_RendererAllocator, pipeline_spec);
 
 		pipeline_spec.culling_mode = PipelineCullingMode::BACK;
 		pipeline_spec.debug_name = "Cluster debug view";
@@ -58,7 +59,7 @@ namespace Omni {
 		pipeline_spec.shader = shader_library->GetShader("ClusterDebugView.ofs");
 		pipeline_spec.input_layout = {};
 
-		m_DebugViewPipeline = Pipeline::Create(&g_PersistentAllocator, pipeline_spec);
+		m_DebugViewPipeline = Pipeline::Create(&g_RendererAllocator, pipeline_spec);
 
 		PrimitiveMeshGenerator mesh_generator;
 		MeshPreprocessor mesh_preprocessor;
@@ -83,7 +84,7 @@ namespace Omni {
 		buffer_spec.memory_usage = DeviceBufferMemoryUsage::NO_HOST_ACCESS;
 		buffer_spec.size = vertex_data.size();
 
-		m_IcosphereMesh = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec, vertex_data.data(), buffer_spec.size);
+		m_IcosphereMesh = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec, vertex_data.data(), buffer_spec.size);
 
 		// Cube
 		auto cube_data = mesh_generator.GenerateCube();
@@ -100,7 +101,7 @@ namespace Omni {
 
 		buffer_spec.size = vertex_data.size();
 
-		m_CubeMesh = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec, vertex_data.data(), buffer_spec.size);
+		m_CubeMesh = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec, vertex_data.data(), buffer_spec.size);
 	}
 
 	DebugRenderer::~DebugRenderer()
@@ -114,7 +115,7 @@ namespace Omni {
 
 	void DebugRenderer::RenderWireframeSphere(const glm::vec3& position, float radius, const glm::vec3& color)
 	{
-		renderer->m_DebugRequests.push_back([=]() {
+		renderer->m_DebugRequests.Add([=]() {
 			Transform trs = {};
 			trs.translation = position;
 			trs.rotation = glm::packHalf(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
@@ -138,7 +139,7 @@ namespace Omni {
 
 	void DebugRenderer::RenderWireframeBox(const glm::vec3& translation, const glm::quat rotation, const glm::vec3 scale, const glm::vec3& color)
 	{
-		renderer->m_DebugRequests.push_back([=]() {
+		renderer->m_DebugRequests.Add([=]() {
 			Transform trs = {};
 			trs.translation = translation;
 			trs.rotation = glm::packHalf(glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w));
@@ -162,7 +163,7 @@ namespace Omni {
 
 	void DebugRenderer::RenderWireframeLines(Ref<DeviceBuffer> vbo, const glm::vec3& translation, const glm::quat rotation, const glm::vec3 scale, const glm::vec3& color)
 	{
-		renderer->m_DebugRequests.push_back([=]() {
+		renderer->m_DebugRequests.Add([=]() {
 			Transform trs = {};
 			trs.translation = translation;
 			trs.rotation = glm::packHalf(glm::vec4( rotation.x, rotation.y, rotation.z, rotation.w ) );
@@ -186,7 +187,7 @@ namespace Omni {
 
 	void DebugRenderer::RenderSceneDebugView(Ref<DeviceBuffer> visible_clusters, DebugSceneView mode, Ref<DescriptorSet> descriptor_set)
 	{
-		renderer->m_DebugRequests.push_back([=]() {
+		renderer->m_DebugRequests.Add([=]() {
 
 			uint64* pc_data = new uint64[2];
 
@@ -211,7 +212,7 @@ namespace Omni {
 
 		Renderer::EndRender(target);
 
-		renderer->m_DebugRequests.clear();
+		renderer->m_DebugRequests.Clear();
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <Foundation/Common.h>
+#include <Threading/JobSystem.h>
+
+#include <span>
+#include <future>
+#include <coroutine>
+
+namespace Omni {
+
+	struct IOReadResult {
+		uint64 bytes_read = 0;	// Less than requested if read went past the end of file
+		bool success = false;	// False if file failed to open or read failed
+	};
+
+	using IOCompletionCallback = InplaceFunction<void(const IOReadResult&), 64>;
+
+	/*
+	*	@brief Read of a file region into caller-provided memory. Destination memory must stay valid until request is completed.
+	*/
+	struct IOReadRequest {
+		std::filesystem::path path;
+		uint64 offset = 0;
+		std::span<byte> destination;
+		IOCompletionCallback on_complete; // Optional, invoked on a job system worker as soon as this request is completed
+	};
+
+	/*
+	*	@brief Handle to a set of read requests submitted together. Batch is completed when all of its reads are finished
+	*	and all of their completion callbacks have returned.
+	*/
+	class OMNIFORCE_API IOBatch {
+	public:
+		IOBatch(std::vector<IOReadRequest>&& requests, JobPriority completion_priority);
+
+		// Blocks calling thread. Job system workers should rely on completion callbacks instead
+		void Wait() const { m_Future.wait(); }
+
+		bool IsCompleted() const { return m_NumPendingRequests.load(std::memory_order_acquire) == 0; }
+
+		std::shared_future<void> GetFuture() const { return m_Future; }
+
+		uint32 GetNumRequests() const { return (uint32)m_Requests.size(); }
+		const IOReadRequest& GetRequest(uint32 index) const { return m_Requests[index]; }
+
+		// Result is valid once request is completed
+		const IOReadResult& GetResult(uint32 index) const { return m_Results[index]; }
+
+		// @return true if all reads of a completed batch succeeded
+		bool Succeeded() const;
+
+		/*
+		*	@brief Registers a coroutine to be resumed on a job system worker once batch is completed. Only one coroutine can await a batch.
+		*	@return false if batch is already completed, coroutine must not suspend then
+		*/
+		bool SetContinuation(std::coroutine_handle<> continuation);
+
+	private:
+		friend class IOService;
+
+		void FinishRequest();
+
+		enum class ContinuationState : uint8 {
+			NONE,
+			SET,
+			COMPLETED
+		};
+
+	private:
+		std::vector<IOReadRequest> m_Requests;
+		std::vector<IOReadResult> m_Results;
+		JobPriority m_CompletionPriority;
+		Atomic<uint32> m_NumPendingRequests;
+		std::promise<void> m_Promise;
+		std::shared_future<void> m_Future;
+		std::coroutine_handle<> m_Continuation;
+		Atomic<ContinuationState> m_ContinuationState = ContinuationState::NONE;
+	};
+
+	/*
+	*	@brief Makes batches awaitable, e.g. `co_await IOService::Get()->Submit(...)` in a `Task`. Coroutine is resumed on
+	*	a job system worker with the batch once all of its reads and completion callbacks are finished
+	*/
+	struct IOBatchAwaiter {
+		bool await_ready() const { return batch->IsCompleted(); }
+		bool await_suspend(std::coroutine_handle<> handle) { return batch->SetContinuation(handle); }
+		Ref<IOBatch> await_resume() { return std::move(batch); }
+
+		Ref<IOBatch> batch;
+	};
+
+	inline IOBatchAwaiter operator co_await(Ref<IOBatch> batch) {
+		return { std::move(batch) };
+	}
+
+	enum class OMNIFORCE_API IOBackend : uint8 {
+		DEFAULT,		// Best backend available on the platform
+		THREAD_POOL,	// Blocking reads on dedicated threads, available everywhere
+		IO_URING		// Linux only
+	};
+
+	struct IOServiceSpecification {
+		IOBackend backend = IOBackend::DEFAULT;
+		uint32 num_threads = 2;			// Number of I/O threads of a thread pool backend
+		uint32 queue_depth = 256;		// Max number of reads in flight for io_uring backend
+		JobPriority completion_priority = JobPriority::NORMAL;	// Job system lane to run completion callbacks and continuations on
+	};
+
+	/*
+	*	@brief Asynchronous file reading service. Reads of a batch are performed in the background and completion
+	*	callbacks are dispatched to the job system as soon as each read is finished, so workers process
+	*	loaded data while remaining reads are still in flight instead of stalling on disk.
+	*/
+	class OMNIFORCE_API IOService {
+	public:
+		static void Init(const IOServiceSpecification& spec = {});
+		static void Shutdown();
+		static IOService* Get() { return s_Instance; }
+
+		virtual ~IOService() {};
+
+		Ref<IOBatch> Submit(std::vector<IOReadRequest> requests);
+
+		IOBackend GetBackend() const { return m_Backend; }
+
+	protected:
+		IOService(IOBackend backend, JobPriority completion_priority)
+			: m_Backend(backend), m_CompletionPriority(completion_priority) {}
+
+		// Request memory is guaranteed to stay valid until request is completed
+		virtual void SubmitBatch(const Ref<IOBatch>& batch) = 0;
+
+		// Called by backends from any thread when request is finished
+		static void CompleteRequest(const Ref<IOBatch>& batch, uint32 index, uint64 bytes_read, bool success);
+
+	private:
+		inline static IOService* s_Instance = nullptr;
+
+		IOBackend m_Backend;
+		JobPriority m_CompletionPriority;
+	};
+
+}
@@ -3,6 +3,7 @@
 #include <Foundation/Common.h>
 
 #include <Filesystem/File.h>
+#include <Filesystem/MappedFile.h>
 
 namespace Omni {
 
@@ -14,6 +15,12 @@ namespace Omni {
 	public:
 		static Ref<File> ReadFile(IAllocator* allocator, std::filesystem::path path, const BitMask& flags);
 		static void WriteFile(Ref<File> file, std::filesystem::path path, const BitMask& flags);
+
+		/*
+		*	@brief Maps a file into memory for reading, no data is copied.
+		*	@return mapped file, nullptr if file does not exist or can't be mapped
+		*/
+		static Ref<MappedFile> MapFile(IAllocator* allocator, std::filesystem::path path, MappedFileAccessHint hint = MappedFileAccessHint::NORMAL);
 		static uint64 FileSize(std::filesystem::path path);
 
 		static bool CheckDirectory(std::filesystem::path path);
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Foundation/Common.h>
+
+#include <span>
+
+namespace Omni {
+
+	/*
+	*	@brief Expected access pattern of a mapped file, lets OS tune read-ahead of pages.
+	*/
+	enum class OMNIFORCE_API MappedFileAccessHint : uint8 {
+		NORMAL,		// Default OS read-ahead
+		SEQUENTIAL,	// File is read from begin to end once, pages are aggressively read ahead
+		RANDOM		// Small reads at arbitrary offsets, read-ahead is disabled
+	};
+
+	/*
+	*	@brief Read-only view of a whole file mapped into address space. Pages are loaded by OS on first access,
+	*	so data is never copied into a heap buffer. File stays mapped while any reference to the object exists,
+	*	spans acquired from the object must not outlive it.
+	*/
+	class OMNIFORCE_API MappedFile {
+	public:
+		// Use `FileSystem::MapFile` instead
+		MappedFile(const std::filesystem::path& path, MappedFileAccessHint hint);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// @return false if file failed to open or map
+		bool IsValid() const { return m_Valid; }
+
+		std::span<const byte> GetView() const { return { m_Data, m_Size }; }
+
+		// @return view of a file region, clamped to the end of a file
+		std::span<const byte> GetView(uint64 offset, uint64 size) const {
+			if (offset >= m_Size)
+				return {};
+
+			return { m_Data + offset, std::min(size, m_Size - offset) };
+		}
+
+		// Changes access pattern of a file region, whole file by default
+		void Advise(MappedFileAccessHint hint, uint64 offset = 0, uint64 size = UINT64_MAX);
+
+		// Asynchronously loads pages of a file region, so the following reads do not stall on page faults
+		void Prefetch(uint64 offset = 0, uint64 size = UINT64_MAX);
+
+		const byte* GetData() const { return m_Data; }
+		uint64 GetSize() const { return m_Size; }
+
+		// @return size of an accessible memory range, it is file size rounded up to a page size. Bytes past the end of a file are zeroed
+		uint64 GetMappingSize() const { return m_MappingSize; }
+
+		std::filesystem::path GetPath() const { return m_Path; }
+
+	private:
+		std::filesystem::path m_Path;
+		const byte* m_Data = nullptr;
+		uint64 m_Size = 0;
+		uint64 m_MappingSize = 0;
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+		bool m_Valid = false;
+	};
+
+}
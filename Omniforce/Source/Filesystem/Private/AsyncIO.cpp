@@ -0,0 +1,103 @@
+#include <Foundation/Common.h>
+#include <Filesystem/AsyncIO.h>
+
+#include <Filesystem/Private/ThreadPoolIOService.h>
+#include <Filesystem/Private/IOUringIOService.h>
+#include <Threading/JobSystem.h>
+
+namespace Omni {
+
+	IOBatch::IOBatch(std::vector<IOReadRequest>&& requests, JobPriority completion_priority)
+		: m_Requests(std::move(requests))
+		, m_Results(m_Requests.size())
+		, m_CompletionPriority(completion_priority)
+		, m_NumPendingRequests((uint32)m_Requests.size())
+		, m_Future(m_Promise.get_future().share())
+	{
+		if (m_Requests.empty()) {
+			m_Promise.set_value();
+			m_ContinuationState.store(ContinuationState::COMPLETED, std::memory_order_relaxed);
+		}
+	}
+
+	bool IOBatch::Succeeded() const
+	{
+		return IsCompleted() && std::all_of(m_Results.begin(), m_Results.end(), [](const IOReadResult& result) {
+			return result.success;
+		});
+	}
+
+	bool IOBatch::SetContinuation(std::coroutine_handle<> continuation)
+	{
+		m_Continuation = continuation;
+
+		ContinuationState expected = ContinuationState::NONE;
+		bool set = m_ContinuationState.compare_exchange_strong(expected, ContinuationState::SET, std::memory_order_acq_rel);
+
+		OMNIFORCE_ASSERT_TAGGED(set || expected == ContinuationState::COMPLETED, "I/O batch is already awaited by another coroutine");
+		return set;
+	}
+
+	void IOBatch::FinishRequest()
+	{
+		if (m_NumPendingRequests.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		m_Promise.set_value();
+
+		// Continuation is resumed on a worker, last request may be finished by an I/O thread
+		if (m_ContinuationState.exchange(ContinuationState::COMPLETED, std::memory_order_acq_rel) == ContinuationState::SET) {
+			std::coroutine_handle<> continuation = m_Continuation;
+			JobSystem::SilentAsync(m_CompletionPriority, [continuation]() { continuation.resume(); });
+		}
+	}
+
+	void IOService::Init(const IOServiceSpecification& spec)
+	{
+#if OMNIFORCE_PLATFORM == OMNIFORCE_PLATFORM_LINUX
+		if (spec.backend != IOBackend::THREAD_POOL)
+			s_Instance = IOUringIOService::Create(spec);
+#endif
+
+		if (!s_Instance) {
+			if (spec.backend == IOBackend::IO_URING)
+				OMNIFORCE_CORE_WARNING("io_uring is not available, falling back to thread pool I/O backend");
+
+			s_Instance = new ThreadPoolIOService(spec);
+		}
+
+		OMNIFORCE_CORE_INFO("Initialized I/O service, backend: {}", s_Instance->GetBackend() == IOBackend::IO_URING ? "io_uring" : "thread pool");
+	}
+
+	void IOService::Shutdown()
+	{
+		delete s_Instance;
+		s_Instance = nullptr;
+	}
+
+	Ref<IOBatch> IOService::Submit(std::vector<IOReadRequest> requests)
+	{
+		Ref<IOBatch> batch = CreateRef<IOBatch>(&g_PersistentAllocator, std::move(requests), m_CompletionPriority);
+
+		if (batch->GetNumRequests())
+			SubmitBatch(batch);
+
+		return batch;
+	}
+
+	void IOService::CompleteRequest(const Ref<IOBatch>& batch, uint32 index, uint64 bytes_read, bool success)
+	{
+		batch->m_Results[index] = { bytes_read, success };
+
+		if (!batch->m_Requests[index].on_complete) {
+			batch->FinishRequest();
+			return;
+		}
+
+		JobSystem::SilentAsync(batch->m_CompletionPriority, [batch, index]() {
+			batch->m_Requests[index].on_complete(batch->m_Results[index]);
+			batch->FinishRequest();
+		});
+	}
+
+}
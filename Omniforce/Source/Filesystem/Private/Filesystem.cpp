@@ -26,6 +26,18 @@ namespace Omni {
 		return CreateRef<File>(allocator, data, file_size, flags, path);;
 	}
 
+	Ref<MappedFile> FileSystem::MapFile(IAllocator* allocator, std::filesystem::path path, MappedFileAccessHint hint)
+	{
+		Ref<MappedFile> file = CreateRef<MappedFile>(allocator, path, hint);
+
+		if (!file->IsValid()) {
+			OMNIFORCE_CORE_ERROR("Failed to map file: {}", path.string());
+			return nullptr;
+		}
+
+		return file;
+	}
+
 	uint64 FileSystem::FileSize(std::filesystem::path path)
 	{
 		uint64 file_size = 0;
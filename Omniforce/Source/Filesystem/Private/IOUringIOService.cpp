@@ -0,0 +1,289 @@
+#include <Foundation/Common.h>
+#include <Filesystem/Private/IOUringIOService.h>
+
+#if OMNIFORCE_PLATFORM == OMNIFORCE_PLATFORM_LINUX
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace Omni {
+
+	// Max size of a single read, larger requests are split by short read handling
+	static constexpr uint64 MAX_READ_SIZE = 1ull << 30;
+
+	static int32 IOUringEnter(int32 ring, uint32 to_submit, uint32 min_complete, uint32 flags) {
+		return (int32)syscall(__NR_io_uring_enter, ring, to_submit, min_complete, flags, nullptr, 0);
+	}
+
+	IOService* IOUringIOService::Create(const IOServiceSpecification& spec)
+	{
+		IOUringIOService* service = new IOUringIOService(spec.completion_priority);
+
+		if (!service->Setup(std::max(spec.queue_depth, 1u))) {
+			delete service;
+			return nullptr;
+		}
+
+		return service;
+	}
+
+	IOUringIOService::IOUringIOService(JobPriority completion_priority)
+		: IOService(IOBackend::IO_URING, completion_priority)
+	{
+	}
+
+	IOUringIOService::~IOUringIOService()
+	{
+		if (m_CompletionThread.joinable()) {
+			std::unique_lock lock(m_SubmissionMutex);
+
+			// Pending reads are finished before shutdown, then completion thread is woken up by an empty operation
+			m_SlotAvailable.wait(lock, [this]() { return m_NumInFlight == 0; });
+			PushNop();
+			SubmitPushed();
+
+			lock.unlock();
+			m_CompletionThread.join();
+		}
+
+		if (m_SubmissionEntries)
+			munmap(m_SubmissionEntries, m_NumSubmissionEntries * sizeof(io_uring_sqe));
+		if (m_CompletionRingMemory && m_CompletionRingMemory != m_SubmissionRingMemory)
+			munmap(m_CompletionRingMemory, m_CompletionRingSize);
+		if (m_SubmissionRingMemory)
+			munmap(m_SubmissionRingMemory, m_SubmissionRingSize);
+		if (m_Ring != -1)
+			close(m_Ring);
+	}
+
+	bool IOUringIOService::Setup(uint32 queue_depth)
+	{
+		io_uring_params params = {};
+		m_Ring = (int32)syscall(__NR_io_uring_setup, queue_depth, &params);
+
+		if (m_Ring < 0) {
+			m_Ring = -1;
+			return false;
+		}
+
+		// IORING_OP_READ appeared in the same kernel version
+		if (!(params.features & IORING_FEAT_RW_CUR_POS))
+			return false;
+
+		m_SubmissionRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32);
+		m_CompletionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+		bool single_mapping = params.features & IORING_FEAT_SINGLE_MMAP;
+
+		if (single_mapping)
+			m_SubmissionRingSize = m_CompletionRingSize = std::max(m_SubmissionRingSize, m_CompletionRingSize);
+
+		void* submission_ring = mmap(nullptr, m_SubmissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_SQ_RING);
+		if (submission_ring == MAP_FAILED)
+			return false;
+		m_SubmissionRingMemory = submission_ring;
+
+		if (single_mapping) {
+			m_CompletionRingMemory = m_SubmissionRingMemory;
+		}
+		else {
+			void* completion_ring = mmap(nullptr, m_CompletionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_CQ_RING);
+			if (completion_ring == MAP_FAILED)
+				return false;
+			m_CompletionRingMemory = completion_ring;
+		}
+
+		void* submission_entries = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_SQES);
+		if (submission_entries == MAP_FAILED)
+			return false;
+		m_SubmissionEntries = (io_uring_sqe*)submission_entries;
+		m_NumSubmissionEntries = params.sq_entries;
+
+		byte* submission_memory = (byte*)m_SubmissionRingMemory;
+		m_SubmissionHead = (uint32*)(submission_memory + params.sq_off.head);
+		m_SubmissionTail = (uint32*)(submission_memory + params.sq_off.tail);
+		m_SubmissionArray = (uint32*)(submission_memory + params.sq_off.array);
+		m_SubmissionMask = *(uint32*)(submission_memory + params.sq_off.ring_mask);
+
+		byte* completion_memory = (byte*)m_CompletionRingMemory;
+		m_CompletionHead = (uint32*)(completion_memory + params.cq_off.head);
+		m_CompletionTail = (uint32*)(completion_memory + params.cq_off.tail);
+		m_CompletionMask = *(uint32*)(completion_memory + params.cq_off.ring_mask);
+		m_CompletionEntries = (io_uring_cqe*)(completion_memory + params.cq_off.cqes);
+
+		m_CompletionThread = std::thread([this]() { CompletionLoop(); });
+
+		return true;
+	}
+
+	void IOUringIOService::SubmitBatch(const Ref<IOBatch>& batch)
+	{
+		std::unique_lock lock(m_SubmissionMutex);
+
+		for (uint32 i = 0; i < batch->GetNumRequests(); i++) {
+			const IOReadRequest& request = batch->GetRequest(i);
+
+			int32 file = open(request.path.c_str(), O_RDONLY | O_CLOEXEC);
+
+			if (file == -1) {
+				CompleteRequest(batch, i, 0, false);
+				continue;
+			}
+
+			if (request.destination.empty()) {
+				close(file);
+				CompleteRequest(batch, i, 0, true);
+				continue;
+			}
+
+			// Queue is full, submit what is already pushed and wait for completions
+			if (m_NumInFlight == m_NumSubmissionEntries) {
+				SubmitPushed();
+				m_SlotAvailable.wait(lock, [this]() { return m_NumInFlight < m_NumSubmissionEntries; });
+			}
+
+			m_NumInFlight++;
+			PushRead(new InFlightRead{ batch, i, file, 0 });
+		}
+
+		// Whole batch is submitted with a single system call
+		SubmitPushed();
+	}
+
+	io_uring_sqe* IOUringIOService::AcquireSubmissionEntry()
+	{
+		// Only this thread writes tail, kernel only moves head
+		uint32 tail = *m_SubmissionTail;
+		uint32 head = std::atomic_ref(*m_SubmissionHead).load(std::memory_order_acquire);
+
+		OMNIFORCE_ASSERT_TAGGED(tail - head < m_NumSubmissionEntries, "io_uring submission queue overflow");
+
+		uint32 index = tail & m_SubmissionMask;
+		m_SubmissionArray[index] = index;
+
+		io_uring_sqe* entry = &m_SubmissionEntries[index];
+		memset(entry, 0, sizeof(io_uring_sqe));
+
+		return entry;
+	}
+
+	void IOUringIOService::PushRead(InFlightRead* read)
+	{
+		const IOReadRequest& request = read->batch->GetRequest(read->index);
+
+		io_uring_sqe* entry = AcquireSubmissionEntry();
+		entry->opcode = IORING_OP_READ;
+		entry->fd = read->file;
+		entry->off = request.offset + read->bytes_read;
+		entry->addr = (uint64)(request.destination.data() + read->bytes_read);
+		entry->len = (uint32)std::min(request.destination.size() - read->bytes_read, MAX_READ_SIZE);
+		entry->user_data = (uint64)read;
+
+		std::atomic_ref(*m_SubmissionTail).store(*m_SubmissionTail + 1, std::memory_order_release);
+		m_NumPushed++;
+	}
+
+	void IOUringIOService::PushNop()
+	{
+		io_uring_sqe* entry = AcquireSubmissionEntry();
+		entry->opcode = IORING_OP_NOP;
+		entry->user_data = 0;
+
+		std::atomic_ref(*m_SubmissionTail).store(*m_SubmissionTail + 1, std::memory_order_release);
+		m_NumPushed++;
+	}
+
+	void IOUringIOService::SubmitPushed()
+	{
+		while (m_NumPushed) {
+			int32 result = IOUringEnter(m_Ring, m_NumPushed, 0, 0);
+
+			if (result < 0) {
+				if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+					continue;
+
+				// Ring is unusable, pushed reads would never complete and their waiters would hang
+				// Critical messages are flushed before the call returns, crash log keeps them for the dump
+				OMNIFORCE_CORE_CRITICAL("Failed to submit io_uring requests: {}", strerror(errno));
+				OMNIFORCE_WRITE_LOGS_TO_FILE();
+				OMNIFORCE_ASSERT_TAGGED(false, "io_uring ring is unusable");
+				std::abort();
+			}
+
+			m_NumPushed -= result;
+		}
+	}
+
+	void IOUringIOService::CompletionLoop()
+	{
+		std::vector<std::pair<InFlightRead*, int32>> completions;
+
+		while (true) {
+			// Only this thread moves head, kernel only writes tail
+			uint32 head = *m_CompletionHead;
+			uint32 tail = std::atomic_ref(*m_CompletionTail).load(std::memory_order_acquire);
+
+			if (head == tail) {
+				IOUringEnter(m_Ring, 0, 1, IORING_ENTER_GETEVENTS);
+				continue;
+			}
+
+			bool exit_requested = false;
+			completions.clear();
+
+			for (; head != tail; head++) {
+				const io_uring_cqe& entry = m_CompletionEntries[head & m_CompletionMask];
+
+				if (entry.user_data)
+					completions.push_back({ (InFlightRead*)entry.user_data, entry.res });
+				else
+					exit_requested = true;
+			}
+
+			std::atomic_ref(*m_CompletionHead).store(head, std::memory_order_release);
+
+			for (auto& [read, result] : completions)
+				CompleteRead(read, result);
+
+			if (exit_requested)
+				return;
+		}
+	}
+
+	void IOUringIOService::CompleteRead(InFlightRead* read, int32 result)
+	{
+		const IOReadRequest& request = read->batch->GetRequest(read->index);
+
+		if (result > 0)
+			read->bytes_read += result;
+
+		// Interrupted or short read, request the rest of data. Read keeps its slot in the queue
+		bool retry = result == -EINTR || result == -EAGAIN || (result > 0 && read->bytes_read < request.destination.size());
+
+		if (retry) {
+			std::lock_guard lock(m_SubmissionMutex);
+			PushRead(read);
+			SubmitPushed();
+			return;
+		}
+
+		close(read->file);
+		CompleteRequest(read->batch, read->index, read->bytes_read, result >= 0);
+		delete read;
+
+		{
+			std::lock_guard lock(m_SubmissionMutex);
+			m_NumInFlight--;
+		}
+		m_SlotAvailable.notify_all();
+	}
+
+}
+
+#endif
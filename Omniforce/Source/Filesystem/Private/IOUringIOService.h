@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Foundation/Common.h>
+#include <Filesystem/AsyncIO.h>
+
+#if OMNIFORCE_PLATFORM == OMNIFORCE_PLATFORM_LINUX
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace Omni {
+
+	/*
+	*	@brief Linux I/O backend built on io_uring. Whole batch is pushed to submission queue and submitted with a single
+	*	system call, completions are reaped by a background thread. Uses raw system calls, so no liburing is required.
+	*/
+	class IOUringIOService : public IOService {
+	public:
+		// @return nullptr if io_uring is not supported by the kernel
+		static IOService* Create(const IOServiceSpecification& spec);
+
+		~IOUringIOService();
+
+	protected:
+		void SubmitBatch(const Ref<IOBatch>& batch) override;
+
+	private:
+		IOUringIOService(JobPriority completion_priority);
+
+		bool Setup(uint32 queue_depth);
+
+		struct InFlightRead {
+			Ref<IOBatch> batch;
+			uint32 index;
+			int32 file;
+			uint64 bytes_read;
+		};
+
+		// Must be called with submission mutex locked. Number of reads in flight is bounded by queue size, so there is always a free entry
+		void PushRead(InFlightRead* read);
+		void PushNop();
+		void SubmitPushed();
+		io_uring_sqe* AcquireSubmissionEntry();
+
+		void CompletionLoop();
+		void CompleteRead(InFlightRead* read, int32 result);
+
+	private:
+		int32 m_Ring = -1;
+
+		// Submission queue ring
+		void* m_SubmissionRingMemory = nullptr;
+		uint64 m_SubmissionRingSize = 0;
+		uint32* m_SubmissionHead = nullptr;
+		uint32* m_SubmissionTail = nullptr;
+		uint32* m_SubmissionArray = nullptr;
+		uint32 m_SubmissionMask = 0;
+		io_uring_sqe* m_SubmissionEntries = nullptr;
+		uint32 m_NumSubmissionEntries = 0;
+
+		// Completion queue ring
+		void* m_CompletionRingMemory = nullptr;
+		uint64 m_CompletionRingSize = 0;
+		uint32* m_CompletionHead = nullptr;
+		uint32* m_CompletionTail = nullptr;
+		uint32 m_CompletionMask = 0;
+		io_uring_cqe* m_CompletionEntries = nullptr;
+
+		std::mutex m_SubmissionMutex;
+		std::condition_variable m_SlotAvailable;
+		uint32 m_NumInFlight = 0; // Bounded by submission queue size, so completion queue never overflows
+		uint32 m_NumPushed = 0;
+
+		std::thread m_CompletionThread;
+	};
+
+}
+
+#endif
@@ -0,0 +1,183 @@
+#include <Foundation/Common.h>
+#include <Filesystem/MappedFile.h>
+
+#if OMNIFORCE_PLATFORM == OMNIFORCE_PLATFORM_WIN64
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace Omni {
+
+#if OMNIFORCE_PLATFORM == OMNIFORCE_PLATFORM_WIN64
+
+	static uint64 GetPageSize() {
+		static const uint64 page_size = []() {
+			SYSTEM_INFO system_info = {};
+			GetSystemInfo(&system_info);
+			return (uint64)system_info.dwPageSize;
+		}();
+		return page_size;
+	}
+
+	MappedFile::MappedFile(const std::filesystem::path& path, MappedFileAccessHint hint)
+		: m_Path(path)
+	{
+		DWORD flags = FILE_ATTRIBUTE_NORMAL;
+		if (hint == MappedFileAccessHint::SEQUENTIAL) flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+		if (hint == MappedFileAccessHint::RANDOM) flags |= FILE_FLAG_RANDOM_ACCESS;
+
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+
+		m_FileHandle = file;
+
+		LARGE_INTEGER file_size = {};
+		if (!GetFileSizeEx(file, &file_size))
+			return;
+
+		m_Size = file_size.QuadPart;
+
+		// Empty files can't be mapped, but they are still valid files
+		if (!m_Size) {
+			m_Valid = true;
+			return;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (!mapping)
+			return;
+
+		m_MappingHandle = mapping;
+		m_Data = (const byte*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (!m_Data)
+			return;
+
+		m_MappingSize = (m_Size + GetPageSize() - 1) & ~(GetPageSize() - 1);
+		m_Valid = true;
+
+		if (hint == MappedFileAccessHint::SEQUENTIAL)
+			Prefetch();
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_MappingHandle)
+			CloseHandle(m_MappingHandle);
+		if (m_FileHandle)
+			CloseHandle(m_FileHandle);
+	}
+
+	void MappedFile::Advise(MappedFileAccessHint hint, uint64 offset, uint64 size)
+	{
+		// There is no per-range access hint for mapped views on Windows, the closest thing is to fetch sequential ranges upfront
+		if (hint == MappedFileAccessHint::SEQUENTIAL)
+			Prefetch(offset, size);
+	}
+
+	void MappedFile::Prefetch(uint64 offset, uint64 size)
+	{
+		std::span<const byte> view = GetView(offset, size);
+
+		if (view.empty())
+			return;
+
+		WIN32_MEMORY_RANGE_ENTRY range = { (PVOID)view.data(), view.size() };
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+
+#else
+
+	static uint64 GetPageSize() {
+		static const uint64 page_size = (uint64)sysconf(_SC_PAGESIZE);
+		return page_size;
+	}
+
+	static int32 ConvertAccessHint(MappedFileAccessHint hint) {
+		switch (hint) {
+		case MappedFileAccessHint::SEQUENTIAL:	return MADV_SEQUENTIAL;
+		case MappedFileAccessHint::RANDOM:		return MADV_RANDOM;
+		default:								return MADV_NORMAL;
+		}
+	}
+
+	MappedFile::MappedFile(const std::filesystem::path& path, MappedFileAccessHint hint)
+		: m_Path(path)
+	{
+		int32 file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (file == -1)
+			return;
+
+		struct stat file_stat = {};
+		if (fstat(file, &file_stat) == -1) {
+			close(file);
+			return;
+		}
+
+		m_Size = file_stat.st_size;
+
+		// Empty files can't be mapped, but they are still valid files
+		if (!m_Size) {
+			close(file);
+			m_Valid = true;
+			return;
+		}
+
+		void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0);
+
+		// Mapping holds its own reference to the file
+		close(file);
+
+		if (data == MAP_FAILED)
+			return;
+
+		m_Data = (const byte*)data;
+		m_MappingSize = (m_Size + GetPageSize() - 1) & ~(GetPageSize() - 1);
+		m_Valid = true;
+
+		if (hint != MappedFileAccessHint::NORMAL)
+			Advise(hint);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (m_Data)
+			munmap((void*)m_Data, m_Size);
+	}
+
+	void MappedFile::Advise(MappedFileAccessHint hint, uint64 offset, uint64 size)
+	{
+		std::span<const byte> view = GetView(offset, size);
+
+		if (view.empty())
+			return;
+
+		// Range has to start at a page boundary
+		uint64 page_offset = (view.data() - m_Data) & (GetPageSize() - 1);
+		madvise((void*)(view.data() - page_offset), view.size() + page_offset, ConvertAccessHint(hint));
+	}
+
+	void MappedFile::Prefetch(uint64 offset, uint64 size)
+	{
+		std::span<const byte> view = GetView(offset, size);
+
+		if (view.empty())
+			return;
+
+		uint64 page_offset = (view.data() - m_Data) & (GetPageSize() - 1);
+		madvise((void*)(view.data() - page_offset), view.size() + page_offset, MADV_WILLNEED);
+	}
+
+#endif
+
+}
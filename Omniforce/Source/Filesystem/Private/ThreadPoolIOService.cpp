@@ -0,0 +1,71 @@
+#include <Foundation/Common.h>
+#include <Filesystem/Private/ThreadPoolIOService.h>
+
+namespace Omni {
+
+	ThreadPoolIOService::ThreadPoolIOService(const IOServiceSpecification& spec)
+		: IOService(IOBackend::THREAD_POOL, spec.completion_priority)
+	{
+		for (uint32 i = 0; i < std::max(spec.num_threads, 1u); i++)
+			m_Threads.emplace_back([this]() { WorkerLoop(); });
+	}
+
+	ThreadPoolIOService::~ThreadPoolIOService()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Running = false;
+		}
+		m_Condition.notify_all();
+
+		for (auto& thread : m_Threads)
+			thread.join();
+	}
+
+	void ThreadPoolIOService::SubmitBatch(const Ref<IOBatch>& batch)
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+
+			for (uint32 i = 0; i < batch->GetNumRequests(); i++)
+				m_Queue.push_back({ batch, i });
+		}
+		m_Condition.notify_all();
+	}
+
+	void ThreadPoolIOService::WorkerLoop()
+	{
+		while (true) {
+			PendingRead read;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_Condition.wait(lock, [this]() { return !m_Queue.empty() || !m_Running; });
+
+				// Pending reads are finished before shutdown
+				if (m_Queue.empty())
+					return;
+
+				read = std::move(m_Queue.front());
+				m_Queue.pop_front();
+			}
+
+			const IOReadRequest& request = read.batch->GetRequest(read.index);
+
+			std::ifstream stream(request.path, std::ifstream::binary);
+
+			if (!stream.is_open()) {
+				CompleteRequest(read.batch, read.index, 0, false);
+				continue;
+			}
+
+			stream.seekg(request.offset);
+			stream.read((char*)request.destination.data(), request.destination.size());
+
+			uint64 bytes_read = stream.gcount();
+			bool success = !stream.bad();
+
+			CompleteRequest(read.batch, read.index, bytes_read, success);
+		}
+	}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Foundation/Common.h>
+#include <Filesystem/AsyncIO.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace Omni {
+
+	/*
+	*	@brief Portable I/O backend, performs blocking reads on a set of dedicated threads, so job system workers never block on disk.
+	*/
+	class ThreadPoolIOService : public IOService {
+	public:
+		ThreadPoolIOService(const IOServiceSpecification& spec);
+		~ThreadPoolIOService();
+
+	protected:
+		void SubmitBatch(const Ref<IOBatch>& batch) override;
+
+	private:
+		void WorkerLoop();
+
+	private:
+		struct PendingRead {
+			Ref<IOBatch> batch;
+			uint32 index;
+		};
+
+		std::vector<std::thread> m_Threads;
+		std::deque<PendingRead> m_Queue;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_Running = true;
+	};
+
+}
@@ -8,7 +8,7 @@
 					do {																					\
 						if(!(expression)) {																	\
 							OMNIFORCE_CORE_ERROR("Assertion failed: {0}({1})", __FILE__, __LINE__);			\
-							__debugbreak();																	\
+							OMNIFORCE_DEBUG_BREAK();														\
 						}																					\
 					} while (false)
 	#define OMNIFORCE_ASSERT_TAGGED(expression, ...)														\
@@ -20,7 +20,7 @@
 								__LINE__,																	\
 								__VA_ARGS__																	\
 							);																				\
-							__debugbreak();																	\
+							OMNIFORCE_DEBUG_BREAK();														\
 						}																					\
 					} while (false)
 #else 
@@ -114,8 +114,6 @@ namespace Omni {
 		Plane planes[6] = {}; // top, bottom, right, left, far, near planes
 	};
 
-	using ShaderMacroTable = std::map<std::string, std::string>;
-
 	struct META(ShaderExpose, Module = "BasicTypes") Transform {
 		glm::vec3 translation;
 		glm::hvec4 rotation;
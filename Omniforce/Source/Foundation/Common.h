@@ -11,14 +11,22 @@
 #include "Memory/Allocators/DedicatedMemoryAllocator.h"
 #include "Memory/Allocators/PersistentAllocator.h"
 #include "Memory/Allocators/TransientAllocator.h"
+#include "Memory/Allocators/PoolAllocator.h"
+#include "Memory/Allocators/TaggedAllocator.h"
+#include "Memory/MemoryTelemetry.h"
 #include "Memory/VirtualMemoryBlock.h"
 #include "Log/Logger.h"
 
 #include "Containers/Array.h"
 #include "Containers/StaticArray.h"
 #include "Containers/Stack.h"
+#include "Containers/MPSCQueue.h"
+#include "Containers/FlatHashMap.h"
 
+#include "InplaceFunction.h"
+#include "Name.h"
 #include "Timer.h"
+#include "Profiling/Profiler.h"
 #include "UUID.h"
 
 #include <iostream>
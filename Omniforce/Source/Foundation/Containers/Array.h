@@ -2,190 +2,145 @@
 
 #include <Foundation/Platform.h>
 #include <Foundation/BasicTypes.h>
+#include <Foundation/TypeTraits.h>
 #include <Foundation/Log/Logger.h>
 #include <Foundation/Memory/Allocator.h>
 #include <Foundation/Memory/MemoryAllocation.h>
 
+#include <initializer_list>
+#include <memory>
+#include <cstring>
+
 namespace Omni {
 
-	// Resizable array
+	template<typename T, uint32 Capacity>
+	struct ArrayInlineStorage {
+		inline T* Data() { return (T*)data; }
+
+		alignas(T) byte data[Capacity * sizeof(T)];
+	};
+
 	template<typename T>
+	struct ArrayInlineStorage<T, 0> {
+		inline T* Data() { return nullptr; }
+	};
+
+	/*
+	*	@brief Resizable array. First `InlineCapacity` elements are stored inside of the array object itself,
+	*	so short arrays never touch the allocator. Heap memory is allocated lazily, once the array outgrows inline storage.
+	*	Trivially relocatable elements are moved with `memcpy` when array grows or shifts elements
+	*/
+	template<typename T, uint32 InlineCapacity = 0>
 	requires ((std::is_copy_constructible_v<T> || std::is_move_constructible_v<T>) && !std::is_abstract_v<T>)
 	class OMNIFORCE_API Array {
 	public:
 		using SizeType = uint64;
 
+		// Capacity of the first heap allocation
+		inline static constexpr SizeType MIN_HEAP_CAPACITY = 8;
+
 		Array()
 			: m_Allocator(nullptr)
-			, m_Size(0)
-			, m_GrowthFactor(2.0f)
 		{}
 
-		Array(IAllocator* allocator) 
+		Array(IAllocator* allocator)
 			: m_Allocator(allocator)
-			, m_Size(0)
-			, m_GrowthFactor(2.0f)
-		{
-			Reallocate(32);
-		}
+		{}
 
 		// Num of objects, not size in bytes
-		Array(IAllocator* allocator, SizeType size) 
+		Array(IAllocator* allocator, SizeType size)
 			: m_Allocator(allocator)
-			, m_Size(0)
-			, m_GrowthFactor(2.0f)
 		{
 			Resize(size);
 		}
 
 		Array(IAllocator* allocator, std::initializer_list<T> init_list)
 			: m_Allocator(allocator)
-			, m_Size(0)
-			, m_GrowthFactor(2.0f) 
 		{
-			Reallocate(init_list.size());
+			Reserve(init_list.size());
 
-			T* typed_array = m_Allocation.As<T>();
 			for (const auto& value : init_list) {
-				new (&typed_array[m_Size++]) T(value);
+				new (&m_Data[m_Size++]) T(value);
 			}
 		}
 
-		Array(const Array<T>& other) 
+		Array(const Array& other)
 			: m_Allocator(other.m_Allocator)
-			, m_Size(0)
 			, m_GrowthFactor(other.m_GrowthFactor)
 		{
-			if (this == &other) {
-				OMNIFORCE_CORE_WARNING("Attempted to assign an array to itself");
-				return;
-			}
-
-			if (other.m_Size > 0 && other.m_Allocator) {
-				// Allocate memory for the new array
-				Reallocate(other.m_Size);
-				
-				// Copy construct all elements
-				T* typed_array = m_Allocation.As<T>();
-				const T* other_array = other.m_Allocation.As<T>();
-
-				for (SizeType i = 0; i < other.m_Size; ++i) {
-					new (&typed_array[i]) T(other_array[i]);
-				}
-
-				m_Size = other.m_Size;
-			}
+			CopyElements(other);
 		}
 
-		Array(Array<T>&& other) noexcept {
-			if (this == &other) {
-				return;
-			}
-
-			if (m_Allocation.IsValid()) {
-				Clear();
-				m_Allocator->FreeBase(m_Allocation);
-			}
-
-			m_Allocator = other.m_Allocator;
-			m_Allocation = other.m_Allocation;
-			m_Size = other.m_Size;
-			m_GrowthFactor = other.m_GrowthFactor;
-
-			other.m_Allocation.Invalidate();
-			other.m_Size = 0;
+		Array(Array&& other) noexcept
+			: m_Allocator(other.m_Allocator)
+			, m_GrowthFactor(other.m_GrowthFactor)
+		{
+			StealElements(other);
 		}
 
 		~Array() {
-			if (m_Allocation.IsValid()) {
-				T* typed_array = m_Allocation.As<T>();
-				for (uint32 i = 0; i < m_Size; i++) {
-					typed_array[i].~T();
-				}
-
-				m_Allocator->Free<T>(m_Allocation, m_Size);
-			}
+			Clear();
+			ReleaseHeapMemory();
 		}
 
 		void Add(const T& value) {
-			if (m_Size == Capacity()) {
-				Reallocate(CalculateNewSize());
-			}
-
-			T* typed_array = m_Allocation.As<T>();
-			typed_array[m_Size] = value;
-
-			m_Size++;
+			EmplaceBack(value);
 		}
 
 		void Add(T&& value) {
-			if (m_Size == Capacity()) {
-				Reallocate(CalculateNewSize());
-			}
+			EmplaceBack(std::move(value));
+		}
 
-			T* typed_array = m_Allocation.As<T>();
-			typed_array[m_Size] = std::move(value);
+		// Constructs an element in place. Arguments may reference elements of the array itself
+		template<typename... TArgs>
+		T& EmplaceBack(TArgs&&... args) {
+			if (m_Size == m_Capacity) [[unlikely]] {
+				return EmplaceBackWithGrowth(std::forward<TArgs>(args)...);
+			}
 
+			T* element = new (&m_Data[m_Size]) T(std::forward<TArgs>(args)...);
 			m_Size++;
+
+			return *element;
 		}
 
 		void Remove(SizeType index) {
 			OMNIFORCE_ASSERT_TAGGED(index < m_Size, "Index out of bounds!");
 
-			T* typed_array = m_Allocation.As<T>();
-
-			typed_array[index].~T();
-
-			for (SizeType i = index; i < m_Size - 1; ++i) {
-				typed_array[i] = std::move(typed_array[i + 1]);
-			}
-
-			m_Size--;
+			Remove(index, index + 1);
 		}
 
 		void Remove(SizeType from, SizeType to) {
 			OMNIFORCE_ASSERT_TAGGED(from < m_Size && to <= m_Size && from <= to, "Invalid range!");
 
-			T* typed_array = m_Allocation.As<T>();
+			// Destroy elements in the specified range and shift elements after the range to the left
+			std::destroy(m_Data + from, m_Data + to);
+			RelocateElements(m_Data + from, m_Data + to, m_Size - to);
 
-			// Destroy elements in the specified range
-			for (SizeType i = from; i < to; ++i) {
-				typed_array[i].~T();
-			}
-
-			// Shift elements after the range to the left
-			SizeType count_to_move = m_Size - to;
-			for (SizeType i = 0; i < count_to_move; ++i) {
-				typed_array[from + i] = std::move(typed_array[to + i]);
-			}
-
-			// Decrement size
 			m_Size -= (to - from);
 		}
 
 		void Insert(const T& value, SizeType index) {
 			OMNIFORCE_ASSERT_TAGGED(index <= m_Size, "Index out of bounds");
 
-			// Check if we are out of bounds
-			if (m_Size == Capacity()) {
-				Reallocate(CalculateNewSize());
-			}
+			// Value may reference an element of this array, so copy it before elements are shifted
+			T value_copy(value);
 
-			T* typed_array = m_Allocation.As<T>();
+			if (m_Size == m_Capacity) {
+				Reallocate(CalculateGrowth(m_Size + 1));
+			}
 
 			// Shift elements to the right
-			for (SizeType i = m_Size; i > index; --i) {
-				typed_array[i] = std::move(typed_array[i - 1]);
-			}
+			RelocateElements(m_Data + index + 1, m_Data + index, m_Size - index);
 
-			// Use in-place constructor
-			new (&typed_array[index]) T(value);
+			new (&m_Data[index]) T(std::move(value_copy));
 
 			m_Size++;
 		}
 
-		void Insert(const Array<T>& range, SizeType index) {
+		void Insert(const Array& range, SizeType index) {
 			OMNIFORCE_ASSERT_TAGGED(index <= m_Size, "Index out of bounds!");
+			OMNIFORCE_ASSERT_TAGGED(&range != this, "Cannot insert an array into itself");
 
 			SizeType range_size = range.Size();
 			if (range_size == 0) {
@@ -195,32 +150,20 @@ namespace Omni {
 			// Check if we have enough memory
 			SizeType new_size = m_Size + range_size;
 			if (!HasEnoughMemory(new_size)) {
-				Reallocate(new_size);
+				Reallocate(CalculateGrowth(new_size));
 			}
 
-			T* typed_array = m_Allocation.As<T>();
-			T* range_array = range.Raw();
-
 			// Shift elements to the right
-			for (SizeType i = m_Size; i > index; --i) {
-				typed_array[i + range_size - 1] = std::move(typed_array[i - 1]);
-			}
+			RelocateElements(m_Data + index + range_size, m_Data + index, m_Size - index);
 
 			// Copy elements
-			for (SizeType i = 0; i < range_size; ++i) {
-				new (&typed_array[index + i]) T(range_array[i]);
-			}
+			std::uninitialized_copy(range.begin(), range.end(), m_Data + index);
 
 			m_Size = new_size;
 		}
 
 		void Clear() {
-			T* typed_array = m_Allocation.As<T>();
-
-			for (SizeType i = 0; i < m_Size; ++i) {
-				typed_array[i].~T();
-			}
-
+			std::destroy(m_Data, m_Data + m_Size);
 			m_Size = 0;
 		}
 
@@ -230,199 +173,258 @@ namespace Omni {
 				return;
 			}
 
-			T* typed_array = m_Allocation.As<T>();
-
 			if (new_size > m_Size) {
 				// Growing the array
 				if (!HasEnoughMemory(new_size)) {
-					// Reallocate memory if needed
 					Reallocate(new_size);
-					typed_array = m_Allocation.As<T>();
 				}
 
 				// Initialize new elements
-				for (SizeType i = m_Size; i < new_size; ++i) {
-					new (&typed_array[i]) T(); // Placement new to construct default objects
-				}
+				std::uninitialized_value_construct(m_Data + m_Size, m_Data + new_size);
 			}
 			else {
 				// Shrinking the array
-				for (SizeType i = new_size; i < m_Size; ++i) {
-					typed_array[i].~T(); // Call destructor on removed elements
-				}
+				std::destroy(m_Data + new_size, m_Data + m_Size);
 			}
 
 			// Update the size
 			m_Size = new_size;
 		}
 
-		void Reallocate(SizeType new_size = 256 / sizeof(T)) {
+		// Makes sure that array can store `capacity` elements without reallocation
+		void Reserve(SizeType capacity) {
+			if (!HasEnoughMemory(capacity)) {
+				Reallocate(capacity);
+			}
+		}
 
-			MemoryAllocation new_allocation = m_Allocator->AllocateBase(new_size * sizeof(T));
-			if (m_Allocation.IsValid()) [[likely]]
-			{
-				// Init new bytes
-				if (new_size > m_Allocation.Size) {
-					memset(new_allocation.Memory + m_Allocation.Size, 0, new_allocation.Size - m_Allocation.Size);
-				}
+		// Moves elements to a new heap allocation of `new_capacity` elements. Elements that do not fit are destroyed
+		void Reallocate(SizeType new_capacity) {
+			OMNIFORCE_ASSERT_TAGGED(m_Allocator, "Array has no allocator to allocate heap memory");
 
-				memcpy(new_allocation.Memory, m_Allocation.Memory, std::min(new_size, m_Size) * sizeof(T));
-				m_Allocator->FreeBase(m_Allocation);
-			}
-			else {
-				memset(new_allocation.Memory, 0, new_allocation.Size);
+			if (new_capacity < m_Size) {
+				Resize(new_capacity);
 			}
 
+			MemoryAllocation new_allocation = m_Allocator->AllocateBase(new_capacity * sizeof(T));
+			T* new_data = new_allocation.As<T>();
+
+			RelocateElements(new_data, m_Data, m_Size);
+			ReleaseHeapMemory();
+
 			m_Allocation = new_allocation;
+			m_Data = new_data;
+			m_Capacity = new_allocation.Size / sizeof(T);
 		}
 
-		inline uint32 Size() const { 
-			return m_Size; 
+		inline uint32 Size() const {
+			return m_Size;
 		}
 
-		inline constexpr bool IsEmpty() const { 
-			return (bool)m_Size; 
+		inline constexpr bool IsEmpty() const {
+			return m_Size == 0;
 		}
 
-		inline uint32 Capacity() const { 
-			return m_Allocation.Size / sizeof(T); 
+		inline uint32 Capacity() const {
+			return m_Capacity;
 		}
 
-		inline T* Raw()	const { 
-			return m_Allocation.As<T>(); 
+		inline T* Raw()	const {
+			return m_Data;
 		}
 
-		inline void	SetGrowthFactor(float32 factor) { 
+		inline void	SetGrowthFactor(float32 factor) {
 			OMNIFORCE_ASSERT_TAGGED(factor > 1.0f, "Growth factor must be greater than 1.0");
-			m_GrowthFactor = factor; 
+			m_GrowthFactor = factor;
 		}
 
-		Array<T>& operator=(const Array<T>& other) {
+		Array& operator=(const Array& other) {
 			if (this == &other) {
 				OMNIFORCE_CORE_WARNING("Attempted to assign an array to itself");
 				return *this;
 			}
 
 			// Clear existing data
-			if (m_Allocation.IsValid()) {
-				Clear();
-				m_Allocator->FreeBase(m_Allocation);
-				m_Allocation.Invalidate();
-			}
+			Clear();
+			ReleaseHeapMemory();
 
 			// Copy allocator and growth factor
 			m_Allocator = other.m_Allocator;
 			m_GrowthFactor = other.m_GrowthFactor;
-			m_Size = 0;
-
-			// Copy data if other has elements
-			if (other.m_Size > 0 && other.m_Allocator) {
-				Reallocate(other.m_Size);
-				
-				T* typed_array = m_Allocation.As<T>();
-				const T* other_array = other.m_Allocation.As<T>();
-
-				for (SizeType i = 0; i < other.m_Size; ++i) {
-					new (&typed_array[i]) T(other_array[i]);
-				}
 
-				m_Size = other.m_Size;
-			}
+			CopyElements(other);
 
 			return *this;
 		}
-		
 
-		Array<T>& operator=(Array<T>&& other) noexcept {
+		Array& operator=(Array&& other) noexcept {
 			if (this == &other) {
 				return *this;
 			}
 
-			if (m_Allocation.IsValid()) {
-				Clear();
-				m_Allocator->FreeBase(m_Allocation);
-			}
+			Clear();
+			ReleaseHeapMemory();
 
 			m_Allocator = other.m_Allocator;
-			m_Allocation = other.m_Allocation;
-			m_Size = other.m_Size;
 			m_GrowthFactor = other.m_GrowthFactor;
 
-			other.m_Allocation.Invalidate();
-			other.m_Size = 0;
+			StealElements(other);
 
 			return *this;
 		}
 
-		Array<T>& operator=(std::initializer_list<T> init_list) {
-			// Reallocate if not enough memory
-			if (!HasEnoughMemory(init_list.size())) {
-				Reallocate(init_list.size());
-			}
-
-			if (m_Allocation.IsValid()) {
-				Clear();
-				m_Allocator->FreeBase(m_Allocation);
-			}
-
-			T* typed_array = m_Allocation.As<T>();
+		Array& operator=(std::initializer_list<T> init_list) {
+			Clear();
+			Reserve(init_list.size());
 
 			for (const auto& value : init_list) {
-				new (&typed_array[m_Size++]) T(value);
+				new (&m_Data[m_Size++]) T(value);
 			}
 
 			return *this;
 		}
 
 		inline T& operator[](uint32 index) {
-			return m_Allocation.As<T>()[index];
+			return m_Data[index];
 		}
 
 		inline const T& operator[](uint32 index) const {
-			return m_Allocation.As<T>()[index];
+			return m_Data[index];
 		}
 
-		inline T* begin() { 
-			return m_Allocation.As<T>(); 
+		inline T* begin() {
+			return m_Data;
 		}
 
 		inline T* end() {
-			return m_Allocation.As<T>() + m_Size; 
+			return m_Data + m_Size;
 		}
 
 		inline const T* begin() const {
-			return m_Allocation.As<T>(); 
+			return m_Data;
 		}
 
 		inline const T* end() const {
-			return m_Allocation.As<T>() + m_Size; 
+			return m_Data + m_Size;
 		}
 
 		inline const T* rbegin() const {
-			return m_Allocation.As<T>() + m_Size - 1;
+			return m_Data + m_Size - 1;
 		}
 
 		inline const T* rend() const {
-			return m_Allocation.As<T>() - 1;
+			return m_Data - 1;
 		}
 
 	private:
-		inline SizeType CalculateNewSize() const { 
-			return m_Allocation.Size * m_GrowthFactor; 
+		inline SizeType CalculateGrowth(SizeType min_capacity) const {
+			SizeType grown_capacity = std::max<SizeType>(m_Capacity * m_GrowthFactor, MIN_HEAP_CAPACITY);
+			return std::max(grown_capacity, min_capacity);
+		}
+
+		inline bool	HasEnoughMemory(SizeType new_size) const {
+			return m_Capacity >= new_size;
+		}
+
+		// Moves `count` elements to uninitialized memory and destroys the source ones. Ranges may overlap
+		static void RelocateElements(T* destination, T* source, SizeType count) {
+			if (destination == source || count == 0) {
+				return;
+			}
+
+			if constexpr (IsTriviallyRelocatable<T>) {
+				memmove((void*)destination, (const void*)source, count * sizeof(T));
+			}
+			else if (destination < source) {
+				for (SizeType i = 0; i < count; i++) {
+					new (&destination[i]) T(std::move(source[i]));
+					source[i].~T();
+				}
+			}
+			else {
+				for (SizeType i = count; i > 0; i--) {
+					new (&destination[i - 1]) T(std::move(source[i - 1]));
+					source[i - 1].~T();
+				}
+			}
+		}
+
+		template<typename... TArgs>
+		T& EmplaceBackWithGrowth(TArgs&&... args) {
+			OMNIFORCE_ASSERT_TAGGED(m_Allocator, "Array has no allocator to allocate heap memory");
+
+			MemoryAllocation new_allocation = m_Allocator->AllocateBase(CalculateGrowth(m_Size + 1) * sizeof(T));
+			T* new_data = new_allocation.As<T>();
+
+			// Construct new element before relocation, since arguments may reference old elements
+			T* element = new (&new_data[m_Size]) T(std::forward<TArgs>(args)...);
+
+			RelocateElements(new_data, m_Data, m_Size);
+			ReleaseHeapMemory();
+
+			m_Allocation = new_allocation;
+			m_Data = new_data;
+			m_Capacity = new_allocation.Size / sizeof(T);
+			m_Size++;
+
+			return *element;
+		}
+
+		// Assumes array is empty
+		void CopyElements(const Array& other) {
+			Reserve(other.m_Size);
+
+			std::uninitialized_copy(other.begin(), other.end(), m_Data);
+			m_Size = other.m_Size;
 		}
 
-		inline bool	HasEnoughMemory(SizeType new_size) const { 
-			return Capacity() >= new_size;
+		// Assumes array is empty and has no heap memory
+		void StealElements(Array& other) {
+			if (other.m_Allocation.IsValid()) {
+				m_Allocation = other.m_Allocation;
+				m_Data = other.m_Data;
+				m_Capacity = other.m_Capacity;
+				m_Size = other.m_Size;
+
+				other.m_Allocation.Invalidate();
+				other.m_Data = other.m_InlineStorage.Data();
+				other.m_Capacity = InlineCapacity;
+			}
+			else {
+				RelocateElements(m_Data, other.m_Data, other.m_Size);
+				m_Size = other.m_Size;
+			}
+
+			other.m_Size = 0;
+		}
+
+		// Assumes all elements are destroyed or relocated
+		void ReleaseHeapMemory() {
+			if (m_Allocation.IsValid()) {
+				m_Allocator->FreeBase(m_Allocation);
+			}
+
+			m_Data = m_InlineStorage.Data();
+			m_Capacity = InlineCapacity;
 		}
 
 	private:
 		IAllocator* m_Allocator;
 		MemoryAllocation m_Allocation;
-		SizeType m_Size;
-		float32 m_GrowthFactor;
+		T* m_Data = m_InlineStorage.Data();
+		SizeType m_Size = 0;
+		SizeType m_Capacity = InlineCapacity;
+		float32 m_GrowthFactor = 2.0f;
+		ArrayInlineStorage<T, InlineCapacity> m_InlineStorage;
 
 	};
 
+	/*
+	*	@brief Array that keeps first `N` elements inline, intended for short-living arrays on hot paths
+	*/
+	template<typename T, uint32 N>
+	using InlineArray = Array<T, N>;
+
 	using ByteArray = Array<byte>;
 
-}
\ No newline at end of file
+}
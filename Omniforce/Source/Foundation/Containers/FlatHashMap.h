@@ -0,0 +1,655 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+#include <Foundation/TypeTraits.h>
+#include <Foundation/Hash.h>
+#include <Foundation/Assert.h>
+#include <Foundation/Memory/Allocator.h>
+#include <Foundation/Memory/MemoryAllocation.h>
+#include <Foundation/Memory/Allocators/DedicatedMemoryAllocator.h>
+
+#include <utility>
+#include <stdexcept>
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#include <emmintrin.h>
+	#define OMNIFORCE_FLAT_HASH_MAP_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+	#include <arm_neon.h>
+	#define OMNIFORCE_FLAT_HASH_MAP_NEON
+#endif
+
+namespace Omni {
+
+	/*
+	*	@brief Control byte of a hash map slot. Full slots store 7 lower bits of a key hash, special values have sign bit set
+	*/
+	struct FlatHashMapControl {
+		inline static constexpr int8 EMPTY = -128;
+		inline static constexpr int8 DELETED = -2;
+		inline static constexpr int8 SENTINEL = -1;
+
+		inline static bool IsFull(int8 control) { return control >= 0; }
+		inline static bool IsEmptyOrDeleted(int8 control) { return control < SENTINEL; }
+	};
+
+#if defined(OMNIFORCE_FLAT_HASH_MAP_SSE2)
+
+	/*
+	*	@brief A group of 16 control bytes which are matched at once with SSE2. Bit N of a mask corresponds to N-th slot of the group
+	*/
+	struct FlatHashMapGroup {
+		using MaskType = uint32;
+
+		inline static constexpr uint32 WIDTH = 16;
+		inline static constexpr uint32 SHIFT = 0;
+
+		FlatHashMapGroup(const int8* control)
+			: controls(_mm_loadu_si128((const __m128i*)control))
+		{}
+
+		MaskType Match(int8 h2) const {
+			return (MaskType)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), controls));
+		}
+
+		MaskType MatchEmpty() const {
+			return Match(FlatHashMapControl::EMPTY);
+		}
+
+		MaskType MatchEmptyOrDeleted() const {
+			return (MaskType)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(FlatHashMapControl::SENTINEL), controls));
+		}
+
+		uint32 CountLeadingEmptyOrDeleted() const {
+			return std::countr_one(MatchEmptyOrDeleted());
+		}
+
+		// Number of slots before the first matched slot, `WIDTH` if nothing is matched
+		inline static uint32 TrailingSlots(MaskType mask) { return std::countr_zero(mask | (1u << WIDTH)); }
+
+		// Number of slots after the last matched slot, `WIDTH` if nothing is matched
+		inline static uint32 LeadingSlots(MaskType mask) { return std::countl_zero(mask) - (32 - WIDTH); }
+
+		__m128i controls;
+	};
+
+#else
+
+	/*
+	*	@brief A group of 8 control bytes which are matched at once, with NEON if available or within a 64-bit register otherwise.
+	*	Most significant bit of N-th byte of a mask corresponds to N-th slot of the group
+	*/
+	struct FlatHashMapGroup {
+		using MaskType = uint64;
+
+		inline static constexpr uint32 WIDTH = 8;
+		inline static constexpr uint32 SHIFT = 3;
+
+		inline static constexpr uint64 LSBS = 0x0101010101010101ull;
+		inline static constexpr uint64 MSBS = 0x8080808080808080ull;
+
+		FlatHashMapGroup(const int8* control) {
+			memcpy(&controls, control, sizeof(controls));
+		}
+
+#if defined(OMNIFORCE_FLAT_HASH_MAP_NEON)
+		MaskType Match(int8 h2) const {
+			uint8x8_t result = vceq_s8(vdup_n_s8(h2), vcreate_s8(controls));
+			return vget_lane_u64(vreinterpret_u64_u8(result), 0) & MSBS;
+		}
+
+		MaskType MatchEmptyOrDeleted() const {
+			uint8x8_t result = vclt_s8(vcreate_s8(controls), vdup_n_s8(FlatHashMapControl::SENTINEL));
+			return vget_lane_u64(vreinterpret_u64_u8(result), 0) & MSBS;
+		}
+#else
+		// May report false positives next to a true match, which is fine since keys are compared anyway
+		MaskType Match(int8 h2) const {
+			uint64 x = controls ^ (LSBS * (uint8)h2);
+			return (x - LSBS) & ~x & MSBS;
+		}
+
+		// Empty and deleted bytes have the most significant bit set and the least significant bit clear
+		MaskType MatchEmptyOrDeleted() const {
+			return controls & ~(controls << 7) & MSBS;
+		}
+#endif
+
+		// Empty is the only special byte which has the most significant bit set and the second bit clear
+		MaskType MatchEmpty() const {
+			return controls & ~(controls << 6) & MSBS;
+		}
+
+		uint32 CountLeadingEmptyOrDeleted() const {
+			return std::countr_zero(~MatchEmptyOrDeleted() & MSBS) >> SHIFT;
+		}
+
+		inline static uint32 TrailingSlots(MaskType mask) { return std::countr_zero(mask) >> SHIFT; }
+		inline static uint32 LeadingSlots(MaskType mask) { return std::countl_zero(mask) >> SHIFT; }
+
+		uint64 controls;
+	};
+
+#endif
+
+	/*
+	*	@brief Open-addressing hash map with SIMD group probing (Swiss table). Keys and values are stored inline in a flat slot array,
+	*	a parallel array of control bytes keeps 7 bits of each key's hash, so a whole group of slots is tested with a few instructions
+	*	and keys are compared only on a hash match. Capacity is always 2^N - 1, max load factor is 7/8.
+	*	References and iterators are invalidated by insertion which causes rehash
+	*/
+	template<typename TKey, typename TValue, typename THasher = Hash<TKey>>
+	class OMNIFORCE_API FlatHashMap {
+	public:
+		using SizeType = uint64;
+		using Slot = std::pair<TKey, TValue>;
+
+		static_assert(alignof(Slot) <= IAllocator::DEFAULT_ALIGNMENT, "Over-aligned slots are not supported");
+
+		template<bool IsConst>
+		class IteratorBase {
+		public:
+			using SlotType = std::conditional_t<IsConst, const Slot, Slot>;
+
+			IteratorBase() = default;
+
+			IteratorBase(const int8* control, SlotType* slot)
+				: m_Control(control), m_Slot(slot)
+			{}
+
+			// Allows to convert a mutable iterator into a const one
+			operator IteratorBase<true>() const {
+				return IteratorBase<true>(m_Control, m_Slot);
+			}
+
+			SlotType& operator*() const { return *m_Slot; }
+			SlotType* operator->() const { return m_Slot; }
+
+			IteratorBase& operator++() {
+				m_Control++;
+				m_Slot++;
+				SkipEmptyOrDeleted();
+
+				return *this;
+			}
+
+			bool operator==(const IteratorBase& other) const { return m_Control == other.m_Control; }
+			bool operator!=(const IteratorBase& other) const { return m_Control != other.m_Control; }
+
+		private:
+			// Control bytes end with a sentinel, so skipping always stops
+			void SkipEmptyOrDeleted() {
+				while (FlatHashMapControl::IsEmptyOrDeleted(*m_Control)) {
+					uint32 shift = FlatHashMapGroup(m_Control).CountLeadingEmptyOrDeleted();
+					m_Control += shift;
+					m_Slot += shift;
+				}
+			}
+
+			const int8* m_Control = nullptr;
+			SlotType* m_Slot = nullptr;
+
+			friend class FlatHashMap;
+		};
+
+		using Iterator = IteratorBase<false>;
+		using ConstIterator = IteratorBase<true>;
+
+		FlatHashMap()
+			: m_Allocator(&g_DedicatedMemoryAllocator)
+		{}
+
+		FlatHashMap(IAllocator* allocator)
+			: m_Allocator(allocator)
+		{}
+
+		FlatHashMap(const FlatHashMap& other)
+			: m_Allocator(other.m_Allocator)
+			, m_Hasher(other.m_Hasher)
+		{
+			CopyElements(other);
+		}
+
+		FlatHashMap(FlatHashMap&& other) noexcept
+			: m_Allocator(other.m_Allocator)
+			, m_Hasher(std::move(other.m_Hasher))
+		{
+			StealElements(other);
+		}
+
+		~FlatHashMap() {
+			Release();
+		}
+
+		FlatHashMap& operator=(const FlatHashMap& other) {
+			if (this == &other) {
+				return *this;
+			}
+
+			Release();
+
+			m_Allocator = other.m_Allocator;
+			m_Hasher = other.m_Hasher;
+
+			CopyElements(other);
+
+			return *this;
+		}
+
+		FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+			if (this == &other) {
+				return *this;
+			}
+
+			Release();
+
+			m_Allocator = other.m_Allocator;
+			m_Hasher = std::move(other.m_Hasher);
+
+			StealElements(other);
+
+			return *this;
+		}
+
+		Iterator Find(const TKey& key) {
+			SizeType index = FindIndex(key);
+			return index != INVALID_INDEX ? MakeIterator(index) : end();
+		}
+
+		ConstIterator Find(const TKey& key) const {
+			return const_cast<FlatHashMap*>(this)->Find(key);
+		}
+
+		bool Contains(const TKey& key) const {
+			return FindIndex(key) != INVALID_INDEX;
+		}
+
+		// Throws `std::out_of_range` if the key is not present, in all build configurations
+		TValue& At(const TKey& key) {
+			SizeType index = FindIndex(key);
+
+			if (index == INVALID_INDEX) [[unlikely]] {
+				OMNIFORCE_ASSERT_TAGGED(false, "Key is not present in the map");
+				throw std::out_of_range("FlatHashMap::At: key is not present in the map");
+			}
+
+			return m_Slots[index].second;
+		}
+
+		const TValue& At(const TKey& key) const {
+			return const_cast<FlatHashMap*>(this)->At(key);
+		}
+
+		// Returns a value by key, default-constructs it if the key is not present
+		TValue& operator[](const TKey& key) {
+			return Emplace(key).first->second;
+		}
+
+		// Constructs a value only if the key is not present yet. Returns an iterator to the element and whether it was inserted
+		template<typename... TArgs>
+		std::pair<Iterator, bool> Emplace(const TKey& key, TArgs&&... args) {
+			uint64 hash = m_Hasher(key);
+
+			SizeType index = FindIndex(key, hash);
+			if (index != INVALID_INDEX) {
+				return { MakeIterator(index), false };
+			}
+
+			index = PrepareInsert(hash);
+			new (&m_Slots[index]) Slot(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...));
+
+			return { MakeIterator(index), true };
+		}
+
+		// Inserts a value or replaces an existing one
+		template<typename TArg>
+		Iterator InsertOrAssign(const TKey& key, TArg&& value) {
+			auto [iterator, inserted] = Emplace(key, std::forward<TArg>(value));
+
+			if (!inserted) {
+				iterator->second = std::forward<TArg>(value);
+			}
+
+			return iterator;
+		}
+
+		// Returns number of removed elements
+		SizeType Remove(const TKey& key) {
+			SizeType index = FindIndex(key);
+
+			if (index == INVALID_INDEX) {
+				return 0;
+			}
+
+			RemoveAt(index);
+			return 1;
+		}
+
+		void Remove(ConstIterator iterator) {
+			RemoveAt(iterator.m_Control - m_Control);
+		}
+
+		// Destroys all elements, keeps memory
+		void Clear() {
+			if (!m_Capacity) {
+				return;
+			}
+
+			DestroyElements();
+			ResetControlBytes();
+
+			m_Size = 0;
+			m_GrowthLeft = CapacityToGrowth(m_Capacity);
+		}
+
+		// Makes sure that map can store `count` elements without rehashing
+		void Reserve(SizeType count) {
+			if (count > m_Size + m_GrowthLeft) {
+				Rehash(GrowthToCapacity(count));
+			}
+		}
+
+		inline SizeType Size() const {
+			return m_Size;
+		}
+
+		inline bool IsEmpty() const {
+			return m_Size == 0;
+		}
+
+		inline SizeType Capacity() const {
+			return m_Capacity;
+		}
+
+		Iterator begin() {
+			if (!m_Capacity) {
+				return end();
+			}
+
+			Iterator iterator(m_Control, m_Slots);
+			iterator.SkipEmptyOrDeleted();
+
+			return iterator;
+		}
+
+		Iterator end() {
+			return Iterator(m_Control + m_Capacity, m_Slots + m_Capacity);
+		}
+
+		ConstIterator begin() const {
+			return const_cast<FlatHashMap*>(this)->begin();
+		}
+
+		ConstIterator end() const {
+			return const_cast<FlatHashMap*>(this)->end();
+		}
+
+	private:
+		using Group = FlatHashMapGroup;
+
+		inline static constexpr SizeType INVALID_INDEX = ~0ull;
+
+		// Smallest capacity which lets every group window map onto real slots
+		inline static constexpr SizeType MIN_CAPACITY = Group::WIDTH - 1;
+
+		// Quadratic probing over groups, visits every group of the table once capacity + 1 is a power of two
+		struct ProbeSequence {
+			ProbeSequence(uint64 hash, SizeType mask)
+				: mask(mask), offset(hash & mask)
+			{}
+
+			inline SizeType Offset(uint32 slot) const { return (offset + slot) & mask; }
+
+			inline void Next() {
+				index += Group::WIDTH;
+				offset = (offset + index) & mask;
+			}
+
+			SizeType mask;
+			SizeType offset;
+			SizeType index = 0;
+		};
+
+		// Lower 7 bits of a hash are stored in control bytes, the rest selects a starting group
+		inline static uint64 H1(uint64 hash) { return hash >> 7; }
+		inline static int8 H2(uint64 hash) { return (int8)(hash & 0x7F); }
+
+		inline static uint32 FirstSlot(typename Group::MaskType mask) { return std::countr_zero(mask) >> Group::SHIFT; }
+
+		inline static SizeType CapacityToGrowth(SizeType capacity) {
+			return capacity - std::max<SizeType>(capacity / 8, 1);
+		}
+
+		inline static SizeType GrowthToCapacity(SizeType growth) {
+			SizeType min_capacity = std::max<SizeType>(growth + growth / 7 + 1, MIN_CAPACITY);
+			return std::bit_ceil(min_capacity + 1) - 1;
+		}
+
+		SizeType FindIndex(const TKey& key) const {
+			return FindIndex(key, m_Hasher(key));
+		}
+
+		SizeType FindIndex(const TKey& key, uint64 hash) const {
+			if (!m_Capacity) {
+				return INVALID_INDEX;
+			}
+
+			ProbeSequence sequence(H1(hash), m_Capacity);
+			int8 h2 = H2(hash);
+
+			while (true) {
+				Group group(m_Control + sequence.offset);
+
+				for (auto mask = group.Match(h2); mask; mask &= mask - 1) {
+					SizeType index = sequence.Offset(FirstSlot(mask));
+
+					if (m_Slots[index].first == key) [[likely]] {
+						return index;
+					}
+				}
+
+				if (group.MatchEmpty()) [[likely]] {
+					return INVALID_INDEX;
+				}
+
+				sequence.Next();
+			}
+		}
+
+		// First empty or deleted slot on a probe sequence of the hash
+		SizeType FindFirstNonFull(uint64 hash) const {
+			ProbeSequence sequence(H1(hash), m_Capacity);
+
+			while (true) {
+				auto mask = Group(m_Control + sequence.offset).MatchEmptyOrDeleted();
+
+				if (mask) [[likely]] {
+					return sequence.Offset(FirstSlot(mask));
+				}
+
+				sequence.Next();
+			}
+		}
+
+		// Finds a slot for a new element and marks it as full. Rehashes the map if there is no room left
+		SizeType PrepareInsert(uint64 hash) {
+			SizeType index = m_Capacity ? FindFirstNonFull(hash) : INVALID_INDEX;
+
+			// Reusing a deleted slot does not reduce growth budget
+			if (index == INVALID_INDEX || (m_GrowthLeft == 0 && m_Control[index] != FlatHashMapControl::DELETED)) [[unlikely]] {
+				RehashForInsertion();
+				index = FindFirstNonFull(hash);
+			}
+
+			m_GrowthLeft -= m_Control[index] == FlatHashMapControl::EMPTY;
+			SetControl(index, H2(hash));
+			m_Size++;
+
+			return index;
+		}
+
+		// If a lot of slots are only occupied by tombstones, they are dropped without growing the map
+		void RehashForInsertion() {
+			if (m_Capacity > Group::WIDTH && m_Size * 32 <= m_Capacity * 25) {
+				Rehash(m_Capacity);
+			}
+			else {
+				Rehash(m_Capacity ? m_Capacity * 2 + 1 : MIN_CAPACITY);
+			}
+		}
+
+		void RemoveAt(SizeType index) {
+			m_Slots[index].~Slot();
+			m_Size--;
+
+			// If the slot was never part of a full group on any probe sequence, it can become empty again instead of a tombstone
+			SizeType index_before = (index - Group::WIDTH) & m_Capacity;
+			auto empty_after = Group(m_Control + index).MatchEmpty();
+			auto empty_before = Group(m_Control + index_before).MatchEmpty();
+
+			bool was_never_full = empty_before && empty_after &&
+				(Group::TrailingSlots(empty_after) + Group::LeadingSlots(empty_before)) < Group::WIDTH;
+
+			SetControl(index, was_never_full ? FlatHashMapControl::EMPTY : FlatHashMapControl::DELETED);
+			m_GrowthLeft += was_never_full;
+		}
+
+		// Sets control byte and its clone, which lets group loads near the end of the table wrap around
+		void SetControl(SizeType index, int8 control) {
+			m_Control[index] = control;
+
+			if (index < Group::WIDTH - 1) {
+				m_Control[m_Capacity + 1 + index] = control;
+			}
+		}
+
+		void ResetControlBytes() {
+			memset(m_Control, (uint8)FlatHashMapControl::EMPTY, m_Capacity + Group::WIDTH);
+			m_Control[m_Capacity] = FlatHashMapControl::SENTINEL;
+		}
+
+		inline static SizeType ComputeSlotsOffset(SizeType capacity) {
+			return IAllocator::AlignUp(capacity + Group::WIDTH, alignof(Slot));
+		}
+
+		void Rehash(SizeType new_capacity) {
+			OMNIFORCE_ASSERT_TAGGED(m_Allocator, "Hash map has no allocator to allocate memory");
+			OMNIFORCE_ASSERT_TAGGED(std::has_single_bit(new_capacity + 1), "Hash map capacity must be 2^N - 1");
+
+			int8* old_control = m_Control;
+			Slot* old_slots = m_Slots;
+			SizeType old_capacity = m_Capacity;
+			MemoryAllocation old_allocation = m_Allocation;
+
+			SizeType slots_offset = ComputeSlotsOffset(new_capacity);
+			m_Allocation = m_Allocator->AllocateBase(slots_offset + new_capacity * sizeof(Slot));
+			OMNIFORCE_ASSERT_TAGGED(m_Allocation.IsValid(), "Failed to allocate hash map memory");
+
+			m_Control = (int8*)m_Allocation.Memory;
+			m_Slots = (Slot*)(m_Allocation.Memory + slots_offset);
+			m_Capacity = new_capacity;
+			m_GrowthLeft = CapacityToGrowth(new_capacity) - m_Size;
+			ResetControlBytes();
+
+			for (SizeType i = 0; i < old_capacity; i++) {
+				if (!FlatHashMapControl::IsFull(old_control[i])) {
+					continue;
+				}
+
+				uint64 hash = m_Hasher(old_slots[i].first);
+				SizeType index = FindFirstNonFull(hash);
+				SetControl(index, H2(hash));
+
+				RelocateSlot(&m_Slots[index], &old_slots[i]);
+			}
+
+			if (old_allocation.IsValid()) {
+				m_Allocator->FreeBase(old_allocation);
+			}
+		}
+
+		inline static void RelocateSlot(Slot* destination, Slot* source) {
+			if constexpr (IsTriviallyRelocatable<TKey> && IsTriviallyRelocatable<TValue>) {
+				memcpy((void*)destination, (const void*)source, sizeof(Slot));
+			}
+			else {
+				new (destination) Slot(std::move(*source));
+				source->~Slot();
+			}
+		}
+
+		void DestroyElements() {
+			if constexpr (!std::is_trivially_destructible_v<Slot>) {
+				for (SizeType i = 0; i < m_Capacity; i++) {
+					if (FlatHashMapControl::IsFull(m_Control[i])) {
+						m_Slots[i].~Slot();
+					}
+				}
+			}
+		}
+
+		inline Iterator MakeIterator(SizeType index) {
+			return Iterator(m_Control + index, m_Slots + index);
+		}
+
+		// Assumes map is empty and has no memory
+		void CopyElements(const FlatHashMap& other) {
+			Reserve(other.m_Size);
+
+			for (const auto& [key, value] : other) {
+				Emplace(key, value);
+			}
+		}
+
+		// Assumes map is empty and has no memory
+		void StealElements(FlatHashMap& other) {
+			m_Allocation = other.m_Allocation;
+			m_Control = other.m_Control;
+			m_Slots = other.m_Slots;
+			m_Capacity = other.m_Capacity;
+			m_Size = other.m_Size;
+			m_GrowthLeft = other.m_GrowthLeft;
+
+			other.m_Allocation.Invalidate();
+			other.m_Control = nullptr;
+			other.m_Slots = nullptr;
+			other.m_Capacity = 0;
+			other.m_Size = 0;
+			other.m_GrowthLeft = 0;
+		}
+
+		void Release() {
+			if (!m_Capacity) {
+				return;
+			}
+
+			DestroyElements();
+			m_Allocator->FreeBase(m_Allocation);
+
+			m_Allocation.Invalidate();
+			m_Control = nullptr;
+			m_Slots = nullptr;
+			m_Capacity = 0;
+			m_Size = 0;
+			m_GrowthLeft = 0;
+		}
+
+	private:
+		IAllocator* m_Allocator;
+		MemoryAllocation m_Allocation;
+		int8* m_Control = nullptr;
+		Slot* m_Slots = nullptr;
+		SizeType m_Capacity = 0;
+		SizeType m_Size = 0;
+		SizeType m_GrowthLeft = 0;
+		[[no_unique_address]] THasher m_Hasher;
+	};
+
+	// Map only points to its memory, so it can be relocated with `memcpy`
+	template<typename TKey, typename TValue, typename THasher>
+	struct TriviallyRelocatable<FlatHashMap<TKey, TValue, THasher>> : std::true_type {};
+
+}
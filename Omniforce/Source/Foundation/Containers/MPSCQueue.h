@@ -0,0 +1,267 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+#include <Foundation/Assert.h>
+#include <Foundation/Memory/Allocator.h>
+#include <Foundation/Memory/MemoryAllocation.h>
+
+#include <thread>
+#include <algorithm>
+
+namespace Omni {
+
+	/*
+	*	@brief Lock-free multi-producer single-consumer queue. Elements are stored in a list of fixed-size chunks,
+	*	so a push is a single atomic increment in the common case; only a producer that overflows a chunk allocates a new one.
+	*	Consumer must only drain the queue when producers are done with it (e.g. a queue that was filled few frames ago).
+	*	Moving a queue is not thread-safe. `ChunkSize` is the size of a whole chunk in bytes, including its header,
+	*	so that chunks occupy power-of-two blocks of buddy allocators without rounding up to the next block size
+	*/
+	template<typename T, uint64 ChunkSize = 16 * 1024>
+	class OMNIFORCE_API MPSCQueue {
+	public:
+		MPSCQueue()
+			: m_Allocator(nullptr)
+		{}
+
+		MPSCQueue(IAllocator* allocator)
+			: m_Allocator(allocator)
+		{
+			m_Head = AllocateChunk();
+			m_Tail.store(m_Head, std::memory_order_relaxed);
+		}
+
+		MPSCQueue(const MPSCQueue&) = delete;
+
+		MPSCQueue(MPSCQueue&& other) noexcept
+			: m_Allocator(other.m_Allocator)
+			, m_Head(other.m_Head)
+			, m_Tail(other.m_Tail.load(std::memory_order_relaxed))
+		{
+			other.m_Head = nullptr;
+			other.m_Tail.store(nullptr, std::memory_order_relaxed);
+		}
+
+		~MPSCQueue() {
+			Release();
+		}
+
+		MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+		MPSCQueue& operator=(MPSCQueue&& other) noexcept {
+			if (this == &other) {
+				return *this;
+			}
+
+			Release();
+
+			m_Allocator = other.m_Allocator;
+			m_Head = other.m_Head;
+			m_Tail.store(other.m_Tail.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+			other.m_Head = nullptr;
+			other.m_Tail.store(nullptr, std::memory_order_relaxed);
+
+			return *this;
+		}
+
+		// Can be called from any thread
+		void Push(T&& value) {
+			Emplace(std::move(value));
+		}
+
+		// Can be called from any thread
+		template<typename... TArgs>
+		void Emplace(TArgs&&... args) {
+			Chunk* chunk = m_Tail.load(std::memory_order_acquire);
+			OMNIFORCE_ASSERT_TAGGED(chunk, "Attempted to push into a queue that has no allocator");
+
+			while (true) {
+				uint32 index = chunk->num_reserved.fetch_add(1, std::memory_order_relaxed);
+
+				if (index < CHUNK_CAPACITY) [[likely]] {
+					new (chunk->Slot(index)) T(std::forward<TArgs>(args)...);
+					chunk->num_committed.fetch_add(1, std::memory_order_release);
+					return;
+				}
+
+				chunk = AcquireNextChunk(chunk, index);
+			}
+		}
+
+		// Consumer only. Invokes `function` on every element in order of insertion and destroys it.
+		// Memory of the first chunk is kept for reuse. Returns number of consumed elements
+		template<typename TFunction>
+		uint64 ConsumeAll(TFunction&& function) {
+			uint64 num_consumed = 0;
+			Chunk* chunk = m_Head;
+
+			while (chunk) {
+				uint32 num_elements = WaitForCommittedElements(chunk);
+
+				for (uint32 i = 0; i < num_elements; i++) {
+					T* element = chunk->Slot(i);
+					function(*element);
+					element->~T();
+				}
+				num_consumed += num_elements;
+
+				Chunk* next_chunk = chunk->next.load(std::memory_order_acquire);
+				if (chunk != m_Head) {
+					FreeChunk(chunk);
+				}
+				chunk = next_chunk;
+			}
+
+			ResetHead();
+
+			return num_consumed;
+		}
+
+		// Consumer only. Same as `ConsumeAll`, but elements are visited in reverse order of insertion,
+		// so an element is destroyed before elements that were pushed earlier
+		template<typename TFunction>
+		uint64 ConsumeAllReversed(TFunction&& function) {
+			uint64 num_consumed = 0;
+			Chunk* chunk = m_Head ? m_Tail.load(std::memory_order_acquire) : nullptr;
+
+			while (chunk) {
+				uint32 num_elements = WaitForCommittedElements(chunk);
+
+				for (uint32 i = num_elements; i > 0; i--) {
+					T* element = chunk->Slot(i - 1);
+					function(*element);
+					element->~T();
+				}
+				num_consumed += num_elements;
+
+				Chunk* previous_chunk = chunk->previous;
+				if (chunk != m_Head) {
+					FreeChunk(chunk);
+				}
+				chunk = previous_chunk;
+			}
+
+			ResetHead();
+
+			return num_consumed;
+		}
+
+		// Consumer only. Destroys all elements
+		void Clear() {
+			ConsumeAll([](T&) {});
+		}
+
+		// Consumer only
+		bool IsEmpty() const {
+			return !m_Head || m_Head->num_reserved.load(std::memory_order_relaxed) == 0;
+		}
+
+	private:
+		struct Chunk;
+
+		struct ChunkHeader {
+			Atomic<uint32> num_reserved = 0;	// Slots claimed by producers, may exceed capacity when chunk overflows
+			Atomic<uint32> num_committed = 0;	// Slots that hold constructed elements
+			Atomic<Chunk*> next = nullptr;
+			Chunk* previous = nullptr;			// Written before the chunk is published, only read by consumer
+			MemoryAllocation allocation;		// As returned by allocator, since it may depend on actual block size when freeing
+		};
+
+		// Element storage starts at the first properly aligned offset past the header
+		static constexpr uint64 STORAGE_OFFSET = (sizeof(ChunkHeader) + alignof(T) - 1) / alignof(T) * alignof(T);
+		static constexpr uint32 CHUNK_CAPACITY = (uint32)((ChunkSize - STORAGE_OFFSET) / sizeof(T));
+
+		static_assert((ChunkSize & (ChunkSize - 1)) == 0, "Chunk size must be a power of two");
+		static_assert(CHUNK_CAPACITY > 0, "Chunk size is too small to hold a single element");
+
+		struct Chunk : ChunkHeader {
+			alignas(T) byte storage[CHUNK_CAPACITY * sizeof(T)];
+
+			inline T* Slot(uint32 index) {
+				return (T*)storage + index;
+			}
+		};
+
+		static_assert(sizeof(Chunk) <= ChunkSize, "Chunk does not fit into its power-of-two block");
+
+		// Producer that overflowed a chunk first links a new chunk, other producers wait until it is linked
+		Chunk* AcquireNextChunk(Chunk* full_chunk, uint32 overflow_index) {
+			if (overflow_index == CHUNK_CAPACITY) {
+				Chunk* new_chunk = AllocateChunk();
+				new_chunk->previous = full_chunk;
+
+				full_chunk->next.store(new_chunk, std::memory_order_release);
+				m_Tail.store(new_chunk, std::memory_order_release);
+
+				return new_chunk;
+			}
+
+			Chunk* next_chunk = full_chunk->next.load(std::memory_order_acquire);
+			while (!next_chunk) {
+				std::this_thread::yield();
+				next_chunk = full_chunk->next.load(std::memory_order_acquire);
+			}
+
+			return next_chunk;
+		}
+
+		// Returns number of elements in a chunk, waits until producers finish constructing them
+		uint32 WaitForCommittedElements(Chunk* chunk) const {
+			uint32 num_elements = std::min(chunk->num_reserved.load(std::memory_order_relaxed), CHUNK_CAPACITY);
+
+			// Producer may still be constructing an element it has reserved a slot for
+			while (chunk->num_committed.load(std::memory_order_acquire) != num_elements) {
+				std::this_thread::yield();
+			}
+
+			return num_elements;
+		}
+
+		// Makes the first chunk empty and the only one in the queue
+		void ResetHead() {
+			if (m_Head) {
+				m_Head->num_reserved.store(0, std::memory_order_relaxed);
+				m_Head->num_committed.store(0, std::memory_order_relaxed);
+				m_Head->next.store(nullptr, std::memory_order_relaxed);
+				m_Tail.store(m_Head, std::memory_order_release);
+			}
+		}
+
+		Chunk* AllocateChunk() {
+			MemoryAllocation allocation = m_Allocator->AllocateBase(sizeof(Chunk));
+			OMNIFORCE_ASSERT_TAGGED(allocation.IsValid(), "Failed to allocate queue chunk");
+
+			Chunk* chunk = new (allocation.Memory) Chunk();
+			chunk->allocation = allocation;
+
+			return chunk;
+		}
+
+		void FreeChunk(Chunk* chunk) {
+			MemoryAllocation allocation = chunk->allocation;
+			chunk->~Chunk();
+
+			m_Allocator->FreeBase(allocation);
+		}
+
+		void Release() {
+			if (!m_Head) {
+				return;
+			}
+
+			Clear();
+			FreeChunk(m_Head);
+
+			m_Head = nullptr;
+			m_Tail.store(nullptr, std::memory_order_relaxed);
+		}
+
+	private:
+		IAllocator* m_Allocator;
+		Chunk* m_Head = nullptr; // Consumer side, the oldest chunk
+		alignas(64) Atomic<Chunk*> m_Tail = nullptr; // Producer side, the chunk elements are pushed to
+	};
+
+}
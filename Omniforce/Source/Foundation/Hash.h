@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+
+#include <robin_hood.h>
+
+namespace Omni {
+
+	/*
+	*	@brief Hasher used by engine hash maps. Forwards to robin_hood's hash, which mixes bits of a key
+	*/
+	template<typename T>
+	struct Hash {
+		uint64 operator()(const T& value) const {
+			return robin_hood::hash<T>()(value);
+		}
+	};
+
+	// UUID is already a random 64-bit value, so it is used as a hash as-is
+	template<>
+	struct Hash<UUID> {
+		uint64 operator()(const UUID& uuid) const {
+			return uuid.Get();
+		}
+	};
+
+	// Finalizer of MurmurHash3, spreads entropy of all input bits over the whole value
+	inline constexpr uint64 MixHash(uint64 value) {
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ull;
+		value ^= value >> 33;
+
+		return value;
+	}
+
+}
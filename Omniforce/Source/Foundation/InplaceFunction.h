@@ -0,0 +1,137 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+#include <Foundation/Assert.h>
+
+#include <type_traits>
+#include <functional>
+#include <utility>
+#include <cstring>
+#include <new>
+
+namespace Omni {
+
+	template<typename TSignature, uint32 Capacity = 48>
+	class InplaceFunction;
+
+	/*
+	*	@brief Move-only type-erased callable which stores the callable inside of the object itself and never allocates.
+	*	Callables that do not fit into `Capacity` bytes are rejected at compile time.
+	*	Trivially copyable callables (e.g. lambdas that capture raw pointers and handles by value) are moved with `memcpy`
+	*/
+	template<typename TResult, typename... TArgs, uint32 Capacity>
+	class OMNIFORCE_API InplaceFunction<TResult(TArgs...), Capacity> {
+	public:
+		inline static constexpr uint64 ALIGNMENT = 16;
+
+		InplaceFunction() = default;
+
+		InplaceFunction(std::nullptr_t) {}
+
+		template<typename TCallable>
+			requires (!std::is_same_v<std::decay_t<TCallable>, InplaceFunction> && std::is_invocable_r_v<TResult, std::decay_t<TCallable>&, TArgs...>)
+		InplaceFunction(TCallable&& callable) {
+			using TStored = std::decay_t<TCallable>;
+
+			static_assert(sizeof(TStored) <= Capacity, "Callable does not fit into inplace function storage, increase capacity or capture less");
+			static_assert(alignof(TStored) <= ALIGNMENT, "Callable is over-aligned for inplace function storage");
+			static_assert(std::is_nothrow_move_constructible_v<TStored>, "Callable must be nothrow move constructible");
+
+			new (m_Storage) TStored(std::forward<TCallable>(callable));
+
+			m_Invoke = [](void* storage, TArgs&&... args) -> TResult {
+				return std::invoke(*(TStored*)storage, std::forward<TArgs>(args)...);
+			};
+
+			if constexpr (!std::is_trivially_copyable_v<TStored>) {
+				m_Manage = [](Operation operation, void* destination, void* source) {
+					if (operation == Operation::MOVE) {
+						new (destination) TStored(std::move(*(TStored*)source));
+					}
+					((TStored*)source)->~TStored();
+				};
+			}
+		}
+
+		InplaceFunction(const InplaceFunction&) = delete;
+
+		InplaceFunction(InplaceFunction&& other) noexcept {
+			Steal(other);
+		}
+
+		~InplaceFunction() {
+			Reset();
+		}
+
+		InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+		InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+			if (this != &other) {
+				Reset();
+				Steal(other);
+			}
+
+			return *this;
+		}
+
+		InplaceFunction& operator=(std::nullptr_t) {
+			Reset();
+			return *this;
+		}
+
+		TResult operator()(TArgs... args) {
+			OMNIFORCE_ASSERT_TAGGED(m_Invoke, "Attempted to invoke an empty inplace function");
+			return m_Invoke(m_Storage, std::forward<TArgs>(args)...);
+		}
+
+		inline explicit operator bool() const {
+			return m_Invoke != nullptr;
+		}
+
+		// Destroys the stored callable
+		void Reset() {
+			if (m_Manage) {
+				m_Manage(Operation::DESTROY, nullptr, m_Storage);
+			}
+
+			m_Invoke = nullptr;
+			m_Manage = nullptr;
+		}
+
+	private:
+		enum class Operation : uint8 {
+			MOVE, // Move-constructs callable into destination and destroys the source one
+			DESTROY
+		};
+
+		using InvokeFunction = TResult(*)(void* storage, TArgs&&... args);
+		using ManageFunction = void(*)(Operation operation, void* destination, void* source);
+
+		// Assumes this function is empty
+		void Steal(InplaceFunction& other) {
+			if (!other.m_Invoke) {
+				return;
+			}
+
+			if (other.m_Manage) {
+				other.m_Manage(Operation::MOVE, m_Storage, other.m_Storage);
+			}
+			else {
+				memcpy(m_Storage, other.m_Storage, Capacity);
+			}
+
+			m_Invoke = other.m_Invoke;
+			m_Manage = other.m_Manage;
+
+			other.m_Invoke = nullptr;
+			other.m_Manage = nullptr;
+		}
+
+	private:
+		alignas(ALIGNMENT) byte m_Storage[Capacity];
+		InvokeFunction m_Invoke = nullptr;
+		ManageFunction m_Manage = nullptr; // Null for trivially copyable callables, they need no move or destruction logic
+	};
+
+}
@@ -0,0 +1,335 @@
+#include <Foundation/Log/AsyncLogger.h>
+#include <Foundation/Assert.h>
+
+#include <algorithm>
+
+#include <spdlog/details/os.h>
+
+namespace Omni {
+
+	static constexpr uint64 AlignRecordSize(uint64 size) {
+		return (size + 7) & ~7ull;
+	}
+
+	LogRingBuffer::LogRingBuffer(uint64 capacity)
+		: m_Data(new byte[capacity])
+		, m_Capacity(capacity)
+		, m_ThreadID(spdlog::details::os::thread_id())
+	{}
+
+	byte* LogRingBuffer::TryReserve(uint64 size)
+	{
+		uint64 write_position = m_WritePosition.load(std::memory_order_relaxed);
+		uint64 offset = write_position & (m_Capacity - 1);
+		uint64 contiguous_size = m_Capacity - offset;
+
+		// If record doesn't fit into the tail, the tail is skipped
+		uint64 padding = contiguous_size < size ? contiguous_size : 0;
+		uint64 required_end = write_position + padding + size;
+
+		if (required_end - m_CachedReadPosition > m_Capacity) {
+			m_CachedReadPosition = m_ReadPosition.load(std::memory_order_acquire);
+
+			if (required_end - m_CachedReadPosition > m_Capacity)
+				return nullptr;
+		}
+
+		if (padding) {
+			uint64 padding_marker = padding | PADDING_BIT;
+			memcpy(m_Data.get() + offset, &padding_marker, sizeof(padding_marker));
+			offset = 0;
+		}
+
+		m_PendingPadding = padding;
+		m_PendingSize = size;
+
+		return m_Data.get() + offset;
+	}
+
+	void LogRingBuffer::Commit()
+	{
+		uint64 write_position = m_WritePosition.load(std::memory_order_relaxed);
+		m_WritePosition.store(write_position + m_PendingPadding + m_PendingSize, std::memory_order_release);
+	}
+
+	/*
+	*	@brief Per-thread handle to a ring buffer. Holds a reference, so the buffer outlives either the thread or
+	*	the logger, whichever goes first. Marks buffer as retired on thread exit.
+	*/
+	struct AsyncLoggerThreadSlot {
+		std::shared_ptr<LogRingBuffer> buffer;
+		uint64 logger_id = UINT64_MAX;
+
+		~AsyncLoggerThreadSlot() {
+			if (buffer)
+				buffer->Retire();
+		}
+	};
+
+	static thread_local AsyncLoggerThreadSlot t_ThreadSlot;
+	static Atomic<uint64> s_AsyncLoggerIDCounter = 0;
+
+	AsyncLogger::AsyncLogger(const AsyncLoggerSpecification& spec, spdlog::logger* diagnostics_logger)
+		: m_Specification(spec)
+		, m_DiagnosticsLogger(diagnostics_logger)
+		, m_ID(s_AsyncLoggerIDCounter.fetch_add(1, std::memory_order_relaxed))
+	{
+		OMNIFORCE_ASSERT_TAGGED(std::has_single_bit(spec.thread_buffer_size), "Async logger buffer size must be a power of two");
+
+		m_Worker = std::thread([this]() { WorkerLoop(); });
+	}
+
+	AsyncLogger::~AsyncLogger()
+	{
+		m_Running.store(false, std::memory_order_release);
+		Wake();
+		m_Worker.join();
+	}
+
+	void AsyncLogger::Flush()
+	{
+		// Can't wait for itself, e.g. if a sink logs something
+		if (std::this_thread::get_id() == m_Worker.get_id())
+			return;
+
+		std::vector<std::pair<std::shared_ptr<LogRingBuffer>, uint64>> targets;
+		{
+			std::lock_guard lock(m_BuffersMutex);
+
+			targets.reserve(m_Buffers.size());
+			for (auto& buffer : m_Buffers)
+				targets.push_back({ buffer, buffer->GetWritePosition() });
+		}
+
+		for (auto& [buffer, position] : targets) {
+			while (buffer->GetReadPosition() < position) {
+				Wake();
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void AsyncLogger::AddSink(spdlog::logger* logger, spdlog::sink_ptr sink)
+	{
+		std::lock_guard lock(m_SinksMutex);
+		logger->sinks().push_back(std::move(sink));
+	}
+
+	void AsyncLogger::FormatPreformattedRecord(const byte* payload, spdlog::memory_buf_t& out)
+	{
+		std::string_view message = LogArgumentCodec<std::string_view>::Decode(payload);
+		out.append(message.data(), message.data() + message.size());
+	}
+
+	void AsyncLogger::LogFormatted(spdlog::logger* logger, spdlog::level::level_enum level, std::string_view message)
+	{
+		byte* cursor = BeginRecord(logger, level, &FormatPreformattedRecord, LogArgumentCodec<std::string_view>::GetEncodedSize(message));
+
+		if (!cursor)
+			return;
+
+		LogArgumentCodec<std::string_view>::Encode(cursor, message);
+
+		EndRecord(level);
+	}
+
+	byte* AsyncLogger::BeginRecord(spdlog::logger* logger, spdlog::level::level_enum level, AsyncLogRecord::FormatFunction format, uint64 payload_size)
+	{
+		LogRingBuffer* buffer = GetThreadBuffer();
+		uint64 record_size = AlignRecordSize(sizeof(AsyncLogRecord) + payload_size);
+
+		// Huge records could never fit, e.g. if an entire file is logged
+		if (record_size > buffer->GetCapacity() / 2) {
+			m_NumDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		// Errors are never dropped
+		bool blocking = m_Specification.overflow_policy == AsyncLogOverflowPolicy::BLOCK || level >= spdlog::level::err;
+
+		byte* memory = buffer->TryReserve(record_size);
+
+		while (!memory) {
+			if (!blocking) {
+				m_NumDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Wake();
+			std::this_thread::yield();
+
+			memory = buffer->TryReserve(record_size);
+		}
+
+		AsyncLogRecord* record = (AsyncLogRecord*)memory;
+		record->size = record_size;
+		record->format = format;
+		record->logger = logger;
+		record->time = spdlog::log_clock::now();
+		record->level = level;
+
+		return memory + sizeof(AsyncLogRecord);
+	}
+
+	void AsyncLogger::EndRecord(spdlog::level::level_enum level)
+	{
+		t_ThreadSlot.buffer->Commit();
+
+		if (level >= spdlog::level::err)
+			Flush();
+	}
+
+	LogRingBuffer* AsyncLogger::GetThreadBuffer()
+	{
+		if (t_ThreadSlot.logger_id == m_ID)
+			return t_ThreadSlot.buffer.get();
+
+		// First record from this thread, or the thread was writing into another logger before
+		if (t_ThreadSlot.buffer)
+			t_ThreadSlot.buffer->Retire();
+
+		t_ThreadSlot.buffer = std::make_shared<LogRingBuffer>(m_Specification.thread_buffer_size);
+		t_ThreadSlot.logger_id = m_ID;
+
+		std::lock_guard lock(m_BuffersMutex);
+		m_Buffers.push_back(t_ThreadSlot.buffer);
+		m_BuffersVersion.fetch_add(1, std::memory_order_release);
+
+		return t_ThreadSlot.buffer.get();
+	}
+
+	void AsyncLogger::Wake()
+	{
+		{
+			std::lock_guard lock(m_WakeMutex);
+			m_WakeRequested = true;
+		}
+		m_WakeCondition.notify_one();
+	}
+
+	void AsyncLogger::WorkerLoop()
+	{
+		while (m_Running.load(std::memory_order_acquire)) {
+			if (ProcessRecords())
+				continue;
+
+			std::unique_lock lock(m_WakeMutex);
+			m_WakeCondition.wait_for(lock, std::chrono::microseconds(m_Specification.idle_sleep_microseconds), [this]() {
+				return m_WakeRequested;
+			});
+			m_WakeRequested = false;
+		}
+
+		// Drain whatever is left
+		while (ProcessRecords());
+	}
+
+	bool AsyncLogger::ProcessRecords()
+	{
+		// Refresh buffer list only if a thread has registered a new buffer
+		uint64 buffers_version = m_BuffersVersion.load(std::memory_order_acquire);
+
+		if (buffers_version != m_ConsumerBuffersVersion) {
+			std::lock_guard lock(m_BuffersMutex);
+
+			m_ConsumerBuffers = m_Buffers;
+			m_ConsumerBuffersVersion = m_BuffersVersion.load(std::memory_order_relaxed);
+		}
+
+		m_PendingRecords.clear();
+		m_ConsumerReleasePositions.resize(m_ConsumerBuffers.size());
+
+		// Collect all committed records
+		for (uint64 i = 0; i < m_ConsumerBuffers.size(); i++) {
+			LogRingBuffer* buffer = m_ConsumerBuffers[i].get();
+
+			uint64 position = buffer->GetReadPosition();
+			uint64 end = buffer->GetWritePosition();
+
+			while (position != end) {
+				const byte* data = buffer->GetData(position);
+
+				uint64 size;
+				memcpy(&size, data, sizeof(size));
+
+				if (!(size & LogRingBuffer::PADDING_BIT))
+					m_PendingRecords.push_back({ (const AsyncLogRecord*)data, buffer->GetThreadID() });
+
+				position += size & ~LogRingBuffer::PADDING_BIT;
+			}
+
+			m_ConsumerReleasePositions[i] = position;
+		}
+
+		// Merge records from different threads in submission order
+		std::stable_sort(m_PendingRecords.begin(), m_PendingRecords.end(), [](const PendingRecord& lhs, const PendingRecord& rhs) {
+			return lhs.record->time < rhs.record->time;
+		});
+
+		spdlog::memory_buf_t formatted_message;
+
+		std::unique_lock sinks_lock(m_SinksMutex);
+
+		for (const PendingRecord& pending_record : m_PendingRecords) {
+			const AsyncLogRecord* record = pending_record.record;
+
+			formatted_message.clear();
+
+			try {
+				record->format((const byte*)record + sizeof(AsyncLogRecord), formatted_message);
+			}
+			catch (const std::exception& e) {
+				formatted_message.clear();
+				fmt::format_to(fmt::appender(formatted_message), "Failed to format log record: {}", e.what());
+			}
+
+			spdlog::details::log_msg message(
+				record->time,
+				spdlog::source_loc{},
+				record->logger->name(),
+				record->level,
+				spdlog::string_view_t(formatted_message.data(), formatted_message.size())
+			);
+			message.thread_id = pending_record.thread_id;
+
+			for (auto& sink : record->logger->sinks()) {
+				if (sink->should_log(message.level))
+					sink->log(message);
+			}
+		}
+
+		sinks_lock.unlock();
+
+		// Give memory back to producers and remove buffers of exited threads
+		bool buffers_removed = false;
+
+		for (uint64 i = 0; i < m_ConsumerBuffers.size(); i++) {
+			LogRingBuffer* buffer = m_ConsumerBuffers[i].get();
+			buffer->Release(m_ConsumerReleasePositions[i]);
+
+			if (buffer->IsRetired() && buffer->GetReadPosition() == buffer->GetWritePosition()) {
+				std::lock_guard lock(m_BuffersMutex);
+				std::erase(m_Buffers, m_ConsumerBuffers[i]);
+				buffers_removed = true;
+			}
+		}
+
+		if (buffers_removed)
+			m_BuffersVersion.fetch_add(1, std::memory_order_release);
+
+		// Report dropped records
+		uint64 num_dropped_records = m_NumDroppedRecords.load(std::memory_order_relaxed);
+
+		if (num_dropped_records != m_NumReportedDroppedRecords && m_DiagnosticsLogger) {
+			std::string message = fmt::format("Async logger dropped {} records, log buffers are full", num_dropped_records - m_NumReportedDroppedRecords);
+
+			std::lock_guard lock(m_SinksMutex);
+			m_DiagnosticsLogger->log(spdlog::level::warn, message);
+
+			m_NumReportedDroppedRecords = num_dropped_records;
+		}
+
+		return !m_PendingRecords.empty();
+	}
+
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <tuple>
+#include <array>
+#include <bit>
+#include <string_view>
+#include <type_traits>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+namespace Omni {
+
+	enum class AsyncLogOverflowPolicy : uint8 {
+		DROP,	// Record is discarded if thread's buffer is full, number of dropped records is reported by the background thread
+		BLOCK	// Caller waits until background thread frees enough space
+	};
+
+	struct AsyncLoggerSpecification {
+		uint64 thread_buffer_size = 256 * 1024; // Size of a per-thread ring buffer in bytes, must be a power of two
+		AsyncLogOverflowPolicy overflow_policy = AsyncLogOverflowPolicy::DROP;
+		uint32 idle_sleep_microseconds = 500; // How long background thread sleeps if there are no records
+	};
+
+	/*
+	*	@brief Header of a record in a log ring buffer, followed by a binary payload:
+	*	format string and arguments encoded with `LogArgumentCodec`.
+	*/
+	struct AsyncLogRecord {
+		using FormatFunction = void(*)(const byte* payload, spdlog::memory_buf_t& out);
+
+		uint64 size; // Size of the whole record including header, 8-byte aligned
+		FormatFunction format;
+		spdlog::logger* logger;
+		spdlog::log_clock::time_point time;
+		spdlog::level::level_enum level;
+	};
+
+	/*
+	*	@brief Single-producer single-consumer byte ring buffer. Records are 8-byte aligned and never wrap around,
+	*	if a record does not fit into the tail of the buffer, the tail is skipped with a padding marker.
+	*	Every record starts with a 64-bit size, padding marker is a size with `PADDING_BIT` set.
+	*/
+	class OMNIFORCE_API LogRingBuffer {
+	public:
+		inline static constexpr uint64 PADDING_BIT = 1ull << 63;
+
+		LogRingBuffer(uint64 capacity);
+
+		// Producer side. @return pointer to `size` bytes of contiguous memory, nullptr if there is not enough free space
+		byte* TryReserve(uint64 size);
+		// Publishes last reserved record to consumer
+		void Commit();
+
+		// Consumer side
+		uint64 GetReadPosition() const { return m_ReadPosition.load(std::memory_order_acquire); }
+		uint64 GetWritePosition() const { return m_WritePosition.load(std::memory_order_acquire); }
+		const byte* GetData(uint64 position) const { return m_Data.get() + (position & (m_Capacity - 1)); }
+		void Release(uint64 position) { m_ReadPosition.store(position, std::memory_order_release); }
+
+		uint64 GetCapacity() const { return m_Capacity; }
+		uint64 GetThreadID() const { return m_ThreadID; }
+
+		// Marks that owner thread has exited, so the buffer can be freed as soon as it is drained
+		void Retire() { m_Retired.store(true, std::memory_order_release); }
+		bool IsRetired() const { return m_Retired.load(std::memory_order_acquire); }
+
+	private:
+		std::unique_ptr<byte[]> m_Data;
+		uint64 m_Capacity;
+		uint64 m_ThreadID;
+		Atomic<bool> m_Retired = false;
+
+		// Producer-owned
+		alignas(64) Atomic<uint64> m_WritePosition = 0;
+		uint64 m_CachedReadPosition = 0;
+		uint64 m_PendingPadding = 0;
+		uint64 m_PendingSize = 0;
+
+		// Consumer-owned
+		alignas(64) Atomic<uint64> m_ReadPosition = 0;
+	};
+
+	/*
+	*	@brief Binary encoding of a log argument. Strings are copied into the payload, arithmetic values, enums and raw pointers
+	*	(printed as addresses) are copied as is and formatted later on the background thread. Other types, including
+	*	trivially copyable views like `std::span`, may reference memory which is gone by then, so records with such arguments
+	*	are formatted on the calling thread.
+	*/
+	template<typename T>
+	struct LogArgumentCodec {
+		inline static constexpr bool IS_STRING = std::is_convertible_v<const T&, std::string_view>;
+		inline static constexpr bool DEFERRED = IS_STRING || std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+		using DecodedType = std::conditional_t<IS_STRING, std::string_view, T>;
+
+		static uint64 GetEncodedSize(const T& value) {
+			if constexpr (IS_STRING)
+				return sizeof(uint32) + ToStringView(value).size();
+			else
+				return sizeof(T);
+		}
+
+		static void Encode(byte*& cursor, const T& value) {
+			if constexpr (IS_STRING) {
+				std::string_view string = ToStringView(value);
+				uint32 length = (uint32)string.size();
+
+				memcpy(cursor, &length, sizeof(length));
+				memcpy(cursor + sizeof(length), string.data(), length);
+				cursor += sizeof(length) + length;
+			}
+			else {
+				memcpy(cursor, &value, sizeof(T));
+				cursor += sizeof(T);
+			}
+		}
+
+		static DecodedType Decode(const byte*& cursor) {
+			if constexpr (IS_STRING) {
+				uint32 length;
+				memcpy(&length, cursor, sizeof(length));
+
+				std::string_view string((const char*)cursor + sizeof(length), length);
+				cursor += sizeof(length) + length;
+
+				return string;
+			}
+			else {
+				std::array<byte, sizeof(T)> bytes;
+				memcpy(bytes.data(), cursor, sizeof(T));
+				cursor += sizeof(T);
+
+				return std::bit_cast<T>(bytes);
+			}
+		}
+
+	private:
+		// Constructing a string view from a null C string is undefined
+		static std::string_view ToStringView(const T& value) {
+			if constexpr (std::is_pointer_v<T>) {
+				if (!value)
+					return "(null)";
+			}
+
+			return std::string_view(value);
+		}
+	};
+
+	/*
+	*	@brief Asynchronous logging backend. Every thread writes records into its own lock-free ring buffer,
+	*	a background thread collects records from all buffers, formats them in timestamp order and passes them
+	*	to sinks of a target spdlog logger. Error and critical records are never dropped and are flushed
+	*	before the call returns, so they are visible before an assertion breaks into debugger.
+	*/
+	class OMNIFORCE_API AsyncLogger {
+	public:
+		AsyncLogger(const AsyncLoggerSpecification& spec, spdlog::logger* diagnostics_logger);
+		~AsyncLogger();
+
+		template<typename... TArgs>
+		void Log(spdlog::logger* logger, spdlog::level::level_enum level, fmt::format_string<TArgs...> format, TArgs&&... args) {
+			if constexpr ((LogArgumentCodec<std::remove_cvref_t<TArgs>>::DEFERRED && ...)) {
+				fmt::string_view format_view = format;
+				std::string_view format_string(format_view.data(), format_view.size());
+
+				uint64 payload_size = LogArgumentCodec<std::string_view>::GetEncodedSize(format_string);
+				((payload_size += LogArgumentCodec<std::remove_cvref_t<TArgs>>::GetEncodedSize(args)), ...);
+
+				byte* cursor = BeginRecord(logger, level, &FormatRecord<std::remove_cvref_t<TArgs>...>, payload_size);
+
+				if (!cursor)
+					return;
+
+				LogArgumentCodec<std::string_view>::Encode(cursor, format_string);
+				(LogArgumentCodec<std::remove_cvref_t<TArgs>>::Encode(cursor, args), ...);
+
+				EndRecord(level);
+			}
+			else {
+				LogFormatted(logger, level, fmt::format(format, std::forward<TArgs>(args)...));
+			}
+		}
+
+		// Blocks until all records submitted before the call are passed to sinks
+		void Flush();
+
+		// Sinks are used by the background thread, so sinks of a logger which logs through the backend must be added here
+		void AddSink(spdlog::logger* logger, spdlog::sink_ptr sink);
+
+		uint64 GetNumDroppedRecords() const { return m_NumDroppedRecords.load(std::memory_order_relaxed); }
+
+	private:
+		template<typename... TArgs>
+		static void FormatRecord(const byte* payload, spdlog::memory_buf_t& out) {
+			std::string_view format = LogArgumentCodec<std::string_view>::Decode(payload);
+
+			// Braced initialization guarantees left-to-right decoding order
+			std::tuple<typename LogArgumentCodec<TArgs>::DecodedType...> arguments{ LogArgumentCodec<TArgs>::Decode(payload)... };
+
+			std::apply([&](auto&... arguments) {
+				fmt::vformat_to(fmt::appender(out), format, fmt::make_format_args(arguments...));
+			}, arguments);
+		}
+
+		static void FormatPreformattedRecord(const byte* payload, spdlog::memory_buf_t& out);
+
+		void LogFormatted(spdlog::logger* logger, spdlog::level::level_enum level, std::string_view message);
+
+		// @return cursor to write payload to, nullptr if the record was dropped
+		byte* BeginRecord(spdlog::logger* logger, spdlog::level::level_enum level, AsyncLogRecord::FormatFunction format, uint64 payload_size);
+		void EndRecord(spdlog::level::level_enum level);
+
+		LogRingBuffer* GetThreadBuffer();
+
+		void WorkerLoop();
+		bool ProcessRecords();
+		void Wake();
+
+	private:
+		struct PendingRecord {
+			const AsyncLogRecord* record;
+			uint64 thread_id;
+		};
+
+		AsyncLoggerSpecification m_Specification;
+		spdlog::logger* m_DiagnosticsLogger;
+		uint64 m_ID;
+
+		// Registered thread buffers, guarded by mutex. Threads only take the lock once, when their buffer is created
+		std::mutex m_BuffersMutex;
+		std::vector<std::shared_ptr<LogRingBuffer>> m_Buffers;
+		Atomic<uint64> m_BuffersVersion = 0;
+
+		// Guards sink lists of target loggers, held by the background thread while it passes records to sinks
+		std::mutex m_SinksMutex;
+
+		Atomic<uint64> m_NumDroppedRecords = 0;
+		uint64 m_NumReportedDroppedRecords = 0;
+
+		// Background thread state
+		std::vector<std::shared_ptr<LogRingBuffer>> m_ConsumerBuffers;
+		std::vector<uint64> m_ConsumerReleasePositions;
+		std::vector<PendingRecord> m_PendingRecords;
+		uint64 m_ConsumerBuffersVersion = UINT64_MAX;
+
+		std::mutex m_WakeMutex;
+		std::condition_variable m_WakeCondition;
+		bool m_WakeRequested = false;
+		Atomic<bool> m_Running = true;
+		std::thread m_Worker;
+	};
+
+}
@@ -4,8 +4,9 @@
 
 #include <spdlog/sinks/ringbuffer_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
-#include <spdlog/sinks/dist_sink.h>
-#include <spdlog/sinks/basic_file_sink.h>
+
+#include <fstream>
+#include <filesystem>
 
 namespace Omni {
 
@@ -37,11 +38,14 @@ namespace Omni {
 		}
 	}
 
-	Logger::Logger(Level level)
-	{;
+	Logger::Logger(Level level, bool async, const AsyncLoggerSpecification& async_spec)
+	{
 		auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
 
-		spdlog::sinks_init_list sink_list = { console_sink };
+		// Keeps last messages, so they can be dumped into a file on crash
+		m_CrashLogSink = std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(128);
+
+		spdlog::sinks_init_list sink_list = { console_sink, m_CrashLogSink };
 
 		m_CoreLogger = std::make_shared<spdlog::logger>("Omniforce", sink_list);
 		m_ClientLogger = std::make_shared<spdlog::logger>("Client", sink_list);
@@ -50,16 +54,20 @@ namespace Omni {
 		m_ClientLogger->set_pattern("%^[%T][%n][%l]: %v%$");
 
 		m_CoreLogger->set_level(OmniToSpdlogLevel(level));
+
+		if (async)
+			m_AsyncLogger = std::make_unique<AsyncLogger>(async_spec, m_CoreLogger.get());
 	}
 
 	Logger::~Logger()
 	{
-
+		// Drains pending records and stops background thread
+		m_AsyncLogger.reset();
 	}
 
-	void Logger::Init(Level level)
+	void Logger::Init(Level level, bool async, const AsyncLoggerSpecification& async_spec)
 	{
-		s_Instance = new Logger(level);
+		s_Instance = new Logger(level, async, async_spec);
 	}
 
 	void Logger::Shutdown()
@@ -67,26 +75,43 @@ namespace Omni {
 		delete s_Instance;
 	}
 
-	void Logger::WriteLogFile() const
+	void Logger::SetClientLoggerSink(LogPtr<spdlog::sinks::base_sink<std::mutex>> sink)
 	{
-		std::string filename = fmt::format("logs/crash_log_{}.txt", Utils::EvaluateDatetime());
-		auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(filename);
+		if (s_Instance->m_AsyncLogger)
+			s_Instance->m_AsyncLogger->AddSink(s_Instance->m_ClientLogger.get(), std::move(sink));
+		else
+			s_Instance->m_ClientLogger->sinks().push_back(std::move(sink));
+	}
 
-		auto distribute_sink = std::static_pointer_cast<spdlog::sinks::dist_sink_mt>(m_FileLogger->sinks()[0]);
-		auto ring_buffer = std::static_pointer_cast<spdlog::sinks::ringbuffer_sink_mt>(m_CoreLogger->sinks()[0]);
+	void Logger::Flush()
+	{
+		if (m_AsyncLogger)
+			m_AsyncLogger->Flush();
 
-		std::vector<std::string> messages = ring_buffer->last_formatted(128);
+		m_CoreLogger->flush();
+		m_ClientLogger->flush();
+	}
 
-		distribute_sink->add_sink(file_sink);
-		m_FileLogger->set_pattern("%v");
+	void Logger::WriteLogFile()
+	{
+		std::string filename = fmt::format("logs/crash_log_{}.txt", Utils::EvaluateDatetime());
 
 		OMNIFORCE_CORE_WARNING("Generating engine dump: {}", filename);
 
-		for (auto& msg : messages) {
-			m_FileLogger->critical(msg);
+		Flush();
+
+		std::error_code error;
+		std::filesystem::create_directories("logs", error);
+
+		std::ofstream file_stream(filename);
+
+		if (!file_stream.is_open()) {
+			OMNIFORCE_CORE_ERROR("Failed to open crash log file \"{}\" {}", filename, error ? error.message() : std::string());
+			return;
 		}
 
-		distribute_sink->remove_sink(file_sink);
+		for (const auto& message : m_CrashLogSink->last_formatted())
+			file_stream << message;
 	}
 
 }
\ No newline at end of file
@@ -2,9 +2,11 @@
 
 #include <Foundation/Platform.h>
 #include <Foundation/BasicTypes.h>
+#include <Foundation/Log/AsyncLogger.h>
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/ringbuffer_sink.h>
 
 namespace Omni {
 
@@ -43,79 +45,102 @@ namespace Omni {
 			}
 		}
 
-		static void Init(Level level);
+		// In async mode log calls only capture arguments, formatting and writing is done on a background thread
+		static void Init(Level level, bool async = true, const AsyncLoggerSpecification& async_spec = {});
 		static void Shutdown();
 		static Logger* Get() { return s_Instance; }
 		static LogPtr<spdlog::logger> GetCoreLogger() { return s_Instance->m_CoreLogger; };
 		static LogPtr<spdlog::logger> GetClientLogger() { return s_Instance->m_ClientLogger; };
 		static LogPtr<spdlog::logger> GetLoggerByName(std::string_view name) { return spdlog::get(name.data()); }
 		static void AddLogger(LogPtr<spdlog::logger> logger) { spdlog::register_logger(logger); }
-		static void SetClientLoggerSink(LogPtr<spdlog::sinks::base_sink<std::mutex>> sink) { s_Instance->m_ClientLogger->sinks().push_back(sink); }
+		static void SetClientLoggerSink(LogPtr<spdlog::sinks::base_sink<std::mutex>> sink);
 		
 		// Core logging API
 		template<typename... Args>
-		void Trace(Args... args)			{ m_CoreLogger->trace(args...); }
+		void Trace(fmt::format_string<Args...> format, Args&&... args)			{ Log(m_CoreLogger.get(), spdlog::level::trace, format, std::forward<Args>(args)...); }
 
 		template<typename... Args>
-		void Info(Args... args)				{ m_CoreLogger->info(args...); }
+		void Info(fmt::format_string<Args...> format, Args&&... args)			{ Log(m_CoreLogger.get(), spdlog::level::info, format, std::forward<Args>(args)...); }
 		
 		template<typename... Args>
-		void Warn(Args... args)				{ m_CoreLogger->warn(args...); }
+		void Warn(fmt::format_string<Args...> format, Args&&... args)			{ Log(m_CoreLogger.get(), spdlog::level::warn, format, std::forward<Args>(args)...); }
 
 		template<typename... Args>
-		void Error(Args... args)			{ m_CoreLogger->error(args...); }
+		void Error(fmt::format_string<Args...> format, Args&&... args)			{ Log(m_CoreLogger.get(), spdlog::level::err, format, std::forward<Args>(args)...); }
 
 		template<typename... Args>
-		void Critical(Args... args)			{ m_CoreLogger->critical(args...); }
+		void Critical(fmt::format_string<Args...> format, Args&&... args)		{ Log(m_CoreLogger.get(), spdlog::level::critical, format, std::forward<Args>(args)...); }
 
 
 		// Client logging API
 		template<typename... Args>
-		void ClientTrace(Args... args)		{ m_ClientLogger->trace(args...); }
+		void ClientTrace(fmt::format_string<Args...> format, Args&&... args)		{ Log(m_ClientLogger.get(), spdlog::level::trace, format, std::forward<Args>(args)...); }
 
 		template<typename... Args>
-		void ClientInfo(Args... args)		{ m_ClientLogger->info(args...); }
+		void ClientInfo(fmt::format_string<Args...> format, Args&&... args)		{ Log(m_ClientLogger.get(), spdlog::level::info, format, std::forward<Args>(args)...); }
 
 		template<typename... Args>
-		void ClientWarn(Args... args)		{ m_ClientLogger->warn(args...); }
+		void ClientWarn(fmt::format_string<Args...> format, Args&&... args)		{ Log(m_ClientLogger.get(), spdlog::level::warn, format, std::forward<Args>(args)...); }
 
 		template<typename... Args>
-		void ClientError(Args... args)		{ m_ClientLogger->error(args...); }
+		void ClientError(fmt::format_string<Args...> format, Args&&... args)		{ Log(m_ClientLogger.get(), spdlog::level::err, format, std::forward<Args>(args)...); }
 
 		template<typename... Args>
-		void ClientCritical(Args... args)	{ m_ClientLogger->critical(args...); }
+		void ClientCritical(fmt::format_string<Args...> format, Args&&... args)	{ Log(m_ClientLogger.get(), spdlog::level::critical, format, std::forward<Args>(args)...); }
 
-		// Flushing logs into a file could be not efficient enough, 
-		// since I recreate file sink every time engine initiates logging into a file
-		void WriteLogFile() const;
+		// Logging API of loggers registered with `AddLogger`, e.g. editor and game loggers
+		template<typename... Args>
+		void Custom(std::string_view logger_name, spdlog::level::level_enum level, fmt::format_string<Args...> format, Args&&... args) {
+			if (LogPtr<spdlog::logger> logger = GetLoggerByName(logger_name))
+				Log(logger.get(), level, format, std::forward<Args>(args)...);
+		}
+
+		// Blocks until all pending records are written to sinks
+		void Flush();
 
+		// Writes last messages into a crash log file
+		void WriteLogFile();
+
+		bool IsAsync() const { return m_AsyncLogger != nullptr; }
 	
-		Logger(Level level);
+		Logger(Level level, bool async, const AsyncLoggerSpecification& async_spec);
 		~Logger();
 
-	
+	private:
+		template<typename... Args>
+		void Log(spdlog::logger* logger, spdlog::level::level_enum level, fmt::format_string<Args...> format, Args&&... args) {
+			if (!logger->should_log(level))
+				return;
+
+			if (m_AsyncLogger)
+				m_AsyncLogger->Log(logger, level, format, std::forward<Args>(args)...);
+			else
+				logger->log(level, format, std::forward<Args>(args)...);
+		}
+
+	public:
 		static Logger* s_Instance;
 		LogPtr<spdlog::logger> m_CoreLogger;
 		LogPtr<spdlog::logger> m_ClientLogger;
-		LogPtr<spdlog::logger> m_FileLogger;
-		std::string m_LogBuffer;
+		LogPtr<spdlog::sinks::ringbuffer_sink_mt> m_CrashLogSink;
+		std::unique_ptr<AsyncLogger> m_AsyncLogger;
 	};
 
 #ifndef OMNIFORCE_RELEASE
 	#define OMNIFORCE_INITIALIZE_LOG_SYSTEM(log_level) Omni::Logger::Init(log_level);
 	#define OMNIFORCE_WRITE_LOGS_TO_FILE()		Omni::Logger::Get()->WriteLogFile();
 
-	#define OMNIFORCE_CORE_TRACE(...)			Omni::Logger::GetCoreLogger()->trace(__VA_ARGS__)
-	#define OMNIFORCE_CORE_INFO(...)			Omni::Logger::GetCoreLogger()->info(__VA_ARGS__)
-	#define OMNIFORCE_CORE_WARNING(...)			Omni::Logger::GetCoreLogger()->warn(__VA_ARGS__)
-	#define OMNIFORCE_CORE_ERROR(...)			Omni::Logger::GetCoreLogger()->error(__VA_ARGS__)
-	#define OMNIFORCE_CORE_CRITICAL(...)		Omni::Logger::GetCoreLogger()->critical(__VA_ARGS__)
-
-	#define OMNIFORCE_CLIENT_TRACE(...)			Omni::Logger::GetClientLogger()->trace(__VA_ARGS__)
-	#define OMNIFORCE_CLIENT_INFO(...)			Omni::Logger::GetClientLogger()->info(__VA_ARGS__)
-	#define OMNIFORCE_CLIENT_WARNING(...)		Omni::Logger::GetClientLogger()->warn(__VA_ARGS__)
-	#define OMNIFORCE_CLIENT_ERROR(...)			Omni::Logger::GetClientLogger()->error(__VA_ARGS__)
-	#define OMNIFORCE_CLIENT_CRITICAL(...)		Omni::Logger::GetClientLogger()->critical(__VA_ARGS__)
+	#define OMNIFORCE_CORE_TRACE(...)			Omni::Logger::Get()->Trace(__VA_ARGS__)
+	#define OMNIFORCE_CORE_INFO(...)			Omni::Logger::Get()->Info(__VA_ARGS__)
+	#define OMNIFORCE_CORE_WARNING(...)			Omni::Logger::Get()->Warn(__VA_ARGS__)
+	#define OMNIFORCE_CORE_ERROR(...)			Omni::Logger::Get()->Error(__VA_ARGS__)
+	#define OMNIFORCE_CORE_CRITICAL(...)		Omni::Logger::Get()->Critical(__VA_ARGS__)
+
+	#define OMNIFORCE_CLIENT_TRACE(...)			Omni::Logger::Get()->ClientTrace(__VA_ARGS__)
+	#define OMNIFORCE_CLIENT_INFO(...)			Omni::Logger::Get()->ClientInfo(__VA_ARGS__)
+	#define OMNIFORCE_CLIENT_WARNING(...)		Omni::Logger::Get()->ClientWarn(__VA_ARGS__)
+	#define OMNIFORCE_CLIENT_ERROR(...)			Omni::Logger::Get()->ClientError(__VA_ARGS__)
+	#define OMNIFORCE_CLIENT_CRITICAL(...)		Omni::Logger::Get()->ClientCritical(__VA_ARGS__)
 #else
 	#define OMNIFORCE_INITIALIZE_LOG_SYSTEM(log_level) Omni::Logger::Init(log_level);
 	#define OMNIFORCE_WRITE_LOGS_TO_FILE()			   Omni::Logger::Get()->WriteLogFile();
@@ -133,10 +158,10 @@ namespace Omni {
 	#define OMNIFORCE_CLIENT_CRITICAL(...)
 #endif
 
-#define OMNIFORCE_CUSTOM_LOGGER_TRACE(logger_name, ...)		Omni::Logger::GetLoggerByName(logger_name)->trace(__VA_ARGS__)
-#define OMNIFORCE_CUSTOM_LOGGER_INFO(logger_name, ...)		Omni::Logger::GetLoggerByName(logger_name)->info(__VA_ARGS__)
-#define OMNIFORCE_CUSTOM_LOGGER_WARN(logger_name, ...)		Omni::Logger::GetLoggerByName(logger_name)->warn(__VA_ARGS__)
-#define OMNIFORCE_CUSTOM_LOGGER_ERROR(logger_name, ...)		Omni::Logger::GetLoggerByName(logger_name)->error(__VA_ARGS__)
-#define OMNIFORCE_CUSTOM_LOGGER_CRITICAL(logger_name, ...)	Omni::Logger::GetLoggerByName(logger_name)->critical(__VA_ARGS__)
+#define OMNIFORCE_CUSTOM_LOGGER_TRACE(logger_name, ...)		Omni::Logger::Get()->Custom(logger_name, spdlog::level::trace, __VA_ARGS__)
+#define OMNIFORCE_CUSTOM_LOGGER_INFO(logger_name, ...)		Omni::Logger::Get()->Custom(logger_name, spdlog::level::info, __VA_ARGS__)
+#define OMNIFORCE_CUSTOM_LOGGER_WARN(logger_name, ...)		Omni::Logger::Get()->Custom(logger_name, spdlog::level::warn, __VA_ARGS__)
+#define OMNIFORCE_CUSTOM_LOGGER_ERROR(logger_name, ...)		Omni::Logger::Get()->Custom(logger_name, spdlog::level::err, __VA_ARGS__)
+#define OMNIFORCE_CUSTOM_LOGGER_CRITICAL(logger_name, ...)	Omni::Logger::Get()->Custom(logger_name, spdlog::level::critical, __VA_ARGS__)
 
 }
\ No newline at end of file
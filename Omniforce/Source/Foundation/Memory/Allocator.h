@@ -6,14 +6,26 @@
 
 namespace Omni {
 
+	/*
+	*	@brief Snapshot of allocator usage. Allocators that do not track some of the values leave them zeroed
+	*/
+	struct AllocatorStats {
+		uint64 live_memory = 0;				// Bytes currently handed out, including allocator rounding
+		uint64 peak_memory = 0;				// Highest `live_memory` value since allocator creation
+		uint64 reserved_memory = 0;			// Bytes allocator holds from its backing storage
+		uint64 num_live_allocations = 0;
+		uint64 total_allocations = 0;		// Monotonic, used to compute per-frame allocation counts
+		float32 fragmentation = 0.0f;			// [0; 1], 0 means all free memory is usable by a single allocation
+	};
+
 	class OMNIFORCE_API IAllocator {
 	public:
 		using TSize = uint64_t;
 
-		struct Stats {
-			TSize frame_memory_usage;
-			TSize a;
-		};
+		// Alignment that is guaranteed for allocations without explicitly specified alignment
+		inline static constexpr TSize DEFAULT_ALIGNMENT = 16;
+
+		using Stats = AllocatorStats;
 
 		virtual ~IAllocator() {};
 
@@ -52,6 +64,10 @@ namespace Omni {
 			return size; 
 		};
 
+		virtual Stats GetStats() {
+			return {};
+		}
+
 		void RebaseAllocation(MemoryAllocation& allocation, IAllocator* allocator) {
 			MemoryAllocation new_allocation = allocator->AllocateBase(allocation.Size);
 			memcpy(new_allocation.Memory, allocation.Memory, allocation.Size);
@@ -59,6 +75,11 @@ namespace Omni {
 			FreeBase(allocation);
 		}
 
+		// Rounds `value` up to `alignment`, which must be a power of two
+		inline static constexpr TSize AlignUp(TSize value, TSize alignment) {
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
 		template<typename TAlloc, typename... TArgs>
 		static TAlloc Setup(TArgs&&... args) {
 			return TAlloc(std::forward<TArgs>(args)...);
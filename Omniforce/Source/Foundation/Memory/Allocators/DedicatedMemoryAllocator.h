@@ -18,10 +18,20 @@ namespace Omni {
 			Allocation.Memory = new byte[InAllocationSize];
 			Allocation.Size = InAllocationSize;
 
+			TSize live_memory = m_LiveMemory.fetch_add(InAllocationSize, std::memory_order_relaxed) + InAllocationSize;
+			TSize peak_memory = m_PeakMemory.load(std::memory_order_relaxed);
+			while (peak_memory < live_memory && !m_PeakMemory.compare_exchange_weak(peak_memory, live_memory, std::memory_order_relaxed));
+
+			m_NumLiveAllocations.fetch_add(1, std::memory_order_relaxed);
+			m_TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+
 			return Allocation;
 		}
 
 		void FreeBase(MemoryAllocation& InAllocation) override {
+			m_LiveMemory.fetch_sub(InAllocation.Size, std::memory_order_relaxed);
+			m_NumLiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
 			delete[] InAllocation.Memory;
 			InAllocation.Invalidate();
 		}
@@ -32,6 +42,24 @@ namespace Omni {
 			return size; 
 		};
 
+		// Every allocation is a separate heap block, so fragmentation is up to the system heap and is not reported
+		Stats GetStats() override {
+			Stats stats = {};
+			stats.live_memory = m_LiveMemory.load(std::memory_order_relaxed);
+			stats.peak_memory = m_PeakMemory.load(std::memory_order_relaxed);
+			stats.reserved_memory = stats.live_memory;
+			stats.num_live_allocations = m_NumLiveAllocations.load(std::memory_order_relaxed);
+			stats.total_allocations = m_TotalAllocations.load(std::memory_order_relaxed);
+
+			return stats;
+		}
+
+	private:
+		Atomic<TSize> m_LiveMemory = 0;
+		Atomic<TSize> m_PeakMemory = 0;
+		Atomic<uint64> m_NumLiveAllocations = 0;
+		Atomic<uint64> m_TotalAllocations = 0;
+
 	};
 
 	inline DedicatedMemoryAllocator g_DedicatedMemoryAllocator = IAllocator::Setup<DedicatedMemoryAllocator>();
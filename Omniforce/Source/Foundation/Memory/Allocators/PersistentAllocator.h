@@ -8,63 +8,95 @@
 #include <Foundation/Containers/Array.h>
 #include <Foundation/Memory/Allocators/DedicatedMemoryAllocator.h>
 
-#include <shared_mutex>
+#include <mutex>
 #include <limits>
+#include <array>
+#include <bit>
 
 namespace Omni {
 
+	/*
+	*	@brief General purpose buddy allocator. Both allocation and deallocation are O(1):
+	*	free lists are intrusive (links are stored inside of free blocks), a bit mask of non-empty
+	*	levels is used to find a suitable block, and a bitmap of free block starts is used to find a buddy.
+	*	Level and state of every allocated block are kept in a byte per minimal block, so a free doesn't depend on
+	*	`MemoryAllocation::Size` alone: double frees and frees of untracked blocks are rejected and a mismatching size asserts.
+	*
+	*	Optionally has a per-thread cache in front of the buddy core: each thread keeps a magazine of
+	*	free blocks per small level and refills / flushes it in batches, so the lock is taken once per batch.
+	*	A block freed on a thread other than the one that allocated it simply goes into the freeing thread's magazine.
+	*	Only one allocator instance can have thread caching enabled (normally `g_PersistentAllocator`)
+	*/
 	class OMNIFORCE_API PersistentAllocator : public IAllocator {
 	public:
 
-		PersistentAllocator(TSize total_size, TSize minimal_block_size = 4)
+		struct ThreadCacheStats {
+			uint64 hits;
+			uint64 misses;
+			uint64 refills;
+			uint64 flushes;
+		};
+
+		PersistentAllocator(TSize total_size, TSize minimal_block_size = 16, bool thread_caching = false)
 			: m_Size(Align(total_size))
-			, m_MinimalBlockSize(minimal_block_size)
-			, m_MaxSubdivisionLevel(std::log2(m_Size / m_MinimalBlockSize))
-			, m_MemoryPool(&g_DedicatedMemoryAllocator, total_size)
+			, m_MinimalBlockSize(Align(minimal_block_size))
+			, m_MinimalBlockSizeLog2(std::countr_zero(m_MinimalBlockSize))
+			, m_MaxSubdivisionLevel(std::countr_zero(m_Size) - m_MinimalBlockSizeLog2)
+			, m_MemoryPool(&g_DedicatedMemoryAllocator, m_Size)
 		{
-			// Init free lists
-			m_FreeLists.resize(m_MaxSubdivisionLevel + 1);
+			OMNIFORCE_ASSERT_TAGGED(m_MinimalBlockSize >= sizeof(FreeBlockHeader), "Persistent allocator: minimal block size is too small to fit free list links");
+			OMNIFORCE_ASSERT_TAGGED((m_Size >> m_MinimalBlockSizeLog2) < INVALID_BLOCK, "Persistent allocator: too many blocks for 32-bit block indices");
+
+			m_FreeBlockBitmap.resize(((m_Size >> m_MinimalBlockSizeLog2) + 63) / 64);
+			m_BlockStates.resize(m_Size >> m_MinimalBlockSizeLog2);
 
-			// Entire list is free
-			m_FreeLists[m_MaxSubdivisionLevel].push_back(0);
+			Reset();
+
+			if (thread_caching) {
+				PersistentAllocator* expected = nullptr;
+				m_ThreadCachingEnabled = s_CachingAllocator.compare_exchange_strong(expected, this);
+				OMNIFORCE_ASSERT_TAGGED(m_ThreadCachingEnabled, "Persistent allocator: thread caching is already enabled for another allocator");
+			}
 		}
 
-		~PersistentAllocator() {}
+		~PersistentAllocator() {
+			// Prevent thread caches of threads that outlive the allocator from flushing into it
+			if (m_ThreadCachingEnabled) {
+				s_CachingAllocator = nullptr;
+			}
+		}
 
 		MemoryAllocation AllocateBase(TSize size) override {
-			std::lock_guard lock(m_Mutex);
-
 			if (size == 0) return MemoryAllocation::InvalidAllocation();
 
-			TSize aligned_size = std::max(m_MinimalBlockSize, Align(size));
-			TSize level = std::log2(aligned_size / m_MinimalBlockSize);
+			TSize aligned_size = ComputeAlignedSize(size);
+			uint32 level = ComputeLevel(aligned_size);
 
-			// Try to find block in general pool
-			for (TSize i = level; i <= m_MaxSubdivisionLevel; ++i) {
-				if (!m_FreeLists[i].empty()) {
-					TSize block = m_FreeLists[i].back();
-					m_FreeLists[i].pop_back();
+			if (level > m_MaxSubdivisionLevel) [[unlikely]] {
+				OMNIFORCE_CORE_CRITICAL("Persistent allocator: requested allocation is bigger than the memory pool");
+				return MemoryAllocation::InvalidAllocation();
+			}
 
-					// Subdivide the block if it is bigger than needed
-					while (i > level) {
-						--i;
-						TSize buddy = block + (TSize(1) << i);
-						m_FreeLists[i].push_back(buddy);
-					}
+			uint32 block = INVALID_BLOCK;
 
-					m_AllocatedMemoryBlocks[(byte*)&m_MemoryPool[block * m_MinimalBlockSize]] = aligned_size;
+			if (level < NUM_CACHED_LEVELS && m_ThreadCachingEnabled) [[likely]] {
+				block = AllocateCachedBlock(level);
+			}
+			else {
+				std::lock_guard lock(m_Mutex);
+				block = AllocateBlock(level);
+				m_NumUncachedAllocations++;
+			}
 
-					// Allocate memory using MemoryAllocation structure
-					return MemoryAllocation(
-						&m_MemoryPool[block * m_MinimalBlockSize], aligned_size
-					);
-				}
+			if (block == INVALID_BLOCK) [[unlikely]] {
+				OMNIFORCE_CORE_CRITICAL("Persistent allocator: out of memory");
+				return MemoryAllocation::InvalidAllocation();
 			}
 
-			OMNIFORCE_CORE_CRITICAL("Persistent allocator: out of memory");
+			// Block is owned by the calling thread now, so its state byte is not shared
+			m_BlockStates[block] |= BLOCK_LIVE_BIT;
 
-			// Out of memory
-			return MemoryAllocation::InvalidAllocation();
+			return MemoryAllocation(BlockToAddress(block), aligned_size);
 		}
 
 		void FreeBase(MemoryAllocation& allocation) override {
@@ -73,73 +105,382 @@ namespace Omni {
 				return;
 			}
 
-			std::lock_guard lock(m_Mutex);
-
-			// Find block using address
-			auto it = m_AllocatedMemoryBlocks.find(allocation.Memory);
-			OMNIFORCE_ASSERT_TAGGED(it != m_AllocatedMemoryBlocks.end(), "Persistent allocator: attempted to free invalid or untracked block");
+			OMNIFORCE_ASSERT_TAGGED(
+				allocation.Memory >= m_MemoryPool.Raw() && allocation.Memory < m_MemoryPool.Raw() + m_Size,
+				"Persistent allocator: attempted to free a block that does not belong to the pool"
+			);
 
-			TSize block_size = it->second;
-			TSize block = (TSize)(allocation.Memory - (byte*)&m_MemoryPool[0]) / m_MinimalBlockSize;
-			TSize level = std::log2(block_size / m_MinimalBlockSize);
+			uint32 block = AddressToBlock(allocation.Memory);
+			uint8 block_state = m_BlockStates[block];
 
-			m_AllocatedMemoryBlocks.erase(it);
+			// Freeing a block twice or a pointer which was not returned by the allocator would corrupt free lists and thread caches
+			if (!(block_state & BLOCK_LIVE_BIT)) [[unlikely]] {
+				OMNIFORCE_CORE_CRITICAL("Persistent allocator: attempted to free a block which is not allocated (double free?)");
+				OMNIFORCE_ASSERT_TAGGED(false, "Persistent allocator: invalid free");
+				return;
+			}
 
-			// Try to merge with buddy
-			while (level < m_MaxSubdivisionLevel) {
-				TSize buddy = block ^ (1 << level);
+			uint32 level = block_state & BLOCK_LEVEL_MASK;
+			OMNIFORCE_ASSERT_TAGGED(ComputeLevel(ComputeAlignedSize(allocation.Size)) == level, "Persistent allocator: size of freed allocation does not match allocated block");
 
-				auto buddy_it = std::find(m_FreeLists[level].begin(), m_FreeLists[level].end(), buddy);
+			m_BlockStates[block] = block_state & ~BLOCK_LIVE_BIT;
 
-				if (buddy_it != m_FreeLists[level].end()) {
-					m_FreeLists[level].erase(buddy_it);
-					block = std::min(block, buddy); // Merge the blocks
-					++level;
-				}
-				else {
-					break;
-				}
+			if (level < NUM_CACHED_LEVELS && m_ThreadCachingEnabled) [[likely]] {
+				FreeCachedBlock(block, level);
+			}
+			else {
+				std::lock_guard lock(m_Mutex);
+				FreeBlock(block, level);
 			}
 
-			m_FreeLists[level].push_back(block);
 			allocation.Invalidate();
 		}
 
 		void Clear() override {
 			std::lock_guard lock(m_Mutex);
 
-			// Clear all free lists and reinitialize them
-			for (auto& free_list : m_FreeLists) {
-				free_list.clear();
-			}
-			m_FreeLists[m_MaxSubdivisionLevel].push_back(0); // Mark the entire memory pool as free
+			Reset();
 
-			// Clear allocated blocks map
-			m_AllocatedMemoryBlocks.clear();
+			// Invalidate blocks that are held by thread caches
+			m_CacheEpoch.fetch_add(1, std::memory_order_relaxed);
 
 			OMNIFORCE_CORE_INFO("PersistentAllocator has been cleared and reset to its initial state.");
 		}
 
 		TSize ComputeAlignedSize(TSize size) override {
-			return Align(size);
+			return std::max(m_MinimalBlockSize, Align(size));
 		};
 
+		// Blocks held by thread caches are counted as live, since they are not available to other threads.
+		// Fragmentation is a share of free memory that cannot be used by the largest possible allocation
+		Stats GetStats() override {
+			ThreadCacheStats cache_stats = GetThreadCacheStats();
+
+			std::lock_guard lock(m_Mutex);
+
+			Stats stats = {};
+			stats.live_memory = m_UsedMemory;
+			stats.peak_memory = m_PeakUsedMemory;
+			stats.reserved_memory = m_Size;
+			stats.num_live_allocations = m_NumUsedBlocks;
+			stats.total_allocations = m_NumUncachedAllocations + cache_stats.hits + cache_stats.misses;
+
+			TSize free_memory = m_Size - m_UsedMemory;
+			TSize largest_free_block = m_NonEmptyLevels ? m_MinimalBlockSize << (std::bit_width(m_NonEmptyLevels) - 1) : 0;
+			stats.fragmentation = free_memory ? 1.0f - (float32)largest_free_block / (float32)free_memory : 0.0f;
+
+			return stats;
+		}
+
+		// Counters are published by each thread once per refill / flush batch, so they may lag slightly behind
+		ThreadCacheStats GetThreadCacheStats() const {
+			ThreadCacheStats stats = {};
+			stats.hits = m_CacheHits.load(std::memory_order_relaxed);
+			stats.misses = m_CacheMisses.load(std::memory_order_relaxed);
+			stats.refills = m_CacheRefills.load(std::memory_order_relaxed);
+			stats.flushes = m_CacheFlushes.load(std::memory_order_relaxed);
+
+			return stats;
+		}
+
 	private:
-		TSize Align(TSize n) const {
-			return std::pow(2, std::ceil(std::log2(n)));
+		inline static constexpr uint32 INVALID_BLOCK = std::numeric_limits<uint32>::max();
+
+		// State byte of an allocated block start. Blocks held by thread caches are allocated, but not live
+		inline static constexpr uint8 BLOCK_LEVEL_MASK = 0x3F;
+		inline static constexpr uint8 BLOCK_ALLOCATED_BIT = 0x40;
+		inline static constexpr uint8 BLOCK_LIVE_BIT = 0x80;
+
+		// Levels below this one (16 - 512 bytes with default minimal block size) are served from thread caches
+		inline static constexpr uint32 NUM_CACHED_LEVELS = 6;
+		inline static constexpr uint32 MAGAZINE_CAPACITY = 64;
+		inline static constexpr uint32 MAGAZINE_BATCH_SIZE = MAGAZINE_CAPACITY / 2;
+
+		struct ThreadCache {
+			struct Magazine {
+				uint32 count = 0;
+				uint32 blocks[MAGAZINE_CAPACITY];
+			};
+
+			~ThreadCache() {
+				// Return cached blocks on thread exit, unless the allocator is already destroyed
+				if (owner && owner == s_CachingAllocator.load()) {
+					owner->FlushThreadCache(*this);
+				}
+			}
+
+			PersistentAllocator* owner = nullptr;
+			uint64 epoch = 0;
+			uint64 hits = 0;
+			uint64 misses = 0;
+			uint64 refills = 0;
+			uint64 flushes = 0;
+			Magazine magazines[NUM_CACHED_LEVELS];
+		};
+
+		// Stored in the first bytes of every free block
+		struct FreeBlockHeader {
+			uint32 prev;
+			uint32 next;
+			uint32 level;
+		};
+
+		static TSize Align(TSize n) {
+			return std::bit_ceil(n);
+		}
+
+		inline uint32 ComputeLevel(TSize aligned_size) const {
+			return std::countr_zero(aligned_size) - m_MinimalBlockSizeLog2;
+		}
+
+		inline byte* BlockToAddress(uint32 block) const {
+			return m_MemoryPool.Raw() + ((TSize)block << m_MinimalBlockSizeLog2);
+		}
+
+		inline uint32 AddressToBlock(const byte* address) const {
+			return (uint32)((TSize)(address - m_MemoryPool.Raw()) >> m_MinimalBlockSizeLog2);
+		}
+
+		inline FreeBlockHeader* GetFreeBlockHeader(uint32 block) const {
+			return (FreeBlockHeader*)BlockToAddress(block);
+		}
+
+		inline bool IsFreeBlockStart(uint32 block) const {
+			return m_FreeBlockBitmap[block >> 6] & (1ull << (block & 63));
+		}
+
+		inline void PushFreeBlock(uint32 block, uint32 level) {
+			FreeBlockHeader* header = GetFreeBlockHeader(block);
+			header->prev = INVALID_BLOCK;
+			header->next = m_FreeListHeads[level];
+			header->level = level;
+
+			if (header->next != INVALID_BLOCK) {
+				GetFreeBlockHeader(header->next)->prev = block;
+			}
+
+			m_FreeListHeads[level] = block;
+			m_NonEmptyLevels |= 1ull << level;
+			m_FreeBlockBitmap[block >> 6] |= 1ull << (block & 63);
+		}
+
+		inline void RemoveFreeBlock(uint32 block, uint32 level) {
+			FreeBlockHeader* header = GetFreeBlockHeader(block);
+
+			if (header->prev != INVALID_BLOCK) {
+				GetFreeBlockHeader(header->prev)->next = header->next;
+			}
+			else {
+				m_FreeListHeads[level] = header->next;
+			}
+
+			if (header->next != INVALID_BLOCK) {
+				GetFreeBlockHeader(header->next)->prev = header->prev;
+			}
+
+			if (m_FreeListHeads[level] == INVALID_BLOCK) {
+				m_NonEmptyLevels &= ~(1ull << level);
+			}
+
+			m_FreeBlockBitmap[block >> 6] &= ~(1ull << (block & 63));
+		}
+
+		// Assumes lock is held
+		uint32 AllocateBlock(uint32 level) {
+			// Find the smallest non-empty level that can fit the requested block
+			uint64 suitable_levels = m_NonEmptyLevels & (~0ull << level);
+
+			if (!suitable_levels) [[unlikely]] {
+				return INVALID_BLOCK;
+			}
+
+			uint32 current_level = std::countr_zero(suitable_levels);
+			uint32 block = m_FreeListHeads[current_level];
+			RemoveFreeBlock(block, current_level);
+
+			// Subdivide the block if it is bigger than needed, upper halves go to free lists
+			while (current_level > level) {
+				--current_level;
+				PushFreeBlock(block + (1u << current_level), current_level);
+			}
+
+			m_BlockStates[block] = BLOCK_ALLOCATED_BIT | (uint8)level;
+
+			m_UsedMemory += m_MinimalBlockSize << level;
+			m_PeakUsedMemory = std::max(m_PeakUsedMemory, m_UsedMemory);
+			m_NumUsedBlocks++;
+
+			return block;
+		}
+
+		// Assumes lock is held
+		void FreeBlock(uint32 block, uint32 level) {
+			OMNIFORCE_ASSERT_TAGGED(!IsFreeBlockStart(block), "Persistent allocator: attempted to free already freed block");
+			OMNIFORCE_ASSERT_TAGGED(m_BlockStates[block] == (BLOCK_ALLOCATED_BIT | level), "Persistent allocator: block state is corrupted");
+
+			m_BlockStates[block] = 0;
+
+			m_UsedMemory -= m_MinimalBlockSize << level;
+			m_NumUsedBlocks--;
+
+			// Try to merge with buddy. Buddy can only be merged if it is free and was not subdivided,
+			// e.g. its free list header is on the same level
+			while (level < m_MaxSubdivisionLevel) {
+				uint32 buddy = block ^ (1u << level);
+
+				if (!IsFreeBlockStart(buddy) || GetFreeBlockHeader(buddy)->level != level) {
+					break;
+				}
+
+				RemoveFreeBlock(buddy, level);
+				block = std::min(block, buddy); // Merge the blocks
+				++level;
+			}
+
+			PushFreeBlock(block, level);
+		}
+
+		ThreadCache& AcquireThreadCache() {
+			thread_local ThreadCache cache;
+
+			if (cache.owner != this || cache.epoch != m_CacheEpoch.load(std::memory_order_relaxed)) [[unlikely]] {
+				// Either first use on this thread, or the allocator was cleared and cached blocks are stale
+				for (auto& magazine : cache.magazines) {
+					magazine.count = 0;
+				}
+
+				cache.owner = this;
+				cache.epoch = m_CacheEpoch.load(std::memory_order_relaxed);
+			}
+
+			return cache;
+		}
+
+		uint32 AllocateCachedBlock(uint32 level) {
+			ThreadCache& cache = AcquireThreadCache();
+			auto& magazine = cache.magazines[level];
+
+			if (magazine.count) [[likely]] {
+				cache.hits++;
+				return magazine.blocks[--magazine.count];
+			}
+
+			cache.misses++;
+
+			// Refill half of the magazine under a single lock
+			{
+				std::lock_guard lock(m_Mutex);
+
+				while (magazine.count < MAGAZINE_BATCH_SIZE) {
+					uint32 block = AllocateBlock(level);
+
+					if (block == INVALID_BLOCK) {
+						break;
+					}
+
+					magazine.blocks[magazine.count++] = block;
+				}
+			}
+
+			cache.refills++;
+			PublishThreadCacheStats(cache);
+
+			return magazine.count ? magazine.blocks[--magazine.count] : INVALID_BLOCK;
+		}
+
+		void FreeCachedBlock(uint32 block, uint32 level) {
+			ThreadCache& cache = AcquireThreadCache();
+			auto& magazine = cache.magazines[level];
+
+			if (magazine.count == MAGAZINE_CAPACITY) [[unlikely]] {
+				// Flush the older half of the magazine under a single lock
+				{
+					std::lock_guard lock(m_Mutex);
+
+					for (uint32 i = 0; i < MAGAZINE_BATCH_SIZE; i++) {
+						FreeBlock(magazine.blocks[i], level);
+					}
+				}
+
+				std::copy(magazine.blocks + MAGAZINE_BATCH_SIZE, magazine.blocks + MAGAZINE_CAPACITY, magazine.blocks);
+				magazine.count -= MAGAZINE_BATCH_SIZE;
+
+				cache.flushes++;
+				PublishThreadCacheStats(cache);
+			}
+
+			magazine.blocks[magazine.count++] = block;
+		}
+
+		void FlushThreadCache(ThreadCache& cache) {
+			if (cache.epoch == m_CacheEpoch.load(std::memory_order_relaxed)) {
+				std::lock_guard lock(m_Mutex);
+
+				for (uint32 level = 0; level < NUM_CACHED_LEVELS; level++) {
+					auto& magazine = cache.magazines[level];
+
+					for (uint32 i = 0; i < magazine.count; i++) {
+						FreeBlock(magazine.blocks[i], level);
+					}
+
+					magazine.count = 0;
+				}
+			}
+
+			PublishThreadCacheStats(cache);
+		}
+
+		// Moves thread-local counters into shared ones, called once per batch to avoid contention on hot path
+		void PublishThreadCacheStats(ThreadCache& cache) {
+			m_CacheHits.fetch_add(cache.hits, std::memory_order_relaxed);
+			m_CacheMisses.fetch_add(cache.misses, std::memory_order_relaxed);
+			m_CacheRefills.fetch_add(cache.refills, std::memory_order_relaxed);
+			m_CacheFlushes.fetch_add(cache.flushes, std::memory_order_relaxed);
+
+			cache.hits = cache.misses = cache.refills = cache.flushes = 0;
+		}
+
+		// Marks entire memory pool as a single free block
+		void Reset() {
+			m_FreeListHeads.fill(INVALID_BLOCK);
+			m_NonEmptyLevels = 0;
+			std::fill(m_FreeBlockBitmap.begin(), m_FreeBlockBitmap.end(), 0);
+			std::fill(m_BlockStates.begin(), m_BlockStates.end(), 0);
+			m_UsedMemory = 0;
+			m_NumUsedBlocks = 0;
+
+			PushFreeBlock(0, m_MaxSubdivisionLevel);
 		}
 
 		TSize m_Size;
 		TSize m_MinimalBlockSize;
-		TSize m_MaxSubdivisionLevel;
+		uint32 m_MinimalBlockSizeLog2;
+		uint32 m_MaxSubdivisionLevel;
 
 		ByteArray m_MemoryPool; // Memory pool, used with MemoryAllocation
-		std::vector<std::vector<TSize>> m_FreeLists; // Free block lists by level
-		std::map<byte*, TSize> m_AllocatedMemoryBlocks; // Map of allocated blocks (address -> size)
-
-		mutable std::shared_mutex m_Mutex; // Mutex for thread safety
+		std::array<uint32, 64> m_FreeListHeads; // Heads of intrusive free lists by level
+		uint64 m_NonEmptyLevels = 0; // Bit per level, set if level's free list is not empty
+		std::vector<uint64> m_FreeBlockBitmap; // Bit per minimal block, set if a free block starts there
+		std::vector<uint8> m_BlockStates; // Byte per minimal block, level and state of an allocated block which starts there
+
+		TSize m_UsedMemory = 0;
+		TSize m_PeakUsedMemory = 0;
+		uint64 m_NumUsedBlocks = 0;
+		uint64 m_NumUncachedAllocations = 0;
+
+		std::mutex m_Mutex; // Mutex for thread safety
+
+		bool m_ThreadCachingEnabled = false;
+		Atomic<uint64> m_CacheEpoch = 0;
+		Atomic<uint64> m_CacheHits = 0;
+		Atomic<uint64> m_CacheMisses = 0;
+		Atomic<uint64> m_CacheRefills = 0;
+		Atomic<uint64> m_CacheFlushes = 0;
+
+		// Atomic pointer is trivially destructible, so it stays valid while thread caches are destroyed on shutdown
+		inline static constinit Atomic<PersistentAllocator*> s_CachingAllocator = nullptr;
 	};
 
-	inline PersistentAllocator g_PersistentAllocator = IAllocator::Setup<PersistentAllocator>(1024 * 1024 * 256);
+	inline PersistentAllocator g_PersistentAllocator = IAllocator::Setup<PersistentAllocator>(1024 * 1024 * 256, 16, true);
 
 }
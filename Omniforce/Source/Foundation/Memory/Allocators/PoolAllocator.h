@@ -0,0 +1,233 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+
+#include <Foundation/Log/Logger.h>
+#include <Foundation/Memory/Allocator.h>
+#include <Foundation/Memory/Allocators/PersistentAllocator.h>
+
+#include <mutex>
+#include <array>
+
+namespace Omni {
+
+	/*
+	*	@brief Slab allocator for small objects, such as tree nodes or `Ref` storage blocks.
+	*	Each size class carves fixed-size slots out of its own pages, so objects of the same size are packed
+	*	together and cost exactly their size class, without power-of-two rounding. Freed slots are reused via
+	*	intrusive LIFO free list. Requests bigger than the largest size class are forwarded to the backing allocator
+	*/
+	class OMNIFORCE_API PoolAllocator : public IAllocator {
+	public:
+		inline static constexpr TSize PAGE_SIZE = 64 * 1024;
+		inline static constexpr std::array<TSize, 8> SIZE_CLASSES = { 16, 32, 48, 64, 96, 128, 192, 256 };
+		inline static constexpr TSize MAX_SIZE_CLASS = SIZE_CLASSES.back();
+
+		PoolAllocator(IAllocator* backing_allocator)
+			: m_BackingAllocator(backing_allocator)
+		{}
+
+		~PoolAllocator() {
+			ReleasePages();
+		}
+
+		MemoryAllocation AllocateBase(TSize size) override {
+			if (size == 0) return MemoryAllocation::InvalidAllocation();
+
+			if (size > MAX_SIZE_CLASS) [[unlikely]] {
+				return m_BackingAllocator->AllocateBase(size);
+			}
+
+			uint32 size_class_index = ComputeSizeClassIndex(size);
+			SizeClass& size_class = m_SizeClasses[size_class_index];
+			TSize slot_size = SIZE_CLASSES[size_class_index];
+
+			std::lock_guard lock(size_class.mutex);
+
+			size_class.num_live_slots++;
+			size_class.peak_live_slots = std::max(size_class.peak_live_slots, size_class.num_live_slots);
+			size_class.total_allocations++;
+
+			// Reuse freed slot first
+			if (FreeSlot* slot = size_class.free_list) {
+				size_class.free_list = slot->next;
+				return MemoryAllocation((byte*)slot, slot_size);
+			}
+
+			// Carve a new slot out of current page, allocate a new page if it is exhausted
+			if ((TSize)(size_class.page_end - size_class.page_cursor) < slot_size) [[unlikely]] {
+				if (!AllocatePage(size_class)) {
+					size_class.num_live_slots--;
+					size_class.total_allocations--;
+					return MemoryAllocation::InvalidAllocation();
+				}
+			}
+
+			byte* memory = size_class.page_cursor;
+			size_class.page_cursor += slot_size;
+
+			return MemoryAllocation(memory, slot_size);
+		}
+
+		void FreeBase(MemoryAllocation& allocation) override {
+			if (!allocation.IsValid()) {
+				OMNIFORCE_CORE_WARNING("Pool allocator: attempted to free invalid block");
+				return;
+			}
+
+			if (allocation.Size > MAX_SIZE_CLASS) [[unlikely]] {
+				m_BackingAllocator->FreeBase(allocation);
+				return;
+			}
+
+			uint32 size_class_index = ComputeSizeClassIndex(allocation.Size);
+			OMNIFORCE_ASSERT_TAGGED(SIZE_CLASSES[size_class_index] == allocation.Size, "Pool allocator: allocation size does not match any size class");
+
+			SizeClass& size_class = m_SizeClasses[size_class_index];
+
+			{
+				std::lock_guard lock(size_class.mutex);
+
+				FreeSlot* slot = (FreeSlot*)allocation.Memory;
+				slot->next = size_class.free_list;
+				size_class.free_list = slot;
+				size_class.num_live_slots--;
+			}
+
+			allocation.Invalidate();
+		}
+
+		// Returns all pages to the backing allocator. All pooled objects must be already destroyed
+		void Clear() override {
+			ReleasePages();
+		}
+
+		TSize ComputeAlignedSize(TSize size) override {
+			if (size > MAX_SIZE_CLASS) {
+				return m_BackingAllocator->ComputeAlignedSize(size);
+			}
+
+			return SIZE_CLASSES[ComputeSizeClassIndex(size)];
+		}
+
+		// Requests forwarded to the backing allocator are reported by it. Size classes are tracked separately
+		// to avoid shared counters, so peak memory is a sum of per-class peaks and may overestimate the real peak.
+		// Fragmentation is a share of page memory that is not occupied by live slots
+		Stats GetStats() override {
+			Stats stats = {};
+
+			for (uint32 i = 0; i < SIZE_CLASSES.size(); i++) {
+				SizeClass& size_class = m_SizeClasses[i];
+				std::lock_guard lock(size_class.mutex);
+
+				stats.live_memory += size_class.num_live_slots * SIZE_CLASSES[i];
+				stats.peak_memory += size_class.peak_live_slots * SIZE_CLASSES[i];
+				stats.reserved_memory += size_class.num_pages * PAGE_SIZE;
+				stats.num_live_allocations += size_class.num_live_slots;
+				stats.total_allocations += size_class.total_allocations;
+			}
+
+			TSize unused_memory = stats.reserved_memory - stats.live_memory;
+			stats.fragmentation = stats.reserved_memory ? (float32)unused_memory / (float32)stats.reserved_memory : 0.0f;
+
+			return stats;
+		}
+
+	private:
+		struct FreeSlot {
+			FreeSlot* next;
+		};
+
+		// Stored in the first bytes of every page, so pages can be released without extra bookkeeping
+		struct alignas(16) PageHeader {
+			PageHeader* next;
+			TSize size;
+		};
+
+		struct SizeClass {
+			std::mutex mutex;
+			FreeSlot* free_list = nullptr;
+			PageHeader* pages = nullptr;
+			byte* page_cursor = nullptr;
+			byte* page_end = nullptr;
+			uint64 num_pages = 0;
+			uint64 num_live_slots = 0;
+			uint64 peak_live_slots = 0;
+			uint64 total_allocations = 0;
+		};
+
+		// Maps size in 16-byte granules to size class index
+		inline static constexpr std::array<uint8, MAX_SIZE_CLASS / 16 + 1> SIZE_CLASS_LOOKUP_TABLE = []() {
+			std::array<uint8, MAX_SIZE_CLASS / 16 + 1> table = {};
+			uint8 size_class_index = 0;
+
+			for (TSize granule = 0; granule < table.size(); granule++) {
+				while (SIZE_CLASSES[size_class_index] < granule * 16) {
+					size_class_index++;
+				}
+				table[granule] = size_class_index;
+			}
+
+			return table;
+		}();
+
+		inline static uint32 ComputeSizeClassIndex(TSize size) {
+			return SIZE_CLASS_LOOKUP_TABLE[(size + 15) / 16];
+		}
+
+		// Assumes size class lock is held
+		bool AllocatePage(SizeClass& size_class) {
+			MemoryAllocation allocation = m_BackingAllocator->AllocateBase(PAGE_SIZE);
+
+			if (!allocation.IsValid()) {
+				OMNIFORCE_CORE_CRITICAL("Pool allocator: failed to allocate a page");
+				return false;
+			}
+
+			PageHeader* page = (PageHeader*)allocation.Memory;
+			page->next = size_class.pages;
+			page->size = allocation.Size;
+			size_class.pages = page;
+			size_class.num_pages++;
+
+			size_class.page_cursor = allocation.Memory + sizeof(PageHeader);
+			size_class.page_end = allocation.Memory + allocation.Size;
+
+			return true;
+		}
+
+		void ReleasePages() {
+			for (auto& size_class : m_SizeClasses) {
+				std::lock_guard lock(size_class.mutex);
+
+				PageHeader* page = size_class.pages;
+				while (page) {
+					PageHeader* next = page->next;
+
+					MemoryAllocation allocation((byte*)page, page->size);
+					m_BackingAllocator->FreeBase(allocation);
+
+					page = next;
+				}
+
+				size_class.free_list = nullptr;
+				size_class.pages = nullptr;
+				size_class.page_cursor = nullptr;
+				size_class.page_end = nullptr;
+				size_class.num_pages = 0;
+				size_class.num_live_slots = 0;
+			}
+		}
+
+	private:
+		IAllocator* m_BackingAllocator;
+		std::array<SizeClass, SIZE_CLASSES.size()> m_SizeClasses;
+	};
+
+	/*
+	*  @brief Global allocator for small engine objects, backed by `g_PersistentAllocator`
+	*/
+	inline PoolAllocator g_PoolAllocator = IAllocator::Setup<PoolAllocator>(&g_PersistentAllocator);
+
+}
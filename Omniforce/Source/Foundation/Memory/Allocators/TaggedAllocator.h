@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+
+#include <Foundation/Memory/Allocator.h>
+#include <Foundation/Memory/Allocators/DedicatedMemoryAllocator.h>
+#include <Foundation/Memory/Allocators/PersistentAllocator.h>
+#include <Foundation/Memory/MemoryTelemetry.h>
+
+#include <string_view>
+
+namespace Omni {
+
+	/*
+	*	@brief Forwards allocations to a backing allocator and accounts them under a tag, e.g. "Mesh" or "Physics".
+	*	The tag is registered in `MemoryTelemetry` for the whole lifetime of the allocator.
+	*	Memory is only accounted here - it is still owned and reported by the backing allocator
+	*/
+	class OMNIFORCE_API TaggedAllocator : public IAllocator {
+	public:
+		TaggedAllocator(std::string_view tag, IAllocator* backing_allocator)
+			: m_BackingAllocator(backing_allocator)
+		{
+			MemoryTelemetry::RegisterAllocator(tag, this);
+		}
+
+		~TaggedAllocator() {
+			MemoryTelemetry::UnregisterAllocator(this);
+		}
+
+		MemoryAllocation AllocateBase(TSize size) override {
+			MemoryAllocation allocation = m_BackingAllocator->AllocateBase(size);
+
+			if (allocation.IsValid()) [[likely]] {
+				TSize live_memory = m_LiveMemory.fetch_add(allocation.Size, std::memory_order_relaxed) + allocation.Size;
+				TSize peak_memory = m_PeakMemory.load(std::memory_order_relaxed);
+				while (peak_memory < live_memory && !m_PeakMemory.compare_exchange_weak(peak_memory, live_memory, std::memory_order_relaxed));
+
+				m_NumLiveAllocations.fetch_add(1, std::memory_order_relaxed);
+				m_TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			return allocation;
+		}
+
+		void FreeBase(MemoryAllocation& allocation) override {
+			if (allocation.IsValid()) {
+				m_LiveMemory.fetch_sub(allocation.Size, std::memory_order_relaxed);
+				m_NumLiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			m_BackingAllocator->FreeBase(allocation);
+		}
+
+		// Backing allocator is shared with other users, so it is not cleared
+		void Clear() override {}
+
+		TSize ComputeAlignedSize(TSize size) override {
+			return m_BackingAllocator->ComputeAlignedSize(size);
+		}
+
+		Stats GetStats() override {
+			Stats stats = {};
+			stats.live_memory = m_LiveMemory.load(std::memory_order_relaxed);
+			stats.peak_memory = m_PeakMemory.load(std::memory_order_relaxed);
+			stats.reserved_memory = stats.live_memory;
+			stats.num_live_allocations = m_NumLiveAllocations.load(std::memory_order_relaxed);
+			stats.total_allocations = m_TotalAllocations.load(std::memory_order_relaxed);
+
+			return stats;
+		}
+
+	private:
+		IAllocator* m_BackingAllocator;
+
+		Atomic<TSize> m_LiveMemory = 0;
+		Atomic<TSize> m_PeakMemory = 0;
+		Atomic<uint64> m_NumLiveAllocations = 0;
+		Atomic<uint64> m_TotalAllocations = 0;
+	};
+
+	/*
+	*	@brief Subsystem tags. Subsystems allocate their long-living objects through them, so telemetry reports memory of each subsystem.
+	*	Physics uses dedicated allocator, since Jolt scratch memory is too large for persistent pool
+	*/
+	inline TaggedAllocator g_RendererAllocator = IAllocator::Setup<TaggedAllocator>("Renderer", &g_PersistentAllocator);
+	inline TaggedAllocator g_AssetAllocator = IAllocator::Setup<TaggedAllocator>("Asset", &g_PersistentAllocator);
+	inline TaggedAllocator g_PhysicsAllocator = IAllocator::Setup<TaggedAllocator>("Physics", &g_DedicatedMemoryAllocator);
+
+}
@@ -3,8 +3,13 @@
 #include <Foundation/Platform.h>
 #include <Foundation/BasicTypes.h>
 #include <Foundation/Memory/Allocator.h>
+#include <Foundation/Memory/Allocators/DedicatedMemoryAllocator.h>
 #include <Foundation/Log/Logger.h>
 
+#include <mutex>
+#include <array>
+#include <thread>
+
 namespace Omni {
 
 	/*
@@ -31,8 +36,6 @@ namespace Omni {
 		};
 
 		MemoryAllocation AllocateBase(TSize InAllocationSize) override {
-			OMNIFORCE_ASSERT_TAGGED(m_MaxSize >= m_Size + InAllocationSize, "Transient allocator: out of memory");
-
 			MemoryAllocation Alloc;
 			Alloc.Size = InAllocationSize;
 			Alloc.Memory = AllocateMemory(InAllocationSize);
@@ -43,20 +46,22 @@ namespace Omni {
 		template<typename T, typename... Args>
 		[[nodiscard]] T* AllocateObject(Args&&... args)
 		{
-			OMNIFORCE_ASSERT_TAGGED(m_MaxSize >= m_Size + sizeof(T), "Transient allocator: out of memory");
-
-			T* ptr = new (m_MemoryPool + m_Size) T(std::forward<Args>(args)...);
-			m_Size += sizeof(T);
+			byte* memory = AllocateMemory(sizeof(T), std::max<TSize>(alignof(T), DEFAULT_ALIGNMENT));
 
-			return ptr;
+			return new (memory) T(std::forward<Args>(args)...);
 		};
 
-		[[nodiscard]] byte* AllocateMemory(TSize size)
+		[[nodiscard]] byte* AllocateMemory(TSize size, TSize alignment = DEFAULT_ALIGNMENT)
 		{
-			OMNIFORCE_ASSERT_TAGGED(m_MaxSize >= m_Size + size, "Transient allocator: out of memory");
+			TSize offset = AlignUp((TSize)m_MemoryPool + m_Size, alignment) - (TSize)m_MemoryPool;
+
+			OMNIFORCE_ASSERT_TAGGED(m_MaxSize >= offset + size, "Transient allocator: out of memory");
 
-			byte* ptr = m_MemoryPool + m_Size;
-			m_Size += sizeof(size);
+			byte* ptr = m_MemoryPool + offset;
+			m_Size = offset + size;
+			m_PeakSize = std::max(m_PeakSize, m_Size);
+			m_NumAllocations++;
+			m_TotalAllocations++;
 
 			return ptr;
 		};
@@ -67,32 +72,62 @@ namespace Omni {
 			InAllocation.Invalidate();
 		}
 
-		// Since it is stack-based allocator for transient data (which will be freed in next frame), we simply set back 
+		// Since it is stack-based allocator for transient data (which will be freed in next frame), we simply set back
 		void Clear() override
 		{
 			m_Size = 0;
+			m_NumAllocations = 0;
+		}
+
+		Stats GetStats() override {
+			Stats stats = {};
+			stats.live_memory = m_Size;
+			stats.peak_memory = m_PeakSize;
+			stats.reserved_memory = m_MaxSize;
+			stats.num_live_allocations = m_NumAllocations;
+			stats.total_allocations = m_TotalAllocations;
+
+			return stats;
 		}
 
 	private:
 		byte* m_MemoryPool = nullptr;
 		TSize m_Size = 0;
 		TSize m_MaxSize = 0;
+		TSize m_PeakSize = 0;
+		uint64 m_NumAllocations = 0;
+		uint64 m_TotalAllocations = 0;
 	};
 
+	/*
+	*	@brief Frame arena. Each thread bumps its own chunk, so allocation takes no locks or atomics
+	*	unless the chunk is exhausted; then a new chunk is taken from the pool (or allocated) and chained to the frame.
+	*	Allocations live for `frames in flight` frames: `BeginFrame()` rotates to the next frame buffer and
+	*	recycles only its chunks, so data written N frames ago survives until the GPU is done with it.
+	*	`BeginFrame()`, `Clear()` and `SetFramesInFlight()` must not race with allocations, so only frame work may allocate:
+	*	the thread which advances frames and threads marked with `SetFrameWorkerThread()` (realtime and normal job lanes).
+	*	Both are asserted in debug builds. Work which may outlive frames in flight, e.g. asset import, must use persistent allocators.
+	*/
 	template<>
 	class OMNIFORCE_API TransientAllocator<true> : public IAllocator {
 	public:
+		inline static constexpr uint32 MAX_FRAMES_IN_FLIGHT = 4;
 
-		TransientAllocator(TSize pool_size = 1024 * 1024)
-			: m_Size(0)
-			, m_MaxSize(pool_size)
+		TransientAllocator(TSize chunk_size = 1024 * 1024, uint32 frames_in_flight = 1)
+			: m_ChunkSize(chunk_size)
+			, m_NumFrames(frames_in_flight)
+			, m_Epoch(GenerateEpoch())
 		{
-			m_MemoryPool = new byte[pool_size];
+			OMNIFORCE_ASSERT_TAGGED(frames_in_flight && frames_in_flight <= MAX_FRAMES_IN_FLIGHT, "Transient allocator: invalid frames in flight count");
+			m_FrameChunks.fill(nullptr);
 		};
 
 		~TransientAllocator()
 		{
-			delete[] m_MemoryPool;
+			for (uint32 i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+				ReleaseChunkList(m_FrameChunks[i]);
+			}
+			ReleaseChunkList(m_FreeChunks);
 		};
 
 		MemoryAllocation AllocateBase(TSize InAllocationSize) override {
@@ -107,49 +142,278 @@ namespace Omni {
 		template<typename T, typename... Args>
 		[[nodiscard]] T* AllocateObject(Args&&... args)
 		{
-			OMNIFORCE_ASSERT_TAGGED(m_MaxSize >= m_Size + sizeof(T), "Transient allocator: out of memory");
-
-			TSize ptr_offset = m_Size.fetch_add(sizeof(T));
-			T* ptr = new (m_MemoryPool + ptr_offset) T(std::forward<Args>(args)...);
+			byte* memory = AllocateMemory(sizeof(T), std::max<TSize>(alignof(T), DEFAULT_ALIGNMENT));
 
-			return ptr;
+			return new (memory) T(std::forward<Args>(args)...);
 		};
 
-		[[nodiscard]] byte* AllocateMemory(TSize size)
+		[[nodiscard]] byte* AllocateMemory(TSize size, TSize alignment = DEFAULT_ALIGNMENT)
 		{
-			OMNIFORCE_ASSERT_TAGGED(m_MaxSize >= m_Size + size, "Transient allocator: out of memory");
-
-			TSize ptr_offset = m_Size.fetch_add(size);
-			byte* ptr = m_MemoryPool + ptr_offset;
-
-			return ptr;
+#ifdef OMNIFORCE_DEBUG
+			// Frame thread is not known until the first frame, startup code may allocate from any thread
+			std::thread::id frame_thread = m_FrameThread.load(std::memory_order_relaxed);
+			OMNIFORCE_ASSERT_TAGGED(
+				frame_thread == std::thread::id() || frame_thread == std::this_thread::get_id() || IsFrameWorkerThread(),
+				"Transient allocator: allocation outside of frame work may outlive its frame, use persistent allocator"
+			);
+#endif
+
+			// Chunk that current thread bumps. Epochs are unique across all arenas and frames,
+			// so a matching epoch means the chunk belongs to this arena and was not recycled
+			thread_local struct {
+				uint64 epoch = 0;
+				Chunk* chunk = nullptr;
+			} thread_arena;
+
+			uint64 epoch = m_Epoch.load(std::memory_order_acquire);
+
+			if (thread_arena.epoch == epoch) [[likely]] {
+				if (byte* ptr = thread_arena.chunk->TryAllocate(size, alignment)) [[likely]] {
+					return ptr;
+				}
+			}
+
+			thread_arena.chunk = AcquireChunk(size + alignment);
+			thread_arena.epoch = epoch;
+
+			return thread_arena.chunk->TryAllocate(size, alignment);
 		};
 
 		void FreeBase(MemoryAllocation& InAllocation) override {
 			// Do nothing except allocation invalidation;
-			// All data will be freed once `Clear()` is called
+			// All data will be freed once its frame buffer is recycled
 			InAllocation.Invalidate();
 		}
 
-		// Since it is stack-based allocator for transient data (which will be freed in next frame), 
-		// we simply set back pointer offset
+		// Rotates to the next frame buffer and recycles memory that was allocated `frames in flight` frames ago
+		void BeginFrame() {
+			AssertFrameThread();
+
+			std::lock_guard lock(m_Mutex);
+
+			Chunk* frame_chunks = m_FrameChunks[m_FrameIndex];
+			TSize frame_usage = ComputeChunkListUsage(frame_chunks);
+			m_LastFrameUsage = frame_usage;
+			m_PeakFrameUsage = std::max(m_PeakFrameUsage, frame_usage);
+
+			for (Chunk* chunk = frame_chunks; chunk; chunk = chunk->next) {
+				m_TotalAllocations += chunk->num_allocations;
+			}
+
+			m_FrameIndex = (m_FrameIndex + 1) % m_NumFrames;
+			RecycleFrame(m_FrameIndex);
+
+			m_Epoch.store(GenerateEpoch(), std::memory_order_release);
+		}
+
+		// Recycles memory of all frames
 		void Clear() override {
-			m_Size = 0;
+			AssertFrameThread();
+
+			std::lock_guard lock(m_Mutex);
+
+			for (uint32 i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+				RecycleFrame(i);
+			}
+
+			m_Epoch.store(GenerateEpoch(), std::memory_order_release);
+		}
+
+		// Does not recycle current frame, so it is safe to call while transient data is in use
+		void SetFramesInFlight(uint32 frames_in_flight) {
+			OMNIFORCE_ASSERT_TAGGED(frames_in_flight && frames_in_flight <= MAX_FRAMES_IN_FLIGHT, "Transient allocator: invalid frames in flight count");
+			AssertFrameThread();
+
+			std::lock_guard lock(m_Mutex);
+
+			// Move current frame chunks to the first buffer, recycle ones that are out of new range
+			if (m_FrameIndex != 0) {
+				std::swap(m_FrameChunks[0], m_FrameChunks[m_FrameIndex]);
+				m_FrameIndex = 0;
+			}
+
+			for (uint32 i = frames_in_flight; i < MAX_FRAMES_IN_FLIGHT; i++) {
+				RecycleFrame(i);
+			}
+
+			m_NumFrames = frames_in_flight;
+			m_Epoch.store(GenerateEpoch(), std::memory_order_release);
+		}
+
+		// Reports usage of the last completed frame, since the current one is being written by other threads.
+		// Allocation count is accumulated when a frame is completed
+		Stats GetStats() override {
+			std::lock_guard lock(m_Mutex);
+
+			Stats stats = {};
+			stats.live_memory = m_LastFrameUsage;
+			stats.peak_memory = m_PeakFrameUsage;
+			stats.reserved_memory = m_CommittedMemory;
+			stats.total_allocations = m_TotalAllocations;
+
+			return stats;
+		}
+
+		TSize ComputeAlignedSize(TSize size) override {
+			return size;
+		};
+
+		// Marks calling thread as a worker which runs frame work, so it may allocate transient memory
+		static void SetFrameWorkerThread(bool frame_worker) {
+			IsFrameWorkerThread() = frame_worker;
+		}
+
+	private:
+		static bool& IsFrameWorkerThread() {
+			thread_local bool frame_worker = false;
+			return frame_worker;
 		}
 
-		TSize ComputeAlignedSize(TSize size) override { 
-			return size; 
+		// The first thread which manages frames becomes the frame thread, all subsequent calls must be made from it
+		void AssertFrameThread() {
+#ifdef OMNIFORCE_DEBUG
+			std::thread::id frame_thread = std::thread::id();
+			m_FrameThread.compare_exchange_strong(frame_thread, std::this_thread::get_id(), std::memory_order_relaxed);
+
+			OMNIFORCE_ASSERT_TAGGED(
+				frame_thread == std::thread::id() || frame_thread == std::this_thread::get_id(),
+				"Transient allocator: frames must be managed by the main thread"
+			);
+#endif
+		}
+
+		struct alignas(16) Chunk {
+			Chunk* next;
+			TSize size;
+			Atomic<TSize> offset;	// Written only by owning thread, atomic so statistics can be read while it allocates
+			uint64 num_allocations;
+
+			inline byte* Data() {
+				return (byte*)(this + 1);
+			}
+
+			inline byte* TryAllocate(TSize allocation_size, TSize alignment) {
+				TSize base = (TSize)Data();
+				TSize aligned_offset = AlignUp(base + offset.load(std::memory_order_relaxed), alignment) - base;
+
+				if (aligned_offset + allocation_size > size) {
+					return nullptr;
+				}
+
+				offset.store(aligned_offset + allocation_size, std::memory_order_relaxed);
+				num_allocations++;
+
+				return Data() + aligned_offset;
+			}
 		};
 
+		static uint64 GenerateEpoch() {
+			static constinit Atomic<uint64> s_EpochCounter = 0;
+			return ++s_EpochCounter;
+		}
+
+		// Takes a pooled chunk or allocates a new one and attaches it to the current frame
+		Chunk* AcquireChunk(TSize min_size) {
+			std::lock_guard lock(m_Mutex);
+
+			Chunk* chunk = nullptr;
+
+			if (min_size <= m_ChunkSize && m_FreeChunks) {
+				chunk = m_FreeChunks;
+				m_FreeChunks = chunk->next;
+			}
+			else {
+				TSize data_size = std::max(m_ChunkSize, min_size);
+				MemoryAllocation allocation = g_DedicatedMemoryAllocator.AllocateBase(sizeof(Chunk) + data_size);
+
+				chunk = new (allocation.Memory) Chunk();
+				chunk->size = data_size;
+
+				m_CommittedMemory += allocation.Size;
+				m_NumChunks++;
+			}
+
+			chunk->offset.store(0, std::memory_order_relaxed);
+			chunk->num_allocations = 0;
+			chunk->next = m_FrameChunks[m_FrameIndex];
+			m_FrameChunks[m_FrameIndex] = chunk;
+
+			return chunk;
+		}
+
+		// Returns regular chunks of a frame to the pool, oversized ones are released. Assumes lock is held
+		void RecycleFrame(uint32 frame_index) {
+			Chunk* chunk = m_FrameChunks[frame_index];
+
+			while (chunk) {
+				Chunk* next = chunk->next;
+
+				if (chunk->size == m_ChunkSize) {
+					chunk->next = m_FreeChunks;
+					m_FreeChunks = chunk;
+				}
+				else {
+					ReleaseChunk(chunk);
+				}
+
+				chunk = next;
+			}
+
+			m_FrameChunks[frame_index] = nullptr;
+		}
+
+		void ReleaseChunk(Chunk* chunk) {
+			MemoryAllocation allocation((byte*)chunk, sizeof(Chunk) + chunk->size);
+
+			m_CommittedMemory -= allocation.Size;
+			m_NumChunks--;
+
+			g_DedicatedMemoryAllocator.FreeBase(allocation);
+		}
+
+		void ReleaseChunkList(Chunk* chunk) {
+			while (chunk) {
+				Chunk* next = chunk->next;
+				ReleaseChunk(chunk);
+				chunk = next;
+			}
+		}
+
+		static TSize ComputeChunkListUsage(Chunk* chunk) {
+			TSize usage = 0;
+
+			for (; chunk; chunk = chunk->next) {
+				usage += chunk->offset.load(std::memory_order_relaxed);
+			}
+
+			return usage;
+		}
+
 	private:
-		byte* m_MemoryPool = nullptr;
-		Atomic<TSize> m_Size = 0;
-		TSize m_MaxSize = 0;
+		TSize m_ChunkSize;
+		uint32 m_NumFrames;
+		uint32 m_FrameIndex = 0;
+		Atomic<uint64> m_Epoch;
+
+		std::array<Chunk*, MAX_FRAMES_IN_FLIGHT> m_FrameChunks; // Chunks used by each frame in flight
+		Chunk* m_FreeChunks = nullptr; // Pool of recycled chunks of `m_ChunkSize` size
+
+		TSize m_LastFrameUsage = 0;
+		TSize m_PeakFrameUsage = 0;
+		TSize m_CommittedMemory = 0;
+		uint32 m_NumChunks = 0;
+		uint64 m_TotalAllocations = 0;
+
+		std::mutex m_Mutex;
+
+#ifdef OMNIFORCE_DEBUG
+		Atomic<std::thread::id> m_FrameThread;
+#endif
 	};
 
 	/*
-	*  @brief Global allocator for data that lives one frame. Managed by the engine. Do not call `Clear()`
+	*  @brief Global allocator for data that lives for frames in flight. Managed by the engine. Do not call `BeginFrame()` or `Clear()`
 	*/
-	inline TransientAllocator<true> g_TransientAllocator = IAllocator::Setup<TransientAllocator<true>>(1024 * 1024 * 32);
+	inline TransientAllocator<true> g_TransientAllocator = IAllocator::Setup<TransientAllocator<true>>(1024 * 1024);
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+#include <Foundation/Memory/Allocator.h>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <filesystem>
+
+namespace Omni {
+
+	class VirtualMemoryBlock;
+
+	/*
+	*	@brief Runtime registry of named allocators and virtual memory blocks.
+	*	Global allocators are registered automatically; any other allocator (e.g. `TaggedAllocator`) or virtual memory block
+	*	can be registered under a name to be included into reports. Registered objects must be unregistered before destruction
+	*/
+	class OMNIFORCE_API MemoryTelemetry {
+	public:
+		struct Report {
+			std::string name;
+			AllocatorStats stats;
+			uint64 frame_allocations; // Allocations made during the last completed frame
+		};
+
+		static void RegisterAllocator(std::string_view name, IAllocator* allocator);
+		static void UnregisterAllocator(IAllocator* allocator);
+
+		static void RegisterVirtualMemoryBlock(std::string_view name, VirtualMemoryBlock* block);
+		static void UnregisterVirtualMemoryBlock(VirtualMemoryBlock* block);
+
+		// Called by the engine once per frame to compute per-frame allocation counts
+		static void OnFrameEnd();
+
+		static std::vector<Report> Query();
+
+		static void Serialize(nlohmann::json& node);
+		static bool DumpJSON(const std::filesystem::path& path);
+
+	};
+
+}
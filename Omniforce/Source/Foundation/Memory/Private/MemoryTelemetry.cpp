@@ -0,0 +1,138 @@
+#include <Foundation/Common.h>
+#include <Foundation/Memory/MemoryTelemetry.h>
+
+#include <mutex>
+
+namespace Omni {
+
+	struct MemoryTelemetryEntry {
+		std::string name;
+		IAllocator* allocator = nullptr;
+		VirtualMemoryBlock* virtual_block = nullptr;
+		uint64 last_total_allocations = 0;
+		uint64 frame_allocations = 0;
+	};
+
+	struct MemoryTelemetryData {
+		MemoryTelemetryData() {
+			entries.push_back({ "Dedicated", &g_DedicatedMemoryAllocator });
+			entries.push_back({ "Persistent", &g_PersistentAllocator });
+			entries.push_back({ "Transient", &g_TransientAllocator });
+			entries.push_back({ "Pool", &g_PoolAllocator });
+		}
+
+		std::mutex mutex;
+		std::vector<MemoryTelemetryEntry> entries;
+	};
+
+	// Function-local static, so allocators can register during static initialization
+	static MemoryTelemetryData& GetTelemetryData()
+	{
+		static MemoryTelemetryData data;
+		return data;
+	}
+
+	static AllocatorStats QueryEntryStats(const MemoryTelemetryEntry& entry)
+	{
+		return entry.allocator ? entry.allocator->GetStats() : entry.virtual_block->GetStats();
+	}
+
+	void MemoryTelemetry::RegisterAllocator(std::string_view name, IAllocator* allocator)
+	{
+		MemoryTelemetryData& data = GetTelemetryData();
+		std::lock_guard lock(data.mutex);
+
+		data.entries.push_back({ std::string(name), allocator, nullptr, allocator->GetStats().total_allocations });
+	}
+
+	void MemoryTelemetry::UnregisterAllocator(IAllocator* allocator)
+	{
+		MemoryTelemetryData& data = GetTelemetryData();
+		std::lock_guard lock(data.mutex);
+
+		std::erase_if(data.entries, [allocator](const MemoryTelemetryEntry& entry) { return entry.allocator == allocator; });
+	}
+
+	void MemoryTelemetry::RegisterVirtualMemoryBlock(std::string_view name, VirtualMemoryBlock* block)
+	{
+		MemoryTelemetryData& data = GetTelemetryData();
+		std::lock_guard lock(data.mutex);
+
+		data.entries.push_back({ std::string(name), nullptr, block, block->GetStats().total_allocations });
+	}
+
+	void MemoryTelemetry::UnregisterVirtualMemoryBlock(VirtualMemoryBlock* block)
+	{
+		MemoryTelemetryData& data = GetTelemetryData();
+		std::lock_guard lock(data.mutex);
+
+		std::erase_if(data.entries, [block](const MemoryTelemetryEntry& entry) { return entry.virtual_block == block; });
+	}
+
+	void MemoryTelemetry::OnFrameEnd()
+	{
+		MemoryTelemetryData& data = GetTelemetryData();
+		std::lock_guard lock(data.mutex);
+
+		for (auto& entry : data.entries) {
+			uint64 total_allocations = QueryEntryStats(entry).total_allocations;
+
+			entry.frame_allocations = total_allocations - entry.last_total_allocations;
+			entry.last_total_allocations = total_allocations;
+		}
+	}
+
+	std::vector<MemoryTelemetry::Report> MemoryTelemetry::Query()
+	{
+		MemoryTelemetryData& data = GetTelemetryData();
+		std::lock_guard lock(data.mutex);
+
+		std::vector<Report> reports;
+		reports.reserve(data.entries.size());
+
+		for (auto& entry : data.entries) {
+			reports.push_back({ entry.name, QueryEntryStats(entry), entry.frame_allocations });
+		}
+
+		return reports;
+	}
+
+	void MemoryTelemetry::Serialize(nlohmann::json& node)
+	{
+		nlohmann::json& allocators_node = node["Allocators"] = nlohmann::json::array();
+
+		for (auto& report : Query()) {
+			nlohmann::json report_node;
+			report_node["Name"] = report.name;
+			report_node["LiveMemory"] = report.stats.live_memory;
+			report_node["PeakMemory"] = report.stats.peak_memory;
+			report_node["ReservedMemory"] = report.stats.reserved_memory;
+			report_node["LiveAllocations"] = report.stats.num_live_allocations;
+			report_node["TotalAllocations"] = report.stats.total_allocations;
+			report_node["FrameAllocations"] = report.frame_allocations;
+			report_node["Fragmentation"] = report.stats.fragmentation;
+
+			allocators_node.push_back(std::move(report_node));
+		}
+	}
+
+	bool MemoryTelemetry::DumpJSON(const std::filesystem::path& path)
+	{
+		nlohmann::json root;
+		Serialize(root);
+
+		std::ofstream output(path);
+
+		if (!output.is_open()) {
+			OMNIFORCE_CORE_ERROR("Failed to dump memory telemetry to \"{}\"", path.string());
+			return false;
+		}
+
+		output << root.dump(4);
+
+		OMNIFORCE_CORE_INFO("Dumped memory telemetry to \"{}\"", path.string());
+
+		return true;
+	}
+
+}
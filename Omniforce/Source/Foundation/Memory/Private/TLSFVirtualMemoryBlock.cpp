@@ -0,0 +1,311 @@
+#include <Foundation/Common.h>
+#include <Foundation/Memory/TLSFVirtualMemoryBlock.h>
+
+#include <bit>
+
+namespace Omni {
+
+	TLSFVirtualMemoryBlock::TLSFVirtualMemoryBlock(uint32 size, uint32 granularity)
+	{
+		if (!granularity)
+			granularity = std::bit_ceil(std::max(1u, (size + MAX_LOOKUP_TABLE_SIZE - 1) / MAX_LOOKUP_TABLE_SIZE));
+
+		OMNIFORCE_ASSERT_TAGGED(std::has_single_bit(granularity), "Virtual memory block granularity must be power of two");
+
+		m_Granularity = granularity;
+		m_GranularityLog2 = std::countr_zero(granularity);
+		m_NumGranules = size >> m_GranularityLog2;
+
+		Clear();
+	}
+
+	void TLSFVirtualMemoryBlock::Clear()
+	{
+		m_Blocks.clear();
+		m_UnusedBlocks.clear();
+		m_OffsetToBlock.assign(m_NumGranules, NONE);
+
+		m_FLBitmap = 0;
+		m_SLBitmaps.fill(0);
+		m_FreeLists.fill(NONE);
+
+		m_NumUsedGranules = 0;
+		m_NumFreeBlocks = 0;
+		m_NumLiveAllocations = 0;
+
+		if (!m_NumGranules)
+			return;
+
+		uint32 block = AcquireBlock();
+		m_Blocks[block] = { 0, m_NumGranules, NONE, NONE, NONE, NONE, false };
+		InsertFreeBlock(block);
+	}
+
+	void TLSFVirtualMemoryBlock::Destroy()
+	{
+		m_NumGranules = 0;
+		Clear();
+
+		m_Blocks.shrink_to_fit();
+		m_UnusedBlocks.shrink_to_fit();
+		m_OffsetToBlock.shrink_to_fit();
+	}
+
+	uint32 TLSFVirtualMemoryBlock::Allocate(uint32 size, uint32 alignment)
+	{
+		alignment = std::max(alignment, 1u);
+		OMNIFORCE_ASSERT_TAGGED(std::has_single_bit(alignment), "Alignment of virtual allocation must be power of two");
+
+		uint32 num_granules = std::max(1u, (uint32)(((uint64)size + m_Granularity - 1) >> m_GranularityLog2));
+		uint32 alignment_granules = std::max(1u, alignment >> m_GranularityLog2);
+
+		// Worst case alignment padding is included into search size, so the found block always fits
+		uint32 block = FindFreeBlock((uint64)num_granules + alignment_granules - 1);
+
+		if (block == NONE)
+			return INVALID_OFFSET;
+
+		RemoveFreeBlock(block);
+
+		// Leading padding becomes a separate free block
+		uint32 offset = m_Blocks[block].offset;
+		uint32 padding = ((offset + alignment_granules - 1) & ~(alignment_granules - 1)) - offset;
+
+		if (padding) {
+			uint32 padding_block = SplitBlock(block, padding);
+			InsertFreeBlock(padding_block);
+		}
+
+		// Trailing remainder is returned to free lists
+		if (m_Blocks[block].size > num_granules) {
+			uint32 allocated_block = SplitBlock(block, num_granules);
+			InsertFreeBlock(block);
+			block = allocated_block;
+		}
+
+		m_Blocks[block].used = true;
+		m_OffsetToBlock[m_Blocks[block].offset] = block;
+
+		m_NumUsedGranules += m_Blocks[block].size;
+		m_NumLiveAllocations++;
+		m_TotalAllocations++;
+		m_PeakUsedMemory = std::max<uint64>(m_PeakUsedMemory, GetUsedMemorySize());
+
+		return m_Blocks[block].offset << m_GranularityLog2;
+	}
+
+	void TLSFVirtualMemoryBlock::Free(uint32 offset)
+	{
+		uint32 granule = offset >> m_GranularityLog2;
+
+		OMNIFORCE_ASSERT_TAGGED(granule < m_NumGranules && (offset & (m_Granularity - 1)) == 0 && m_OffsetToBlock[granule] != NONE,
+			"Attempted to free virtual allocation that was not allocated");
+
+		uint32 block = m_OffsetToBlock[granule];
+		m_OffsetToBlock[granule] = NONE;
+
+		m_NumUsedGranules -= m_Blocks[block].size;
+		m_NumLiveAllocations--;
+		m_Blocks[block].used = false;
+
+		// Coalesce with free neighbours
+		uint32 next = m_Blocks[block].next_physical;
+		if (next != NONE && !m_Blocks[next].used) {
+			RemoveFreeBlock(next);
+			MergeBlocks(block, next);
+		}
+
+		uint32 prev = m_Blocks[block].prev_physical;
+		if (prev != NONE && !m_Blocks[prev].used) {
+			RemoveFreeBlock(prev);
+			MergeBlocks(prev, block);
+			block = prev;
+		}
+
+		InsertFreeBlock(block);
+	}
+
+	AllocatorStats TLSFVirtualMemoryBlock::GetStats()
+	{
+		uint64 free_memory = GetFreeMemorySize();
+
+		AllocatorStats stats = {};
+		stats.live_memory = GetUsedMemorySize();
+		stats.peak_memory = m_PeakUsedMemory;
+		stats.reserved_memory = (uint64)m_NumGranules << m_GranularityLog2;
+		stats.num_live_allocations = m_NumLiveAllocations;
+		stats.total_allocations = m_TotalAllocations;
+		stats.fragmentation = free_memory ? 1.0f - (float32)GetLargestFreeBlockSize() / (float32)free_memory : 0.0f;
+
+		return stats;
+	}
+
+	uint32 TLSFVirtualMemoryBlock::GetLargestFreeBlockSize() const
+	{
+		if (!m_FLBitmap)
+			return 0;
+
+		// Largest block is in the highest non-empty size class, sizes within a class differ, so the class list is scanned
+		uint32 fl = 31 - std::countl_zero(m_FLBitmap);
+		uint32 sl = 31 - std::countl_zero(m_SLBitmaps[fl]);
+
+		uint32 largest_size = 0;
+		for (uint32 block = m_FreeLists[fl * SL_COUNT + sl]; block != NONE; block = m_Blocks[block].next_free)
+			largest_size = std::max(largest_size, m_Blocks[block].size);
+
+		return largest_size << m_GranularityLog2;
+	}
+
+	TLSFVirtualMemoryBlock::SizeClass TLSFVirtualMemoryBlock::MapSize(uint32 size)
+	{
+		// Small sizes are mapped linearly into the first class
+		if (size < SL_COUNT)
+			return { 0, size };
+
+		uint32 size_log2 = 31 - std::countl_zero(size);
+		uint32 fl = size_log2 - SL_COUNT_LOG2 + 1;
+		uint32 sl = (size >> (size_log2 - SL_COUNT_LOG2)) - SL_COUNT;
+
+		return { fl, sl };
+	}
+
+	TLSFVirtualMemoryBlock::SizeClass TLSFVirtualMemoryBlock::MapSizeForSearch(uint64 size)
+	{
+		if (size >= SL_COUNT) {
+			uint32 size_log2 = 63 - std::countl_zero(size);
+			size += (1ull << (size_log2 - SL_COUNT_LOG2)) - 1;
+		}
+
+		// Can't be satisfied by any block
+		if (size > UINT32_MAX)
+			return { FL_COUNT, 0 };
+
+		return MapSize((uint32)size);
+	}
+
+	uint32 TLSFVirtualMemoryBlock::AcquireBlock()
+	{
+		if (!m_UnusedBlocks.empty()) {
+			uint32 block = m_UnusedBlocks.back();
+			m_UnusedBlocks.pop_back();
+			return block;
+		}
+
+		m_Blocks.emplace_back();
+		return (uint32)m_Blocks.size() - 1;
+	}
+
+	void TLSFVirtualMemoryBlock::ReleaseBlock(uint32 block)
+	{
+		m_UnusedBlocks.push_back(block);
+	}
+
+	void TLSFVirtualMemoryBlock::InsertFreeBlock(uint32 block)
+	{
+		auto [fl, sl] = MapSize(m_Blocks[block].size);
+		uint32& head = m_FreeLists[fl * SL_COUNT + sl];
+
+		m_Blocks[block].prev_free = NONE;
+		m_Blocks[block].next_free = head;
+
+		if (head != NONE)
+			m_Blocks[head].prev_free = block;
+
+		head = block;
+
+		m_FLBitmap |= 1u << fl;
+		m_SLBitmaps[fl] |= 1u << sl;
+		m_NumFreeBlocks++;
+	}
+
+	void TLSFVirtualMemoryBlock::RemoveFreeBlock(uint32 block)
+	{
+		auto [fl, sl] = MapSize(m_Blocks[block].size);
+		uint32& head = m_FreeLists[fl * SL_COUNT + sl];
+
+		uint32 prev = m_Blocks[block].prev_free;
+		uint32 next = m_Blocks[block].next_free;
+
+		if (prev != NONE)
+			m_Blocks[prev].next_free = next;
+		else
+			head = next;
+
+		if (next != NONE)
+			m_Blocks[next].prev_free = prev;
+
+		if (head == NONE) {
+			m_SLBitmaps[fl] &= ~(1u << sl);
+
+			if (!m_SLBitmaps[fl])
+				m_FLBitmap &= ~(1u << fl);
+		}
+
+		m_NumFreeBlocks--;
+	}
+
+	uint32 TLSFVirtualMemoryBlock::FindFreeBlock(uint64 size) const
+	{
+		auto [fl, sl] = MapSizeForSearch(size);
+
+		if (fl < FL_COUNT) {
+			// Look for a non-empty class at or after the requested one within the same first level class
+			uint32 sl_bitmap = m_SLBitmaps[fl] & (~0u << sl);
+
+			if (!sl_bitmap) {
+				// Then take the smallest non-empty first level class above
+				uint32 fl_bitmap = fl + 1 < 32 ? m_FLBitmap & (~0u << (fl + 1)) : 0;
+
+				if (fl_bitmap) {
+					fl = std::countr_zero(fl_bitmap);
+					sl_bitmap = m_SLBitmaps[fl];
+				}
+			}
+
+			if (sl_bitmap)
+				return m_FreeLists[fl * SL_COUNT + std::countr_zero(sl_bitmap)];
+		}
+
+		// Rounded up search skips blocks of the requested class, which still may fit, e.g. when the whole block is allocated.
+		// Only the list head is checked to keep the search O(1), so a fitting block deeper in the list may be missed
+		if (size > UINT32_MAX)
+			return NONE;
+
+		auto [exact_fl, exact_sl] = MapSize((uint32)size);
+		uint32 block = m_FreeLists[exact_fl * SL_COUNT + exact_sl];
+
+		return block != NONE && m_Blocks[block].size >= size ? block : NONE;
+	}
+
+	uint32 TLSFVirtualMemoryBlock::SplitBlock(uint32 block, uint32 size)
+	{
+		uint32 new_block = AcquireBlock();
+
+		// References are taken after acquisition, it may reallocate block storage
+		Block& source = m_Blocks[block];
+		Block& front = m_Blocks[new_block];
+
+		front = { source.offset, size, source.prev_physical, block, NONE, NONE, false };
+
+		if (source.prev_physical != NONE)
+			m_Blocks[source.prev_physical].next_physical = new_block;
+
+		source.offset += size;
+		source.size -= size;
+		source.prev_physical = new_block;
+
+		return new_block;
+	}
+
+	void TLSFVirtualMemoryBlock::MergeBlocks(uint32 block, uint32 next)
+	{
+		m_Blocks[block].size += m_Blocks[next].size;
+		m_Blocks[block].next_physical = m_Blocks[next].next_physical;
+
+		if (m_Blocks[next].next_physical != NONE)
+			m_Blocks[m_Blocks[next].next_physical].prev_physical = block;
+
+		ReleaseBlock(next);
+	}
+
+}
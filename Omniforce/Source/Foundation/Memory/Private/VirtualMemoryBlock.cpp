@@ -1,15 +1,32 @@
 #include "../VirtualMemoryBlock.h"
+#include "../MemoryTelemetry.h"
 
-#include <Platform/Vulkan/VulkanVirtualMemoryBlock.h>
+#include "../TLSFVirtualMemoryBlock.h"
+
+// Renderer-independent builds (asset cooker) have no Vulkan backend
+#ifndef OMNIFORCE_NO_RENDERER
+	#include <Platform/Vulkan/VulkanVirtualMemoryBlock.h>
+#endif
 #include <Foundation/Memory/Allocators/PersistentAllocator.h>
 
 #include <memory>
 
 namespace Omni {
 
-	Ptr<VirtualMemoryBlock> VirtualMemoryBlock::Create(IAllocator* allocator, uint32 size)
+	Ptr<VirtualMemoryBlock> VirtualMemoryBlock::Create(IAllocator* allocator, uint32 size, VirtualMemoryBlockBackend backend, uint32 granularity)
+	{
+		switch (backend) {
+		case VirtualMemoryBlockBackend::TLSF:	return CreatePtr<TLSFVirtualMemoryBlock>(allocator, size, granularity);
+#ifndef OMNIFORCE_NO_RENDERER
+		case VirtualMemoryBlockBackend::VMA:	return CreatePtr<VulkanVirtualMemoryBlock>(allocator, size);
+#endif
+		default:								OMNIFORCE_ASSERT_TAGGED(false, "Unknown or unavailable virtual memory block backend"); return nullptr;
+		}
+	}
+
+	VirtualMemoryBlock::~VirtualMemoryBlock()
 	{
-		return CreatePtr<VulkanVirtualMemoryBlock>(allocator, size);
+		MemoryTelemetry::UnregisterVirtualMemoryBlock(this);
 	}
 
 }
\ No newline at end of file
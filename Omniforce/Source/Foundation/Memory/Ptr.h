@@ -2,6 +2,7 @@
 
 #include <Foundation/Platform.h>
 #include <Foundation/BasicTypes.h>
+#include <Foundation/TypeTraits.h>
 
 #include <Foundation/Memory/MemoryAllocation.h>
 #include <Foundation/Memory/Allocator.h>
@@ -43,8 +44,8 @@ namespace Omni {
 			m_Allocator = nullptr;
 		}
 
-		template<typename T>
-		Ptr(T*) = delete;
+		template<typename U>
+		Ptr(U*) = delete;
 
 		Ptr(Ptr<T>&& other) noexcept
 			: m_Allocator(other.m_Allocator)
@@ -138,6 +139,9 @@ namespace Omni {
 
 	};
 
+	template<typename T>
+	struct TriviallyRelocatable<Ptr<T>> : std::true_type {};
+
 	template<typename U, typename... TArgs>
 	Ptr<U> CreatePtr(IAllocator* allocator, TArgs&&... args) {
 		return Ptr<U>(allocator, std::forward<TArgs>(args)...);
@@ -2,71 +2,102 @@
 
 #include <Foundation/Platform.h>
 #include <Foundation/BasicTypes.h>
+#include <Foundation/TypeTraits.h>
 
+#include <Foundation/Memory/PtrCommon.h>
 #include <Foundation/Memory/MemoryAllocation.h>
 #include <Foundation/Memory/Allocator.h>
 #include <Foundation/Assert.h>
 
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+
 namespace Omni {
+
 	/*
-	*  @brief Ref-counted pointer
+	*  @brief Ref counter policy for objects that can be shared between threads
 	*/
-	template<typename T>
-	class OMNIFORCE_API Ref {
-	public:
-		using TCounter = uint64;
-
-		struct StorageType {
-			template<typename... TArgs>
-			requires (!std::is_abstract_v<T>)
-			StorageType(TArgs&&... args)
-				: object(), ref_counter(1)
-			{
-				new (object) T(std::forward<TArgs>(args)...);
-			}
+	struct ThreadSafeRefCounter {
+		static void Increment(uint32& counter) {
+			std::atomic_ref(counter).fetch_add(1, std::memory_order_relaxed);
+		}
 
-			template<typename... TArgs>
-			requires std::is_abstract_v<T>
-			StorageType(TArgs&&... args)
-				: object(), ref_counter(1)
-			{
-				OMNIFORCE_ASSERT_TAGGED(false, "Cannot instantiate abstract class");
-			}
+		// Returns true if the last reference was released
+		static bool Decrement(uint32& counter) {
+			return std::atomic_ref(counter).fetch_sub(1, std::memory_order_acq_rel) == 1;
+		}
+	};
 
-			~StorageType()
-			{
-				T* typed_object = (T*)object;
-				typed_object->~T();
-			}
+	/*
+	*  @brief Ref counter policy for objects that never leave the thread they were created on
+	*/
+	struct SingleThreadRefCounter {
+		static void Increment(uint32& counter) {
+			counter++;
+		}
 
-			Atomic<TCounter> ref_counter;
-			byte object[sizeof(T)]; // a hack that forbids allocation of T explicitly
-		};
+		// Returns true if the last reference was released
+		static bool Decrement(uint32& counter) {
+			return --counter == 0;
+		}
+	};
+
+	/*
+	*  @brief Stored right before the object in the same allocation, so a handle only needs an object pointer.
+	*  Keeps everything that is required to destroy the object, so it is correctly destroyed by a handle of any related type
+	*/
+	struct alignas(16) RefControlBlock {
+		uint32 ref_counter;
+		uint32 object_offset; // Offset of the object from the allocation start
+		uint64 allocation_size;
+		IAllocator* allocator;
+		void (*destructor)(void* object);
+	};
+
+	/*
+	*  @brief Intrusive ref-counted pointer, a handle is a single pointer.
+	*  Copies touch the counter according to `TCounterPolicy`, moves do not touch it at all.
+	*  Handles of related types can be converted as long as the object address is not adjusted by conversion (no multiple inheritance)
+	*/
+	template<typename T, typename TCounterPolicy = ThreadSafeRefCounter>
+	class OMNIFORCE_API Ref {
+	public:
+		inline static constexpr uint64 OBJECT_ALIGNMENT = std::max(alignof(T), alignof(RefControlBlock));
 
 		template<typename... TArgs>
 		Ref(IAllocator* allocator, TArgs&&... args)
-			: m_Allocator(allocator)
 		{
-			// Make one allocation for both counter and object so we get better caching
-			m_Allocation = m_Allocator->Allocate<StorageType>(std::forward<TArgs>(args)...);
+			static_assert(!std::is_abstract_v<T>, "Cannot instantiate abstract class");
+
+			// Allocators only guarantee default alignment, so over-aligned objects need padding
+			constexpr uint64 alignment_padding = OBJECT_ALIGNMENT > IAllocator::DEFAULT_ALIGNMENT ? OBJECT_ALIGNMENT - IAllocator::DEFAULT_ALIGNMENT : 0;
+
+			// Make one allocation for both control block and object so we get better caching
+			MemoryAllocation allocation = allocator->AllocateBase(sizeof(RefControlBlock) + alignment_padding + sizeof(T));
+			OMNIFORCE_ASSERT_TAGGED(allocation.IsValid(), "Failed to allocate ref-counted object");
+
+			byte* object_memory = (byte*)IAllocator::AlignUp((uint64)allocation.Memory + sizeof(RefControlBlock), OBJECT_ALIGNMENT);
 
-			// Cache object and pointer so we don't need to add `sizeof(CounterType)` each time we access an object
-			m_CachedObject = (T*)(m_Allocation.Memory + sizeof(TCounter));
+			RefControlBlock* control_block = (RefControlBlock*)(object_memory - sizeof(RefControlBlock));
+			control_block->ref_counter = 1;
+			control_block->object_offset = (uint32)(object_memory - allocation.Memory);
+			control_block->allocation_size = allocation.Size;
+			control_block->allocator = allocator;
+			control_block->destructor = [](void* object) { ((T*)object)->~T(); };
+
+			m_Object = new (object_memory) T(std::forward<TArgs>(args)...);
 		};
 
 	public:
 		Ref()
-			: m_Allocator(nullptr)
-			, m_Allocation(MemoryAllocation::InvalidAllocation())
-			, m_CachedObject(nullptr)
+			: m_Object(nullptr)
 		{
 		}
 
 		// Make it only possible to accept nullptr
 		Ref(std::nullptr_t)
-			: m_Allocator(nullptr)
-			, m_Allocation(MemoryAllocation::InvalidAllocation())
-			, m_CachedObject(nullptr)
+			: m_Object(nullptr)
 		{}
 
 		// Delete all other variations except nullptr
@@ -74,224 +105,178 @@ namespace Omni {
 		Ref(U*) = delete;
 
 		Ref(const Ref& other)
-			: m_Allocator(other.m_Allocator)
-			, m_Allocation(other.m_Allocation)
-			, m_CachedObject((T*)other.m_CachedObject)
+			: m_Object(other.m_Object)
 		{
 			IncrementRefCounter();
 		};
 
 		template<typename U>
-		Ref(const Ref<U>& other)
-			: m_Allocator(other.m_Allocator)
-			, m_Allocation(other.m_Allocation)
-			, m_CachedObject((T*)other.m_CachedObject)
+		Ref(const Ref<U, TCounterPolicy>& other)
+			: m_Object(ConvertObject(other.m_Object))
 		{
-			static_assert(std::is_same_v<T, U> || std::is_base_of_v<T, U> || std::is_base_of_v<U, T>, "Types are not related to each other");
-
 			IncrementRefCounter();
 		};
 
-		template<typename U>
-		Ref(Ref<U>&& other) noexcept
-			: m_Allocator(other.m_Allocator)
-			, m_Allocation(other.m_Allocation)
-			, m_CachedObject((T*)other.m_CachedObject)
+		Ref(Ref&& other) noexcept
+			: m_Object(other.m_Object)
 		{
-			static_assert(std::is_same_v<T, U> || std::is_base_of_v<T, U> || std::is_base_of_v<U, T>, "Types are not related to each other");
-
-			IncrementRefCounter();
+			other.m_Object = nullptr;
+		}
 
-			other.Reset();
+		template<typename U>
+		Ref(Ref<U, TCounterPolicy>&& other) noexcept
+			: m_Object(ConvertObject(other.m_Object))
+		{
+			other.m_Object = nullptr;
 		}
 
 		~Ref() {
-			// Decrement ref counter
-			DecrementRefCounter();
-
-			// Check if allocation is valid (e.g. if this pointer references some object)
-			if (CanReleaseAllocation()) {
-				ReleaseAllocation();
-			}
+			Release();
 		}
 
 		inline constexpr T* Raw() const {
-			return m_CachedObject;
+			return m_Object;
 		}
 
 		void Reset() {
-			DecrementRefCounter();
-
-			m_Allocator = nullptr;
-			m_Allocation = MemoryAllocation::InvalidAllocation();
-			m_CachedObject = nullptr;
-
-			if (CanReleaseAllocation()) {
-				ReleaseAllocation();
-			}
+			Release();
+			m_Object = nullptr;
 		}
 
 		Ref& operator=(const Ref& other) noexcept {
-			// Early out in case if two pointers are referencing the same resource
-			if (m_Allocation == other.m_Allocation) [[unlikely]] {
-				return *this;
-			}
-
-			if (m_Allocation.IsValid()) {
-				DecrementRefCounter();
-
-				if (CanReleaseAllocation()) {
-					ReleaseAllocation();
-				}
-			}
-
-			m_Allocator = other.m_Allocator;
-			m_Allocation = other.m_Allocation;
-			m_CachedObject = (T*)other.m_CachedObject;
-
-			IncrementRefCounter();
+			// Increment first, so self-assignment and assignment of a handle owned by the current object are safe
+			T* object = other.m_Object;
+			AddReference(object);
+			Release();
+			m_Object = object;
 
 			return *this;
 		}
 
 		template<typename U>
-		Ref<T>& operator=(const Ref<U>& other) noexcept {
-			static_assert(std::is_same_v<T, U> || std::is_base_of_v<T, U> || std::is_base_of_v<U, T>, "Types are not related to each other");
-
-			// Early out in case if two pointers are referencing the same resource
-			if (m_Allocation == other.m_Allocation) [[unlikely]] {
-				return *this;
-			}
-
-			if (m_Allocation.IsValid()) {
-				DecrementRefCounter();
-
-				if (CanReleaseAllocation()) {
-					ReleaseAllocation();
-				}
-			}
-
-			m_Allocator = other.m_Allocator;
-			m_Allocation = other.m_Allocation;
-			m_CachedObject = (T*)other.m_CachedObject;
-
-			IncrementRefCounter();
+		Ref& operator=(const Ref<U, TCounterPolicy>& other) noexcept {
+			T* object = ConvertObject(other.m_Object);
+			AddReference(object);
+			Release();
+			m_Object = object;
 
 			return *this;
 		}
 
 		Ref& operator=(Ref&& other) noexcept {
-			// Early out in case if two pointers are referencing the same resource
-			if (m_Allocation == other.m_Allocation) [[unlikely]] {
-				return *this;
-			}
+			// Detach source first, so self-move and assignment of a handle owned by the current object are safe
+			T* object = other.m_Object;
+			other.m_Object = nullptr;
 
-			if (m_Allocation.IsValid()) {
-				DecrementRefCounter();
-
-				if (CanReleaseAllocation()) {
-					ReleaseAllocation();
-				}
-			}
-
-			m_Allocator = other.m_Allocator;
-			m_Allocation = other.m_Allocation;
-			m_CachedObject = other.m_CachedObject;
-
-			IncrementRefCounter();
-
-			other.Reset();
+			Release();
+			m_Object = object;
 
 			return *this;
 		}
 
 		template<typename U>
-		Ref<T>& operator=(Ref<U>&& other) noexcept {
-			static_assert(std::is_same_v<T, U> || std::is_base_of_v<T, U> || std::is_base_of_v<U, T>, "Types are not related to each other");
-
-			// Early out in case if two pointers are referencing the same resource
-			if (m_Allocation == other.m_Allocation) [[unlikely]] {
-				return *this;
-			}
-
-			if (m_Allocation.IsValid()) {
-				DecrementRefCounter();
-
-				if (CanReleaseAllocation()) {
-					ReleaseAllocation();
-				}
-			}
+		Ref& operator=(Ref<U, TCounterPolicy>&& other) noexcept {
+			T* object = ConvertObject(other.m_Object);
+			other.m_Object = nullptr;
 
-			m_Allocator = other.m_Allocator;
-			m_Allocation = other.m_Allocation;
-			m_CachedObject = other.m_CachedObject;
-
-			IncrementRefCounter();
-
-			other.Reset();
+			Release();
+			m_Object = object;
 
 			return *this;
 		};
 
 		inline T* operator->() const {
-			return m_CachedObject;
+			return m_Object;
 		}
 
 		inline T& operator*() {
-			return *m_CachedObject;
+			return *m_Object;
 		}
 
 		inline operator bool() const {
-			return m_Allocation.IsValid();
+			return m_Object != nullptr;
 		}
 
-		template<typename T, typename... TArgs>
-		friend Ref<T> CreateRef(IAllocator* allocator, TArgs&&... args);
+		// Number of handles that reference the object, intended for debugging
+		uint32 GetRefCount() const {
+			// Counter may be modified by other threads concurrently
+			return m_Object ? std::atomic_ref(GetControlBlock(m_Object)->ref_counter).load(std::memory_order_relaxed) : 0;
+		}
 
-		template<typename U>
+		template<typename U, typename UCounterPolicy>
 		friend class Ref;
 
 	private:
-		inline bool CanReleaseAllocation() const noexcept {
-			// Check if allocation is valid (e.g. if this pointer references some object)
-			if (!m_Allocation.IsValid()) {
-				return false;
-			}
+		template<typename U>
+		inline static T* ConvertObject(U* object) {
+			static_assert(PtrCheckType<T, U>, "Types are not related to each other");
+
+			T* converted_object = (T*)object;
 
-			if (*m_Allocation.As<Atomic<TCounter>>() != 0) { // for some reason fails to compile here
-				return false;
+			// Control block is found by object address, so an adjusted address would corrupt the heap. Fatal in all configurations
+			if ((void*)converted_object != (void*)object) [[unlikely]] {
+				OMNIFORCE_CORE_CRITICAL("Ref conversion must not adjust object address, types are related by multiple inheritance");
+				std::abort();
 			}
 
-			return true;
+			return converted_object;
 		}
 
-		inline void ReleaseAllocation() {
-			// Free resource
-			m_Allocator->Free<StorageType>(m_Allocation);
+		inline static RefControlBlock* GetControlBlock(T* object) {
+			return (RefControlBlock*)((byte*)object - sizeof(RefControlBlock));
 		}
 
 		inline void IncrementRefCounter() {
-			if (m_Allocation.IsValid()) {
-				(*m_Allocation.As<Atomic<TCounter>>())++;
+			AddReference(m_Object);
+		}
+
+		inline static void AddReference(T* object) {
+			if (object) {
+				TCounterPolicy::Increment(GetControlBlock(object)->ref_counter);
 			}
 		}
 
-		inline void DecrementRefCounter() {
-			if (m_Allocation.IsValid()) {
-				(*m_Allocation.As<Atomic<TCounter>>())--;
+		inline void Release() {
+			if (!m_Object) {
+				return;
+			}
+
+			RefControlBlock* control_block = GetControlBlock(m_Object);
+
+			if (TCounterPolicy::Decrement(control_block->ref_counter)) {
+				// Copy control block data, since it is located in the memory that is about to be freed
+				IAllocator* allocator = control_block->allocator;
+				MemoryAllocation allocation((byte*)m_Object - control_block->object_offset, control_block->allocation_size);
+
+				control_block->destructor(m_Object);
+				allocator->FreeBase(allocation);
 			}
 		}
 
 	private:
-		IAllocator* m_Allocator;
-		MemoryAllocation m_Allocation;
-		T* m_CachedObject;
+		T* m_Object;
 	};
 
+	// Handle does not point to itself, so it can be relocated with `memcpy`
+	template<typename T, typename TCounterPolicy>
+	struct TriviallyRelocatable<Ref<T, TCounterPolicy>> : std::true_type {};
+
+	/*
+	*  @brief Ref-counted pointer without atomic operations, must not be shared between threads
+	*/
+	template<typename T>
+	using LocalRef = Ref<T, SingleThreadRefCounter>;
+
 	template<typename T, typename... TArgs>
 		requires (!std::is_abstract_v<T>)
 	Ref<T> CreateRef(IAllocator* allocator, TArgs&&... args) {
 		return Ref<T>(allocator, std::forward<TArgs>(args)...);
 	}
 
-}
\ No newline at end of file
+	template<typename T, typename... TArgs>
+		requires (!std::is_abstract_v<T>)
+	LocalRef<T> CreateLocalRef(IAllocator* allocator, TArgs&&... args) {
+		return LocalRef<T>(allocator, std::forward<TArgs>(args)...);
+	}
+
+}
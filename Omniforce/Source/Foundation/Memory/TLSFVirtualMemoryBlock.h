@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Foundation/BasicTypes.h>
+#include <Foundation/Memory/VirtualMemoryBlock.h>
+
+#include <vector>
+#include <array>
+
+namespace Omni {
+
+	/*
+	*	@brief Backend-independent offset allocator built on two-level segregated fit (TLSF) free lists, suitable for any GPU or CPU sub-allocation.
+	*	Allocation and free are O(1): free blocks are binned by size into first level (power of two) and second level (linear subdivision)
+	*	classes with a bitmap per level, so a fitting block is found with two bit scans.
+	*	Offsets and sizes are multiples of granularity. Allocated offsets are mapped to block descriptors with a direct lookup table
+	*	of `size / granularity` entries, so freeing by offset does not involve hashing. By default granularity is picked so the table has at most 64K entries
+	*/
+	class OMNIFORCE_API TLSFVirtualMemoryBlock : public VirtualMemoryBlock {
+	public:
+		inline static constexpr uint32 SL_COUNT_LOG2 = 4;
+		inline static constexpr uint32 SL_COUNT = 1 << SL_COUNT_LOG2;
+		inline static constexpr uint32 FL_COUNT = 32 - SL_COUNT_LOG2 + 1;
+		inline static constexpr uint32 MAX_LOOKUP_TABLE_SIZE = 64 * 1024;
+
+		// `granularity` must be power of two, 0 to pick it automatically
+		TLSFVirtualMemoryBlock(uint32 size, uint32 granularity = 0);
+
+		void Clear() override;
+		void Destroy() override;
+		uint32 Allocate(uint32 size, uint32 alignment = 0) override;
+		void Free(uint32 offset) override;
+
+		uint32 GetUsedMemorySize() override { return m_NumUsedGranules * m_Granularity; }
+		uint32 GetFreeMemorySize() override { return (m_NumGranules - m_NumUsedGranules) * m_Granularity; }
+		AllocatorStats GetStats() override;
+
+		uint32 GetGranularity() const { return m_Granularity; }
+
+		// @return size of the largest allocation that can currently succeed
+		uint32 GetLargestFreeBlockSize() const;
+
+	private:
+		inline static constexpr uint32 NONE = UINT32_MAX;
+
+		// Offsets and sizes are in granules
+		struct Block {
+			uint32 offset;
+			uint32 size;
+			uint32 prev_physical;
+			uint32 next_physical;
+			uint32 prev_free;
+			uint32 next_free;
+			bool used;
+		};
+
+		struct SizeClass {
+			uint32 fl;
+			uint32 sl;
+		};
+
+		static SizeClass MapSize(uint32 size);
+
+		// Rounds size up to the next size class, so any block of the returned class fits the size
+		static SizeClass MapSizeForSearch(uint64 size);
+
+		uint32 AcquireBlock();
+		void ReleaseBlock(uint32 block);
+
+		void InsertFreeBlock(uint32 block);
+		void RemoveFreeBlock(uint32 block);
+		uint32 FindFreeBlock(uint64 size) const;
+
+		// Cuts `size` granules from the beginning of the block into a new block, which is returned
+		uint32 SplitBlock(uint32 block, uint32 size);
+		// Merges next physical block into the block
+		void MergeBlocks(uint32 block, uint32 next);
+
+	private:
+		uint32 m_Granularity;
+		uint32 m_GranularityLog2;
+		uint32 m_NumGranules;
+
+		std::vector<Block> m_Blocks;
+		std::vector<uint32> m_UnusedBlocks;
+		std::vector<uint32> m_OffsetToBlock; // Granule index - allocated block
+
+		uint32 m_FLBitmap = 0;
+		std::array<uint32, FL_COUNT> m_SLBitmaps = {};
+		std::array<uint32, FL_COUNT * SL_COUNT> m_FreeLists;
+
+		uint32 m_NumUsedGranules = 0;
+		uint32 m_NumFreeBlocks = 0;
+		uint64 m_NumLiveAllocations = 0;
+		uint64 m_TotalAllocations = 0;
+		uint64 m_PeakUsedMemory = 0;
+	};
+
+}
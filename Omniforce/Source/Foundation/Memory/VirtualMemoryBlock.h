@@ -5,12 +5,26 @@
 
 namespace Omni {
 
+	enum class OMNIFORCE_API VirtualMemoryBlockBackend : uint8 {
+		TLSF,	// Engine-native, backend-independent
+		VMA		// Vulkan Memory Allocator virtual block
+	};
+
 	class VirtualMemoryBlock {
 	protected:
 		VirtualMemoryBlock() {};
 
 	public:
-		static Ptr<VirtualMemoryBlock> Create(IAllocator* allocator, uint32 size);
+		// Returned by `Allocate` if there is no free range that fits the allocation
+		inline static constexpr uint32 INVALID_OFFSET = UINT32_MAX;
+
+		/*
+		*	@brief Creates virtual block. `granularity` is a power of two all offsets and sizes are multiple of,
+		*	0 to pick it automatically. Only TLSF backend takes it into account
+		*/
+		static Ptr<VirtualMemoryBlock> Create(IAllocator* allocator, uint32 size, VirtualMemoryBlockBackend backend = VirtualMemoryBlockBackend::TLSF, uint32 granularity = 0);
+
+		virtual ~VirtualMemoryBlock();
 
 		virtual void Clear() = 0;
 		virtual void Destroy() = 0;
@@ -19,6 +33,7 @@ namespace Omni {
 
 		virtual uint32 GetUsedMemorySize() = 0;
 		virtual uint32 GetFreeMemorySize() = 0;
+		virtual AllocatorStats GetStats() = 0;
 
 	};
 
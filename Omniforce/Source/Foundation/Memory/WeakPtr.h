@@ -2,6 +2,7 @@
 
 #include <Foundation/Platform.h>
 #include <Foundation/BasicTypes.h>
+#include <Foundation/TypeTraits.h>
 
 #include <Foundation/Memory/PtrCommon.h>
 #include <Foundation/Memory/MemoryAllocation.h>
@@ -10,19 +11,16 @@
 #include <Foundation/Assert.h>
 
 namespace Omni {
-	template<typename T>
-	class Ref;
-
 	template<typename T>
 	class Ptr;
 
 	template<typename T>
 	class WeakPtr;
 
-	template<template<typename> class PtrType, typename T, typename U>
+	template<template<typename...> class PtrType, typename T, typename U>
 	concept SupportsWeakPtr = ((std::is_same_v<PtrType<U>, Ref<U>> || std::is_same_v<PtrType<U>, Ptr<U>> || std::is_same_v<PtrType<U>, WeakPtr<U>>) && PtrCheckType<T, U>);
 
-	template<template<typename> typename PtrType, typename T>
+	template<template<typename...> typename PtrType, typename T>
 	concept IsPtrOrRef = (std::is_same_v<PtrType<T>, Ptr<T>> || std::is_same_v<PtrType<T>, Ref<T>>);
 
 	/*
@@ -60,31 +58,31 @@ namespace Omni {
 		}
 
 		// Allow copy constructors
-		template<template<typename> class PtrType, typename U>
+		template<template<typename...> class PtrType, typename U, typename... TRest>
 		requires SupportsWeakPtr<PtrType, T, U>
-		WeakPtr<T>(const PtrType<U>& other) noexcept
+		WeakPtr(const PtrType<U, TRest...>& other) noexcept
 		{
 			m_Object = (T*)other.Raw();
 		}
 
 		// Forbid move constructors
-		template<template<typename> class PtrType, typename U>
+		template<template<typename...> class PtrType, typename U, typename... TRest>
 		requires IsPtrOrRef<PtrType, U>
-		WeakPtr(PtrType<U>&& other) noexcept = delete;
+		WeakPtr(PtrType<U, TRest...>&& other) noexcept = delete;
 
 		// Allow copy assignment
-		template<template<typename> class PtrType, typename U>
+		template<template<typename...> class PtrType, typename U, typename... TRest>
 		requires SupportsWeakPtr<PtrType, T, U>
-		WeakPtr<T>& operator=(const PtrType<U>& other) noexcept
+		WeakPtr<T>& operator=(const PtrType<U, TRest...>& other) noexcept
 		{
 			m_Object = (T*)other.Raw();
 			return *this;
 		}
 
 		// Forbid move assignment
-		template<template<typename> class PtrType, typename U>
+		template<template<typename...> class PtrType, typename U, typename... TRest>
 		requires IsPtrOrRef<PtrType, U>
-		WeakPtr<T>& operator=(PtrType<U>&& other) noexcept = delete;
+		WeakPtr<T>& operator=(PtrType<U, TRest...>&& other) noexcept = delete;
 
 		WeakPtr& operator=(const WeakPtr& other) noexcept 
 		{
@@ -120,4 +118,7 @@ namespace Omni {
 		T* m_Object;
 	};
 
+	template<typename T>
+	struct TriviallyRelocatable<WeakPtr<T>> : std::true_type {};
+
 }
\ No newline at end of file
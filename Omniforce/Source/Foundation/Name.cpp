@@ -0,0 +1,118 @@
+#include "Name.h"
+
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace Omni {
+
+	/*
+	*	@brief Open-addressing table with linear probing. Slots are only ever filled, never cleared,
+	*	so lookups are plain atomic loads and insertion is a single CAS into an empty slot
+	*/
+	struct NameTable {
+		inline static constexpr uint64 CAPACITY = 1 << 16;
+		inline static constexpr uint64 MAX_NAMES = CAPACITY / 8 * 7;
+
+		Atomic<const NameEntry*> slots[CAPACITY];
+		Atomic<uint64> num_names;
+	};
+
+	// Constant-initialized, so names can be created during static initialization of other translation units
+	static NameTable s_NameTable;
+
+	// FNV-1a with a finalizer, lower bits of the hash select a slot
+	static uint64 HashString(std::string_view string)
+	{
+		uint64 hash = 0xcbf29ce484222325ull;
+
+		for (char c : string) {
+			hash ^= (uint8)c;
+			hash *= 0x100000001b3ull;
+		}
+
+		return MixHash(hash);
+	}
+
+	// Allocated with global `new`, since engine allocators may not be initialized yet when a static name is created
+	static NameEntry* CreateEntry(std::string_view string, uint64 hash)
+	{
+		byte* memory = new byte[offsetof(NameEntry, data) + string.size() + 1];
+
+		NameEntry* entry = (NameEntry*)memory;
+		entry->hash = hash;
+		entry->length = (uint32)string.size();
+		memcpy(entry->data, string.data(), string.size());
+		entry->data[string.size()] = '\0';
+
+		return entry;
+	}
+
+	static void DestroyEntry(NameEntry* entry)
+	{
+		delete[] (byte*)entry;
+	}
+
+	// Counts a new name before it is inserted. Table is never filled above `MAX_NAMES`, so probing always reaches an empty slot.
+	// Running out of names is fatal in all configurations; logger is not used, since names may be created before it is initialized
+	static void ReserveName(std::string_view string)
+	{
+		uint64 num_names = s_NameTable.num_names.load(std::memory_order_relaxed);
+
+		do {
+			if (num_names >= NameTable::MAX_NAMES) [[unlikely]] {
+				std::fprintf(stderr, "Name table is full (%llu names), failed to intern \"%.*s\"\n", (unsigned long long)num_names, (int)string.size(), string.data());
+				std::abort();
+			}
+		} while (!s_NameTable.num_names.compare_exchange_weak(num_names, num_names + 1, std::memory_order_relaxed));
+	}
+
+	const NameEntry* Name::Intern(std::string_view string)
+	{
+		if (string.empty()) {
+			return nullptr;
+		}
+
+		uint64 hash = HashString(string);
+		uint64 index = hash & (NameTable::CAPACITY - 1);
+
+		// Created lazily, only if the string is not interned yet
+		NameEntry* new_entry = nullptr;
+
+		while (true) {
+			const NameEntry* entry = s_NameTable.slots[index].load(std::memory_order_acquire);
+
+			if (!entry) {
+				if (!new_entry) {
+					ReserveName(string);
+					new_entry = CreateEntry(string, hash);
+				}
+
+				if (s_NameTable.slots[index].compare_exchange_strong(entry, new_entry, std::memory_order_acq_rel, std::memory_order_acquire)) {
+					return new_entry;
+				}
+
+				// Another thread has filled the slot, `entry` now holds its value
+			}
+
+			if (entry->hash == hash && entry->length == string.size() && memcmp(entry->data, string.data(), string.size()) == 0) {
+				// Another thread has interned the same string first
+				if (new_entry) {
+					DestroyEntry(new_entry);
+					s_NameTable.num_names.fetch_sub(1, std::memory_order_relaxed);
+				}
+
+				return entry;
+			}
+
+			index = (index + 1) & (NameTable::CAPACITY - 1);
+		}
+	}
+
+	uint64 Name::GetNumInternedNames()
+	{
+		return s_NameTable.num_names.load(std::memory_order_relaxed);
+	}
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+#include <Foundation/TypeTraits.h>
+#include <Foundation/Hash.h>
+
+#include <string>
+#include <string_view>
+
+#include <spdlog/fmt/fmt.h>
+#include <robin_hood.h>
+
+namespace Omni {
+
+	/*
+	*	@brief Interned string, stored once in a global table and never freed
+	*/
+	struct NameEntry {
+		uint64 hash;
+		uint32 length;
+		char data[1]; // Null-terminated, actual size is `length + 1`
+	};
+
+	/*
+	*	@brief Handle to an interned string. Equal strings are interned into the same entry, so equality is a pointer compare
+	*	and hash is precomputed. Creating a name from a string costs a lookup in a global lock-free table,
+	*	so names for hot paths should be created once and stored.
+	*	Default-constructed name is none and views as an empty string
+	*/
+	class OMNIFORCE_API Name {
+	public:
+		Name() = default;
+
+		Name(std::string_view string)
+			: m_Entry(Intern(string))
+		{}
+
+		Name(const char* string)
+			: Name(std::string_view(string))
+		{}
+
+		Name(const std::string& string)
+			: Name(std::string_view(string))
+		{}
+
+		inline std::string_view View() const {
+			return m_Entry ? std::string_view(m_Entry->data, m_Entry->length) : std::string_view();
+		}
+
+		inline const char* CStr() const {
+			return m_Entry ? m_Entry->data : "";
+		}
+
+		inline std::string ToString() const {
+			return std::string(View());
+		}
+
+		inline uint64 GetHash() const {
+			return m_Entry ? m_Entry->hash : 0;
+		}
+
+		inline bool IsNone() const {
+			return m_Entry == nullptr;
+		}
+
+		inline bool operator==(const Name& other) const {
+			return m_Entry == other.m_Entry;
+		}
+
+		// Orders names by their entries. Order is stable within a single run only and is not lexical
+		inline bool operator<(const Name& other) const {
+			return m_Entry < other.m_Entry;
+		}
+
+		// Lexical order, compares strings
+		inline static bool LexicalLess(const Name& lhs, const Name& rhs) {
+			return lhs.View() < rhs.View();
+		}
+
+		// Number of interned strings, intended for debugging
+		static uint64 GetNumInternedNames();
+
+	private:
+		static const NameEntry* Intern(std::string_view string);
+
+	private:
+		const NameEntry* m_Entry = nullptr;
+	};
+
+	template<>
+	struct TriviallyRelocatable<Name> : std::true_type {};
+
+	template<>
+	struct Hash<Name> {
+		uint64 operator()(const Name& name) const {
+			return name.GetHash();
+		}
+	};
+
+}
+
+namespace robin_hood {
+
+	template<>
+	struct hash<Omni::Name> {
+		size_t operator()(const Omni::Name& name) const {
+			return name.GetHash();
+		}
+	};
+
+}
+
+template<>
+struct fmt::formatter<Omni::Name> : fmt::formatter<std::string_view>
+{
+	template<typename FormatContext>
+	auto format(const Omni::Name& name, FormatContext& ctx) const {
+		return fmt::formatter<std::string_view>::format(name.View(), ctx);
+	};
+
+};
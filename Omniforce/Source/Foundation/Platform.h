@@ -18,8 +18,8 @@
 	#ifndef _WIN64
 		#error Engine requires 64-bit system to build.
 	#endif
-#else
-	#error Only Windows platform is supported
+#elif !defined(__linux__)
+	#error Only Windows and Linux platforms are supported
 #endif
 
 #define OMNIFORCE_PLATFORM_WIN64 0x1
@@ -28,6 +28,8 @@
 
 #if defined(_WIN32) || defined(_WIN64)
 	#define OMNIFORCE_PLATFORM OMNIFORCE_PLATFORM_WIN64
+#elif defined(__linux__)
+	#define OMNIFORCE_PLATFORM OMNIFORCE_PLATFORM_LINUX
 #endif
 
 #if OMNIFORCE_PLATFORM == OMNIFORCE_PLATFORM_WIN64
@@ -40,6 +42,16 @@
 	#elif defined(OMNIFORCE_STATIC)
 		#define OMNIFORCE_API
 	#endif
+
+	#define OMNIFORCE_DEBUG_BREAK() __debugbreak()
+#elif OMNIFORCE_PLATFORM == OMNIFORCE_PLATFORM_LINUX
+	#ifdef OMNIFORCE_DYNAMIC
+		#define OMNIFORCE_API __attribute__((visibility("default")))
+	#elif defined(OMNIFORCE_STATIC)
+		#define OMNIFORCE_API
+	#endif
+
+	#define OMNIFORCE_DEBUG_BREAK() __builtin_trap()
 #endif
 
 #ifdef OMNIFORCE_DEBUG
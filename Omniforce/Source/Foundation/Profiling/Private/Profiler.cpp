@@ -0,0 +1,462 @@
+#include <Foundation/Common.h>
+#include <Foundation/Profiling/Profiler.h>
+
+#include <mutex>
+#include <memory>
+#include <bit>
+
+#include <fmt/format.h>
+
+namespace Omni {
+
+	static constinit Atomic<uint64> s_NumDroppedEvents = 0;
+
+	/*
+	*	@brief Single-producer single-consumer ring buffer of profiler events. Owner thread pushes events,
+	*	profiler drains them under its capture lock. Events which don't fit are dropped and counted
+	*/
+	class ProfilerThreadBuffer {
+	public:
+		ProfilerThreadBuffer(uint32 capacity, uint32 thread_index)
+			: m_Events(new ProfilerEvent[capacity])
+			, m_Capacity(capacity)
+			, m_ThreadIndex(thread_index)
+		{}
+
+		// Producer side
+		void Push(ProfilerEvent event)
+		{
+			uint64 write_position = m_WritePosition.load(std::memory_order_relaxed);
+
+			if (write_position - m_CachedReadPosition >= m_Capacity) {
+				m_CachedReadPosition = m_ReadPosition.load(std::memory_order_acquire);
+
+				if (write_position - m_CachedReadPosition >= m_Capacity) {
+					s_NumDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+			}
+
+			event.thread_index = m_ThreadIndex;
+			m_Events[write_position & (m_Capacity - 1)] = event;
+
+			m_WritePosition.store(write_position + 1, std::memory_order_release);
+		}
+
+		// Consumer side
+		template<typename Func>
+		void Drain(Func&& func)
+		{
+			uint64 read_position = m_ReadPosition.load(std::memory_order_relaxed);
+			uint64 write_position = m_WritePosition.load(std::memory_order_acquire);
+
+			for (uint64 position = read_position; position != write_position; position++)
+				func(m_Events[position & (m_Capacity - 1)]);
+
+			m_ReadPosition.store(write_position, std::memory_order_release);
+		}
+
+		uint32 GetThreadIndex() const { return m_ThreadIndex; }
+
+		void Retire() { m_Retired.store(true, std::memory_order_release); }
+		bool IsRetired() const { return m_Retired.load(std::memory_order_acquire); }
+
+	private:
+		std::unique_ptr<ProfilerEvent[]> m_Events;
+		uint64 m_Capacity;
+		uint32 m_ThreadIndex;
+		Atomic<bool> m_Retired = false;
+
+		// Producer-owned
+		alignas(64) Atomic<uint64> m_WritePosition = 0;
+		uint64 m_CachedReadPosition = 0;
+
+		// Consumer-owned
+		alignas(64) Atomic<uint64> m_ReadPosition = 0;
+	};
+
+	struct ProfilerThreadInfo {
+		std::string name;
+	};
+
+	struct ProfilerState {
+		ProfilerSpecification specification;
+
+		// Guards buffers and thread infos. Threads only take it once, when their buffer is created
+		std::mutex registry_mutex;
+		std::vector<std::shared_ptr<ProfilerThreadBuffer>> buffers;
+		std::vector<ProfilerThreadInfo> threads;
+
+		// Guards capture, taken by the thread which drains buffers
+		std::mutex capture_mutex;
+		std::vector<ProfilerEvent> captured_events;
+		uint64 num_dropped_captured_events = 0;
+		uint64 capture_start_timestamp = 0;
+		uint64 frame_index = 0;
+
+		// Frames left until capture started by `CaptureFrames` is exported, 0 if capture is not limited
+		uint32 num_capture_frames_left = 0;
+		std::filesystem::path capture_export_path;
+	};
+
+	static ProfilerState* s_State = nullptr;
+	static uint64 s_StateGeneration = 0; // Incremented on every initialization, so buffers of a previous profiler instance are not reused
+	static constinit Atomic<ProfilerCounter*> s_CountersHead = nullptr;
+
+	/*
+	*	@brief Per-thread handle to a ring buffer. Holds a reference, so the buffer outlives either the thread
+	*	or the profiler, whichever goes first. Marks buffer as retired on thread exit. Thread name is kept here,
+	*	so threads can be named without allocating a buffer; it is created when the thread records its first event
+	*/
+	struct ProfilerThreadSlot {
+		std::shared_ptr<ProfilerThreadBuffer> buffer;
+		uint64 generation = 0;
+		std::string name;
+
+		~ProfilerThreadSlot() {
+			if (buffer)
+				buffer->Retire();
+		}
+	};
+
+	static thread_local ProfilerThreadSlot t_ProfilerThreadSlot;
+
+	// @return nullptr if profiler is not initialized
+	static ProfilerThreadBuffer* GetThreadBuffer()
+	{
+		if (!s_State) [[unlikely]]
+			return nullptr;
+
+		if (t_ProfilerThreadSlot.buffer && t_ProfilerThreadSlot.generation == s_StateGeneration) [[likely]]
+			return t_ProfilerThreadSlot.buffer.get();
+
+		if (t_ProfilerThreadSlot.buffer)
+			t_ProfilerThreadSlot.buffer->Retire();
+
+		std::lock_guard lock(s_State->registry_mutex);
+
+		uint32 thread_index = (uint32)s_State->threads.size();
+		s_State->threads.push_back({ t_ProfilerThreadSlot.name.size() ? t_ProfilerThreadSlot.name : fmt::format("Thread {}", thread_index) });
+
+		t_ProfilerThreadSlot.buffer = std::make_shared<ProfilerThreadBuffer>(s_State->specification.thread_buffer_capacity, thread_index);
+		t_ProfilerThreadSlot.generation = s_StateGeneration;
+		s_State->buffers.push_back(t_ProfilerThreadSlot.buffer);
+
+		return t_ProfilerThreadSlot.buffer.get();
+	}
+
+	ProfilerCounter::ProfilerCounter(const char* name, ProfilerCounterMode mode)
+		: m_Name(name)
+		, m_Mode(mode)
+	{
+		m_Next = s_CountersHead.load(std::memory_order_relaxed);
+		while (!s_CountersHead.compare_exchange_weak(m_Next, this, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	int64 ProfilerCounter::Sample()
+	{
+		if (m_Mode == ProfilerCounterMode::PER_FRAME)
+			return m_Value.exchange(0, std::memory_order_relaxed);
+
+		return m_Value.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::Init(const ProfilerSpecification& spec)
+	{
+		OMNIFORCE_ASSERT_TAGGED(!s_State, "Profiler is already initialized");
+		OMNIFORCE_ASSERT_TAGGED(std::has_single_bit(spec.thread_buffer_capacity), "Profiler thread buffer capacity must be a power of two");
+
+		s_State = new ProfilerState;
+		s_State->specification = spec;
+		s_StateGeneration++;
+
+		SetThreadName("Main Thread");
+
+		OMNIFORCE_CORE_INFO("Initialized profiler");
+	}
+
+	void Profiler::Shutdown()
+	{
+		StopCapture();
+
+		// Threads which are still running keep their buffers alive through thread slots
+		delete s_State;
+		s_State = nullptr;
+		t_ProfilerThreadSlot.buffer.reset();
+	}
+
+	// Must be called with capture lock held
+	static void CollectEvents()
+	{
+		std::vector<std::shared_ptr<ProfilerThreadBuffer>> buffers;
+		{
+			std::lock_guard lock(s_State->registry_mutex);
+
+			// Drop buffers of exited threads, retired buffer is drained for the last time below
+			buffers = s_State->buffers;
+			std::erase_if(s_State->buffers, [](const std::shared_ptr<ProfilerThreadBuffer>& buffer) {
+				return buffer->IsRetired();
+			});
+		}
+
+		std::vector<ProfilerEvent>& captured_events = s_State->captured_events;
+		uint64 max_captured_events = s_State->specification.max_captured_events;
+
+		for (auto& buffer : buffers) {
+			buffer->Drain([&](const ProfilerEvent& event) {
+				if (captured_events.size() < max_captured_events)
+					captured_events.push_back(event);
+				else
+					s_State->num_dropped_captured_events++;
+			});
+		}
+	}
+
+	void Profiler::StartCapture()
+	{
+		OMNIFORCE_ASSERT_TAGGED(s_State, "Profiler is not initialized");
+
+		std::lock_guard lock(s_State->capture_mutex);
+
+		// Drain events recorded before the capture was restarted
+		CollectEvents();
+
+		s_State->captured_events.clear();
+		s_State->num_dropped_captured_events = 0;
+		s_NumDroppedEvents.store(0, std::memory_order_relaxed);
+		s_State->capture_start_timestamp = Now();
+		s_State->num_capture_frames_left = 0;
+
+		s_Capturing.store(true, std::memory_order_relaxed);
+
+		OMNIFORCE_CORE_INFO("Started profiler capture");
+	}
+
+	void Profiler::StopCapture()
+	{
+		if (!s_State || !IsCapturing())
+			return;
+
+		s_Capturing.store(false, std::memory_order_relaxed);
+
+		std::lock_guard lock(s_State->capture_mutex);
+		CollectEvents();
+
+		OMNIFORCE_CORE_INFO("Stopped profiler capture, {} events captured", s_State->captured_events.size());
+	}
+
+	void Profiler::CaptureFrames(uint32 num_frames, const std::filesystem::path& path)
+	{
+		OMNIFORCE_ASSERT_TAGGED(num_frames, "Captured frame count must not be zero");
+
+		StartCapture();
+
+		std::lock_guard lock(s_State->capture_mutex);
+		s_State->num_capture_frames_left = num_frames;
+		s_State->capture_export_path = path;
+
+		OMNIFORCE_CORE_INFO("Capturing {} frames to \"{}\"", num_frames, path.string());
+	}
+
+	void Profiler::SetThreadName(std::string_view name)
+	{
+		t_ProfilerThreadSlot.name = name;
+
+		// Buffer is not created here, every lane worker names itself and most of them may never record an event.
+		// Only a thread which is already registered needs its name updated
+		if (!s_State || !t_ProfilerThreadSlot.buffer || t_ProfilerThreadSlot.generation != s_StateGeneration)
+			return;
+
+		std::lock_guard lock(s_State->registry_mutex);
+		s_State->threads[t_ProfilerThreadSlot.buffer->GetThreadIndex()].name = name;
+	}
+
+	void Profiler::RecordZone(const ProfilerZoneSource* zone, uint64 begin, uint64 end)
+	{
+		ProfilerEvent event = {};
+		event.type = ProfilerEventType::ZONE;
+		event.timestamp = begin;
+		event.end_timestamp = end;
+		event.zone = zone;
+
+		if (ProfilerThreadBuffer* buffer = GetThreadBuffer())
+			buffer->Push(event);
+	}
+
+	void Profiler::RecordPlot(const char* name, float64 value)
+	{
+		if (!IsCapturing())
+			return;
+
+		ProfilerEvent event = {};
+		event.type = ProfilerEventType::PLOT;
+		event.timestamp = Now();
+		event.value = value;
+		event.plot_name = name;
+
+		if (ProfilerThreadBuffer* buffer = GetThreadBuffer())
+			buffer->Push(event);
+	}
+
+	void Profiler::MarkFrame()
+	{
+		if (!s_State)
+			return;
+
+		bool capturing = IsCapturing();
+		uint64 timestamp = Now();
+
+		// Counters are sampled even if there is no capture, so per-frame counters are reset every frame
+		for (ProfilerCounter* counter = s_CountersHead.load(std::memory_order_acquire); counter; counter = counter->GetNext()) {
+			int64 value = counter->Sample();
+
+			if (capturing) {
+				ProfilerEvent event = {};
+				event.type = ProfilerEventType::PLOT;
+				event.timestamp = timestamp;
+				event.value = (float64)value;
+				event.plot_name = counter->GetName();
+
+				GetThreadBuffer()->Push(event);
+			}
+		}
+
+		std::filesystem::path export_path;
+		{
+			std::lock_guard lock(s_State->capture_mutex);
+
+			if (capturing) {
+				ProfilerEvent event = {};
+				event.type = ProfilerEventType::FRAME;
+				event.timestamp = timestamp;
+				event.frame_index = s_State->frame_index;
+
+				GetThreadBuffer()->Push(event);
+
+				if (s_State->num_capture_frames_left && --s_State->num_capture_frames_left == 0)
+					export_path = std::move(s_State->capture_export_path);
+			}
+
+			s_State->frame_index++;
+
+			CollectEvents();
+		}
+
+		// Capture is finished outside of the lock, both calls take it
+		if (!export_path.empty()) {
+			StopCapture();
+			ExportChromeTrace(export_path);
+		}
+	}
+
+	uint64 Profiler::GetNumCapturedEvents()
+	{
+		std::lock_guard lock(s_State->capture_mutex);
+		return s_State->captured_events.size();
+	}
+
+	uint64 Profiler::GetNumDroppedEvents()
+	{
+		std::lock_guard lock(s_State->capture_mutex);
+		return s_NumDroppedEvents.load(std::memory_order_relaxed) + s_State->num_dropped_captured_events;
+	}
+
+	// Names are string literals and file paths, which may contain backslashes and quotes
+	static std::string EscapeJSONString(std::string_view string)
+	{
+		std::string result;
+		result.reserve(string.size());
+
+		for (char c : string) {
+			if (c == '"' || c == '\\')
+				result.push_back('\\');
+			result.push_back(c);
+		}
+
+		return result;
+	}
+
+	bool Profiler::ExportChromeTrace(const std::filesystem::path& path)
+	{
+		OMNIFORCE_ASSERT_TAGGED(s_State, "Profiler is not initialized");
+
+		std::ofstream output(path);
+
+		if (!output.is_open()) {
+			OMNIFORCE_CORE_ERROR("Failed to export profiler capture to \"{}\"", path.string());
+			return false;
+		}
+
+		std::lock_guard lock(s_State->capture_mutex);
+
+		if (IsCapturing())
+			CollectEvents();
+
+		std::vector<std::string> thread_names;
+		{
+			std::lock_guard registry_lock(s_State->registry_mutex);
+			for (auto& thread : s_State->threads)
+				thread_names.push_back(EscapeJSONString(thread.name));
+		}
+
+		// Timestamps are in microseconds relative to capture start
+		uint64 start = s_State->capture_start_timestamp;
+		auto to_microseconds = [start](uint64 timestamp) {
+			return timestamp > start ? (float64)(timestamp - start) * 0.001 : 0.0;
+		};
+
+		fmt::memory_buffer buffer;
+		fmt::format_to(fmt::appender(buffer), "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+		for (uint32 i = 0; i < thread_names.size(); i++) {
+			fmt::format_to(fmt::appender(buffer), "{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}},\n", i, thread_names[i]);
+			fmt::format_to(fmt::appender(buffer), "{{\"ph\":\"M\",\"name\":\"thread_sort_index\",\"pid\":0,\"tid\":{},\"args\":{{\"sort_index\":{}}}}},\n", i, i);
+		}
+
+		for (const ProfilerEvent& event : s_State->captured_events) {
+			switch (event.type) {
+			case ProfilerEventType::ZONE:
+				fmt::format_to(fmt::appender(buffer),
+					"{{\"ph\":\"X\",\"name\":\"{}\",\"cat\":\"zone\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{\"file\":\"{}\",\"line\":{}}}}},\n",
+					EscapeJSONString(event.zone->name), event.thread_index, to_microseconds(event.timestamp),
+					(float64)(event.end_timestamp - event.timestamp) * 0.001, EscapeJSONString(event.zone->file), event.zone->line
+				);
+				break;
+			case ProfilerEventType::PLOT:
+				fmt::format_to(fmt::appender(buffer),
+					"{{\"ph\":\"C\",\"name\":\"{}\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"args\":{{\"value\":{}}}}},\n",
+					EscapeJSONString(event.plot_name), event.thread_index, to_microseconds(event.timestamp), event.value
+				);
+				break;
+			case ProfilerEventType::FRAME:
+				fmt::format_to(fmt::appender(buffer),
+					"{{\"ph\":\"i\",\"s\":\"g\",\"name\":\"Frame {}\",\"cat\":\"frame\",\"pid\":0,\"tid\":{},\"ts\":{:.3f}}},\n",
+					event.frame_index, event.thread_index, to_microseconds(event.timestamp)
+				);
+				break;
+			}
+
+			// Flush periodically, so large captures are not duplicated in memory as a whole
+			if (buffer.size() > 4 * 1024 * 1024) {
+				output.write(buffer.data(), buffer.size());
+				buffer.clear();
+			}
+		}
+
+		uint64 num_dropped_events = s_NumDroppedEvents.load(std::memory_order_relaxed) + s_State->num_dropped_captured_events;
+
+		// Metadata event closes the array, so every event above can be followed by a comma
+		fmt::format_to(fmt::appender(buffer), "{{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":0,\"args\":{{\"name\":\"Omniforce\"}}}}\n],\n");
+		fmt::format_to(fmt::appender(buffer), "\"otherData\":{{\"droppedEvents\":{}}}}}\n", num_dropped_events);
+
+		output.write(buffer.data(), buffer.size());
+
+		if (num_dropped_events)
+			OMNIFORCE_CORE_WARNING("Profiler capture is missing {} events, increase thread buffer capacity or captured events limit", num_dropped_events);
+
+		OMNIFORCE_CORE_INFO("Exported profiler capture to \"{}\", {} events", path.string(), s_State->captured_events.size());
+
+		return true;
+	}
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <Foundation/Platform.h>
+#include <Foundation/BasicTypes.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string_view>
+
+// Instrumentation is compiled in for all builds except release, unless build overrides it
+#ifndef OMNIFORCE_PROFILER_ENABLED
+	#define OMNIFORCE_PROFILER_ENABLED (OMNIFORCE_BUILD_CONFIG != OMNIFORCE_RELEASE_CONFIG)
+#endif
+
+#if OMNIFORCE_PROFILER_ENABLED && defined(OMNIFORCE_PROFILER_TRACY)
+	#include <tracy/Tracy.hpp>
+#endif
+
+namespace Omni {
+
+	struct ProfilerSpecification {
+		uint32 thread_buffer_capacity = 64 * 1024; // Number of events in a per-thread ring buffer, must be a power of two
+		uint64 max_captured_events = 16 * 1024 * 1024; // Events beyond the limit are dropped until capture is restarted
+	};
+
+	// Static description of a zone, one per instrumented scope
+	struct ProfilerZoneSource {
+		const char* name;
+		const char* file;
+		uint32 line;
+	};
+
+	enum class ProfilerEventType : uint32 {
+		ZONE,
+		PLOT,
+		FRAME
+	};
+
+	struct ProfilerEvent {
+		ProfilerEventType type;
+		uint32 thread_index;
+		uint64 timestamp; // Nanoseconds, for zones it is a beginning of the zone
+
+		union {
+			uint64 end_timestamp;
+			float64 value;
+			uint64 frame_index;
+		};
+
+		union {
+			const ProfilerZoneSource* zone;
+			const char* plot_name;
+		};
+	};
+
+	enum class ProfilerCounterMode : uint8 {
+		ACCUMULATE, // Value is kept between frames
+		PER_FRAME	// Value is reset on every frame marker
+	};
+
+	/*
+	*	@brief Named counter which can be changed from any thread. Values of all counters are sampled into plots
+	*	on every frame marker. Counters register themselves on construction and must have static storage duration
+	*/
+	class OMNIFORCE_API ProfilerCounter {
+	public:
+		ProfilerCounter(const char* name, ProfilerCounterMode mode = ProfilerCounterMode::ACCUMULATE);
+
+		ProfilerCounter(const ProfilerCounter&) = delete;
+		ProfilerCounter& operator=(const ProfilerCounter&) = delete;
+
+		void Add(int64 value) { m_Value.fetch_add(value, std::memory_order_relaxed); }
+		void Set(int64 value) { m_Value.store(value, std::memory_order_relaxed); }
+
+		const char* GetName() const { return m_Name; }
+		ProfilerCounterMode GetMode() const { return m_Mode; }
+
+		// Returns current value and resets it if counter is per-frame
+		int64 Sample();
+
+		ProfilerCounter* GetNext() const { return m_Next; }
+
+	private:
+		const char* m_Name;
+		ProfilerCounterMode m_Mode;
+		Atomic<int64> m_Value = 0;
+		ProfilerCounter* m_Next = nullptr;
+	};
+
+	/*
+	*	@brief CPU profiler. Every thread records events into its own lock-free ring buffer, buffers are drained into
+	*	a capture on every frame marker. Events are only recorded while capture is running, otherwise zones cost
+	*	a single relaxed load. Captures are exported as Chrome trace JSON (chrome://tracing, Perfetto).
+	*	Use macros below instead of calling it directly, so instrumentation can be compiled out.
+	*/
+	class OMNIFORCE_API Profiler {
+	public:
+		static void Init(const ProfilerSpecification& spec = {});
+		static void Shutdown();
+
+		// Starting a capture discards events of the previous one
+		static void StartCapture();
+		static void StopCapture();
+		static bool IsCapturing() { return s_Capturing.load(std::memory_order_relaxed); }
+
+		// Starts a capture which is stopped and exported to `path` by the frame marker which ends `num_frames`-th frame
+		static void CaptureFrames(uint32 num_frames, const std::filesystem::path& path);
+
+		// Name of calling thread in exported captures
+		static void SetThreadName(std::string_view name);
+
+		static uint64 Now() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		static void RecordZone(const ProfilerZoneSource* zone, uint64 begin, uint64 end);
+		static void RecordPlot(const char* name, float64 value);
+
+		// Marks the end of a frame, samples counters and collects events recorded by all threads
+		static void MarkFrame();
+
+		static uint64 GetNumCapturedEvents();
+		static uint64 GetNumDroppedEvents();
+
+		static bool ExportChromeTrace(const std::filesystem::path& path);
+
+	private:
+		inline static Atomic<bool> s_Capturing = false;
+	};
+
+	class ProfilerScopedZone {
+	public:
+		ProfilerScopedZone(const ProfilerZoneSource* zone)
+			: m_Zone(Profiler::IsCapturing() ? zone : nullptr)
+			, m_Begin(m_Zone ? Profiler::Now() : 0)
+		{}
+
+		~ProfilerScopedZone() {
+			if (m_Zone)
+				Profiler::RecordZone(m_Zone, m_Begin, Profiler::Now());
+		}
+
+		ProfilerScopedZone(const ProfilerScopedZone&) = delete;
+		ProfilerScopedZone& operator=(const ProfilerScopedZone&) = delete;
+
+	private:
+		const ProfilerZoneSource* m_Zone;
+		uint64 m_Begin;
+	};
+
+}
+
+#define OMNI_PROFILER_CONCAT_IMPL(a, b) a##b
+#define OMNI_PROFILER_CONCAT(a, b) OMNI_PROFILER_CONCAT_IMPL(a, b)
+
+// With `OMNIFORCE_PROFILER_TRACY` defined and Tracy client linked, events are also streamed to Tracy
+#if OMNIFORCE_PROFILER_ENABLED && defined(OMNIFORCE_PROFILER_TRACY)
+	#define OMNI_PROFILER_TRACY_ZONE(name) ZoneScopedN(name)
+	#define OMNI_PROFILER_TRACY_FRAME() FrameMark
+	#define OMNI_PROFILER_TRACY_PLOT(name, value) TracyPlot(name, (double)(value))
+	#define OMNI_PROFILER_TRACY_THREAD(name) tracy::SetThreadName(name)
+#else
+	#define OMNI_PROFILER_TRACY_ZONE(name)
+	#define OMNI_PROFILER_TRACY_FRAME()
+	#define OMNI_PROFILER_TRACY_PLOT(name, value)
+	#define OMNI_PROFILER_TRACY_THREAD(name)
+#endif
+
+#if OMNIFORCE_PROFILER_ENABLED
+	// Records a zone from this point to the end of enclosing scope. Name must be a string literal
+	#define OMNIFORCE_PROFILE_ZONE(name) \
+		static const ::Omni::ProfilerZoneSource OMNI_PROFILER_CONCAT(omni_profiler_zone_source_, __LINE__) = { name, __FILE__, __LINE__ }; \
+		::Omni::ProfilerScopedZone OMNI_PROFILER_CONCAT(omni_profiler_zone_, __LINE__)(&OMNI_PROFILER_CONCAT(omni_profiler_zone_source_, __LINE__)); \
+		OMNI_PROFILER_TRACY_ZONE(name)
+	#define OMNIFORCE_PROFILE_FUNCTION() OMNIFORCE_PROFILE_ZONE(__FUNCTION__)
+	#define OMNIFORCE_PROFILE_FRAME() ::Omni::Profiler::MarkFrame(); OMNI_PROFILER_TRACY_FRAME()
+	#define OMNIFORCE_PROFILE_PLOT(name, value) ::Omni::Profiler::RecordPlot(name, (::Omni::float64)(value)); OMNI_PROFILER_TRACY_PLOT(name, value)
+	#define OMNIFORCE_PROFILE_COUNTER(name, value) \
+		{ static ::Omni::ProfilerCounter omni_profiler_counter(name); omni_profiler_counter.Add((::Omni::int64)(value)); }
+	#define OMNIFORCE_PROFILE_FRAME_COUNTER(name, value) \
+		{ static ::Omni::ProfilerCounter omni_profiler_counter(name, ::Omni::ProfilerCounterMode::PER_FRAME); omni_profiler_counter.Add((::Omni::int64)(value)); }
+	#define OMNIFORCE_PROFILE_THREAD(name) ::Omni::Profiler::SetThreadName(name); OMNI_PROFILER_TRACY_THREAD(name)
+#else
+	#define OMNIFORCE_PROFILE_ZONE(name)
+	#define OMNIFORCE_PROFILE_FUNCTION()
+	#define OMNIFORCE_PROFILE_FRAME()
+	#define OMNIFORCE_PROFILE_PLOT(name, value)
+	#define OMNIFORCE_PROFILE_COUNTER(name, value)
+	#define OMNIFORCE_PROFILE_FRAME_COUNTER(name, value)
+	#define OMNIFORCE_PROFILE_THREAD(name)
+#endif
@@ -11,16 +11,20 @@ namespace Omni {
 
 	class OMNIFORCE_API RandomEngine {
 	public:
+		// @return uniformly distributed value in [min, max] range
 		template<typename T>
 		inline static T Generate(const T& min = std::numeric_limits<T>::min(), const T& max = std::numeric_limits<T>::max()) {
 			static_assert(std::is_integral<T>()); // check for non-integral type
-			T value = (s_UniformDistribution(s_MersenneTwisterGenerator) % (max - min)) + min;
-			return value;
+
+			// Distribution is not defined for 8-bit types, so a 64-bit one is used
+			using DistributionType = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+			std::uniform_int_distribution<DistributionType> distribution(min, max);
+
+			return (T)distribution(s_MersenneTwisterGenerator);
 		}
 	private:
 		inline static thread_local std::random_device s_RandomDevice;
 		inline static thread_local std::mt19937_64 s_MersenneTwisterGenerator = std::mt19937_64(s_RandomDevice());
-		inline static thread_local std::uniform_int_distribution<uint64> s_UniformDistribution;
 	};
 
 }
\ No newline at end of file
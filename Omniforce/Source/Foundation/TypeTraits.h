@@ -0,0 +1,18 @@
+#pragma once
+
+#include <type_traits>
+
+namespace Omni {
+
+	/*
+	*	@brief Marks types that can be moved to another address with `memcpy`, without calling move constructor and destructor.
+	*	All trivially copyable types are trivially relocatable; other types (e.g. handles that do not point to themselves)
+	*	can opt in by specializing the trait
+	*/
+	template<typename T>
+	struct TriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+	template<typename T>
+	inline constexpr bool IsTriviallyRelocatable = TriviallyRelocatable<T>::value;
+
+}
@@ -3,6 +3,7 @@
 #include <Foundation/Platform.h>
 
 #include <Foundation/RandomNumberGenerator.h>
+#include <Foundation/TypeTraits.h>
 
 #include <atomic>
 #include <unordered_map>
@@ -14,12 +15,96 @@ namespace Omni {
 
 	typedef uint64_t uint64;
 
+	/*
+	*	@brief Contiguous range of reserved UUIDs. Can be shared between threads, e.g. an importer can reserve
+	*	UUIDs for all objects up front and address them by index from parallel jobs
+	*/
+	class UUIDRange {
+	public:
+		UUIDRange(uint64 first, uint64 size)
+			: m_First(first), m_Size(size)
+		{}
+
+		uint64 operator[](uint64 index) const;
+		uint64 Size() const { return m_Size; }
+
+	private:
+		uint64 m_First;
+		uint64 m_Size;
+	};
+
+	/*
+	*	@brief Fast UUID source. Threads reserve blocks of values from a global counter, which starts at a random
+	*	per-process offset, and pass counter values through a 64-bit bijective mix. Distinct counter values always
+	*	give distinct UUIDs, so UUIDs are unique within a process, and UUIDs from different sessions only collide
+	*	if their counter ranges overlap. Generating a UUID is an increment and a few multiplications,
+	*	global counter is only touched once per `THREAD_BLOCK_SIZE` UUIDs
+	*/
+	class OMNIFORCE_API UUIDGenerator {
+	public:
+		inline static constexpr uint64 THREAD_BLOCK_SIZE = 4096;
+
+		static uint64 Generate() {
+			ThreadState& state = s_ThreadState;
+
+			if (state.next == state.end) {
+				state.next = ReserveCounters(THREAD_BLOCK_SIZE);
+				state.end = state.next + THREAD_BLOCK_SIZE;
+			}
+
+			return Permute(state.next++);
+		}
+
+		// Reserves `count` UUIDs with a single atomic operation
+		static UUIDRange Reserve(uint64 count) {
+			return count ? UUIDRange(ReserveCounters(count), count) : UUIDRange(0, 0);
+		}
+
+		// Bijective 64-bit mix (SplitMix64 finalizer), maps zero to zero only
+		inline static constexpr uint64 Permute(uint64 counter) {
+			counter = (counter ^ (counter >> 30)) * 0xbf58476d1ce4e5b9ull;
+			counter = (counter ^ (counter >> 27)) * 0x94d049bb133111ebull;
+			return counter ^ (counter >> 31);
+		}
+
+	private:
+		// No default member initializers, so the state can be defined inside the class. It is zero-initialized as a thread_local
+		struct ThreadState {
+			uint64 next;
+			uint64 end;
+		};
+
+		static uint64 ReserveCounters(uint64 count) {
+			// Function-local, so UUIDs created during static initialization already get a random offset
+			static std::atomic<uint64> s_Counter = [] {
+				std::random_device random_device;
+				return ((uint64)random_device() << 32) | random_device();
+			}();
+
+			while (true) {
+				uint64 first = s_Counter.fetch_add(count, std::memory_order_relaxed);
+				uint64 last = first + count - 1;
+
+				// Zero is reserved for invalid UUID, so a range which contains it is skipped
+				if (first != 0 && last >= first)
+					return first;
+			}
+		}
+
+	private:
+		inline static thread_local ThreadState s_ThreadState;
+	};
+
+	inline uint64 UUIDRange::operator[](uint64 index) const {
+		return UUIDGenerator::Permute(m_First + index);
+	}
+
 	class OMNIFORCE_API UUID
 	{
 	public:
 		UUID()
 		{
-			m_UUID = RandomEngine::Generate<uint64>();
+			m_UUID = UUIDGenerator::Generate();
 		}
 
 		UUID(uint64 uuid)
@@ -39,6 +124,9 @@ namespace Omni {
 		uint64 m_UUID;
 	};
 
+	template<>
+	struct TriviallyRelocatable<UUID> : std::true_type {};
+
 }
 
 namespace robin_hood {
@@ -0,0 +1,77 @@
+#include <Foundation/Common.h>
+#include <Physics/Private/JoltJobSystem.h>
+
+#include <taskflow/taskflow.hpp>
+
+namespace Omni {
+
+	JoltJobSystem::JoltJobSystem(tf::Executor* executor, uint32 max_jobs, uint32 max_barriers)
+		: JPH::JobSystemWithBarrier(max_barriers), m_Executor(executor)
+	{
+		m_Jobs.Init(max_jobs, max_jobs);
+	}
+
+	JoltJobSystem::~JoltJobSystem()
+	{
+		// Decrement is the last access of a task to this object, so it is polled rather than waited with notification
+		while (m_NumQueuedJobs.load(std::memory_order_acquire))
+			std::this_thread::yield();
+	}
+
+	int JoltJobSystem::GetMaxConcurrency() const
+	{
+		// Thread which waits on a barrier also executes jobs
+		return (int)m_Executor->num_workers() + 1;
+	}
+
+	JPH::JobSystem::JobHandle JoltJobSystem::CreateJob(const char* name, JPH::ColorArg color, const JobFunction& job_function, uint32 num_dependencies)
+	{
+		uint32 index = m_Jobs.ConstructObject(name, color, this, job_function, num_dependencies);
+
+		// Pool is sized by physics system limits, jobs are released as soon as they are executed
+		if (index == JobPool::cInvalidObjectIndex) {
+			OMNIFORCE_CORE_WARNING("Physics job pool is exhausted, waiting for jobs to finish");
+
+			while (index == JobPool::cInvalidObjectIndex) {
+				std::this_thread::yield();
+				index = m_Jobs.ConstructObject(name, color, this, job_function, num_dependencies);
+			}
+		}
+
+		Job* job = &m_Jobs.Get(index);
+
+		// Handle holds a reference, so job is not freed if it is executed before the handle is returned
+		JobHandle handle(job);
+
+		if (num_dependencies == 0)
+			QueueJob(job);
+
+		return handle;
+	}
+
+	void JoltJobSystem::QueueJob(Job* job)
+	{
+		// Reference is held by the executor until job is executed. Job may be already executed by a barrier
+		// waiting thread by then, in which case `Execute` does nothing
+		job->AddRef();
+		m_NumQueuedJobs.fetch_add(1, std::memory_order_relaxed);
+
+		m_Executor->silent_async([this, job]() {
+			job->Execute();
+			job->Release();
+			m_NumQueuedJobs.fetch_sub(1, std::memory_order_release);
+		});
+	}
+
+	void JoltJobSystem::QueueJobs(Job** jobs, uint32 num_jobs)
+	{
+		for (uint32 i = 0; i < num_jobs; i++)
+			QueueJob(jobs[i]);
+	}
+
+	void JoltJobSystem::FreeJob(Job* job)
+	{
+		m_Jobs.DestroyObject(job);
+	}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Foundation/Common.h>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+
+namespace tf {
+	class Executor;
+}
+
+namespace Omni {
+
+	/*
+	*	@brief Runs Jolt jobs on a job system executor, so physics shares workers with the rest of the engine instead
+	*	of oversubscribing the machine with a private thread pool. Barriers are provided by `JPH::JobSystemWithBarrier`,
+	*	thread waiting on a barrier executes queued jobs of that barrier itself, so waiting from a worker does not deadlock.
+	*/
+	class JoltJobSystem final : public JPH::JobSystemWithBarrier {
+	public:
+		JoltJobSystem(tf::Executor* executor, uint32 max_jobs, uint32 max_barriers);
+		~JoltJobSystem();
+
+		int GetMaxConcurrency() const override;
+		JobHandle CreateJob(const char* name, JPH::ColorArg color, const JobFunction& job_function, uint32 num_dependencies = 0) override;
+
+	protected:
+		void QueueJob(Job* job) override;
+		void QueueJobs(Job** jobs, uint32 num_jobs) override;
+		void FreeJob(Job* job) override;
+
+	private:
+		using JobPool = JPH::FixedSizeFreeList<Job>;
+
+		tf::Executor* m_Executor;
+		JobPool m_Jobs;
+		Atomic<uint32> m_NumQueuedJobs = 0; // Jobs referenced by executor tasks, pool must outlive them
+	};
+
+}
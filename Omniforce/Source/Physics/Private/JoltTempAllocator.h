@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Foundation/Common.h>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/TempAllocator.h>
+
+namespace Omni {
+
+	/*
+	*	@brief Stack allocator for Jolt per-step scratch data, backed by an engine allocator so physics memory is visible in telemetry.
+	*	Allocations that do not fit into the stack fall back to the backing allocator
+	*/
+	class JoltTempAllocator final : public JPH::TempAllocator {
+	public:
+		JoltTempAllocator(IAllocator* allocator, uint32 size)
+			: m_Allocator(allocator)
+			, m_Allocation(allocator->AllocateBase(size + JPH_RVECTOR_ALIGNMENT))
+			, m_Size(size)
+		{
+			m_Base = (byte*)IAllocator::AlignUp((IAllocator::TSize)m_Allocation.Memory, JPH_RVECTOR_ALIGNMENT);
+		}
+
+		~JoltTempAllocator()
+		{
+			OMNIFORCE_ASSERT_TAGGED(m_Top == 0, "Physics temp allocator: not all memory was freed");
+			m_Allocator->FreeBase(m_Allocation);
+		}
+
+		void* Allocate(JPH::uint size) override
+		{
+			if (!size)
+				return nullptr;
+
+			uint32 new_top = m_Top + (uint32)IAllocator::AlignUp(size, JPH_RVECTOR_ALIGNMENT);
+
+			if (new_top > m_Size) [[unlikely]]
+				return m_Allocator->AllocateBase(size).Memory;
+
+			byte* address = m_Base + m_Top;
+			m_Top = new_top;
+
+			return address;
+		}
+
+		void Free(void* address, JPH::uint size) override
+		{
+			if (!address)
+				return;
+
+			if (address < m_Base || address >= m_Base + m_Size) [[unlikely]] {
+				MemoryAllocation allocation((byte*)address, size);
+				m_Allocator->FreeBase(allocation);
+				return;
+			}
+
+			m_Top -= (uint32)IAllocator::AlignUp(size, JPH_RVECTOR_ALIGNMENT);
+			OMNIFORCE_ASSERT_TAGGED(m_Base + m_Top == address, "Physics temp allocator: memory must be freed in reverse order");
+		}
+
+	private:
+		IAllocator* m_Allocator;
+		MemoryAllocation m_Allocation;
+		byte* m_Base = nullptr;
+		uint32 m_Size;
+		uint32 m_Top = 0;
+	};
+
+}
@@ -7,8 +7,13 @@
 #include <Scene/Entity.h>
 #include <Core/Input/Input.h>
 #include <Physics/Private/JoltUtils.h>
+#include <Physics/Private/JoltJobSystem.h>
+#include <Physics/Private/JoltTempAllocator.h>
+#include <Threading/JobSystem.h>
+#include <Core/EngineConfig.h>
 
 #include <Jolt/Core/Factory.h>
+#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsScene.h>
@@ -16,7 +21,6 @@
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
 #include <Jolt/Physics/Collision/Shape/SphereShape.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
-#include <Jolt/Core/TempAllocator.h>
 
 #include <glm/gtc/quaternion.hpp>
 
@@ -24,6 +28,8 @@ namespace Omni {
 
 	PhysicsEngine* PhysicsEngine::s_Instance = nullptr;
 
+	static EngineConfigValue<bool> s_UseEngineJobSystem("Physics.UseEngineJobSystem", "Runs Jolt jobs on realtime lane of engine job system instead of a private thread pool");
+
 	constexpr JPH::EMotionType convert(RigidBodyComponent::Type type) {
 		switch (type)
 		{
@@ -40,8 +46,8 @@ namespace Omni {
 		ObjectLayerPairFilter object_layer_pair_filter;
 		BodyActivationListener body_activation_listener;
 		BodyContantListener body_contact_listener;
-		JPH::TempAllocatorImpl* temp_allocator;
-		JPH::JobSystemThreadPool* job_system;
+		JoltTempAllocator* temp_allocator;
+		JPH::JobSystem* job_system;
 	} s_InternalData;
 
 	PhysicsEngine::PhysicsEngine()
@@ -71,15 +77,24 @@ namespace Omni {
 		m_CoreSystem->SetContactListener(&s_InternalData.body_contact_listener);
 
 		// allocate 50 mb for physics engine temporal data
-		s_InternalData.temp_allocator = new JPH::TempAllocatorImpl(50 * 1024 * 1024);
-
-		// for now I let Jolt to use all available threads except main thread. 
-		// Later I will need to switch to my custom job system to handle Jolt jobs.
-		s_InternalData.job_system = new JPH::JobSystemThreadPool(
-			JPH::cMaxPhysicsJobs,
-			JPH::cMaxPhysicsBarriers,
-			std::thread::hardware_concurrency() - 1
-		);
+		s_InternalData.temp_allocator = new JoltTempAllocator(&g_PhysicsAllocator, 50 * 1024 * 1024);
+
+		// Physics step is frame-critical, so on the engine job system Jolt jobs run on realtime lane and never queue behind general work.
+		// Private pool stays the default until `OmniforceBench physics` shows the realtime lane is not slower on target hardware
+		if (s_UseEngineJobSystem.Get()) {
+			s_InternalData.job_system = new JoltJobSystem(
+				JobSystem::GetExecutor(JobPriority::REALTIME),
+				JPH::cMaxPhysicsJobs,
+				JPH::cMaxPhysicsBarriers
+			);
+		}
+		else {
+			s_InternalData.job_system = new JPH::JobSystemThreadPool(
+				JPH::cMaxPhysicsJobs,
+				JPH::cMaxPhysicsBarriers,
+				std::max(std::thread::hardware_concurrency(), 2u) - 1
+			);
+		}
 
 		OMNIFORCE_CORE_INFO("Initialized physics engine");
 	}
@@ -210,6 +225,8 @@ namespace Omni {
 
 	void PhysicsEngine::Update()
 	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
 		// fetch new objects' position which was changed from scripts
 		auto view = m_Context->GetRegistry()->view<RigidBodyComponent, ScriptComponent>();
 		JPH::BodyInterface& body_interface = m_CoreSystem->GetBodyInterface();
@@ -253,7 +270,7 @@ namespace Omni {
 
 		for (auto& id : bodies) {
 			UUID entity_id = body_interface.GetUserData(id);
-			Entity entity(entities.at(entity_id), m_Context);
+			Entity entity(entities.At(entity_id), m_Context);
 
 			TRSComponent& trs_component = entity.GetComponent<TRSComponent>();
 			JPH::RVec3 position = body_interface.GetPosition(id);
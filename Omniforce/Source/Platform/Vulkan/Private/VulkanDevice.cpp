@@ -296,7 +296,7 @@ namespace Omni {
 
 	Ref<VulkanDeviceCmdBuffer> VulkanDevice::AllocateTransientCmdBuffer()
 	{
-		Ref<DeviceCmdBuffer> cmd_buffer = DeviceCmdBuffer::Create(&g_TransientAllocator, DeviceCmdBufferLevel::PRIMARY, DeviceCmdBufferType::TRANSIENT, DeviceCmdType::GENERAL);
+		Ref<DeviceCmdBuffer> cmd_buffer = DeviceCmdBuffer::Create(&g_RendererAllocator, DeviceCmdBufferLevel::PRIMARY, DeviceCmdBufferType::TRANSIENT, DeviceCmdType::GENERAL);
 		cmd_buffer->Begin();
 
 		return cmd_buffer;
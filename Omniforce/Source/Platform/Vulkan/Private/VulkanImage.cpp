@@ -299,7 +299,7 @@ namespace Omni {
 		VK_CHECK_RESULT(vkCreateImageView(device->Raw(), &image_view_create_info, nullptr, &m_ImageView));
 
 		Ref<DeviceCmdBuffer> cmd_buffer = DeviceCmdBuffer::Create(
-			&g_TransientAllocator,
+			&g_RendererAllocator,
 			DeviceCmdBufferLevel::PRIMARY, 
 			DeviceCmdBufferType::TRANSIENT, 
 			DeviceCmdType::GENERAL
@@ -356,7 +356,7 @@ namespace Omni {
 		VK_CHECK_RESULT(vkCreateImageView(device->Raw(), &image_view_create_info, nullptr, &m_ImageView));
 
 		Ref<DeviceCmdBuffer> cmd_buffer = DeviceCmdBuffer::Create(
-			&g_TransientAllocator,
+			&g_RendererAllocator,
 			DeviceCmdBufferLevel::PRIMARY,
 			DeviceCmdBufferType::TRANSIENT,
 			DeviceCmdType::GENERAL
@@ -413,7 +413,7 @@ namespace Omni {
 		VK_CHECK_RESULT(vkCreateImageView(device->Raw(), &image_view_create_info, nullptr, &m_ImageView));
 
 		Ref<DeviceCmdBuffer> cmd_buffer = DeviceCmdBuffer::Create(
-			&g_TransientAllocator,
+			&g_RendererAllocator,
 			DeviceCmdBufferLevel::PRIMARY,
 			DeviceCmdBufferType::TRANSIENT,
 			DeviceCmdType::GENERAL
@@ -38,6 +38,11 @@ namespace Omni {
 
 		m_Map.emplace(offset, virtual_allocation);
 
+		VmaStatistics stats = {};
+		vmaGetVirtualBlockStatistics(m_MemoryBlock, &stats);
+		m_PeakUsedMemory = std::max<uint64>(m_PeakUsedMemory, stats.allocationBytes);
+		m_TotalAllocations++;
+
 		return offset;
 	}
 
@@ -63,4 +68,23 @@ namespace Omni {
 		return stats.blockBytes - stats.allocationBytes;
 	}
 
+	AllocatorStats VulkanVirtualMemoryBlock::GetStats()
+	{
+		VmaDetailedStatistics detailed_stats = {};
+		vmaCalculateVirtualBlockStatistics(m_MemoryBlock, &detailed_stats);
+
+		const VmaStatistics& vma_stats = detailed_stats.statistics;
+		uint64 free_memory = vma_stats.blockBytes - vma_stats.allocationBytes;
+
+		AllocatorStats stats = {};
+		stats.live_memory = vma_stats.allocationBytes;
+		stats.peak_memory = m_PeakUsedMemory;
+		stats.reserved_memory = vma_stats.blockBytes;
+		stats.num_live_allocations = vma_stats.allocationCount;
+		stats.total_allocations = m_TotalAllocations;
+		stats.fragmentation = free_memory ? 1.0f - (float32)detailed_stats.unusedRangeSizeMax / (float32)free_memory : 0.0f;
+
+		return stats;
+	}
+
 }
\ No newline at end of file
@@ -17,12 +17,16 @@ namespace Omni {
 
 		uint32 GetUsedMemorySize() override;
 		uint32 GetFreeMemorySize() override;
+		AllocatorStats GetStats() override;
 
 	private:
 		uint64 m_Size;
 		VmaVirtualBlock m_MemoryBlock;
 		rh::unordered_map<uint32, VmaVirtualAllocation> m_Map; // offset - allocation map
 
+		uint64 m_PeakUsedMemory = 0;
+		uint64 m_TotalAllocations = 0;
+
 	};
 
 }
\ No newline at end of file
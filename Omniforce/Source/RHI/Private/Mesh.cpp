@@ -24,13 +24,13 @@ namespace Omni {
 			buffer_spec.size = mesh_data.virtual_geometry.attributes.size();
 			m_Buffers.emplace(MeshBufferKey::ATTRIBUTES, DeviceBuffer::Create(allocator, buffer_spec, (void*)mesh_data.virtual_geometry.attributes.data(), buffer_spec.size));
 
-			buffer_spec.size = mesh_data.virtual_geometry.meshlets.size() * sizeof RenderableMeshlet;
+			buffer_spec.size = mesh_data.virtual_geometry.meshlets.size() * sizeof(RenderableMeshlet);
 			m_Buffers.emplace(MeshBufferKey::MESHLETS, DeviceBuffer::Create(allocator, buffer_spec, (void*)mesh_data.virtual_geometry.meshlets.data(), buffer_spec.size));
 
 			buffer_spec.size = mesh_data.virtual_geometry.local_indices.size();
 			m_Buffers.emplace(MeshBufferKey::MICRO_INDICES, DeviceBuffer::Create(allocator, buffer_spec, (void*)mesh_data.virtual_geometry.local_indices.data(), buffer_spec.size));
 
-			buffer_spec.size = mesh_data.virtual_geometry.cull_data.size() * sizeof MeshClusterBounds;
+			buffer_spec.size = mesh_data.virtual_geometry.cull_data.size() * sizeof(MeshClusterBounds);
 			m_Buffers.emplace(MeshBufferKey::MESHLETS_CULL_DATA, DeviceBuffer::Create(allocator, buffer_spec, (void*)mesh_data.virtual_geometry.cull_data.data(), buffer_spec.size));
 		}
 
@@ -100,7 +100,7 @@ namespace Omni {
 
 	bool ShaderCompiler::ReadShaderFile(std::filesystem::path path, std::stringstream* out)
 	{
-		Ref<File> file = FileSystem::ReadFile(&g_TransientAllocator, path, 0);
+		Ref<File> file = FileSystem::ReadFile(&g_PersistentAllocator, path, 0);
 		if (!file->GetData() && file->GetSize())
 			return false;
 
@@ -128,8 +128,8 @@ namespace Omni {
 			//local_options.SetOptimizationLevel(shaderc_optimization_level_zero);
 		}
 
-		for (auto& macro : macros)
-			local_options.AddMacroDefinition(macro.first, macro.second);
+		for (auto& [macro, value] : macros)
+			local_options.AddMacroDefinition(macro.CStr(), macro.View().size(), value.c_str(), value.size());
 
 		std::map<ShaderStage, std::string> separated_sources;
 		std::map<ShaderStage, std::vector<uint32>> binaries;
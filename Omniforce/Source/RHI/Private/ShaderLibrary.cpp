@@ -49,7 +49,7 @@ namespace Omni {
 	bool ShaderLibrary::LoadShader(const std::filesystem::path& path, const ShaderMacroTable& macros) {
 		ShaderCompilationResult compilation_result;
 
-		OMNIFORCE_ASSERT_TAGGED(macros.contains("__OMNI_PIPELINE_LOCAL_HASH"), "No pipeline ID macro provided");
+		OMNIFORCE_ASSERT_TAGGED(macros.Contains(PIPELINE_LOCAL_HASH_MACRO), "No pipeline ID macro provided");
 
 		bool result = HasShader(path.filename().string(), macros);
 
@@ -195,24 +195,16 @@ namespace Omni {
 		return false;
 	}
 
-	Omni::Ref<Omni::Shader> ShaderLibrary::GetShader(std::string key, ShaderMacroTable macros) {
+	Omni::Ref<Omni::Shader> ShaderLibrary::GetShader(std::string key, const ShaderMacroTable& macros) {
 		if (!m_Library.contains(key))
 			return nullptr;
 
 		auto& permutation_list = m_Library.at(key);
 
+		// If everything other than pipeline ID matches, then we can freely return this shader
 		for (auto& permutation : permutation_list) {
-			auto& permutation_macro_table = permutation.second;
-			
-			std::string& permutation_id = permutation_macro_table["__OMNI_PIPELINE_LOCAL_HASH"];
-			
-			// Emplace an id so if everything other than ID matches, then we can freely return this shader
-			macros["__OMNI_PIPELINE_LOCAL_HASH"] = permutation_id;
-
-			if (permutation_macro_table == macros)
+			if (permutation.second.EqualsIgnoring(macros, PIPELINE_LOCAL_HASH_MACRO))
 				return permutation.first;
-			else
-				macros.erase("__OMNI_PIPELINE_LOCAL_HASH");
 		}
 
 		return nullptr;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RHICommon.h"
+#include "ShaderMacroTable.h"
 
 #include <filesystem>
 #include <vector>
@@ -45,7 +45,7 @@ namespace Omni {
 		*  @brief Acquire shader from library. Read-only.
 		*  @return a shared pointer to shader. If shader is not present, returns nullptr.
 		*/
-		Ref<Shader> GetShader(std::string key, ShaderMacroTable macros = {});
+		Ref<Shader> GetShader(std::string key, const ShaderMacroTable& macros = {});
 
 		/*
 		*  @return a whole shader library. Can be used to iterate through, e.g. for using with ImGui to list all shaders
@@ -72,6 +72,9 @@ namespace Omni {
 		ShaderEntryPointCode LoadShaderEntryPoint(const EntryPointCompilationOptions& options, ShaderCompiler& compiler);
 
 	private:
+		// Every shader permutation gets its own pipeline id macro, it is ignored when permutations are matched
+		inline static const Name PIPELINE_LOCAL_HASH_MACRO = "__OMNI_PIPELINE_LOCAL_HASH";
+
 		inline static ShaderLibrary* s_Instance;
 		InternalStorage m_Library;
 		std::shared_mutex m_Mutex;
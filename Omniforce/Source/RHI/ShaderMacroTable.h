@@ -0,0 +1,140 @@
+#pragma once
+
+#include <Foundation/Common.h>
+
+#include <initializer_list>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <bit>
+
+namespace Omni {
+
+	/*
+	*	@brief Set of shader macro definitions. Keys are interned names, values are plain strings, since they are often
+	*	unique per pipeline (e.g. pipeline IDs) and would grow the permanent name table.
+	*	Entries are kept sorted by name handle and the table maintains an order-independent hash of its entries,
+	*	so comparing two tables is a hash compare followed by key pointer and short value compares
+	*/
+	class OMNIFORCE_API ShaderMacroTable {
+	public:
+		using Entry = std::pair<Name, std::string>; // macro - value
+
+		ShaderMacroTable() = default;
+
+		ShaderMacroTable(std::initializer_list<Entry> entries) {
+			for (const auto& [macro, value] : entries) {
+				Set(macro, value);
+			}
+		}
+
+		// Adds a macro or replaces value of an existing one
+		void Set(Name macro, std::string_view value = {}) {
+			auto iterator = LowerBound(macro);
+
+			if (iterator != m_Entries.end() && iterator->first == macro) {
+				m_Hash ^= ComputeEntryHash(*iterator);
+				iterator->second = value;
+			}
+			else {
+				iterator = m_Entries.insert(iterator, Entry(macro, std::string(value)));
+			}
+
+			m_Hash ^= ComputeEntryHash(*iterator);
+		}
+
+		void Remove(Name macro) {
+			auto iterator = LowerBound(macro);
+
+			if (iterator != m_Entries.end() && iterator->first == macro) {
+				m_Hash ^= ComputeEntryHash(*iterator);
+				m_Entries.erase(iterator);
+			}
+		}
+
+		bool Contains(Name macro) const {
+			auto iterator = LowerBound(macro);
+			return iterator != m_Entries.end() && iterator->first == macro;
+		}
+
+		// Returns a value of a macro, empty if macro is not defined or has no value
+		std::string_view Get(Name macro) const {
+			auto iterator = LowerBound(macro);
+			return iterator != m_Entries.end() && iterator->first == macro ? std::string_view(iterator->second) : std::string_view();
+		}
+
+		void Clear() {
+			m_Entries.clear();
+			m_Hash = 0;
+		}
+
+		inline uint64 Size() const { return m_Entries.size(); }
+		inline bool IsEmpty() const { return m_Entries.empty(); }
+		inline uint64 GetHash() const { return m_Hash; }
+
+		bool operator==(const ShaderMacroTable& other) const {
+			return m_Hash == other.m_Hash && m_Entries == other.m_Entries;
+		}
+
+		// Compares tables as if `ignored_macro` was not defined in both of them
+		bool EqualsIgnoring(const ShaderMacroTable& other, Name ignored_macro) const {
+			if (ComputeHashIgnoring(ignored_macro) != other.ComputeHashIgnoring(ignored_macro)) {
+				return false;
+			}
+
+			auto lhs = m_Entries.begin();
+			auto rhs = other.m_Entries.begin();
+
+			while (true) {
+				if (lhs != m_Entries.end() && lhs->first == ignored_macro) lhs++;
+				if (rhs != other.m_Entries.end() && rhs->first == ignored_macro) rhs++;
+
+				if (lhs == m_Entries.end() || rhs == other.m_Entries.end()) {
+					return lhs == m_Entries.end() && rhs == other.m_Entries.end();
+				}
+
+				if (*lhs != *rhs) {
+					return false;
+				}
+
+				lhs++;
+				rhs++;
+			}
+		}
+
+		auto begin() const { return m_Entries.begin(); }
+		auto end() const { return m_Entries.end(); }
+
+	private:
+		inline static uint64 ComputeEntryHash(const Entry& entry) {
+			return MixHash(entry.first.GetHash() ^ std::rotl((uint64)std::hash<std::string_view>()(entry.second), 32));
+		}
+
+		uint64 ComputeHashIgnoring(Name ignored_macro) const {
+			auto iterator = LowerBound(ignored_macro);
+			bool defined = iterator != m_Entries.end() && iterator->first == ignored_macro;
+
+			return defined ? m_Hash ^ ComputeEntryHash(*iterator) : m_Hash;
+		}
+
+		std::vector<Entry>::const_iterator LowerBound(Name macro) const {
+			return std::lower_bound(m_Entries.begin(), m_Entries.end(), macro, [](const Entry& entry, const Name& macro) {
+				return entry.first < macro;
+			});
+		}
+
+		std::vector<Entry>::iterator LowerBound(Name macro) {
+			return std::lower_bound(m_Entries.begin(), m_Entries.end(), macro, [](const Entry& entry, const Name& macro) {
+				return entry.first < macro;
+			});
+		}
+
+	private:
+		std::vector<Entry> m_Entries;
+		uint64 m_Hash = 0;
+	};
+
+}
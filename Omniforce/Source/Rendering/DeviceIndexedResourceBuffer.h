@@ -10,8 +10,14 @@ namespace Omni {
 	template<typename T>
 	class DeviceIndexedResourceBuffer {
 	public:
+		// Largest power of two that divides element size. All allocations are element-sized, so with this granularity
+		// every offset returned by index allocator is a multiple of element size and maps to an element index
+		inline static constexpr uint32 INDEX_GRANULARITY = sizeof(T) & (~sizeof(T) + 1);
+
+		static_assert(sizeof(T) % INDEX_GRANULARITY == 0 && alignof(T) <= INDEX_GRANULARITY);
+
 		DeviceIndexedResourceBuffer(uint32 buffer_size)
-			: m_IndexAllocator(VirtualMemoryBlock::Create(&g_PersistentAllocator, buffer_size))
+			: m_IndexAllocator(VirtualMemoryBlock::Create(&g_RendererAllocator, buffer_size, VirtualMemoryBlockBackend::TLSF, INDEX_GRANULARITY))
 		{
 			DeviceBufferSpecification buffer_spec = {};
 			buffer_spec.size = buffer_size;
@@ -19,13 +25,13 @@ namespace Omni {
 			buffer_spec.buffer_usage = DeviceBufferUsage::SHADER_DEVICE_ADDRESS;
 			buffer_spec.heap = DeviceBufferMemoryHeap::DEVICE;
 
-			m_DeviceBuffer = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec);
+			m_DeviceBuffer = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec);
 			
 			buffer_spec.size = sizeof(T);
 			buffer_spec.memory_usage = DeviceBufferMemoryUsage::COHERENT_WRITE;
 			buffer_spec.buffer_usage = DeviceBufferUsage::STAGING_BUFFER;
 
-			m_StagingForCopy = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec);
+			m_StagingForCopy = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec);
 		}
 
 		void Destroy() {
@@ -35,34 +41,35 @@ namespace Omni {
 			uint32 offset = m_IndexAllocator->Allocate(sizeof(T), alignof(T));
 			uint32 index = offset / sizeof (T);
 
-			OMNIFORCE_ASSERT_TAGGED(offset != UINT32_MAX, "Failed to find free block. It can be caused by fragmentation or exceeded resource limits");
+			OMNIFORCE_ASSERT_TAGGED(offset != VirtualMemoryBlock::INVALID_OFFSET, "Failed to find free block. It can be caused by fragmentation or exceeded resource limits");
+			OMNIFORCE_ASSERT_TAGGED(offset % sizeof(T) == 0, "Resource offset is not a multiple of element size");
 
 			m_StagingForCopy->UploadData(0, (void*)&data, sizeof (T));
 
-			Ref<DeviceCmdBuffer> cmd_buffer = DeviceCmdBuffer::Create(&g_PersistentAllocator, DeviceCmdBufferLevel::PRIMARY, DeviceCmdBufferType::TRANSIENT, DeviceCmdType::GENERAL);
+			Ref<DeviceCmdBuffer> cmd_buffer = DeviceCmdBuffer::Create(&g_RendererAllocator, DeviceCmdBufferLevel::PRIMARY, DeviceCmdBufferType::TRANSIENT, DeviceCmdType::GENERAL);
 			cmd_buffer->Begin();
 			m_StagingForCopy->CopyRegionTo(cmd_buffer, m_DeviceBuffer, 0, offset, sizeof (T));
 			cmd_buffer->End();
 			cmd_buffer->Execute(true);
 
-			m_Indices.emplace(id, index);
+			m_Indices.Emplace(id, index);
 
-			return offset;
+			return index;
 		}
 
-		uint32 ReleaseIndex(const AssetHandle& id) {
-			m_IndexAllocator->Free(m_Indices.at(id));
-			m_Indices.erase(id);
+		void ReleaseIndex(const AssetHandle& id) {
+			m_IndexAllocator->Free(m_Indices.At(id) * sizeof(T));
+			m_Indices.Remove(id);
 		}
 
-		uint32 GetIndex(const AssetHandle& id) const { return m_Indices.at(id); }
+		uint32 GetIndex(const AssetHandle& id) const { return m_Indices.At(id); }
 
 		uint64 GetStorageBDA() const { return m_DeviceBuffer->GetDeviceAddress(); }
 		Ref<DeviceBuffer> GetStorage() const { return m_DeviceBuffer; }
 
 	private:
 		Ptr<VirtualMemoryBlock> m_IndexAllocator;
-		rhumap<UUID, uint32> m_Indices;
+		FlatHashMap<UUID, uint32> m_Indices;
 		Ref<DeviceBuffer> m_DeviceBuffer;
 		Ref<DeviceBuffer> m_StagingForCopy;
 	};
@@ -68,14 +68,14 @@ namespace Omni {
 		uint32 AcquireResourceIndex(Ref<Material> material);
 
 		bool ReleaseResourceIndex(Ref<Image> image) {
-			uint16 index = m_TextureIndices.at(image->Handle);
+			uint16 index = m_TextureIndices.At(image->Handle);
 			m_TextureIndexAllocator->Free(sizeof(uint32) * index);
-			m_TextureIndices.erase(image->Handle);
+			m_TextureIndices.Remove(image->Handle);
 
 			return true;
 		}
 
-		uint32 GetTextureIndex(const AssetHandle& uuid) const { return m_TextureIndices.at(uuid); }
+		uint32 GetTextureIndex(const AssetHandle& uuid) const { return m_TextureIndices.At(uuid); }
 		uint64 GetMaterialBDA(const AssetHandle& id) const { return m_MaterialDataPool.GetStorageBufferAddress() + m_MaterialDataPool.GetOffset(id); }
 		uint32 GetMeshIndex(const AssetHandle& uuid) const { return m_MeshResourcesBuffer.GetIndex(uuid); }
 
@@ -114,8 +114,8 @@ namespace Omni {
 
 		Ptr<VirtualMemoryBlock> m_TextureIndexAllocator;
 		Ptr<VirtualMemoryBlock> m_StorageImageIndexAllocator;
-		rhumap<UUID, uint32> m_TextureIndices;
-		rhumap<UUID, uint32> m_StorageImageIndices;
+		FlatHashMap<UUID, uint32> m_TextureIndices;
+		FlatHashMap<UUID, uint32> m_StorageImageIndices;
 
 		DeviceIndexedResourceBuffer<GeometryMeshData> m_MeshResourcesBuffer;
 		DeviceMaterialPool m_MaterialDataPool;
@@ -48,7 +48,7 @@ namespace Omni {
 		blas_build_info.vertex_count = sphere_vertices.size();
 		blas_build_info.vertex_stride = sizeof(glm::vec3);
 
-		m_SphereBLAS = RTAccelerationStructure::Create(&g_PersistentAllocator, blas_build_info);
+		m_SphereBLAS = RTAccelerationStructure::Create(&g_RendererAllocator, blas_build_info);
 
 		ShaderLibrary* shader_library = ShaderLibrary::Get();
 		shader_library->LoadShader2(
@@ -129,7 +129,7 @@ namespace Omni {
 		rt_pipeline_spec.groups.Add(translucent_hit_group);
 		rt_pipeline_spec.groups.Add(miss_group);
 
-		m_RTPipeline = RTPipeline::Create(&g_PersistentAllocator, rt_pipeline_spec);
+		m_RTPipeline = RTPipeline::Create(&g_RendererAllocator, rt_pipeline_spec);
 
 		PipelineSpecification tone_mapping_pass_spec = PipelineSpecification::Default();
 		tone_mapping_pass_spec.shader = shader_library->GetShader("ToneMappingPass");
@@ -141,7 +141,7 @@ namespace Omni {
 		tone_mapping_pass_spec.depth_write_enable = false;
 		tone_mapping_pass_spec.descriptor_set = m_SceneDescriptorSet[0];
 
-		m_ToneMappingPass = Pipeline::Create(&g_PersistentAllocator, tone_mapping_pass_spec);
+		m_ToneMappingPass = Pipeline::Create(&g_RendererAllocator, tone_mapping_pass_spec);
 
 		// TODO: remove
 		// Init visibility buffer
@@ -152,7 +152,7 @@ namespace Omni {
 			image_spec.extent = Renderer::GetSwapchainImage()->GetSpecification().extent;
 			OMNI_DEBUG_ONLY_CODE(image_spec.debug_name = "Vis-buffer attachment");
 
-			m_VisibilityBuffer = Image::Create(&g_PersistentAllocator, image_spec);
+			m_VisibilityBuffer = Image::Create(&g_RendererAllocator, image_spec);
 
 			for (auto& set : m_SceneDescriptorSet) {
 				set->Write(1, 0, m_VisibilityBuffer, nullptr);
@@ -166,7 +166,7 @@ namespace Omni {
 			output_image_spec.format = ImageFormat::RGBA128_HDR;
 			OMNI_DEBUG_ONLY_CODE(output_image_spec.debug_name = "PathTracing.Output");
 
-			m_OutputImage = Image::Create(&g_PersistentAllocator, output_image_spec);
+			m_OutputImage = Image::Create(&g_RendererAllocator, output_image_spec);
 
 			for (int i = 0; i < Renderer::GetConfig().frames_in_flight; i++) {
 				m_SceneDescriptorSet[i]->Write(3, 0, m_OutputImage, nullptr);
@@ -180,7 +180,7 @@ namespace Omni {
 			buffer_spec.memory_usage = DeviceBufferMemoryUsage::COHERENT_WRITE;
 			buffer_spec.heap = DeviceBufferMemoryHeap::DEVICE;
 
-			m_SettingsBuffer = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec);
+			m_SettingsBuffer = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec);
 
 			// Copy default settings to all frames
 			for (uint32 i = 0; i < Renderer::GetConfig().frames_in_flight; i++) {
@@ -337,7 +337,7 @@ namespace Omni {
 			TLASBuildInfo tlas_build_info = {};
 			tlas_build_info.instances = std::move(tlas_instances);
 
-			m_SceneTLAS = RTAccelerationStructure::Create(&g_PersistentAllocator, tlas_build_info);
+			m_SceneTLAS = RTAccelerationStructure::Create(&g_RendererAllocator, tlas_build_info);
 
 			m_SceneDescriptorSet[Renderer::GetCurrentFrameIndex()]->Write(2, 0, m_SceneTLAS);
 
@@ -21,17 +21,20 @@ namespace Omni {
 	ISceneRenderer::ISceneRenderer(const SceneRendererSpecification& spec)
 		: m_Specification(spec)
 		, m_MaterialDataPool(this, 4096 * 256 /* 256Kb of data*/)
-		, m_TextureIndexAllocator(VirtualMemoryBlock::Create(&g_PersistentAllocator, 4 * UINT16_MAX))
+		, m_TextureIndexAllocator(VirtualMemoryBlock::Create(&g_RendererAllocator, 4 * UINT16_MAX))
 		, m_MeshResourcesBuffer(4096 * sizeof(GeometryMeshData)) // allow up to 4096 meshes be allocated at once
-		, m_StorageImageIndexAllocator(VirtualMemoryBlock::Create(&g_PersistentAllocator, 4 * UINT16_MAX)) 
+		, m_StorageImageIndexAllocator(VirtualMemoryBlock::Create(&g_RendererAllocator, 4 * UINT16_MAX)) 
 	{
+		MemoryTelemetry::RegisterVirtualMemoryBlock("Renderer.TextureIndices", m_TextureIndexAllocator.Raw());
+		MemoryTelemetry::RegisterVirtualMemoryBlock("Renderer.StorageImageIndices", m_StorageImageIndexAllocator.Raw());
+
 		// Descriptor data
 		{
 			DescriptorSetSpecification global_set_spec = {};
 			global_set_spec.bindings = ShaderLibrary::Get()->GetGlobalDescriptorSetBindings();
 
 			for (int i = 0; i < Renderer::GetConfig().frames_in_flight; i++) {
-				auto set = DescriptorSet::Create(&g_PersistentAllocator, global_set_spec);
+				auto set = DescriptorSet::Create(&g_RendererAllocator, global_set_spec);
 				m_SceneDescriptorSet.push_back(set);
 			}
 
@@ -44,14 +47,14 @@ namespace Omni {
 				OMNI_DEBUG_ONLY_CODE(attachment_spec.debug_name = "SceneRenderer output");
 
 				for (int i = 0; i < Renderer::GetConfig().frames_in_flight; i++) {
-					m_RendererOutputs.push_back(Image::Create(&g_PersistentAllocator, attachment_spec));
+					m_RendererOutputs.push_back(Image::Create(&g_RendererAllocator, attachment_spec));
 				}
 
 				attachment_spec.usage = ImageUsage::DEPTH_BUFFER;
 				attachment_spec.format = ImageFormat::D32;
 
 				for (int i = 0; i < Renderer::GetConfig().frames_in_flight; i++)
-					m_DepthAttachments.push_back(Image::Create(&g_PersistentAllocator, attachment_spec));
+					m_DepthAttachments.push_back(Image::Create(&g_RendererAllocator, attachment_spec));
 
 			}
 
@@ -64,7 +67,7 @@ namespace Omni {
 			buffer_spec.heap = DeviceBufferMemoryHeap::DEVICE;
 			buffer_spec.buffer_usage = DeviceBufferUsage::SHADER_DEVICE_ADDRESS;
 			buffer_spec.size = sizeof(ViewData) * Renderer::GetConfig().frames_in_flight;
-			m_CameraDataBuffer = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec);
+			m_CameraDataBuffer = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec);
 		}
 
 		// Initialize nearest filtration sampler
@@ -79,7 +82,7 @@ namespace Omni {
 			sampler_spec.lod_bias = 0.0f;
 			sampler_spec.anisotropic_filtering_level = m_Specification.anisotropic_filtering;
 
-			m_SamplerNearest = ImageSampler::Create(&g_PersistentAllocator, sampler_spec);
+			m_SamplerNearest = ImageSampler::Create(&g_RendererAllocator, sampler_spec);
 		}
 		// Initializing linear filtration sampler
 		{
@@ -93,7 +96,7 @@ namespace Omni {
 			sampler_spec.lod_bias = 0.0f;
 			sampler_spec.anisotropic_filtering_level = m_Specification.anisotropic_filtering;
 
-			m_SamplerLinear = ImageSampler::Create(&g_PersistentAllocator, sampler_spec);
+			m_SamplerLinear = ImageSampler::Create(&g_RendererAllocator, sampler_spec);
 		}
 		// Load dummy white texture
 		{
@@ -109,7 +112,7 @@ namespace Omni {
 			image_spec.array_layers = 1;
 			OMNI_DEBUG_ONLY_CODE(image_spec.debug_name = "Dummy white texture");
 
-			m_DummyWhiteTexture = Image::Create(&g_PersistentAllocator, image_spec, 0);
+			m_DummyWhiteTexture = Image::Create(&g_RendererAllocator, image_spec, 0);
 			AcquireResourceIndex(m_DummyWhiteTexture, SamplerFilteringMode::LINEAR);
 		}
 		// Create render queue
@@ -123,7 +126,7 @@ namespace Omni {
 			spec.memory_usage = DeviceBufferMemoryUsage::COHERENT_WRITE;
 			OMNI_DEBUG_ONLY_CODE(spec.debug_name = "Device render queue");
 
-			m_DeviceRenderQueue = DeviceBuffer::Create(&g_PersistentAllocator, spec);
+			m_DeviceRenderQueue = DeviceBuffer::Create(&g_RendererAllocator, spec);
 		}
 		// Init device light source storage
 		{
@@ -137,7 +140,7 @@ namespace Omni {
 			spec.memory_usage = DeviceBufferMemoryUsage::COHERENT_WRITE;
 			spec.heap = DeviceBufferMemoryHeap::DEVICE;
 
-			m_DevicePointLights = DeviceBuffer::Create(&g_PersistentAllocator, spec);
+			m_DevicePointLights = DeviceBuffer::Create(&g_RendererAllocator, spec);
 		}
 		// Initialize white noise image
 		{
@@ -157,7 +160,7 @@ namespace Omni {
 			image_spec.array_layers = 1;
 			image_spec.pixels = white_noise_data;
 
-			m_WhiteNoiseImage = Image::Create(&g_PersistentAllocator, image_spec);
+			m_WhiteNoiseImage = Image::Create(&g_RendererAllocator, image_spec);
 
 			for (auto& set : m_SceneDescriptorSet) {
 				set->Write(4, 0, m_WhiteNoiseImage, nullptr);
@@ -186,7 +189,7 @@ namespace Omni {
 
 		for (auto& set : m_SceneDescriptorSet)
 			set->Write(0, index, image, sampler);
-		m_TextureIndices.emplace(image->Handle, index);
+		m_TextureIndices.Emplace(image->Handle, index);
 
 		return index;
 	}
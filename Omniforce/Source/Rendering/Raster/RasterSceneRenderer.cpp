@@ -41,7 +41,7 @@ namespace Omni {
 			buffer_spec.buffer_usage = DeviceBufferUsage::SHADER_DEVICE_ADDRESS;
 			buffer_spec.heap = DeviceBufferMemoryHeap::DEVICE;
 
-			m_SpriteDataBuffer = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec);
+			m_SpriteDataBuffer = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec);
 			m_SpriteBufferSize = per_frame_size;
 		}
 
@@ -58,8 +58,8 @@ namespace Omni {
 
 			// helper lambda
 			auto m = [](UUID id) -> auto {
-				std::map<std::string, std::string> m;
-				m.emplace("__OMNI_PIPELINE_LOCAL_HASH", std::to_string(Pipeline::ComputeDeviceID(id)));
+				ShaderMacroTable m;
+				m.Set("__OMNI_PIPELINE_LOCAL_HASH", std::to_string(Pipeline::ComputeDeviceID(id)));
 				return m;
 			};
 
@@ -118,7 +118,7 @@ namespace Omni {
 			pipeline_spec.output_attachments_formats = { ImageFormat::RGBA64_HDR };
 			pipeline_spec.culling_mode = PipelineCullingMode::NONE;
 
-			m_SpritePass = Pipeline::Create(&g_PersistentAllocator, pipeline_spec);
+			m_SpritePass = Pipeline::Create(&g_RendererAllocator, pipeline_spec);
 
 			// PBR full screen
 			pipeline_spec.shader = shader_library->GetShader("PBRLighting");
@@ -127,7 +127,7 @@ namespace Omni {
 			pipeline_spec.depth_test_enable = false;
 			pipeline_spec.depth_write_enable = false;
 
-			m_PBRFullscreenPipeline = Pipeline::Create(&g_PersistentAllocator, pipeline_spec);
+			m_PBRFullscreenPipeline = Pipeline::Create(&g_RendererAllocator, pipeline_spec);
 
 			// Vis buffer pass
 			pipeline_spec.shader = shader_library->GetShader("VisibilityBuffer.ofs");
@@ -137,7 +137,7 @@ namespace Omni {
 			pipeline_spec.depth_test_enable = false;
 			pipeline_spec.color_blending_enable = false;
 
-			m_VisBufferPass = Pipeline::Create(&g_PersistentAllocator, pipeline_spec);
+			m_VisBufferPass = Pipeline::Create(&g_RendererAllocator, pipeline_spec);
 
 			// Vis material resolve pass
 			pipeline_spec.shader = shader_library->GetShader("ResolveVisibleMaterialMask");
@@ -145,14 +145,14 @@ namespace Omni {
 			pipeline_spec.depth_write_enable = true;
 			pipeline_spec.depth_test_enable = true;
 
-			m_VisMaterialResolvePass = Pipeline::Create(&g_PersistentAllocator, pipeline_spec);
+			m_VisMaterialResolvePass = Pipeline::Create(&g_RendererAllocator, pipeline_spec);
 
 			// compute frustum culling
 			pipeline_spec.type = PipelineType::COMPUTE;
 			pipeline_spec.shader = shader_library->GetShader("FrustumCulling");
 			pipeline_spec.debug_name = "Frustum cull prepass";
 
-			m_IndirectFrustumCullPipeline = Pipeline::Create(&g_PersistentAllocator, pipeline_spec);
+			m_IndirectFrustumCullPipeline = Pipeline::Create(&g_RendererAllocator, pipeline_spec);
 		}
 		// Initialize device render queue and all buffers for indirect drawing
 		{
@@ -169,14 +169,14 @@ namespace Omni {
 			spec.memory_usage = DeviceBufferMemoryUsage::NO_HOST_ACCESS;
 			OMNI_DEBUG_ONLY_CODE(spec.debug_name = "Device culled render queue buffer");
 
-			m_CulledDeviceRenderQueue = DeviceBuffer::Create(&g_PersistentAllocator, spec);
+			m_CulledDeviceRenderQueue = DeviceBuffer::Create(&g_RendererAllocator, spec);
 
 			// Create indirect params buffer
 			spec.size = 4 + sizeof(glm::uvec3) * std::pow(2, 16);
 			spec.buffer_usage = DeviceBufferUsage::INDIRECT_PARAMS;
 			OMNI_DEBUG_ONLY_CODE(spec.debug_name = "Device indirect draw params buffer");
 
-			m_DeviceIndirectDrawParams = DeviceBuffer::Create(&g_PersistentAllocator, spec);
+			m_DeviceIndirectDrawParams = DeviceBuffer::Create(&g_RendererAllocator, spec);
 		}
 		// Init G-Buffer
 		{
@@ -186,18 +186,18 @@ namespace Omni {
 			image_spec.extent = Renderer::GetSwapchainImage()->GetSpecification().extent;
 			OMNI_DEBUG_ONLY_CODE(image_spec.debug_name = "G-Buffer positions attachment");
 
-			m_GBuffer.positions = Image::Create(&g_PersistentAllocator, image_spec);
+			m_GBuffer.positions = Image::Create(&g_RendererAllocator, image_spec);
 
 			OMNI_DEBUG_ONLY_CODE(image_spec.debug_name = "G-Buffer normals attachment");
-			m_GBuffer.normals = Image::Create(&g_PersistentAllocator, image_spec);
+			m_GBuffer.normals = Image::Create(&g_RendererAllocator, image_spec);
 
 			image_spec.format = ImageFormat::RGBA32_UNORM;
 
 			OMNI_DEBUG_ONLY_CODE(image_spec.debug_name = "G-Buffer base color attachment");
-			m_GBuffer.base_color = Image::Create(&g_PersistentAllocator, image_spec);
+			m_GBuffer.base_color = Image::Create(&g_RendererAllocator, image_spec);
 
 			OMNI_DEBUG_ONLY_CODE(image_spec.debug_name = "G-Buffer MRO attachment");
-			m_GBuffer.metallic_roughness_occlusion = Image::Create(&g_PersistentAllocator, image_spec);
+			m_GBuffer.metallic_roughness_occlusion = Image::Create(&g_RendererAllocator, image_spec);
 
 			// Acquire indices
 			AcquireResourceIndex(m_GBuffer.positions, SamplerFilteringMode::LINEAR);
@@ -213,7 +213,7 @@ namespace Omni {
 			image_spec.extent = Renderer::GetSwapchainImage()->GetSpecification().extent;
 			OMNI_DEBUG_ONLY_CODE(image_spec.debug_name = "Vis-buffer attachment");
 
-			m_VisibilityBuffer = Image::Create(&g_PersistentAllocator, image_spec);
+			m_VisibilityBuffer = Image::Create(&g_RendererAllocator, image_spec);
 
 			for (auto& set : m_SceneDescriptorSet) {
 				set->Write(1, 0, m_VisibilityBuffer, nullptr);
@@ -231,7 +231,7 @@ namespace Omni {
 			// + 4 bytes for size
 			buffer_spec.size = 4 + glm::pow(2, 25) * sizeof(SceneVisibleCluster);
 
-			m_VisibleClusters = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec);
+			m_VisibleClusters = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec);
 		}
 		// Init SW raster queue
 		{
@@ -243,7 +243,7 @@ namespace Omni {
 			// Assume that only a half of visible clusters at most will be SW rasterized
 			buffer_spec.size = m_VisibleClusters->GetSpecification().size / 2;
 
-			m_SWRasterQueue = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec);
+			m_SWRasterQueue = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec);
 		}
 	}
 
@@ -11,10 +11,22 @@ namespace Omni {
 
 	static EngineConfigValue<bool> s_BuildVirtualGeometry("Renderer.UseVirtualGeometry", "Enables virtual geometry raster renderer");
 
+	// Material property keys, interned once
+	static const Name s_BaseColorMapKey = "BASE_COLOR_MAP";
+	static const Name s_NormalMapKey = "NORMAL_MAP";
+	static const Name s_MetallicRoughnessMapKey = "METALLIC_ROUGHNESS_MAP";
+	static const Name s_OcclusionMapKey = "OCCLUSION_MAP";
+	static const Name s_DoubleSidedKey = "DOUBLE_SIDED";
+	static const Name s_BaseColorFactorKey = "BASE_COLOR_FACTOR";
+	static const Name s_TransmissionEnabledKey = "TRANSMISSION_ENABLED";
+	static const Name s_TransmissionIorKey = "TRANSMISSION_IOR";
+	static const Name s_TransmissionThicknessKey = "TRANSMISSION_THICKNESS";
+
 	DeviceMaterialPool::DeviceMaterialPool(ISceneRenderer* context, uint64 size)
 		: m_Context(context)
 	{
-		m_VirtualAllocator = VirtualMemoryBlock::Create(&g_PersistentAllocator, size);
+		m_VirtualAllocator = VirtualMemoryBlock::Create(&g_RendererAllocator, size);
+		MemoryTelemetry::RegisterVirtualMemoryBlock("Renderer.MaterialPool", m_VirtualAllocator.Raw());
 
 		DeviceBufferSpecification buffer_spec = {};
 		buffer_spec.size = size;
@@ -22,14 +34,14 @@ namespace Omni {
 		buffer_spec.memory_usage = DeviceBufferMemoryUsage::NO_HOST_ACCESS;
 		buffer_spec.heap = DeviceBufferMemoryHeap::DEVICE;
 
-		m_PoolBuffer = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec);
+		m_PoolBuffer = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec);
 
 		buffer_spec.size = 512;
 		buffer_spec.buffer_usage = DeviceBufferUsage::STAGING_BUFFER;
 		buffer_spec.memory_usage = DeviceBufferMemoryUsage::COHERENT_WRITE;
 		buffer_spec.heap = DeviceBufferMemoryHeap::HOST;
 
-		m_StagingForCopy = DeviceBuffer::Create(&g_PersistentAllocator, buffer_spec);
+		m_StagingForCopy = DeviceBuffer::Create(&g_RendererAllocator, buffer_spec);
 	}
 
 	DeviceMaterialPool::~DeviceMaterialPool()
@@ -68,29 +80,29 @@ namespace Omni {
 		RTMaterial rt_material = {};
 
 		// Fill-in flags
-		rt_material.Metadata.HasBaseColor				= material_table.contains("BASE_COLOR_MAP");
-		rt_material.Metadata.HasNormal					= material_table.contains("NORMAL_MAP");
-		rt_material.Metadata.HasMetallicRoughness		= material_table.contains("METALLIC_ROUGHNESS_MAP");
-		rt_material.Metadata.HasOcclusion				= material_table.contains("OCCLUSION_MAP");
-		rt_material.Metadata.DoubleSided				= std::get<uint32>(material_table.at("DOUBLE_SIDED"));
+		rt_material.Metadata.HasBaseColor				= material_table.Contains(s_BaseColorMapKey);
+		rt_material.Metadata.HasNormal					= material_table.Contains(s_NormalMapKey);
+		rt_material.Metadata.HasMetallicRoughness		= material_table.Contains(s_MetallicRoughnessMapKey);
+		rt_material.Metadata.HasOcclusion				= material_table.Contains(s_OcclusionMapKey);
+		rt_material.Metadata.DoubleSided				= std::get<uint32>(material_table.At(s_DoubleSidedKey));
 
 		// Fill-in data
 		if (rt_material.Metadata.HasBaseColor) {
-			memcpy(&rt_material.BaseColor, &material_table["BASE_COLOR_MAP"], sizeof(DeviceTexture));
+			memcpy(&rt_material.BaseColor, &material_table[s_BaseColorMapKey], sizeof(DeviceTexture));
 		}
 		if (rt_material.Metadata.HasNormal) {
-			memcpy(&rt_material.Normal, &material_table["NORMAL_MAP"], sizeof(DeviceTexture));
+			memcpy(&rt_material.Normal, &material_table[s_NormalMapKey], sizeof(DeviceTexture));
 		}
 		if (rt_material.Metadata.HasMetallicRoughness) {
-			memcpy(&rt_material.MetallicRoughness, &material_table["METALLIC_ROUGHNESS_MAP"], sizeof(DeviceTexture));
+			memcpy(&rt_material.MetallicRoughness, &material_table[s_MetallicRoughnessMapKey], sizeof(DeviceTexture));
 		}
 		if (rt_material.Metadata.HasOcclusion) {
-			memcpy(&rt_material.Occlusion, &material_table["OCCLUSION_MAP"], sizeof(DeviceTexture));
+			memcpy(&rt_material.Occlusion, &material_table[s_OcclusionMapKey], sizeof(DeviceTexture));
 		}
 
 		// Handle uniform color
-		if (material_table.contains("BASE_COLOR_FACTOR")) {
-			memcpy(&rt_material.UniformColor, &material_table["BASE_COLOR_FACTOR"], sizeof(glm::vec4));
+		if (material_table.Contains(s_BaseColorFactorKey)) {
+			memcpy(&rt_material.UniformColor, &material_table[s_BaseColorFactorKey], sizeof(glm::vec4));
 		}
 		else {
 			glm::vec4 default_value = glm::vec4(1.0f);
@@ -100,14 +112,14 @@ namespace Omni {
 		// Handle transmission
 		uint32 rt_material_size = sizeof(RTMaterial);
 
-		if((rt_material.TransmissionData.enabled = material_table.contains("TRANSMISSION_ENABLED")) == true) {
+		if((rt_material.TransmissionData.enabled = material_table.Contains(s_TransmissionEnabledKey)) == true) {
 			rt_material_size += sizeof(RTMaterialTransmission);
 			
-			if (material_table.contains("TRANSMISSION_IOR")) {
-				memcpy(&rt_material.TransmissionData.value.IOR, &material_table["TRANSMISSION_IOR"], sizeof(float32));
+			if (material_table.Contains(s_TransmissionIorKey)) {
+				memcpy(&rt_material.TransmissionData.value.IOR, &material_table[s_TransmissionIorKey], sizeof(float32));
 			}
-			else if (material_table.contains("TRANSMISSION_THICKNESS")) {
-				memcpy(&rt_material.TransmissionData.value.Thickness, &material_table["TRANSMISSION_THICKNESS"], sizeof(float32));
+			else if (material_table.Contains(s_TransmissionThicknessKey)) {
+				memcpy(&rt_material.TransmissionData.value.Thickness, &material_table[s_TransmissionThicknessKey], sizeof(float32));
 			}
 		} else {
 			rt_material_size -= sizeof(RTMaterialTransmission);
@@ -135,7 +147,7 @@ namespace Omni {
 		OMNIFORCE_ASSERT_TAGGED(dst_offset != UINT32_MAX, "Failed to allocate material data. Exceeded limit?");
 		m_OffsetsMap.emplace(material, dst_offset);
 
-		Ref<DeviceCmdBuffer> cmd_buffer = DeviceCmdBuffer::Create(&g_TransientAllocator, DeviceCmdBufferLevel::PRIMARY, DeviceCmdBufferType::TRANSIENT, DeviceCmdType::GENERAL);
+		Ref<DeviceCmdBuffer> cmd_buffer = DeviceCmdBuffer::Create(&g_RendererAllocator, DeviceCmdBufferLevel::PRIMARY, DeviceCmdBufferType::TRANSIENT, DeviceCmdType::GENERAL);
 		cmd_buffer->Begin();
 		m_StagingForCopy->CopyRegionTo(cmd_buffer, m_PoolBuffer, 0, dst_offset, material_size);
 		cmd_buffer->End();
@@ -12,6 +12,7 @@
 #include <Asset/OFRController.h>
 #include <Physics/PhysicsEngine.h>
 #include <Filesystem/Filesystem.h>
+#include <Filesystem/AsyncIO.h>
 #include <Scripting/ScriptEngine.h>
 #include <Threading/JobSystem.h>
 #include <Core/Utils.h>
@@ -21,11 +22,11 @@
 namespace Omni {
 
 	template<typename Component>
-	static void ExplicitComponentCopy(entt::registry& src_registry, entt::registry& dst_registry, robin_hood::unordered_map<UUID, entt::entity>& map) {
+	static void ExplicitComponentCopy(entt::registry& src_registry, entt::registry& dst_registry, FlatHashMap<UUID, entt::entity>& map) {
 		auto components = src_registry.view<Component>();
 		for (auto& src_entity : components)
 		{
-			entt::entity dst_entity = map.at(src_registry.get<UUIDComponent>(src_entity).id);
+			entt::entity dst_entity = map.At(src_registry.get<UUIDComponent>(src_entity).id);
 			auto& src_component = src_registry.get<Component>(src_entity);
 			dst_registry.emplace_or_replace<Component>(dst_entity, src_component);
 		}
@@ -37,7 +38,7 @@ namespace Omni {
 		SceneRendererSpecification renderer_spec = {};
 		renderer_spec.anisotropic_filtering = 16;
 
-		m_Renderer = PathTracingSceneRenderer::Create(&g_PersistentAllocator, renderer_spec);
+		m_Renderer = PathTracingSceneRenderer::Create(&g_RendererAllocator, renderer_spec);
 	}
 
 	Scene::Scene(Scene* other)
@@ -77,6 +78,8 @@ namespace Omni {
 
 	void Scene::OnUpdate(float32 step)
 	{
+		OMNIFORCE_PROFILE_FUNCTION();
+
 		// Sort sprite components by their layer, so they and their depth are rendered correctly
 		m_Registry.sort<SpriteComponent>([](const auto& lhs, const auto& rhs) {
 			return lhs.layer < rhs.layer;
@@ -179,6 +182,8 @@ namespace Omni {
 		// Update scripts (if script engine has no context, then we are in editor mode and no scripts update needed)
 		ScriptEngine* script_engine = ScriptEngine::Get();
 		if (script_engine->HasContext()) {
+			OMNIFORCE_PROFILE_ZONE("Update Scripts");
+
 			script_engine->OnUpdate();
 
 			auto script_component_view = m_Registry.view<ScriptComponent>();
@@ -204,7 +209,7 @@ namespace Omni {
 
 		entity.GetComponent<TagComponent>().tag.reserve(256);
 
-		m_Entities.emplace(id, entity);
+		m_Entities.Emplace(id, entity);
 
 		return entity;
 	}
@@ -222,7 +227,7 @@ namespace Omni {
 		if(parent)
 			parent.GetComponent<HierarchyNodeComponent>().children.push_back(id);
 
-		m_Entities.emplace(id, entity);
+		m_Entities.Emplace(id, entity);
 
 
 		return entity;
@@ -269,7 +274,7 @@ namespace Omni {
 			}
 		}
 
-		m_Entities.erase(entity.GetID());
+		m_Entities.Remove(entity.GetID());
 		m_Registry.destroy(entity);
 	}
 
@@ -333,7 +338,7 @@ namespace Omni {
 
 		nlohmann::json& texture_node = node["Textures"];
 
-		auto tex_registry = *AssetManager::Get()->GetAssetRegistry();
+		auto& tex_registry = *AssetManager::Get()->GetAssetRegistry();
 		for (auto& [id, texture] : tex_registry) {
 			Ref<Image> image = texture;
 			texture_node.emplace(std::to_string(texture->Handle), image->GetSpecification().path.string());
@@ -358,22 +363,52 @@ namespace Omni {
 
 	void Scene::Deserialize(nlohmann::json& node)
 	{
-		m_Entities.clear();
+		m_Entities.Clear();
 		m_Registry.clear();
 
 		nlohmann::json textures = node["Textures"];
 
 		std::shared_mutex renderer_mtx;
-		auto executor = JobSystem::GetExecutor();
 
-		tf::Taskflow taskflow;
+		struct TextureLoadContext {
+			AssetHandle id;
+			std::string path;
+			std::vector<byte> file_data;
+		};
+
+		// Reserved upfront, completion callbacks hold pointers to contexts
+		std::vector<TextureLoadContext> texture_contexts;
+		texture_contexts.reserve(textures.size());
+
+		std::vector<IOReadRequest> read_requests;
+		read_requests.reserve(textures.size());
+
+		// All texture files are read in one batch, each texture is decoded on a worker as soon as its file is loaded
 		for (auto i : textures.items()) {
-			taskflow.emplace([&, i]() {
-				std::string texture_path = i.value().get<std::string>();
+			TextureLoadContext& context = texture_contexts.emplace_back();
+			context.id = std::stoull(i.key());
+			context.path = i.value().get<std::string>();
+
+			std::filesystem::path full_path = FileSystem::GetWorkingDirectory().append(context.path);
+			context.file_data.resize(FileSystem::FileSize(full_path));
+
+			IOReadRequest& request = read_requests.emplace_back();
+			request.path = full_path;
+			request.destination = context.file_data;
+			request.on_complete = [this, context = &context, renderer_mtx = &renderer_mtx](const IOReadResult& result) {
+				if (!result.success) {
+					OMNIFORCE_CORE_ERROR("Failed to read texture file: {}", context->path);
+					return;
+				}
 
-				OFRController ofr_controller(FileSystem::GetWorkingDirectory().append(texture_path));
+				OFRController ofr_controller(std::span<const byte>(context->file_data.data(), result.bytes_read));
 				auto data = ofr_controller.ExtractSubresources();
 
+				if (data.empty()) {
+					OMNIFORCE_CORE_ERROR("Failed to extract texture data: {}", context->path);
+					return;
+				}
+
 				AssetFileHeader header = ofr_controller.ExtractHeader();
 				auto metadata = ofr_controller.ExtractMetadata();
 				uint32 num_mip_levels = 0;
@@ -390,23 +425,24 @@ namespace Omni {
 				image_spec.extent = { image_width, image_height, 1 };
 				image_spec.format = ImageFormat::BC7;
 				image_spec.mip_levels = num_mip_levels;
-				image_spec.path = texture_path;
+				image_spec.path = context->path;
 				image_spec.pixels = data;
 				image_spec.format = ImageFormat::BC7;
 				image_spec.mip_levels = Utils::ComputeNumMipLevelsBC7(image_width, image_height) + 1;
 
-				Ref<AssetBase> image = Image::Create(&g_PersistentAllocator, image_spec, 0);
+				Ref<AssetBase> image = Image::Create(&g_AssetAllocator, image_spec, 0);
 
-				AssetHandle id = AssetManager::Get()->RegisterAsset(image, std::stoull(i.key()));
+				AssetHandle id = AssetManager::Get()->RegisterAsset(image, context->id);
 
 				Ref<Image> texture = AssetManager::Get()->GetAsset<Image>(id);
 
-				renderer_mtx.lock();
+				renderer_mtx->lock();
 				m_Renderer->AcquireResourceIndex(texture, SamplerFilteringMode::NEAREST);
-				renderer_mtx.unlock();
-			});
+				renderer_mtx->unlock();
+			};
 		}
-		executor->run(taskflow).wait();
+
+		IOService::Get()->Submit(std::move(read_requests))->Wait();
 
 		nlohmann::json& entities_node = node["GameObjects"];
 		for (auto i : entities_node.items()) {
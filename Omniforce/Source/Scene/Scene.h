@@ -72,7 +72,7 @@ namespace Omni {
 		bool m_InRuntime = false;
 
 		entt::registry m_Registry;
-		robin_hood::unordered_map<UUID, entt::entity> m_Entities;
+		FlatHashMap<UUID, entt::entity> m_Entities;
 		Entity* m_RootNode; // all nodes' parent, origin of the world
 
 		PhysicsSettings m_PhysicsSettings;
@@ -69,11 +69,11 @@ namespace Omni {
 		char* msg = mono_string_to_utf8(message);
 		switch (severity)
 		{
-		case Logger::Level::LEVEL_TRACE:			OMNIFORCE_CUSTOM_LOGGER_TRACE("Game", msg);			break;
-		case Logger::Level::LEVEL_INFO:				OMNIFORCE_CUSTOM_LOGGER_INFO("Game", msg);			break;
-		case Logger::Level::LEVEL_WARN:				OMNIFORCE_CUSTOM_LOGGER_WARN("Game", msg);			break;
-		case Logger::Level::LEVEL_ERROR:			OMNIFORCE_CUSTOM_LOGGER_ERROR("Game", msg);			break;
-		case Logger::Level::LEVEL_CRITICAL:			OMNIFORCE_CUSTOM_LOGGER_CRITICAL("Game", msg);		break;
+		case Logger::Level::LEVEL_TRACE:			OMNIFORCE_CUSTOM_LOGGER_TRACE("Game", "{}", msg);		break;
+		case Logger::Level::LEVEL_INFO:				OMNIFORCE_CUSTOM_LOGGER_INFO("Game", "{}", msg);		break;
+		case Logger::Level::LEVEL_WARN:				OMNIFORCE_CUSTOM_LOGGER_WARN("Game", "{}", msg);		break;
+		case Logger::Level::LEVEL_ERROR:			OMNIFORCE_CUSTOM_LOGGER_ERROR("Game", "{}", msg);		break;
+		case Logger::Level::LEVEL_CRITICAL:			OMNIFORCE_CUSTOM_LOGGER_CRITICAL("Game", "{}", msg);	break;
 		case Logger::Level::LEVEL_NONE:																	break;
 		default:									std::unreachable();									break;
 		}
@@ -5,24 +5,301 @@
 #include <thread>
 #include <queue>
 #include <shared_mutex>
+#include <mutex>
 #include <atomic>
+#include <chrono>
+#include <optional>
+#include <array>
 
 #include <taskflow/taskflow.hpp>
 
 namespace Omni {
 
-	class JobSystem {
+	class JobLaneObserver;
+
+	/*
+	*	@brief Priority class of job system work. Every priority has its own executor with its own workers, so work of
+	*	one priority never occupies workers of another one and never waits in another priority's queues.
+	*/
+	enum class OMNIFORCE_API JobPriority : uint8 {
+		REALTIME,	// Frame-critical work which must complete within a frame: physics sync, render queue building
+		NORMAL,		// General work, default for everything submitted without a priority
+		BACKGROUND,	// Long-running work which must not affect frame time: texture encoding, mesh processing, compression
+		IO,			// Work which mostly blocks on disk or network
+		COUNT
+	};
+
+	struct JobLaneMetrics {
+		uint32 num_workers = 0;
+		uint64 queue_depth = 0;			// Submitted jobs which have not been started yet
+		uint64 num_running = 0;			// Started jobs which have not been finished yet
+		uint64 num_completed = 0;
+		float32 average_wait_time = 0.0f;		// Milliseconds from submission to start of a job
+		float32 max_wait_time = 0.0f;
+		float32 average_completion_time = 0.0f;	// Milliseconds from submission to completion of a job
+		float32 max_completion_time = 0.0f;
+	};
+
+	struct JobWorkerUtilization {
+		uint32 worker_id = 0;
+		uint64 num_tasks = 0;		// Tasks finished within the frame, including nested ones
+		float32 busy_time = 0.0f;	// Milliseconds spent executing tasks within the frame
+		float32 utilization = 0.0f;	// Busy time divided by frame time
+	};
+
+	struct JobLaneUtilization {
+		float32 average_utilization = 0.0f;
+		float32 min_utilization = 0.0f;	// Utilization of the least busy worker, low values point at starved workers
+		std::vector<JobWorkerUtilization> workers;
+	};
+
+	struct JobFrameUtilization {
+		uint64 frame_index = 0;
+		float32 frame_time = 0.0f; // Milliseconds
+		std::array<JobLaneUtilization, (uint32)JobPriority::COUNT> lanes;
+	};
+
+	struct JobTaskRecord {
+		std::string name;			// Name of taskflow task, "<unnamed>" if task has no name
+		JobPriority priority = JobPriority::NORMAL;
+		uint32 worker_id = 0;
+		uint32 nesting_depth = 0;	// Number of tasks which were running on the worker when task started, e.g. a task executed by `corun`
+		uint64 frame_index = 0;
+		float32 start_time = 0.0f;	// Milliseconds since task recording was started
+		float32 duration = 0.0f;	// Milliseconds
+		float32 queue_wait_time = -1.0f; // Milliseconds from submission to start, only known for jobs submitted through job system, -1 otherwise
+	};
+
+	struct JobSystemSpecification {
+		uint32 num_realtime_workers = 0;	// 0 to use a quarter of hardware threads, taken from normal lane
+		uint32 num_background_workers = 0;	// 0 to use a worker per two hardware threads
+	};
+
+	struct ParallelForSettings {
+		JobPriority priority = JobPriority::NORMAL;
+		uint32 grain_size = 0;	// Number of items processed by a single chunk, 0 to pick it from item and worker count
+		const char* name = "Parallel For";	// Name of loop tasks in profiler captures and task records
+	};
+
+	/*
+	*	@brief Job system with a separate lane per priority class. Realtime and normal lanes together get a worker per
+	*	hardware thread. Background lane has its own workers running at lowered OS priority, so background work only takes
+	*	cores which are not needed by frame work, and frame work never queues behind it. It gets half as many workers as there are
+	*	hardware threads, so the process runs about 1.5 threads per hardware thread in total. IO lane has a couple of workers for blocking work.
+	*	Workers steal only within their own lane, so a higher priority lane never loses its workers to lower priority work.
+	*	Metrics are collected for work submitted through `Run` and `SilentAsync`, direct executor use is not tracked.
+	*	Every executed task, including direct executor use, is observed for per-frame worker utilization and task recording.
+	*/
+	class OMNIFORCE_API JobSystem {
 	public:
-		static tf::Executor* GetExecutor() { 
-			return &m_Executor; 
+		/*
+		*	@brief Overrides lane sizes. Optional, lanes are created on first use, so it must be called before any work is
+		*	submitted. Used by tools which run with a fixed worker budget
+		*/
+		static void Configure(const JobSystemSpecification& spec);
+
+		static tf::Executor* GetExecutor(JobPriority priority = JobPriority::NORMAL) {
+			return &GetLane(priority).executor;
 		};
 
-		static void WaitForAll() { 
-			return m_Executor.wait_for_all(); 
+		// Waits for work of all priorities
+		static void WaitForAll();
+
+		/*
+		*	@brief Runs taskflow on the lane of given priority. Taskflow must stay alive until returned future is ready.
+		*	Whole taskflow is tracked as a single job, it is considered started once its first task is started
+		*/
+		static tf::Future<void> Run(tf::Taskflow& taskflow, JobPriority priority = JobPriority::NORMAL);
+
+		/*
+		*	@brief Runs taskflow on the lane of given priority and waits for it. When called from a worker of the same lane,
+		*	the worker keeps executing tasks while waiting instead of blocking, so nested graphs can't starve the lane
+		*/
+		static void RunAndWait(tf::Taskflow& taskflow, JobPriority priority = JobPriority::NORMAL);
+
+		template<typename Func>
+		static void SilentAsync(JobPriority priority, Func&& func) {
+			Lane& lane = GetLane(priority);
+			std::chrono::steady_clock::time_point submit_time = lane.OnSubmit();
+
+			lane.executor.silent_async([&lane, submit_time, func = std::forward<Func>(func)]() mutable {
+				lane.OnStart(submit_time, true);
+				func();
+				lane.OnComplete(submit_time);
+			});
+		}
+
+		/*
+		*	@brief When called from a worker of any lane, keeps executing tasks of that lane until `predicate` returns true
+		*	and returns true. Returns false immediately when called from any other thread, which then may block instead
+		*/
+		template<typename Predicate>
+		static bool CorunUntil(Predicate&& predicate) {
+			for (uint32 i = 0; i < (uint32)JobPriority::COUNT; i++) {
+				tf::Executor& executor = GetLane((JobPriority)i).executor;
+
+				if (executor.this_worker_id() >= 0) {
+					executor.corun_until(std::forward<Predicate>(predicate));
+					return true;
+				}
+			}
+
+			return false;
 		}
 
+		/*
+		*	@brief Calls `func(begin, end)` for chunks of [0; count) range in parallel and waits for completion.
+		*	Runs on a task graph which is built once per lane and reused by following calls, workers pull chunks from
+		*	a shared counter, so uneven chunks are balanced. When called from a worker of the same lane, calling worker
+		*	executes chunks too instead of blocking. Single chunk loops are executed inline
+		*/
+		template<typename Func>
+		static void ParallelFor(uint32 count, Func&& func, const ParallelForSettings& settings = {}) {
+			ParallelForImpl(count, settings, [&func](uint32 begin, uint32 end, uint32 worker_slot) {
+				func(begin, end);
+			});
+		}
+
+		/*
+		*	@brief Same as above, calls `func(begin, end, scratch)`. Every worker gets its own default constructed `Scratch`,
+		*	which is reused for all chunks executed by the worker within the call, so per item temporary storage keeps its capacity
+		*/
+		template<typename Scratch, typename Func>
+		static void ParallelFor(uint32 count, Func&& func, const ParallelForSettings& settings = {}) {
+			std::vector<WorkerLocal<Scratch>> scratch(GetNumWorkerSlots(settings.priority));
+
+			ParallelForImpl(count, settings, [&func, &scratch](uint32 begin, uint32 end, uint32 worker_slot) {
+				std::optional<Scratch>& worker_scratch = scratch[worker_slot].value;
+
+				if (!worker_scratch)
+					worker_scratch.emplace();
+
+				func(begin, end, *worker_scratch);
+			});
+		}
+
+		/*
+		*	@brief Reduces [0; count) range in parallel. `func(begin, end)` returns a value of a chunk, chunk values are
+		*	combined by `combine(T, T)` per worker first and then across workers. `combine` must be associative and commutative
+		*/
+		template<typename T, typename Func, typename Combine>
+		static T ParallelReduce(uint32 count, T identity, Func&& func, Combine&& combine, const ParallelForSettings& settings = {}) {
+			std::vector<WorkerLocal<T>> partials(GetNumWorkerSlots(settings.priority));
+
+			ParallelForImpl(count, settings, [&func, &combine, &partials](uint32 begin, uint32 end, uint32 worker_slot) {
+				std::optional<T>& partial = partials[worker_slot].value;
+
+				if (partial)
+					partial = combine(std::move(*partial), func(begin, end));
+				else
+					partial.emplace(func(begin, end));
+			});
+
+			T result = std::move(identity);
+			for (WorkerLocal<T>& partial : partials) {
+				if (partial.value)
+					result = combine(std::move(result), std::move(*partial.value));
+			}
+
+			return result;
+		}
+
+		static JobLaneMetrics GetMetrics(JobPriority priority);
+
+		// Resets latency statistics of all lanes, job counters are not affected
+		static void ResetMetrics();
+
+		// Called by the engine once per frame to compute worker utilization of the frame
+		static void OnFrameEnd();
+
+		// Utilization of the last completed frame
+		static JobFrameUtilization GetFrameUtilization();
+
+		// Utilization of recent frames, oldest first
+		static std::vector<JobFrameUtilization> GetUtilizationHistory();
+
+		/*
+		*	@brief Task recording stores name, worker, duration and queue wait time of every executed task until it is stopped.
+		*	Starting recording discards tasks recorded before. At most `MAX_RECORDED_TASKS` tasks are kept, tasks beyond
+		*	the limit are counted as dropped
+		*/
+		static constexpr uint64 MAX_RECORDED_TASKS = 256 * 1024;
+
+		static void StartTaskRecording();
+		static void StopTaskRecording();
+		static bool IsRecordingTasks();
+
+		// Returns tasks recorded so far, finished tasks only
+		static std::vector<JobTaskRecord> GetTaskRecords();
+
+		// Number of tasks which were not recorded since recording was started, because the limit was reached
+		static uint64 GetNumDroppedTaskRecords();
+
+		// Dumps utilization history, recorded tasks and per-name task statistics
+		static void SerializeTaskStatistics(nlohmann::json& node);
+		static bool DumpTaskStatistics(const std::filesystem::path& path);
+
 	private:
-		inline static tf::Executor m_Executor;
+		// Padded to cache line, so workers do not share lines when updating their values
+		template<typename T>
+		struct alignas(64) WorkerLocal {
+			std::optional<T> value;
+		};
+
+		struct ParallelForInvocation {
+			void (*function)(void* context, uint32 begin, uint32 end, uint32 worker_slot);
+			void* context;
+		};
+
+		struct ParallelForGraph;
+
+		template<typename Body>
+		static void ParallelForImpl(uint32 count, const ParallelForSettings& settings, Body&& body) {
+			ParallelForInvocation invocation = {};
+			invocation.context = &body;
+			invocation.function = [](void* context, uint32 begin, uint32 end, uint32 worker_slot) {
+				(*(std::remove_reference_t<Body>*)context)(begin, end, worker_slot);
+			};
+
+			ExecuteParallelFor(count, settings, invocation);
+		}
+
+		static void ExecuteParallelFor(uint32 count, const ParallelForSettings& settings, const ParallelForInvocation& invocation);
+
+		// Worker ids of a lane and one extra slot for a thread outside of the lane
+		static uint32 GetNumWorkerSlots(JobPriority priority);
+
+		struct Lane {
+			Lane(JobPriority priority, uint32 num_workers);
+			~Lane();
+
+			std::chrono::steady_clock::time_point OnSubmit();
+			// `within_job_task` is set when called from the task which executes the job, so its queue wait time is attached to the task
+			void OnStart(std::chrono::steady_clock::time_point submit_time, bool within_job_task);
+			void OnComplete(std::chrono::steady_clock::time_point submit_time);
+
+			tf::Executor executor;
+
+			Atomic<uint64> num_submitted = 0;
+			Atomic<uint64> num_started = 0;
+			Atomic<uint64> num_completed = 0;
+
+			// In nanoseconds, totals are accumulated since last metrics reset
+			Atomic<uint64> total_wait_time = 0;
+			Atomic<uint64> max_wait_time = 0;
+			Atomic<uint64> num_waits = 0;
+			Atomic<uint64> total_completion_time = 0;
+			Atomic<uint64> max_completion_time = 0;
+			Atomic<uint64> num_completions = 0;
+
+			// Idle parallel for graphs, a graph is taken by a call for its duration, so concurrent calls do not share one
+			std::mutex parallel_for_mutex;
+			std::vector<ParallelForGraph*> parallel_for_graphs;
+
+			std::shared_ptr<JobLaneObserver> observer;
+		};
+
+		static Lane& GetLane(JobPriority priority);
 
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,166 @@
+#include <Foundation/Common.h>
+#include <Threading/Private/JobLaneObserver.h>
+
+namespace Omni {
+
+	// Tasks executed by the calling thread, nested tasks are pushed on top of the task which coruns them
+	struct JobObserverActiveTask {
+		uint64 begin;
+		int64 queue_wait_time; // -1 if task was not submitted through job system
+	};
+
+	static thread_local std::vector<JobObserverActiveTask> t_ActiveTasks;
+
+	static const ProfilerZoneSource s_TaskZone = { "Task", __FILE__, __LINE__ };
+
+	// Zone sources of named tasks. Captured events point to them, so they are created once per name and never freed.
+	// Every worker keeps its own cache, so the shared table is only locked the first time a worker meets a name
+	static std::mutex s_TaskZonesMutex;
+	static FlatHashMap<Name, const ProfilerZoneSource*> s_TaskZones;
+	static thread_local FlatHashMap<Name, const ProfilerZoneSource*> t_TaskZones;
+
+	static const ProfilerZoneSource* GetTaskZone(const std::string& task_name)
+	{
+		if (task_name.empty())
+			return &s_TaskZone;
+
+		Name name = task_name;
+
+		auto cached = t_TaskZones.Find(name);
+		if (cached != t_TaskZones.end())
+			return cached->second;
+
+		const ProfilerZoneSource* zone = nullptr;
+		{
+			std::lock_guard lock(s_TaskZonesMutex);
+
+			auto [iterator, inserted] = s_TaskZones.Emplace(name, nullptr);
+			if (inserted)
+				iterator->second = new ProfilerZoneSource{ name.CStr(), __FILE__, __LINE__ };
+
+			zone = iterator->second;
+		}
+
+		t_TaskZones.Emplace(name, zone);
+		return zone;
+	}
+
+	JobLaneObserver::JobLaneObserver(JobPriority priority)
+		: m_Priority(priority)
+	{
+	}
+
+	void JobLaneObserver::set_up(size_t num_workers)
+	{
+		m_NumWorkers = (uint32)num_workers;
+		m_Workers = std::make_unique<WorkerState[]>(num_workers);
+	}
+
+	void JobLaneObserver::on_entry(tf::WorkerView worker, tf::TaskView task)
+	{
+		uint64 now = Profiler::Now();
+
+		if (t_ActiveTasks.empty())
+			m_Workers[worker.id()].active_since.store(now, std::memory_order_relaxed);
+
+		t_ActiveTasks.push_back({ now, -1 });
+	}
+
+	void JobLaneObserver::on_exit(tf::WorkerView worker, tf::TaskView task)
+	{
+		uint64 now = Profiler::Now();
+
+		JobObserverActiveTask active_task = t_ActiveTasks.back();
+		t_ActiveTasks.pop_back();
+
+		WorkerState& state = m_Workers[worker.id()];
+		state.num_tasks.fetch_add(1, std::memory_order_relaxed);
+
+		if (t_ActiveTasks.empty()) {
+			// Part of the task which belongs to a previous frame was already accounted by `CollectUtilization`
+			uint64 frame_begin = s_FrameBegin.load(std::memory_order_relaxed);
+			uint64 begin = std::max(active_task.begin, frame_begin);
+
+			state.active_since.store(0, std::memory_order_relaxed);
+			state.busy_time.fetch_add(now > begin ? now - begin : 0, std::memory_order_relaxed);
+		}
+
+		if (Profiler::IsCapturing())
+			Profiler::RecordZone(GetTaskZone(task.name()), active_task.begin, now);
+
+		if (!s_RecordTasks.load(std::memory_order_relaxed))
+			return;
+
+		if (s_NumRecordedTasks.fetch_add(1, std::memory_order_relaxed) >= JobSystem::MAX_RECORDED_TASKS) {
+			s_NumDroppedTasks.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		constexpr float32 ns_to_ms = 0.001f * 0.001f;
+		uint64 recording_begin = s_RecordingBegin.load(std::memory_order_relaxed);
+
+		JobTaskRecord record = {};
+		record.name = task.name().empty() ? "<unnamed>" : task.name();
+		record.priority = m_Priority;
+		record.worker_id = (uint32)worker.id();
+		record.frame_index = s_FrameIndex.load(std::memory_order_relaxed);
+		record.start_time = active_task.begin > recording_begin ? (float32)(active_task.begin - recording_begin) * ns_to_ms : 0.0f;
+		record.duration = (float32)(now - active_task.begin) * ns_to_ms;
+		record.queue_wait_time = active_task.queue_wait_time >= 0 ? (float32)active_task.queue_wait_time * ns_to_ms : -1.0f;
+		record.nesting_depth = (uint32)t_ActiveTasks.size();
+
+		// Only contended when records are collected
+		std::lock_guard lock(state.records_mutex);
+		state.records.push_back(std::move(record));
+	}
+
+	void JobLaneObserver::OnJobStarted(uint64 wait_time)
+	{
+		if (!t_ActiveTasks.empty())
+			t_ActiveTasks.back().queue_wait_time = (int64)wait_time;
+	}
+
+	JobLaneUtilization JobLaneObserver::CollectUtilization(uint64 frame_begin, uint64 frame_end)
+	{
+		constexpr float32 ns_to_ms = 0.001f * 0.001f;
+		uint64 frame_time = std::max<uint64>(frame_end - frame_begin, 1);
+
+		JobLaneUtilization utilization = {};
+		utilization.workers.resize(m_NumWorkers);
+		utilization.min_utilization = m_NumWorkers ? 1.0f : 0.0f;
+
+		for (uint32 i = 0; i < m_NumWorkers; i++) {
+			WorkerState& state = m_Workers[i];
+
+			uint64 busy_time = state.busy_time.exchange(0, std::memory_order_relaxed);
+
+			// Running task contributes its part within the frame
+			uint64 active_since = state.active_since.load(std::memory_order_relaxed);
+			if (active_since && active_since < frame_end)
+				busy_time += frame_end - std::max(active_since, frame_begin);
+
+			JobWorkerUtilization& worker = utilization.workers[i];
+			worker.worker_id = i;
+			worker.num_tasks = state.num_tasks.exchange(0, std::memory_order_relaxed);
+			worker.busy_time = (float32)busy_time * ns_to_ms;
+			worker.utilization = std::min((float32)busy_time / (float32)frame_time, 1.0f);
+
+			utilization.average_utilization += worker.utilization / m_NumWorkers;
+			utilization.min_utilization = std::min(utilization.min_utilization, worker.utilization);
+		}
+
+		return utilization;
+	}
+
+	void JobLaneObserver::CollectTaskRecords(std::vector<JobTaskRecord>& records)
+	{
+		for (uint32 i = 0; i < m_NumWorkers; i++) {
+			WorkerState& state = m_Workers[i];
+
+			std::lock_guard lock(state.records_mutex);
+			std::move(state.records.begin(), state.records.end(), std::back_inserter(records));
+			state.records.clear();
+		}
+	}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Foundation/Common.h>
+#include <Threading/JobSystem.h>
+
+#include <mutex>
+
+namespace Omni {
+
+	/*
+	*	@brief Executor observer of a job system lane. Accumulates busy time of every worker for per-frame utilization
+	*	and, while task recording is enabled, records every executed task. Nested tasks (e.g. executed by `corun`)
+	*	are recorded, but only outermost ones count towards busy time, so time is not counted twice
+	*/
+	class JobLaneObserver : public tf::ObserverInterface {
+	public:
+		JobLaneObserver(JobPriority priority);
+
+		void set_up(size_t num_workers) override;
+		void on_entry(tf::WorkerView worker, tf::TaskView task) override;
+		void on_exit(tf::WorkerView worker, tf::TaskView task) override;
+
+		// Called by lane when a job submitted through job system is started, attaches its queue wait time to the running task
+		static void OnJobStarted(uint64 wait_time);
+
+		// Called once per frame, `frame_begin` and `frame_end` are profiler timestamps
+		JobLaneUtilization CollectUtilization(uint64 frame_begin, uint64 frame_end);
+
+		// Moves recorded tasks to `records`
+		void CollectTaskRecords(std::vector<JobTaskRecord>& records);
+
+		inline static Atomic<bool> s_RecordTasks = false;
+		inline static Atomic<uint64> s_RecordingBegin = 0;
+		inline static Atomic<uint64> s_NumRecordedTasks = 0;	// Reserved record slots, may exceed the limit by dropped tasks
+		inline static Atomic<uint64> s_NumDroppedTasks = 0;
+		inline static Atomic<uint64> s_FrameBegin = 0;
+		inline static Atomic<uint64> s_FrameIndex = 0;
+
+	private:
+		struct alignas(64) WorkerState {
+			Atomic<uint64> busy_time = 0;		// Nanoseconds of finished outermost tasks since the last collection
+			Atomic<uint64> num_tasks = 0;
+			Atomic<uint64> active_since = 0;	// Beginning of running outermost task, 0 if worker is idle
+
+			std::mutex records_mutex;
+			std::vector<JobTaskRecord> records;
+		};
+
+		JobPriority m_Priority;
+		std::unique_ptr<WorkerState[]> m_Workers;
+		uint32 m_NumWorkers = 0;
+	};
+
+}
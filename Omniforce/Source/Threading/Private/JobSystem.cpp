@@ -0,0 +1,551 @@
+#include <Foundation/Common.h>
+#include <Threading/JobSystem.h>
+#include <Threading/Private/JobLaneObserver.h>
+
+#include <deque>
+#include <map>
+
+#if OMNIFORCE_PLATFORM == OMNIFORCE_PLATFORM_WIN64
+	#include <Windows.h>
+#else
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+	#include <pthread.h>
+	#include <unistd.h>
+#endif
+
+namespace Omni {
+
+	/*
+	*	@brief Sets OS priority and name of lane workers when they are started
+	*/
+	class JobLaneWorkerInterface : public tf::WorkerInterface {
+	public:
+		JobLaneWorkerInterface(JobPriority priority)
+			: m_Priority(priority) {}
+
+		void scheduler_prologue(tf::Worker& worker) override
+		{
+#if OMNIFORCE_PLATFORM == OMNIFORCE_PLATFORM_WIN64
+			constexpr int32 thread_priorities[] = { THREAD_PRIORITY_ABOVE_NORMAL, THREAD_PRIORITY_NORMAL, THREAD_PRIORITY_LOWEST, THREAD_PRIORITY_NORMAL };
+			constexpr const wchar_t* thread_names[] = { L"Realtime Worker", L"Worker", L"Background Worker", L"IO Worker" };
+
+			SetThreadPriority(GetCurrentThread(), thread_priorities[(uint32)m_Priority]);
+			SetThreadDescription(GetCurrentThread(), thread_names[(uint32)m_Priority]);
+#else
+			constexpr int32 nice_values[] = { -5, 0, 10, 0 };
+			constexpr const char* thread_names[] = { "Realtime Worker", "Worker", "Backgr. Worker", "IO Worker" };
+
+			// Raising priority requires privileges, realtime workers stay at normal priority if it fails
+			setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), nice_values[(uint32)m_Priority]);
+			pthread_setname_np(pthread_self(), thread_names[(uint32)m_Priority]);
+#endif
+
+			constexpr const char* profiler_thread_names[] = { "Realtime Worker", "Worker", "Background Worker", "IO Worker" };
+			OMNIFORCE_PROFILE_THREAD(profiler_thread_names[(uint32)m_Priority]);
+
+			// Frame work runs on realtime and normal lanes, work on other lanes may outlive frames in flight
+			g_TransientAllocator.SetFrameWorkerThread(m_Priority == JobPriority::REALTIME || m_Priority == JobPriority::NORMAL);
+		}
+
+		void scheduler_epilogue(tf::Worker& worker, std::exception_ptr exception) override {}
+
+	private:
+		JobPriority m_Priority;
+	};
+
+	static uint64 ElapsedNanoseconds(std::chrono::steady_clock::time_point since)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count();
+	}
+
+	static void UpdateMax(Atomic<uint64>& max, uint64 value)
+	{
+		uint64 current = max.load(std::memory_order_relaxed);
+		while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+	}
+
+	static constexpr const char* s_PriorityNames[] = { "Realtime", "Normal", "Background", "IO" };
+
+	// Plot names must outlive profiler capture
+	static constexpr const char* s_UtilizationPlotNames[] = {
+		"Job Utilization: Realtime", "Job Utilization: Normal", "Job Utilization: Background", "Job Utilization: IO"
+	};
+
+	// Number of frames kept in utilization history
+	static constexpr uint32 UTILIZATION_HISTORY_SIZE = 256;
+
+	struct JobSystemStatisticsState {
+		std::mutex mutex;
+		std::deque<JobFrameUtilization> utilization_history;
+		std::vector<JobTaskRecord> task_records;
+	};
+
+	static JobSystemStatisticsState& GetStatisticsState()
+	{
+		static JobSystemStatisticsState state;
+		return state;
+	}
+
+	// Chunks per worker for automatic grain size, more chunks balance uneven work better at the cost of more counter contention
+	static constexpr uint32 PARALLEL_FOR_CHUNKS_PER_WORKER = 8;
+
+	/*
+	*	@brief Persistent graph of a parallel for. It has a task per lane worker, each task pulls chunks until range is exhausted.
+	*	Graph is built once and only its invocation state is changed between runs
+	*/
+	struct JobSystem::ParallelForGraph {
+		ParallelForGraph(Lane& lane)
+			: lane(lane)
+		{
+			for (uint32 i = 0; i < lane.executor.num_workers(); i++)
+				tasks.push_back(taskflow.emplace([this]() { ExecuteChunks((uint32)this->lane.executor.this_worker_id()); }));
+		}
+
+		// Tasks are renamed only when graph is reused by a loop with a different name
+		void SetName(std::string_view name)
+		{
+			if (tasks.front().name() == name)
+				return;
+
+			for (tf::Task& task : tasks)
+				task.name(std::string(name));
+		}
+
+		void ExecuteChunks(uint32 worker_slot)
+		{
+			while (true) {
+				uint64 begin = next_item.fetch_add(grain_size, std::memory_order_relaxed);
+
+				if (begin >= count)
+					return;
+
+				// First chunk marks the start of the whole loop
+				if (begin == 0)
+					lane.OnStart(submit_time, true);
+
+				invocation.function(invocation.context, (uint32)begin, (uint32)std::min<uint64>(begin + grain_size, count), worker_slot);
+			}
+		}
+
+		Lane& lane;
+		tf::Taskflow taskflow;
+		std::vector<tf::Task> tasks;
+
+		ParallelForInvocation invocation = {};
+		uint32 count = 0;
+		uint32 grain_size = 1;
+		std::chrono::steady_clock::time_point submit_time;
+		alignas(64) Atomic<uint64> next_item = 0; // 64 bit, so counter can't wrap when workers overshoot the end
+	};
+
+	JobSystem::Lane::Lane(JobPriority priority, uint32 num_workers)
+		: executor(num_workers, std::make_shared<JobLaneWorkerInterface>(priority))
+	{
+		observer = executor.make_observer<JobLaneObserver>(priority);
+	}
+
+	JobSystem::Lane::~Lane()
+	{
+		for (ParallelForGraph* graph : parallel_for_graphs)
+			delete graph;
+	}
+
+	std::chrono::steady_clock::time_point JobSystem::Lane::OnSubmit()
+	{
+		num_submitted.fetch_add(1, std::memory_order_relaxed);
+		return std::chrono::steady_clock::now();
+	}
+
+	void JobSystem::Lane::OnStart(std::chrono::steady_clock::time_point submit_time, bool within_job_task)
+	{
+		uint64 wait_time = ElapsedNanoseconds(submit_time);
+
+		if (within_job_task)
+			JobLaneObserver::OnJobStarted(wait_time);
+
+		total_wait_time.fetch_add(wait_time, std::memory_order_relaxed);
+		num_waits.fetch_add(1, std::memory_order_relaxed);
+		UpdateMax(max_wait_time, wait_time);
+
+		num_started.fetch_add(1, std::memory_order_release);
+	}
+
+	void JobSystem::Lane::OnComplete(std::chrono::steady_clock::time_point submit_time)
+	{
+		uint64 completion_time = ElapsedNanoseconds(submit_time);
+
+		total_completion_time.fetch_add(completion_time, std::memory_order_relaxed);
+		num_completions.fetch_add(1, std::memory_order_relaxed);
+		UpdateMax(max_completion_time, completion_time);
+
+		num_completed.fetch_add(1, std::memory_order_release);
+	}
+
+	static JobSystemSpecification s_Specification = {};
+	static Atomic<bool> s_LanesCreated = false;
+
+	void JobSystem::Configure(const JobSystemSpecification& spec)
+	{
+		OMNIFORCE_ASSERT_TAGGED(!s_LanesCreated.load(), "Job system must be configured before it is used");
+		s_Specification = spec;
+	}
+
+	JobSystem::Lane& JobSystem::GetLane(JobPriority priority)
+	{
+		// Realtime and normal lanes share hardware threads, lower priority lanes oversubscribe them
+		// at lowered OS priority, so they make progress only on cores which are left idle by frame work
+		static const uint32 num_hardware_threads = std::max(std::thread::hardware_concurrency(), 2u);
+		static const uint32 num_realtime_workers = []() {
+			s_LanesCreated.store(true);
+
+			uint32 num_workers = s_Specification.num_realtime_workers ? s_Specification.num_realtime_workers : num_hardware_threads / 4;
+			return std::clamp(num_workers, 1u, num_hardware_threads - 1);
+		}();
+		static const uint32 num_background_workers =
+			s_Specification.num_background_workers ? s_Specification.num_background_workers : num_hardware_threads / 2;
+
+		static Lane lanes[] = {
+			{ JobPriority::REALTIME, num_realtime_workers },
+			{ JobPriority::NORMAL, num_hardware_threads - num_realtime_workers },
+			{ JobPriority::BACKGROUND, num_background_workers },
+			{ JobPriority::IO, 2 }
+		};
+
+		OMNIFORCE_ASSERT_TAGGED(priority < JobPriority::COUNT, "Invalid job priority");
+		return lanes[(uint32)priority];
+	}
+
+	void JobSystem::WaitForAll()
+	{
+		for (uint32 i = 0; i < (uint32)JobPriority::COUNT; i++)
+			GetLane((JobPriority)i).executor.wait_for_all();
+	}
+
+	tf::Future<void> JobSystem::Run(tf::Taskflow& taskflow, JobPriority priority)
+	{
+		Lane& lane = GetLane(priority);
+		std::chrono::steady_clock::time_point submit_time = lane.OnSubmit();
+
+		// Taskflow is composed into a wrapper which records its start, wrapper is owned by executor until it is finished
+		tf::Taskflow wrapper;
+		tf::Task start_task = wrapper.emplace([&lane, submit_time]() { lane.OnStart(submit_time, true); });
+		tf::Task taskflow_task = wrapper.composed_of(taskflow);
+		start_task.precede(taskflow_task);
+
+		return lane.executor.run(std::move(wrapper), [&lane, submit_time]() { lane.OnComplete(submit_time); });
+	}
+
+	void JobSystem::RunAndWait(tf::Taskflow& taskflow, JobPriority priority)
+	{
+		Lane& lane = GetLane(priority);
+
+		if (lane.executor.this_worker_id() < 0) {
+			Run(taskflow, priority).wait();
+			return;
+		}
+
+		std::chrono::steady_clock::time_point submit_time = lane.OnSubmit();
+		lane.OnStart(submit_time, false);
+
+		lane.executor.corun(taskflow);
+
+		lane.OnComplete(submit_time);
+	}
+
+	uint32 JobSystem::GetNumWorkerSlots(JobPriority priority)
+	{
+		return (uint32)GetLane(priority).executor.num_workers() + 1;
+	}
+
+	void JobSystem::ExecuteParallelFor(uint32 count, const ParallelForSettings& settings, const ParallelForInvocation& invocation)
+	{
+		if (!count)
+			return;
+
+		Lane& lane = GetLane(settings.priority);
+		uint32 num_workers = (uint32)lane.executor.num_workers();
+
+		uint32 grain_size = settings.grain_size;
+		if (!grain_size)
+			grain_size = std::max(count / (num_workers * PARALLEL_FOR_CHUNKS_PER_WORKER), 1u);
+
+		int32 worker_id = lane.executor.this_worker_id();
+		uint32 worker_slot = worker_id >= 0 ? (uint32)worker_id : num_workers;
+
+		// Not worth scheduling
+		if (count <= grain_size) {
+			invocation.function(invocation.context, 0, count, worker_slot);
+			return;
+		}
+
+		ParallelForGraph* graph = nullptr;
+		{
+			std::lock_guard lock(lane.parallel_for_mutex);
+
+			if (!lane.parallel_for_graphs.empty()) {
+				graph = lane.parallel_for_graphs.back();
+				lane.parallel_for_graphs.pop_back();
+			}
+		}
+
+		if (!graph)
+			graph = new ParallelForGraph(lane);
+
+		graph->SetName(settings.name);
+		graph->invocation = invocation;
+		graph->count = count;
+		graph->grain_size = grain_size;
+		graph->next_item.store(0, std::memory_order_relaxed);
+		graph->submit_time = lane.OnSubmit();
+
+		// Worker of the lane keeps executing tasks while waiting, blocking it could starve the lane
+		if (worker_id >= 0)
+			lane.executor.corun(graph->taskflow);
+		else
+			lane.executor.run(graph->taskflow).wait();
+
+		lane.OnComplete(graph->submit_time);
+
+		std::lock_guard lock(lane.parallel_for_mutex);
+		lane.parallel_for_graphs.push_back(graph);
+	}
+
+	JobLaneMetrics JobSystem::GetMetrics(JobPriority priority)
+	{
+		Lane& lane = GetLane(priority);
+
+		// Counters are loaded in reverse order of increments, so derived values never underflow
+		uint64 num_completed = lane.num_completed.load(std::memory_order_acquire);
+		uint64 num_started = lane.num_started.load(std::memory_order_acquire);
+		uint64 num_submitted = lane.num_submitted.load(std::memory_order_relaxed);
+
+		uint64 num_waits = lane.num_waits.load(std::memory_order_relaxed);
+		uint64 num_completions = lane.num_completions.load(std::memory_order_relaxed);
+
+		constexpr float32 ns_to_ms = 0.001f * 0.001f;
+
+		JobLaneMetrics metrics = {};
+		metrics.num_workers = (uint32)lane.executor.num_workers();
+		metrics.queue_depth = num_submitted - num_started;
+		metrics.num_running = num_started - num_completed;
+		metrics.num_completed = num_completed;
+		metrics.average_wait_time = num_waits ? (float32)lane.total_wait_time.load(std::memory_order_relaxed) / num_waits * ns_to_ms : 0.0f;
+		metrics.max_wait_time = (float32)lane.max_wait_time.load(std::memory_order_relaxed) * ns_to_ms;
+		metrics.average_completion_time = num_completions ? (float32)lane.total_completion_time.load(std::memory_order_relaxed) / num_completions * ns_to_ms : 0.0f;
+		metrics.max_completion_time = (float32)lane.max_completion_time.load(std::memory_order_relaxed) * ns_to_ms;
+
+		return metrics;
+	}
+
+	void JobSystem::ResetMetrics()
+	{
+		for (uint32 i = 0; i < (uint32)JobPriority::COUNT; i++) {
+			Lane& lane = GetLane((JobPriority)i);
+
+			lane.total_wait_time.store(0, std::memory_order_relaxed);
+			lane.max_wait_time.store(0, std::memory_order_relaxed);
+			lane.num_waits.store(0, std::memory_order_relaxed);
+			lane.total_completion_time.store(0, std::memory_order_relaxed);
+			lane.max_completion_time.store(0, std::memory_order_relaxed);
+			lane.num_completions.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void JobSystem::OnFrameEnd()
+	{
+		uint64 frame_end = Profiler::Now();
+		uint64 frame_begin = JobLaneObserver::s_FrameBegin.exchange(frame_end, std::memory_order_relaxed);
+		uint64 frame_index = JobLaneObserver::s_FrameIndex.fetch_add(1, std::memory_order_relaxed);
+
+		// Utilization is computed from the second frame, the first one has no beginning
+		if (!frame_begin)
+			return;
+
+		JobFrameUtilization utilization = {};
+		utilization.frame_index = frame_index;
+		utilization.frame_time = (float32)(frame_end - frame_begin) * 0.001f * 0.001f;
+
+		for (uint32 i = 0; i < (uint32)JobPriority::COUNT; i++) {
+			utilization.lanes[i] = GetLane((JobPriority)i).observer->CollectUtilization(frame_begin, frame_end);
+			OMNIFORCE_PROFILE_PLOT(s_UtilizationPlotNames[i], utilization.lanes[i].average_utilization);
+		}
+
+		JobSystemStatisticsState& state = GetStatisticsState();
+		std::lock_guard lock(state.mutex);
+
+		state.utilization_history.push_back(std::move(utilization));
+		if (state.utilization_history.size() > UTILIZATION_HISTORY_SIZE)
+			state.utilization_history.pop_front();
+	}
+
+	JobFrameUtilization JobSystem::GetFrameUtilization()
+	{
+		JobSystemStatisticsState& state = GetStatisticsState();
+		std::lock_guard lock(state.mutex);
+
+		return state.utilization_history.empty() ? JobFrameUtilization() : state.utilization_history.back();
+	}
+
+	std::vector<JobFrameUtilization> JobSystem::GetUtilizationHistory()
+	{
+		JobSystemStatisticsState& state = GetStatisticsState();
+		std::lock_guard lock(state.mutex);
+
+		return { state.utilization_history.begin(), state.utilization_history.end() };
+	}
+
+	void JobSystem::StartTaskRecording()
+	{
+		JobSystemStatisticsState& state = GetStatisticsState();
+		std::lock_guard lock(state.mutex);
+
+		// Discard tasks recorded before
+		for (uint32 i = 0; i < (uint32)JobPriority::COUNT; i++)
+			GetLane((JobPriority)i).observer->CollectTaskRecords(state.task_records);
+		state.task_records.clear();
+
+		JobLaneObserver::s_NumRecordedTasks.store(0, std::memory_order_relaxed);
+		JobLaneObserver::s_NumDroppedTasks.store(0, std::memory_order_relaxed);
+		JobLaneObserver::s_RecordingBegin.store(Profiler::Now(), std::memory_order_relaxed);
+		JobLaneObserver::s_RecordTasks.store(true, std::memory_order_relaxed);
+	}
+
+	void JobSystem::StopTaskRecording()
+	{
+		JobLaneObserver::s_RecordTasks.store(false, std::memory_order_relaxed);
+	}
+
+	bool JobSystem::IsRecordingTasks()
+	{
+		return JobLaneObserver::s_RecordTasks.load(std::memory_order_relaxed);
+	}
+
+	std::vector<JobTaskRecord> JobSystem::GetTaskRecords()
+	{
+		JobSystemStatisticsState& state = GetStatisticsState();
+		std::lock_guard lock(state.mutex);
+
+		for (uint32 i = 0; i < (uint32)JobPriority::COUNT; i++)
+			GetLane((JobPriority)i).observer->CollectTaskRecords(state.task_records);
+
+		return state.task_records;
+	}
+
+	uint64 JobSystem::GetNumDroppedTaskRecords()
+	{
+		return JobLaneObserver::s_NumDroppedTasks.load(std::memory_order_relaxed);
+	}
+
+	void JobSystem::SerializeTaskStatistics(nlohmann::json& node)
+	{
+		nlohmann::json& frames_node = node["Frames"] = nlohmann::json::array();
+
+		for (const JobFrameUtilization& frame : GetUtilizationHistory()) {
+			nlohmann::json frame_node;
+			frame_node["FrameIndex"] = frame.frame_index;
+			frame_node["FrameTime"] = frame.frame_time;
+
+			for (uint32 i = 0; i < (uint32)JobPriority::COUNT; i++) {
+				const JobLaneUtilization& lane = frame.lanes[i];
+
+				nlohmann::json lane_node;
+				lane_node["Lane"] = s_PriorityNames[i];
+				lane_node["AverageUtilization"] = lane.average_utilization;
+				lane_node["MinUtilization"] = lane.min_utilization;
+
+				for (const JobWorkerUtilization& worker : lane.workers) {
+					nlohmann::json worker_node;
+					worker_node["WorkerID"] = worker.worker_id;
+					worker_node["NumTasks"] = worker.num_tasks;
+					worker_node["BusyTime"] = worker.busy_time;
+					worker_node["Utilization"] = worker.utilization;
+
+					lane_node["Workers"].push_back(std::move(worker_node));
+				}
+
+				frame_node["Lanes"].push_back(std::move(lane_node));
+			}
+
+			frames_node.push_back(std::move(frame_node));
+		}
+
+		std::vector<JobTaskRecord> records = GetTaskRecords();
+		node["NumDroppedTasks"] = GetNumDroppedTaskRecords();
+
+		// Aggregate tasks by lane and name, so hot tasks can be found without going through every record
+		struct TaskStatistics {
+			uint64 count = 0;
+			float32 total_time = 0.0f;
+			float32 max_time = 0.0f;
+			float32 total_queue_wait_time = 0.0f;
+			uint64 num_queue_waits = 0;
+		};
+
+		std::map<std::pair<JobPriority, std::string_view>, TaskStatistics> task_statistics;
+
+		nlohmann::json& tasks_node = node["Tasks"] = nlohmann::json::array();
+
+		for (const JobTaskRecord& record : records) {
+			nlohmann::json task_node;
+			task_node["Name"] = record.name;
+			task_node["Lane"] = s_PriorityNames[(uint32)record.priority];
+			task_node["WorkerID"] = record.worker_id;
+			task_node["NestingDepth"] = record.nesting_depth;
+			task_node["FrameIndex"] = record.frame_index;
+			task_node["StartTime"] = record.start_time;
+			task_node["Duration"] = record.duration;
+			task_node["QueueWaitTime"] = record.queue_wait_time;
+
+			tasks_node.push_back(std::move(task_node));
+
+			TaskStatistics& statistics = task_statistics[{ record.priority, record.name }];
+			statistics.count++;
+			statistics.total_time += record.duration;
+			statistics.max_time = std::max(statistics.max_time, record.duration);
+
+			if (record.queue_wait_time >= 0.0f) {
+				statistics.total_queue_wait_time += record.queue_wait_time;
+				statistics.num_queue_waits++;
+			}
+		}
+
+		nlohmann::json& statistics_node = node["TaskStatistics"] = nlohmann::json::array();
+
+		for (auto& [key, statistics] : task_statistics) {
+			nlohmann::json entry_node;
+			entry_node["Name"] = key.second;
+			entry_node["Lane"] = s_PriorityNames[(uint32)key.first];
+			entry_node["Count"] = statistics.count;
+			entry_node["TotalTime"] = statistics.total_time;
+			entry_node["AverageTime"] = statistics.total_time / statistics.count;
+			entry_node["MaxTime"] = statistics.max_time;
+			entry_node["AverageQueueWaitTime"] = statistics.num_queue_waits ? statistics.total_queue_wait_time / statistics.num_queue_waits : -1.0f;
+
+			statistics_node.push_back(std::move(entry_node));
+		}
+	}
+
+	bool JobSystem::DumpTaskStatistics(const std::filesystem::path& path)
+	{
+		nlohmann::json root;
+		SerializeTaskStatistics(root);
+
+		std::ofstream output(path);
+
+		if (!output.is_open()) {
+			OMNIFORCE_CORE_ERROR("Failed to dump job system task statistics to \"{}\"", path.string());
+			return false;
+		}
+
+		output << root.dump(4);
+
+		if (uint64 num_dropped_tasks = root["NumDroppedTasks"]; num_dropped_tasks)
+			OMNIFORCE_CORE_WARNING("Task recording is missing {} tasks, recording was running longer than its limit allows", num_dropped_tasks);
+
+		OMNIFORCE_CORE_INFO("Dumped job system task statistics to \"{}\"", path.string());
+
+		return true;
+	}
+
+}
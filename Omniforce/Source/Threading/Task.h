@@ -0,0 +1,367 @@
+#pragma once
+
+#include <Foundation/Common.h>
+#include <Threading/JobSystem.h>
+
+#include <coroutine>
+#include <optional>
+#include <exception>
+#include <semaphore>
+#include <variant>
+#include <tuple>
+
+namespace Omni {
+
+	template<typename T = void>
+	class Task;
+
+	namespace TaskDetail {
+
+		struct PromiseBase {
+			// Final awaiter transfers execution to the coroutine which awaited the task
+			struct FinalAwaiter {
+				bool await_ready() noexcept { return false; }
+
+				template<typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+					return handle.promise().continuation;
+				}
+
+				void await_resume() noexcept {}
+			};
+
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			FinalAwaiter final_suspend() noexcept { return {}; }
+			void unhandled_exception() { exception = std::current_exception(); }
+
+			std::coroutine_handle<> continuation = std::noop_coroutine();
+			std::exception_ptr exception;
+		};
+
+		template<typename T>
+		struct Promise : PromiseBase {
+			Task<T> get_return_object();
+
+			template<typename Value>
+			void return_value(Value&& value) { result.emplace(std::forward<Value>(value)); }
+
+			T TakeResult() {
+				if (exception)
+					std::rethrow_exception(exception);
+				return std::move(*result);
+			}
+
+			std::optional<T> result;
+		};
+
+		template<>
+		struct Promise<void> : PromiseBase {
+			Task<void> get_return_object();
+
+			void return_void() {}
+
+			void TakeResult() {
+				if (exception)
+					std::rethrow_exception(exception);
+			}
+		};
+
+		// Coroutine which starts immediately and destroys itself when finished
+		struct DetachedTask {
+			struct promise_type {
+				DetachedTask get_return_object() { return {}; }
+				std::suspend_never initial_suspend() noexcept { return {}; }
+				std::suspend_never final_suspend() noexcept { return {}; }
+				void return_void() {}
+				void unhandled_exception() { std::terminate(); }
+			};
+		};
+
+		/*
+		*	@brief Shared state of `WhenAll`. Count starts at number of children + 1, awaiting coroutine removes
+		*	the extra one when it suspends, so whoever decrements it to zero resumes the coroutine exactly once
+		*/
+		struct WhenAllCounter {
+			Atomic<uint32> count;
+			std::coroutine_handle<> awaiting;
+
+			void OnChildCompleted() {
+				if (count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					awaiting.resume();
+			}
+		};
+
+		// Awaits a child task and notifies counter. Frame is owned and destroyed by `WhenAllAwaiter`
+		struct WhenAllChild {
+			struct promise_type {
+				struct FinalAwaiter {
+					bool await_ready() noexcept { return false; }
+					void await_suspend(std::coroutine_handle<promise_type> handle) noexcept { handle.promise().counter->OnChildCompleted(); }
+					void await_resume() noexcept {}
+				};
+
+				WhenAllChild get_return_object() { return WhenAllChild(std::coroutine_handle<promise_type>::from_promise(*this)); }
+				std::suspend_always initial_suspend() noexcept { return {}; }
+				FinalAwaiter final_suspend() noexcept { return {}; }
+				void return_void() {}
+				void unhandled_exception() { std::terminate(); }
+
+				WhenAllCounter* counter = nullptr;
+			};
+
+			explicit WhenAllChild(std::coroutine_handle<promise_type> handle)
+				: handle(handle) {}
+
+			WhenAllChild(WhenAllChild&& other) noexcept
+				: handle(std::exchange(other.handle, nullptr)) {}
+
+			~WhenAllChild() {
+				if (handle)
+					handle.destroy();
+			}
+
+			std::coroutine_handle<promise_type> handle;
+		};
+
+		template<typename T>
+		WhenAllChild MakeWhenAllChild(Task<T>& task) {
+			co_await task.Completion();
+		}
+
+		struct WhenAllAwaiter {
+			bool await_ready() const noexcept { return children.empty(); }
+
+			bool await_suspend(std::coroutine_handle<> handle) {
+				counter.awaiting = handle;
+
+				for (WhenAllChild& child : children) {
+					child.handle.promise().counter = &counter;
+					child.handle.resume();
+				}
+
+				return counter.count.fetch_sub(1, std::memory_order_acq_rel) > 1;
+			}
+
+			void await_resume() noexcept {}
+
+			std::vector<WhenAllChild> children;
+			WhenAllCounter counter;
+		};
+
+		// `void` results of `WhenAll` tuples are represented by `std::monostate`
+		template<typename T>
+		using WhenAllResult = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+		template<typename T>
+		WhenAllResult<T> TakeWhenAllResult(Task<T>& task) {
+			if constexpr (std::is_void_v<T>) {
+				task.TakeResult();
+				return {};
+			}
+			else {
+				return task.TakeResult();
+			}
+		}
+
+	}
+
+	/*
+	*	@brief Lazily started coroutine returning `T`. Task is started when it is awaited and the awaiting coroutine
+	*	is resumed on the thread which finishes the task, so waiting for I/O, jobs and other tasks suspends instead of
+	*	blocking a worker. Use `ScheduleOn` to continue on a job system lane and `SyncWait` to wait outside of coroutines.
+	*	Exceptions are propagated to the awaiting coroutine.
+	*/
+	template<typename T>
+	class [[nodiscard]] Task {
+	public:
+		using promise_type = TaskDetail::Promise<T>;
+
+		Task() = default;
+
+		explicit Task(std::coroutine_handle<promise_type> handle)
+			: m_Handle(handle) {}
+
+		Task(Task&& other) noexcept
+			: m_Handle(std::exchange(other.m_Handle, nullptr)) {}
+
+		Task& operator=(Task&& other) noexcept {
+			if (this != &other) {
+				if (m_Handle)
+					m_Handle.destroy();
+				m_Handle = std::exchange(other.m_Handle, nullptr);
+			}
+			return *this;
+		}
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+		~Task() {
+			if (m_Handle)
+				m_Handle.destroy();
+		}
+
+		bool IsValid() const { return (bool)m_Handle; }
+		bool IsCompleted() const { return m_Handle && m_Handle.done(); }
+
+		// Awaits the task and returns its result
+		auto operator co_await() noexcept {
+			struct Awaiter {
+				bool await_ready() const noexcept { return handle.done(); }
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+					handle.promise().continuation = awaiting;
+					return handle;
+				}
+
+				T await_resume() { return handle.promise().TakeResult(); }
+
+				std::coroutine_handle<promise_type> handle;
+			};
+
+			OMNIFORCE_ASSERT_TAGGED(m_Handle, "Awaiting an empty task");
+			return Awaiter{ m_Handle };
+		}
+
+		// Awaits the task without taking its result, result can be taken later by `TakeResult`
+		auto Completion() noexcept {
+			struct Awaiter {
+				bool await_ready() const noexcept { return handle.done(); }
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+					handle.promise().continuation = awaiting;
+					return handle;
+				}
+
+				void await_resume() noexcept {}
+
+				std::coroutine_handle<promise_type> handle;
+			};
+
+			OMNIFORCE_ASSERT_TAGGED(m_Handle, "Awaiting an empty task");
+			return Awaiter{ m_Handle };
+		}
+
+		// Task must be completed. Rethrows exception of the task, if any
+		T TakeResult() {
+			OMNIFORCE_ASSERT_TAGGED(IsCompleted(), "Taking result of a task which is not completed");
+			return m_Handle.promise().TakeResult();
+		}
+
+	private:
+		std::coroutine_handle<promise_type> m_Handle;
+	};
+
+	namespace TaskDetail {
+
+		template<typename T>
+		Task<T> Promise<T>::get_return_object() {
+			return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+		}
+
+		inline Task<void> Promise<void>::get_return_object() {
+			return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+		}
+
+	}
+
+	/*
+	*	@brief `co_await ScheduleOn(priority)` suspends the coroutine and resumes it on a worker of the lane
+	*/
+	inline auto ScheduleOn(JobPriority priority) {
+		struct Awaiter {
+			bool await_ready() const noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle) {
+				JobSystem::SilentAsync(priority, [handle]() { handle.resume(); });
+			}
+
+			void await_resume() noexcept {}
+
+			JobPriority priority;
+		};
+
+		return Awaiter{ priority };
+	}
+
+	/*
+	*	@brief Runs `func` as a child job on a lane, awaiting the task resumes the coroutine with its result
+	*/
+	template<typename Func>
+	Task<std::invoke_result_t<Func&>> RunOn(JobPriority priority, Func func) {
+		co_await ScheduleOn(priority);
+		co_return func();
+	}
+
+	/*
+	*	@brief Starts all tasks and completes once all of them are completed. Tasks are started one after another on
+	*	the awaiting thread, so they run concurrently from their first suspension, e.g. `ScheduleOn` or I/O.
+	*	Awaiting coroutine is resumed by the task which completes last
+	*/
+	template<typename T>
+	Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> WhenAll(std::vector<Task<T>> tasks) {
+		TaskDetail::WhenAllAwaiter awaiter;
+		awaiter.counter.count.store((uint32)tasks.size() + 1, std::memory_order_relaxed);
+		awaiter.children.reserve(tasks.size());
+
+		for (Task<T>& task : tasks)
+			awaiter.children.push_back(TaskDetail::MakeWhenAllChild(task));
+
+		co_await awaiter;
+
+		if constexpr (std::is_void_v<T>) {
+			for (Task<T>& task : tasks)
+				task.TakeResult();
+		}
+		else {
+			std::vector<T> results;
+			results.reserve(tasks.size());
+
+			for (Task<T>& task : tasks)
+				results.push_back(task.TakeResult());
+
+			co_return results;
+		}
+	}
+
+	// Variadic form, `void` results are returned as `std::monostate`
+	template<typename... Ts>
+	Task<std::tuple<TaskDetail::WhenAllResult<Ts>...>> WhenAll(Task<Ts>... tasks) {
+		TaskDetail::WhenAllAwaiter awaiter;
+		awaiter.counter.count.store((uint32)sizeof...(Ts) + 1, std::memory_order_relaxed);
+		awaiter.children.reserve(sizeof...(Ts));
+
+		(awaiter.children.push_back(TaskDetail::MakeWhenAllChild(tasks)), ...);
+
+		co_await awaiter;
+
+		co_return std::tuple<TaskDetail::WhenAllResult<Ts>...>(TaskDetail::TakeWhenAllResult(tasks)...);
+	}
+
+	/*
+	*	@brief Starts the task and waits until it is completed. Meant for synchronous APIs built on top of tasks.
+	*	A thread outside of job system blocks. A lane worker keeps executing tasks of its lane while waiting,
+	*	so the task can't deadlock by needing the very worker which waits for it
+	*/
+	template<typename T>
+	T SyncWait(Task<T> task) {
+		Atomic<bool> done = false;
+		std::binary_semaphore completed(0);
+
+		auto signal = [](Task<T>& task, Atomic<bool>& done, std::binary_semaphore& completed) -> TaskDetail::DetachedTask {
+			co_await task.Completion();
+			done.store(true, std::memory_order_release);
+			completed.release();
+		};
+
+		signal(task, done, completed);
+
+		JobSystem::CorunUntil([&done]() { return done.load(std::memory_order_acquire); });
+
+		// Also makes sure signalling coroutine no longer touches the semaphore
+		completed.acquire();
+
+		return task.TakeResult();
+	}
+
+}
@@ -0,0 +1,221 @@
+#include "Benchmark.h"
+
+#include <Foundation/Memory/Allocators/PersistentAllocator.h>
+
+#include <barrier>
+#include <cmath>
+#include <map>
+#include <random>
+#include <thread>
+
+namespace Omni {
+
+	/*
+	*	@brief Persistent allocator as it was before O(1) free lists and thread caches: a single mutex, free lists of block indices
+	*	searched linearly for a buddy and a map of allocated blocks. Kept as a baseline
+	*/
+	class PreviousPersistentAllocator : public IAllocator {
+	public:
+		PreviousPersistentAllocator(TSize total_size, TSize minimal_block_size)
+			: m_Size(Align(total_size))
+			, m_MinimalBlockSize(minimal_block_size)
+			, m_MaxSubdivisionLevel(std::log2(m_Size / m_MinimalBlockSize))
+			, m_MemoryPool(&g_DedicatedMemoryAllocator, m_Size)
+		{
+			m_FreeLists.resize(m_MaxSubdivisionLevel + 1);
+			m_FreeLists[m_MaxSubdivisionLevel].push_back(0);
+		}
+
+		MemoryAllocation AllocateBase(TSize size) override {
+			std::lock_guard lock(m_Mutex);
+
+			TSize aligned_size = std::max(m_MinimalBlockSize, Align(size));
+			TSize level = std::log2(aligned_size / m_MinimalBlockSize);
+
+			for (TSize i = level; i <= m_MaxSubdivisionLevel; ++i) {
+				if (!m_FreeLists[i].empty()) {
+					TSize block = m_FreeLists[i].back();
+					m_FreeLists[i].pop_back();
+
+					while (i > level) {
+						--i;
+						m_FreeLists[i].push_back(block + (TSize(1) << i));
+					}
+
+					m_AllocatedMemoryBlocks[(byte*)&m_MemoryPool[block * m_MinimalBlockSize]] = aligned_size;
+
+					return MemoryAllocation(&m_MemoryPool[block * m_MinimalBlockSize], aligned_size);
+				}
+			}
+
+			return MemoryAllocation::InvalidAllocation();
+		}
+
+		void FreeBase(MemoryAllocation& allocation) override {
+			std::lock_guard lock(m_Mutex);
+
+			auto it = m_AllocatedMemoryBlocks.find(allocation.Memory);
+
+			TSize block_size = it->second;
+			TSize block = (TSize)(allocation.Memory - (byte*)&m_MemoryPool[0]) / m_MinimalBlockSize;
+			TSize level = std::log2(block_size / m_MinimalBlockSize);
+
+			m_AllocatedMemoryBlocks.erase(it);
+
+			while (level < m_MaxSubdivisionLevel) {
+				TSize buddy = block ^ (TSize(1) << level);
+				auto buddy_it = std::find(m_FreeLists[level].begin(), m_FreeLists[level].end(), buddy);
+
+				if (buddy_it == m_FreeLists[level].end())
+					break;
+
+				m_FreeLists[level].erase(buddy_it);
+				block = std::min(block, buddy);
+				++level;
+			}
+
+			m_FreeLists[level].push_back(block);
+			allocation.Invalidate();
+		}
+
+		void Clear() override {}
+
+	private:
+		static TSize Align(TSize n) {
+			return std::pow(2, std::ceil(std::log2(n)));
+		}
+
+		TSize m_Size;
+		TSize m_MinimalBlockSize;
+		TSize m_MaxSubdivisionLevel;
+
+		ByteArray m_MemoryPool;
+		std::vector<std::vector<TSize>> m_FreeLists;
+		std::map<byte*, TSize> m_AllocatedMemoryBlocks;
+
+		std::mutex m_Mutex;
+	};
+
+	struct AllocatorChurnResult {
+		uint64 duration = 0;	// Of the slowest thread, in nanoseconds
+		bool valid = true;
+	};
+
+	/*
+	*	@brief Every thread keeps a window of live allocations and replaces a random one on each operation. Sizes are
+	*	log-uniform from 16 bytes to 4 KB, so most requests hit small levels like engine objects do. A tag written into every
+	*	allocation is checked before it is freed, so overlapping allocations handed to different threads are detected
+	*/
+	static AllocatorChurnResult MeasureAllocatorChurn(IAllocator* allocator, uint32 num_threads, uint32 num_operations)
+	{
+		constexpr uint32 num_live_allocations = 256;
+
+		std::vector<uint64> thread_durations(num_threads);
+		std::vector<uint8> thread_valid(num_threads, true);
+		std::barrier start_barrier(num_threads);
+		std::vector<std::thread> threads;
+
+		for (uint32 thread_index = 0; thread_index < num_threads; thread_index++) {
+			threads.emplace_back([&, thread_index]() {
+				std::mt19937 random_engine(thread_index);
+				std::uniform_real_distribution<float64> size_distribution(4.0, 12.0);
+				std::uniform_int_distribution<uint32> slot_distribution(0, num_live_allocations - 1);
+
+				// Sizes and slots are generated up front, so only allocator calls are measured
+				std::vector<std::pair<uint32, uint32>> operations(num_operations);
+				for (auto& [size, slot] : operations) {
+					size = (uint32)std::exp2(size_distribution(random_engine));
+					slot = slot_distribution(random_engine);
+				}
+
+				std::vector<MemoryAllocation> live_allocations(num_live_allocations, MemoryAllocation::InvalidAllocation());
+				std::vector<uint64> live_tags(num_live_allocations);
+				bool valid = true;
+
+				start_barrier.arrive_and_wait();
+
+				uint64 begin = Profiler::Now();
+
+				for (uint32 i = 0; i < num_operations; i++) {
+					auto [size, slot] = operations[i];
+					MemoryAllocation& allocation = live_allocations[slot];
+
+					if (allocation.IsValid()) {
+						valid &= *allocation.As<uint64>() == live_tags[slot];
+						allocator->FreeBase(allocation);
+					}
+
+					allocation = allocator->AllocateBase(size);
+					valid &= allocation.IsValid();
+
+					if (allocation.IsValid()) {
+						live_tags[slot] = ((uint64)thread_index << 32) | i;
+						*allocation.As<uint64>() = live_tags[slot];
+					}
+				}
+
+				for (MemoryAllocation& allocation : live_allocations)
+					if (allocation.IsValid())
+						allocator->FreeBase(allocation);
+
+				thread_durations[thread_index] = Profiler::Now() - begin;
+				thread_valid[thread_index] = valid;
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		AllocatorChurnResult result = {};
+		result.duration = *std::max_element(thread_durations.begin(), thread_durations.end());
+		result.valid = std::all_of(thread_valid.begin(), thread_valid.end(), [](uint8 valid) { return valid; });
+
+		return result;
+	}
+
+	bool RunAllocatorBenchmark(const BenchmarkOptions& options)
+	{
+		const uint32 num_operations = 100'000 * options.scale;
+		constexpr IAllocator::TSize pool_size = 256 * 1024 * 1024;
+
+		PreviousPersistentAllocator previous_allocator(pool_size, 16);
+		PersistentAllocator uncached_allocator(pool_size, 16);
+
+		struct Variant {
+			std::string_view label;
+			IAllocator* allocator;
+		};
+
+		const Variant variants[] = {
+			{ "Previous (map, mutex)", &previous_allocator },
+			{ "O(1) buddy, no cache", &uncached_allocator },
+			// Only one allocator can have thread caching, so the global one is measured
+			{ "O(1) buddy, thread cache", &g_PersistentAllocator },
+		};
+
+		fmt::print("{} operations per thread, 16 B - 4 KB\n", num_operations);
+		fmt::print("{:<28}", "Threads");
+		for (const Variant& variant : variants)
+			fmt::print("{:>28}", variant.label);
+		fmt::print("\n");
+
+		bool valid = true;
+
+		for (uint32 num_threads : { 1u, 2u, 4u, 8u, 16u, 32u }) {
+			fmt::print("{:<28}", num_threads);
+
+			for (const Variant& variant : variants) {
+				AllocatorChurnResult result = MeasureAllocatorChurn(variant.allocator, num_threads, num_operations);
+
+				// Each operation is an allocation and a free
+				fmt::print("{:>16.2f} M ops/s{}", (float64)num_threads * num_operations / (result.duration / 1e3), result.valid ? "     " : " FAIL");
+				valid &= result.valid;
+			}
+
+			fmt::print("\n");
+		}
+
+		return valid;
+	}
+
+}
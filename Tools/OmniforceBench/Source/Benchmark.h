@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Foundation/Common.h>
+
+#include <algorithm>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <spdlog/fmt/fmt.h>
+
+namespace Omni {
+
+	struct BenchmarkOptions {
+		uint32 num_threads = 16;	// Number of threads for multithreaded benchmarks and background lane workers
+		uint32 scale = 1;			// Multiplier of iteration counts
+	};
+
+	/*
+	*	@brief A benchmark prints its results and returns false if it failed, e.g. if a validation check did not pass
+	*/
+	struct BenchmarkDesc {
+		std::string_view name;
+		std::string_view description;
+		bool (*run)(const BenchmarkOptions& options);
+	};
+
+	bool RunLogBenchmark(const BenchmarkOptions& options);
+	bool RunAllocatorBenchmark(const BenchmarkOptions& options);
+	bool RunRefBenchmark(const BenchmarkOptions& options);
+	bool RunUUIDBenchmark(const BenchmarkOptions& options);
+	bool RunHashMapBenchmark(const BenchmarkOptions& options);
+	bool RunTLSFBenchmark(const BenchmarkOptions& options);
+	bool RunParallelBenchmark(const BenchmarkOptions& options);
+	bool RunImportBenchmark(const BenchmarkOptions& options);
+#ifdef OMNIFORCE_BENCH_PHYSICS
+	bool RunPhysicsBenchmark(const BenchmarkOptions& options);
+#endif
+
+	inline constexpr BenchmarkDesc g_Benchmarks[] = {
+		{ "log", "Latency of log calls from many threads, synchronous spdlog vs asynchronous backend", &RunLogBenchmark },
+		{ "allocator", "Allocate / free throughput of persistent allocator at 1 - 32 threads, previous vs O(1) buddy and thread cache", &RunAllocatorBenchmark },
+		{ "ref", "Copy, move, release and create / destroy of ref-counted handles, previous Ref vs intrusive 8-byte Ref", &RunRefBenchmark },
+		{ "uuid", "Bulk entity creation: UUID generation and registration in UUID -> entity map", &RunUUIDBenchmark },
+		{ "hashmap", "Insert, lookup and remove of 10k - 1M random UUID keys, FlatHashMap vs robin_hood", &RunHashMapBenchmark },
+		{ "tlsf", "Randomized validation and allocate / free latency of TLSF virtual memory block", &RunTLSFBenchmark },
+		{ "parallel", "Mip generation, task per row vs JobSystem::ParallelFor, and cluster graph build time", &RunParallelBenchmark },
+		{ "import", "Model import mesh processing time by mesh processing budget, run with -t 1 ... 64 for core scaling", &RunImportBenchmark },
+#ifdef OMNIFORCE_BENCH_PHYSICS
+		{ "physics", "Physics step time of 10k / 50k bodies, private Jolt thread pool vs engine job system", &RunPhysicsBenchmark },
+#endif
+	};
+
+	// Regular grid of `grid_size`^2 quads with noisy heights and position only vertices, so simplification can't collapse it
+	void GenerateGridMesh(uint32 grid_size, std::vector<byte>* vertices, std::vector<uint32>* indices);
+
+	// Percentiles of per-call latency in nanoseconds
+	struct LatencyStatistics {
+		uint64 num_samples = 0;
+		uint64 p50 = 0;
+		uint64 p99 = 0;
+		uint64 p999 = 0;
+		uint64 max = 0;
+		float64 mean = 0.0;
+	};
+
+	inline LatencyStatistics ComputeLatencyStatistics(std::vector<uint64>& samples)
+	{
+		LatencyStatistics statistics = {};
+
+		if (samples.empty())
+			return statistics;
+
+		std::sort(samples.begin(), samples.end());
+
+		auto percentile = [&](float64 fraction) {
+			return samples[std::min<uint64>((uint64)(fraction * samples.size()), samples.size() - 1)];
+		};
+
+		uint64 sum = 0;
+		for (uint64 sample : samples)
+			sum += sample;
+
+		statistics.num_samples = samples.size();
+		statistics.p50 = percentile(0.5);
+		statistics.p99 = percentile(0.99);
+		statistics.p999 = percentile(0.999);
+		statistics.max = samples.back();
+		statistics.mean = (float64)sum / samples.size();
+
+		return statistics;
+	}
+
+	inline void PrintLatencyHeader()
+	{
+		fmt::print("{:<28}{:>12}{:>10}{:>10}{:>10}{:>10}{:>12}\n", "", "Calls", "Mean ns", "p50 ns", "p99 ns", "p99.9 ns", "Max ns");
+	}
+
+	inline void PrintLatency(std::string_view label, const LatencyStatistics& statistics)
+	{
+		fmt::print("{:<28}{:>12}{:>10.1f}{:>10}{:>10}{:>10}{:>12}\n",
+			label, statistics.num_samples, statistics.mean, statistics.p50, statistics.p99, statistics.p999, statistics.max);
+	}
+
+}
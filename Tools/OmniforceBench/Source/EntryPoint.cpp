@@ -0,0 +1,89 @@
+#include "Benchmark.h"
+
+#include <Threading/JobSystem.h>
+
+using namespace Omni;
+
+static void PrintBenchUsage()
+{
+	fmt::print(
+		"Usage: OmniforceBench [options] [benchmark]...\n"
+		"\n"
+		"Runs benchmarks of renderer-independent engine systems, all of them if none is specified.\n"
+		"\n"
+		"Options:\n"
+		"  -t, --threads <count>    Number of threads for multithreaded benchmarks and background jobs, 16 by default\n"
+		"  -s, --scale <factor>     Multiplier of iteration counts\n"
+		"  -h, --help               Print this message\n"
+		"\n"
+		"Benchmarks:\n"
+	);
+
+	for (const BenchmarkDesc& benchmark : g_Benchmarks)
+		fmt::print("  {:<23}  {}\n", benchmark.name, benchmark.description);
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options = {};
+	std::vector<const BenchmarkDesc*> benchmarks;
+
+	for (int32 i = 1; i < argc; i++) {
+		std::string_view argument = argv[i];
+		bool has_value = i + 1 < argc;
+
+		if (argument == "-h" || argument == "--help") {
+			PrintBenchUsage();
+			return 0;
+		}
+		else if ((argument == "-t" || argument == "--threads") && has_value) {
+			options.num_threads = (uint32)std::max(std::atoi(argv[++i]), 1);
+		}
+		else if ((argument == "-s" || argument == "--scale") && has_value) {
+			options.scale = (uint32)std::max(std::atoi(argv[++i]), 1);
+		}
+		else {
+			auto benchmark = std::find_if(std::begin(g_Benchmarks), std::end(g_Benchmarks), [&](const BenchmarkDesc& desc) {
+				return desc.name == argument;
+			});
+
+			if (benchmark == std::end(g_Benchmarks)) {
+				fmt::print(stderr, "Unknown benchmark or option \"{}\"\n\n", argument);
+				PrintBenchUsage();
+				return 2;
+			}
+
+			benchmarks.push_back(benchmark);
+		}
+	}
+
+	if (benchmarks.empty()) {
+		for (const BenchmarkDesc& benchmark : g_Benchmarks)
+			benchmarks.push_back(&benchmark);
+	}
+
+	// Benchmarks log through their own loggers, engine messages are only printed if something goes wrong
+	OMNIFORCE_INITIALIZE_LOG_SYSTEM(Logger::Level::LEVEL_WARN);
+
+	// Parallel loops of asset processing run on background lane, so it is sized by thread count as well
+	JobSystemSpecification job_system_spec = {};
+	job_system_spec.num_background_workers = options.num_threads;
+	JobSystem::Configure(job_system_spec);
+
+	uint32 num_failed_benchmarks = 0;
+
+	for (const BenchmarkDesc* benchmark : benchmarks) {
+		fmt::print("=== {} ===\n", benchmark->name);
+
+		if (!benchmark->run(options)) {
+			fmt::print(stderr, "Benchmark \"{}\" failed\n", benchmark->name);
+			num_failed_benchmarks++;
+		}
+
+		fmt::print("\n");
+	}
+
+	Logger::Get()->Flush();
+
+	return num_failed_benchmarks ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+#include "Benchmark.h"
+
+#include <Foundation/Containers/FlatHashMap.h>
+
+#include <random>
+
+#include <robin_hood.h>
+
+namespace Omni {
+
+	// Durations in nanoseconds, lookup results are summed so they can be compared between maps
+	struct HashMapTimings {
+		uint64 insert = 0;
+		uint64 hits = 0;
+		uint64 misses = 0;
+		uint64 remove = 0;
+		uint64 checksum = 0;
+	};
+
+	template<typename Function>
+	static uint64 MeasureDuration(Function&& function)
+	{
+		uint64 begin = Profiler::Now();
+		function();
+		return Profiler::Now() - begin;
+	}
+
+	/*
+	*	@brief Access pattern of UUID registries (scene entities, asset registry): keys are random 64-bit UUIDs, the map is filled
+	*	without reserving, looked up by random existing and missing keys and emptied by removing every key
+	*/
+	template<typename TMap, typename FindFunction>
+	static HashMapTimings MeasureHashMap(const std::vector<UUID>& keys, const std::vector<uint32>& hit_indices,
+		const std::vector<UUID>& missing_keys, FindFunction&& find)
+	{
+		HashMapTimings timings = {};
+		TMap map;
+
+		timings.insert = MeasureDuration([&]() {
+			for (uint32 i = 0; i < keys.size(); i++)
+				map.emplace(keys[i], i);
+		});
+
+		timings.hits = MeasureDuration([&]() {
+			for (uint32 index : hit_indices)
+				timings.checksum += find(map, keys[index]);
+		});
+
+		timings.misses = MeasureDuration([&]() {
+			for (const UUID& key : missing_keys)
+				timings.checksum += find(map, key);
+		});
+
+		timings.remove = MeasureDuration([&]() {
+			for (const UUID& key : keys)
+				map.erase(key);
+		});
+
+		timings.checksum += map.size();
+
+		return timings;
+	}
+
+	// Adapts FlatHashMap to the standard container interface used by `MeasureHashMap`
+	struct FlatUUIDMap : FlatHashMap<UUID, uint32> {
+		void emplace(const UUID& key, uint32 value) { Emplace(key, value); }
+		void erase(const UUID& key) { Remove(key); }
+		SizeType size() const { return Size(); }
+	};
+
+	using RobinHoodUUIDMap = robin_hood::unordered_map<UUID, uint32>;
+
+	bool RunHashMapBenchmark(const BenchmarkOptions& options)
+	{
+		const uint32 num_hits = 4'000'000 * options.scale;
+		const uint32 num_misses = 1'000'000 * options.scale;
+
+		fmt::print("UUID -> uint32, {} hit lookups, {} miss lookups\n", num_hits, num_misses);
+		fmt::print("{:<12}{:<16}{:>12}{:>12}{:>12}{:>12}\n", "Entries", "", "Insert ms", "Hits ms", "Misses ms", "Remove ms");
+
+		bool valid = true;
+
+		for (uint32 num_entries : { 10'000u, 100'000u, 1'000'000u }) {
+			std::mt19937_64 random_engine(num_entries);
+
+			std::vector<UUID> keys(num_entries);
+			for (UUID& key : keys)
+				key = UUID(random_engine() | 1);
+
+			// Even keys never collide with odd ones above
+			std::vector<UUID> missing_keys(num_misses);
+			for (UUID& key : missing_keys)
+				key = UUID(random_engine() & ~1ull);
+
+			std::uniform_int_distribution<uint32> index_distribution(0, num_entries - 1);
+			std::vector<uint32> hit_indices(num_hits);
+			for (uint32& index : hit_indices)
+				index = index_distribution(random_engine);
+
+			HashMapTimings robin_hood_timings = MeasureHashMap<RobinHoodUUIDMap>(keys, hit_indices, missing_keys,
+				[](const RobinHoodUUIDMap& map, const UUID& key) -> uint64 {
+					auto it = map.find(key);
+					return it != map.end() ? it->second : 0;
+				});
+
+			HashMapTimings flat_timings = MeasureHashMap<FlatUUIDMap>(keys, hit_indices, missing_keys,
+				[](const FlatUUIDMap& map, const UUID& key) -> uint64 {
+					auto it = map.Find(key);
+					return it != map.end() ? it->second : 0;
+				});
+
+			auto print_timings = [&](std::string_view label, const HashMapTimings& timings) {
+				fmt::print("{:<12}{:<16}{:>12.2f}{:>12.2f}{:>12.2f}{:>12.2f}\n", num_entries, label,
+					timings.insert / 1e6, timings.hits / 1e6, timings.misses / 1e6, timings.remove / 1e6);
+			};
+
+			print_timings("robin_hood", robin_hood_timings);
+			print_timings("FlatHashMap", flat_timings);
+
+			if (robin_hood_timings.checksum != flat_timings.checksum) {
+				fmt::print("  lookup results differ\n");
+				valid = false;
+			}
+		}
+
+		return valid;
+	}
+
+}
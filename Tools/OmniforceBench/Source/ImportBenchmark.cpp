@@ -0,0 +1,107 @@
+#include "Benchmark.h"
+
+#include <Asset/AssetCooker.h>
+#include <Threading/JobSystem.h>
+
+#include <glm/glm.hpp>
+#include <taskflow/taskflow.hpp>
+
+namespace Omni {
+
+	struct ImportBenchmarkMesh {
+		std::vector<byte> vertices;
+		std::vector<uint32> indices;
+	};
+
+	/*
+	*	@brief Mesh processing part of `ModelImporter::Import`: a task per mesh cooks its virtual geometry, tasks are gated
+	*	by a semaphore of `budget` meshes, the graph runs on the background lane and cluster graph building spreads
+	*	each mesh over the same lane
+	*	@return wall time in nanoseconds
+	*/
+	static uint64 MeasureImport(const std::vector<ImportBenchmarkMesh>& meshes, uint32 budget, uint64* num_meshlets)
+	{
+		VertexAttributeMetadataTable vertex_metadata = { { "POSITION", 0 } };
+		std::vector<uint64> mesh_num_meshlets(meshes.size());
+
+		tf::Taskflow taskflow;
+		tf::Semaphore mesh_processing_budget(budget);
+
+		for (uint64 i = 0; i < meshes.size(); i++) {
+			taskflow.emplace([&, i]() {
+				CookedVirtualMesh cooked_mesh = AssetCooker::CookVirtualMesh(meshes[i].vertices, meshes[i].indices, sizeof(glm::vec3), vertex_metadata);
+				mesh_num_meshlets[i] = cooked_mesh.meshlets.size();
+			}).acquire(mesh_processing_budget).release(mesh_processing_budget);
+		}
+
+		uint64 begin = Profiler::Now();
+		JobSystem::RunAndWait(taskflow, JobPriority::BACKGROUND);
+		uint64 duration = Profiler::Now() - begin;
+
+		*num_meshlets = 0;
+		for (uint64 count : mesh_num_meshlets)
+			*num_meshlets += count;
+
+		return duration;
+	}
+
+	bool RunImportBenchmark(const BenchmarkOptions& options)
+	{
+		const uint32 num_runs = 3 * options.scale;
+		const uint32 num_workers = (uint32)JobSystem::GetExecutor(JobPriority::BACKGROUND)->num_workers();
+
+		// Many small props and a few large meshes, like a typical glTF scene
+		constexpr uint32 grid_sizes[] = { 16, 16, 16, 16, 32, 32, 32, 64, 64, 128, 256 };
+		constexpr uint32 num_mesh_sets = 4;
+
+		std::vector<ImportBenchmarkMesh> meshes;
+		uint64 num_triangles = 0;
+
+		for (uint32 set = 0; set < num_mesh_sets; set++) {
+			for (uint32 grid_size : grid_sizes) {
+				ImportBenchmarkMesh& mesh = meshes.emplace_back();
+				GenerateGridMesh(grid_size, &mesh.vertices, &mesh.indices);
+				num_triangles += mesh.indices.size() / 3;
+			}
+		}
+
+		// Powers of two up to lane size, half of the lane is the default of `Asset.Import.MeshProcessingBudget`
+		std::vector<uint32> budgets;
+		for (uint32 budget = 1; budget < num_workers; budget *= 2)
+			budgets.push_back(budget);
+		budgets.push_back(num_workers);
+		budgets.push_back(num_workers * 2);
+
+		fmt::print("{} background workers, {} meshes, {} triangles, {} runs\n", num_workers, meshes.size(), num_triangles, num_runs);
+		fmt::print("{:<28}{:>12}{:>12}{:>11}\n", "Budget", "Min ms", "Median ms", "Speedup");
+
+		uint64 baseline_median = 0;
+		bool valid = true;
+
+		for (uint32 budget : budgets) {
+			std::vector<uint64> durations;
+
+			for (uint32 run = 0; run < num_runs; run++) {
+				uint64 num_meshlets = 0;
+				durations.push_back(MeasureImport(meshes, budget, &num_meshlets));
+
+				valid &= num_meshlets != 0;
+			}
+
+			std::sort(durations.begin(), durations.end());
+			uint64 median = durations[durations.size() / 2];
+
+			if (!baseline_median)
+				baseline_median = median;
+
+			std::string label = fmt::format("{}{}", budget, budget == std::max(num_workers / 2, 1u) ? " (half of lane)" : "");
+			fmt::print("{:<28}{:>12.2f}{:>12.2f}{:>10.2f}x\n", label, durations.front() / 1e6, median / 1e6, (float64)baseline_median / median);
+		}
+
+		if (!valid)
+			fmt::print("  no meshlets were built\n");
+
+		return valid;
+	}
+
+}
@@ -0,0 +1,92 @@
+#include "Benchmark.h"
+
+#include <barrier>
+#include <thread>
+
+#include <spdlog/sinks/null_sink.h>
+
+namespace Omni {
+
+	/*
+	*	@brief Every thread logs the same number of records with a typical argument mix and measures every call.
+	*	Sinks discard messages, so synchronous numbers are formatting and sink locking only, without console output
+	*/
+	template<typename LogFunction>
+	static LatencyStatistics MeasureLogLatency(uint32 num_threads, uint32 num_records, LogFunction&& log)
+	{
+		std::vector<std::vector<uint64>> thread_samples(num_threads);
+		std::barrier start_barrier(num_threads);
+		std::vector<std::thread> threads;
+
+		for (uint32 thread_index = 0; thread_index < num_threads; thread_index++) {
+			threads.emplace_back([&, thread_index]() {
+				std::vector<uint64>& samples = thread_samples[thread_index];
+				samples.reserve(num_records);
+
+				std::string entity_name = fmt::format("Entity_{}", thread_index);
+
+				start_barrier.arrive_and_wait();
+
+				for (uint32 i = 0; i < num_records; i++) {
+					uint64 begin = Profiler::Now();
+					log(i, entity_name, i * 0.25f);
+					samples.push_back(Profiler::Now() - begin);
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		std::vector<uint64> samples;
+		samples.reserve((uint64)num_threads * num_records);
+
+		for (std::vector<uint64>& thread_sample : thread_samples)
+			samples.insert(samples.end(), thread_sample.begin(), thread_sample.end());
+
+		return ComputeLatencyStatistics(samples);
+	}
+
+	bool RunLogBenchmark(const BenchmarkOptions& options)
+	{
+		const uint32 num_records = 50'000 * options.scale;
+
+		auto logger = std::make_shared<spdlog::logger>("Benchmark", std::make_shared<spdlog::sinks::null_sink_mt>());
+		logger->set_pattern("%^[%T][%n][%l]: %v%$");
+		logger->set_level(spdlog::level::trace);
+
+		fmt::print("{} threads, {} records per thread\n", options.num_threads, num_records);
+		PrintLatencyHeader();
+
+		LatencyStatistics sync_latency = MeasureLogLatency(options.num_threads, num_records, [&](uint32 frame, const std::string& name, float32 value) {
+			logger->info("Frame {} updated \"{}\", value {:.3f}", frame, name, value);
+		});
+		PrintLatency("Synchronous", sync_latency);
+
+		for (AsyncLogOverflowPolicy policy : { AsyncLogOverflowPolicy::DROP, AsyncLogOverflowPolicy::BLOCK }) {
+			AsyncLoggerSpecification async_spec = {};
+			async_spec.overflow_policy = policy;
+
+			uint64 num_dropped_records = 0;
+			LatencyStatistics async_latency;
+			{
+				AsyncLogger async_logger(async_spec, nullptr);
+
+				async_latency = MeasureLogLatency(options.num_threads, num_records, [&](uint32 frame, const std::string& name, float32 value) {
+					async_logger.Log(logger.get(), spdlog::level::info, "Frame {} updated \"{}\", value {:.3f}", frame, name, value);
+				});
+
+				async_logger.Flush();
+				num_dropped_records = async_logger.GetNumDroppedRecords();
+			}
+
+			PrintLatency(policy == AsyncLogOverflowPolicy::DROP ? "Asynchronous, drop" : "Asynchronous, block", async_latency);
+
+			if (num_dropped_records)
+				fmt::print("  {} records dropped ({:.2f}%)\n", num_dropped_records, 100.0 * num_dropped_records / ((float64)options.num_threads * num_records));
+		}
+
+		return true;
+	}
+
+}
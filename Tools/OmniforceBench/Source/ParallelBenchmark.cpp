@@ -0,0 +1,187 @@
+#include "Benchmark.h"
+
+#include <Asset/AssetCompressor.h>
+#include <Asset/VirtualMeshBuilder.h>
+#include <Core/Utils.h>
+#include <Threading/JobSystem.h>
+
+#include <random>
+
+#include <glm/glm.hpp>
+#include <taskflow/taskflow.hpp>
+
+namespace Omni {
+
+	// Timings of repeated runs in nanoseconds
+	struct RunTimes {
+		uint64 min = 0;
+		uint64 median = 0;
+	};
+
+	template<typename Function>
+	static RunTimes MeasureRuns(uint32 num_runs, Function&& function)
+	{
+		std::vector<uint64> durations;
+
+		for (uint32 i = 0; i < num_runs; i++) {
+			uint64 begin = Profiler::Now();
+			function();
+			durations.push_back(Profiler::Now() - begin);
+		}
+
+		std::sort(durations.begin(), durations.end());
+
+		return { durations.front(), durations[durations.size() / 2] };
+	}
+
+	static void PrintRunTimes(std::string_view label, const RunTimes& times, const RunTimes& baseline)
+	{
+		fmt::print("{:<36}{:>12.2f}{:>12.2f}{:>10.2f}x\n", label, times.min / 1e6, times.median / 1e6, (float64)baseline.median / times.median);
+	}
+
+	/*
+	*	@brief Mip generation as it was before `JobSystem::ParallelFor`: a taskflow with a task per row is built for every level.
+	*	Kept as a baseline, filtering is the same as in `AssetCompressor::GenerateMipMaps`
+	*/
+	static std::vector<RGBA32> GenerateMipMapsTaskPerRow(const std::vector<RGBA32>& mip0_data, uint32 image_width, uint32 image_height)
+	{
+		std::vector<RGBA32> storage(Utils::ComputeMipLevelsStorage<sizeof(RGBA32)>(image_width, image_height) / sizeof(RGBA32));
+		memcpy(storage.data(), mip0_data.data(), image_width * image_height * sizeof(RGBA32));
+
+		uint32 current_image_width = image_width;
+		uint32 current_image_height = image_height;
+
+		RGBA32* src_mip_pointer = storage.data();
+		RGBA32* dst_mip_pointer = src_mip_pointer + image_width * image_height;
+
+		uint8 num_mip_levels = Utils::ComputeNumMipLevelsBC7(image_width, image_height);
+
+		for (int i = 0; i < num_mip_levels; i++) {
+			tf::Taskflow taskflow;
+
+			uint32 num_rows = current_image_height / 2;
+
+			for (uint32 row_idx = 0; row_idx < num_rows; row_idx++) {
+				taskflow.emplace([=]() {
+					int y = row_idx * 2;
+					for (int x = 0; x < current_image_width; x += 2) {
+						RGBA32* current_block = src_mip_pointer + (y * current_image_width + x);
+
+						glm::uvec4 pixels[4] = {};
+						pixels[0] = *(current_block);
+						pixels[1] = *(current_block + 1);
+						pixels[2] = *(current_block + current_image_width);
+						pixels[3] = *(current_block + current_image_width + 1);
+
+						glm::uvec4 result = (pixels[0] + pixels[1] + pixels[2] + pixels[3]) / 4U;
+
+						uint32 offset = (y / 2 * (current_image_width / 2)) + (x / 2);
+						*(dst_mip_pointer + offset) = result;
+					}
+				});
+			}
+
+			JobSystem::Run(taskflow, JobPriority::BACKGROUND).wait();
+
+			src_mip_pointer += current_image_width * current_image_height;
+			dst_mip_pointer += (current_image_width / 2) * (current_image_height / 2);
+
+			current_image_width >>= 1;
+			current_image_height >>= 1;
+		}
+
+		return storage;
+	}
+
+	static bool RunMipMapBenchmark(uint32 num_runs)
+	{
+		constexpr uint32 image_size = 4096;
+
+		std::mt19937 random_engine(0);
+		std::vector<RGBA32> image(image_size * image_size);
+
+		for (RGBA32& pixel : image)
+			pixel = RGBA32(random_engine(), random_engine(), random_engine(), 255);
+
+		std::vector<RGBA32> task_per_row_mips;
+		std::vector<RGBA32> parallel_for_mips;
+
+		RunTimes task_per_row_times = MeasureRuns(num_runs, [&]() {
+			task_per_row_mips = GenerateMipMapsTaskPerRow(image, image_size, image_size);
+		});
+		RunTimes parallel_for_times = MeasureRuns(num_runs, [&]() {
+			parallel_for_mips = AssetCompressor::GenerateMipMaps(image, image_size, image_size);
+		});
+
+		fmt::print("{}x{} mip chain, {} runs\n", image_size, image_size, num_runs);
+		fmt::print("{:<36}{:>12}{:>12}{:>11}\n", "", "Min ms", "Median ms", "Speedup");
+		PrintRunTimes("Task per row (previous)", task_per_row_times, task_per_row_times);
+		PrintRunTimes("JobSystem::ParallelFor", parallel_for_times, task_per_row_times);
+
+		if (task_per_row_mips != parallel_for_mips) {
+			fmt::print("  mip chains differ\n");
+			return false;
+		}
+
+		return true;
+	}
+
+	void GenerateGridMesh(uint32 grid_size, std::vector<byte>* vertices, std::vector<uint32>* indices)
+	{
+		std::mt19937 random_engine(0);
+		std::uniform_real_distribution<float32> height_distribution(0.0f, 0.05f);
+
+		uint32 num_vertices_per_row = grid_size + 1;
+		vertices->resize((uint64)num_vertices_per_row * num_vertices_per_row * sizeof(glm::vec3));
+		glm::vec3* positions = (glm::vec3*)vertices->data();
+
+		for (uint32 y = 0; y < num_vertices_per_row; y++)
+			for (uint32 x = 0; x < num_vertices_per_row; x++)
+				positions[y * num_vertices_per_row + x] = glm::vec3(x, height_distribution(random_engine), y) / (float32)grid_size;
+
+		indices->clear();
+		indices->reserve((uint64)grid_size * grid_size * 6);
+
+		for (uint32 y = 0; y < grid_size; y++) {
+			for (uint32 x = 0; x < grid_size; x++) {
+				uint32 corner = y * num_vertices_per_row + x;
+				indices->insert(indices->end(), { corner, corner + num_vertices_per_row, corner + 1 });
+				indices->insert(indices->end(), { corner + 1, corner + num_vertices_per_row, corner + num_vertices_per_row + 1 });
+			}
+		}
+	}
+
+	static bool RunClusterGraphBenchmark(uint32 num_runs)
+	{
+		constexpr uint32 grid_size = 512;
+
+		std::vector<byte> vertices;
+		std::vector<uint32> indices;
+		GenerateGridMesh(grid_size, &vertices, &indices);
+
+		VertexAttributeMetadataTable vertex_metadata = { { "POSITION", 0 } };
+
+		uint64 num_meshlets = 0;
+		RunTimes times = MeasureRuns(num_runs, [&]() {
+			VirtualMeshBuilder builder = {};
+			num_meshlets = builder.BuildClusterGraph(vertices, indices, sizeof(glm::vec3), vertex_metadata).meshlets.size();
+		});
+
+		fmt::print("Cluster graph of {} triangles, {} runs, {} meshlets\n", indices.size() / 3, num_runs, num_meshlets);
+		fmt::print("{:<36}{:>12}{:>12}\n", "", "Min ms", "Median ms");
+		fmt::print("{:<36}{:>12.2f}{:>12.2f}\n", "BuildClusterGraph", times.min / 1e6, times.median / 1e6);
+
+		return num_meshlets != 0;
+	}
+
+	bool RunParallelBenchmark(const BenchmarkOptions& options)
+	{
+		fmt::print("{} background workers\n", JobSystem::GetExecutor(JobPriority::BACKGROUND)->num_workers());
+
+		bool valid = RunMipMapBenchmark(5 * options.scale);
+		valid &= RunClusterGraphBenchmark(3 * options.scale);
+
+		return valid;
+	}
+
+}
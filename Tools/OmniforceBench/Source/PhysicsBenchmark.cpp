@@ -0,0 +1,217 @@
+#include "Benchmark.h"
+
+#include <Physics/Private/JoltJobSystem.h>
+#include <Physics/Private/JoltTempAllocator.h>
+#include <Threading/JobSystem.h>
+
+#include <cmath>
+#include <optional>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/RegisterTypes.h>
+#include <Jolt/Core/Factory.h>
+#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Physics/PhysicsSettings.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+
+#include <taskflow/taskflow.hpp>
+
+namespace Omni {
+
+	// Engine layer setup depends on scripting and scenes, so the benchmark has its own: static bodies only collide with moving ones
+	namespace BenchmarkBodyLayers {
+		static constexpr JPH::ObjectLayer NON_MOVING = 0;
+		static constexpr JPH::ObjectLayer MOVING = 1;
+		static constexpr uint32 NUM_LAYERS = 2;
+	};
+
+	class BenchmarkBroadPhaseLayerInterface final : public JPH::BroadPhaseLayerInterface {
+	public:
+		uint32 GetNumBroadPhaseLayers() const override { return BenchmarkBodyLayers::NUM_LAYERS; }
+
+		JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer layer) const override {
+			return JPH::BroadPhaseLayer((JPH::BroadPhaseLayer::Type)layer);
+		}
+
+#ifdef JPH_PROFILE_ENABLED
+		const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer layer) const override {
+			return layer == JPH::BroadPhaseLayer(BenchmarkBodyLayers::MOVING) ? "Moving" : "Non moving";
+		}
+#endif
+	};
+
+	class BenchmarkObjectBroadPhaseLayerFilter final : public JPH::ObjectVsBroadPhaseLayerFilter {
+	public:
+		bool ShouldCollide(JPH::ObjectLayer layer, JPH::BroadPhaseLayer broad_phase_layer) const override {
+			return layer == BenchmarkBodyLayers::MOVING || broad_phase_layer == JPH::BroadPhaseLayer(BenchmarkBodyLayers::MOVING);
+		}
+	};
+
+	class BenchmarkObjectLayerPairFilter final : public JPH::ObjectLayerPairFilter {
+	public:
+		bool ShouldCollide(JPH::ObjectLayer layer1, JPH::ObjectLayer layer2) const override {
+			return layer1 == BenchmarkBodyLayers::MOVING || layer2 == BenchmarkBodyLayers::MOVING;
+		}
+	};
+
+	/*
+	*	@brief Floor with columns of boxes and spheres dropped on it. Columns are close enough for neighbours to collide
+	*	when they topple, so contact count grows over the run like in a real scene
+	*/
+	class PhysicsBenchmarkWorld {
+	public:
+		PhysicsBenchmarkWorld(uint32 num_bodies)
+			: m_TempAllocator(&g_PhysicsAllocator, 64 * 1024 * 1024)
+		{
+			m_System.Init(num_bodies + 1, 0, num_bodies * 4, num_bodies * 4,
+				m_BroadPhaseLayerInterface, m_ObjectBroadPhaseLayerFilter, m_ObjectLayerPairFilter);
+
+			constexpr uint32 column_height = 10;
+			const uint32 num_columns = (num_bodies + column_height - 1) / column_height;
+			const uint32 grid_size = (uint32)std::ceil(std::sqrt((float32)num_columns));
+			const float32 spacing = 1.2f;
+
+			JPH::BodyInterface& body_interface = m_System.GetBodyInterface();
+
+			float32 floor_half_extent = grid_size * spacing;
+			JPH::BodyCreationSettings floor_settings(new JPH::BoxShape(JPH::Vec3(floor_half_extent, 1.0f, floor_half_extent)),
+				JPH::RVec3(0.0f, -1.0f, 0.0f), JPH::Quat::sIdentity(), JPH::EMotionType::Static, BenchmarkBodyLayers::NON_MOVING);
+			body_interface.CreateAndAddBody(floor_settings, JPH::EActivation::DontActivate);
+
+			JPH::RefConst<JPH::Shape> box_shape = new JPH::BoxShape(JPH::Vec3::sReplicate(0.5f));
+			JPH::RefConst<JPH::Shape> sphere_shape = new JPH::SphereShape(0.5f);
+
+			for (uint32 i = 0; i < num_bodies; i++) {
+				uint32 column = i / column_height;
+				uint32 level = i % column_height;
+
+				// Every other level is shifted, so columns are unstable and bodies keep interacting
+				JPH::RVec3 position(
+					((float32)(column % grid_size) - grid_size * 0.5f) * spacing + (level % 2) * 0.25f,
+					0.5f + level * 1.05f,
+					((float32)(column / grid_size) - grid_size * 0.5f) * spacing
+				);
+
+				JPH::BodyCreationSettings settings(i % 2 ? sphere_shape : box_shape, position, JPH::Quat::sIdentity(),
+					JPH::EMotionType::Dynamic, BenchmarkBodyLayers::MOVING);
+				body_interface.CreateAndAddBody(settings, JPH::EActivation::Activate);
+			}
+
+			m_System.OptimizeBroadPhase();
+		}
+
+		// @return step duration in nanoseconds
+		uint64 Step(JPH::JobSystem* job_system) {
+			uint64 begin = Profiler::Now();
+			m_System.Update(1.0f / 60.0f, 1, &m_TempAllocator, job_system);
+			return Profiler::Now() - begin;
+		}
+
+	private:
+		BenchmarkBroadPhaseLayerInterface m_BroadPhaseLayerInterface;
+		BenchmarkObjectBroadPhaseLayerFilter m_ObjectBroadPhaseLayerFilter;
+		BenchmarkObjectLayerPairFilter m_ObjectLayerPairFilter;
+		JoltTempAllocator m_TempAllocator;
+		JPH::PhysicsSystem m_System;
+	};
+
+	/*
+	*	@brief Keeps every background lane worker busy, like an asset import running next to the game
+	*/
+	class BackgroundLoad {
+	public:
+		BackgroundLoad() {
+			uint32 num_workers = (uint32)JobSystem::GetExecutor(JobPriority::BACKGROUND)->num_workers();
+
+			for (uint32 i = 0; i < num_workers; i++) {
+				m_NumRunningTasks.fetch_add(1);
+
+				JobSystem::SilentAsync(JobPriority::BACKGROUND, [this]() {
+					uint64 value = 0;
+					while (!m_Stop.load(std::memory_order_relaxed))
+						value = value * 6364136223846793005ull + 1442695040888963407ull;
+
+					m_Sink.fetch_xor(value, std::memory_order_relaxed);
+					m_NumRunningTasks.fetch_sub(1, std::memory_order_release);
+				});
+			}
+		}
+
+		~BackgroundLoad() {
+			m_Stop.store(true, std::memory_order_relaxed);
+
+			while (m_NumRunningTasks.load(std::memory_order_acquire))
+				std::this_thread::yield();
+		}
+
+	private:
+		Atomic<bool> m_Stop = false;
+		Atomic<uint32> m_NumRunningTasks = 0;
+		Atomic<uint64> m_Sink = 0;
+	};
+
+	static LatencyStatistics MeasureStepTime(uint32 num_bodies, uint32 num_steps, JPH::JobSystem* job_system, bool with_background_load)
+	{
+		PhysicsBenchmarkWorld world(num_bodies);
+
+		std::optional<BackgroundLoad> background_load;
+		if (with_background_load)
+			background_load.emplace();
+
+		// First steps are dominated by initial contact generation and island building
+		constexpr uint32 num_warmup_steps = 10;
+		for (uint32 i = 0; i < num_warmup_steps; i++)
+			world.Step(job_system);
+
+		std::vector<uint64> samples;
+		samples.reserve(num_steps);
+
+		for (uint32 i = 0; i < num_steps; i++)
+			samples.push_back(world.Step(job_system));
+
+		return ComputeLatencyStatistics(samples);
+	}
+
+	bool RunPhysicsBenchmark(const BenchmarkOptions& options)
+	{
+		const uint32 num_steps = 200 * options.scale;
+
+		JPH::RegisterDefaultAllocator();
+		JPH::Factory::sInstance = new JPH::Factory;
+		JPH::RegisterTypes();
+
+		{
+			// Private pool the engine used before, a thread per hardware thread except the main one
+			uint32 num_pool_threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+			JPH::JobSystemThreadPool thread_pool(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, (int)num_pool_threads);
+
+			tf::Executor* realtime_executor = JobSystem::GetExecutor(JobPriority::REALTIME);
+			JoltJobSystem engine_job_system(realtime_executor, JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+
+			fmt::print("Private pool: {} threads, realtime lane: {} workers, background lane: {} workers, {} steps\n", num_pool_threads,
+				realtime_executor->num_workers(), JobSystem::GetExecutor(JobPriority::BACKGROUND)->num_workers(), num_steps);
+			PrintLatencyHeader();
+
+			for (uint32 num_bodies : { 10'000u, 50'000u }) {
+				for (bool with_background_load : { false, true }) {
+					std::string suffix = fmt::format("{}k{}", num_bodies / 1000, with_background_load ? ", loaded" : "");
+
+					PrintLatency(fmt::format("Private pool, {}", suffix),
+						MeasureStepTime(num_bodies, num_steps, &thread_pool, with_background_load));
+					PrintLatency(fmt::format("Job system, {}", suffix),
+						MeasureStepTime(num_bodies, num_steps, &engine_job_system, with_background_load));
+				}
+			}
+		}
+
+		JPH::UnregisterTypes();
+		delete JPH::Factory::sInstance;
+		JPH::Factory::sInstance = nullptr;
+
+		return true;
+	}
+
+}
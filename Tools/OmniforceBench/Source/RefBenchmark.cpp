@@ -0,0 +1,202 @@
+#include "Benchmark.h"
+
+#include <Foundation/Memory/Ref.h>
+
+namespace Omni {
+
+	/*
+	*	@brief Ref as it was before the intrusive 8-byte handle: allocator, allocation and object pointer in every handle,
+	*	atomic counter with sequentially consistent increments, and moves that fall back to copies. Kept as a baseline
+	*/
+	template<typename T>
+	class PreviousRef {
+	public:
+		using TCounter = uint64;
+
+		struct StorageType {
+			template<typename... TArgs>
+			StorageType(TArgs&&... args)
+				: ref_counter(1), object()
+			{
+				new (object) T(std::forward<TArgs>(args)...);
+			}
+
+			~StorageType() {
+				((T*)object)->~T();
+			}
+
+			Atomic<TCounter> ref_counter;
+			byte object[sizeof(T)];
+		};
+
+		template<typename... TArgs>
+		PreviousRef(IAllocator* allocator, TArgs&&... args)
+			: m_Allocator(allocator)
+		{
+			m_Allocation = m_Allocator->Allocate<StorageType>(std::forward<TArgs>(args)...);
+			m_CachedObject = (T*)(m_Allocation.Memory + sizeof(TCounter));
+		}
+
+		PreviousRef()
+			: m_Allocator(nullptr)
+			, m_Allocation(MemoryAllocation::InvalidAllocation())
+			, m_CachedObject(nullptr)
+		{}
+
+		// Only a converting move constructor existed, so same type moves were copies
+		PreviousRef(const PreviousRef& other)
+			: m_Allocator(other.m_Allocator)
+			, m_Allocation(other.m_Allocation)
+			, m_CachedObject(other.m_CachedObject)
+		{
+			IncrementRefCounter();
+		}
+
+		~PreviousRef() {
+			DecrementRefCounter();
+
+			if (CanReleaseAllocation()) {
+				m_Allocator->Free<StorageType>(m_Allocation);
+			}
+		}
+
+		T* Raw() const { return m_CachedObject; }
+
+	private:
+		bool CanReleaseAllocation() const {
+			return m_Allocation.IsValid() && *m_Allocation.As<Atomic<TCounter>>() == 0;
+		}
+
+		void IncrementRefCounter() {
+			if (m_Allocation.IsValid()) {
+				(*m_Allocation.As<Atomic<TCounter>>())++;
+			}
+		}
+
+		void DecrementRefCounter() {
+			if (m_Allocation.IsValid()) {
+				(*m_Allocation.As<Atomic<TCounter>>())--;
+			}
+		}
+
+		IAllocator* m_Allocator;
+		MemoryAllocation m_Allocation;
+		T* m_CachedObject;
+	};
+
+	struct RefBenchmarkObject {
+		uint64 value;
+	};
+
+	// Nanoseconds per handle operation
+	struct RefTimings {
+		float64 copy = 0.0;
+		float64 move = 0.0;
+		float64 release = 0.0;
+		float64 create_destroy = 0.0;
+	};
+
+	/*
+	*	@brief Handles are copied from a single object into an array, moved to a second array and then destroyed, which only
+	*	drops the counter, like component and asset handles passed around during a frame. Create / destroy covers allocation,
+	*	construction and the last release
+	*/
+	template<typename TRef, typename CreateFunction>
+	static RefTimings MeasureRef(uint32 num_rounds, CreateFunction&& create, uint64* checksum)
+	{
+		constexpr uint32 num_handles = 1024;
+
+		uint64 copy_duration = 0;
+		uint64 move_duration = 0;
+		uint64 release_duration = 0;
+		uint64 create_destroy_duration = 0;
+
+		TRef source = create(1);
+
+		std::vector<TRef> copies;
+		std::vector<TRef> moved;
+		copies.reserve(num_handles);
+		moved.reserve(num_handles);
+
+		for (uint32 round = 0; round < num_rounds; round++) {
+			uint64 begin = Profiler::Now();
+			for (uint32 i = 0; i < num_handles; i++)
+				copies.emplace_back(source);
+			copy_duration += Profiler::Now() - begin;
+
+			begin = Profiler::Now();
+			for (TRef& handle : copies)
+				moved.emplace_back(std::move(handle));
+			move_duration += Profiler::Now() - begin;
+
+			copies.clear();
+
+			for (const TRef& handle : moved)
+				*checksum += handle.Raw()->value;
+
+			begin = Profiler::Now();
+			moved.clear();
+			release_duration += Profiler::Now() - begin;
+
+			begin = Profiler::Now();
+			for (uint32 i = 0; i < num_handles; i++) {
+				TRef handle = create(i);
+				*checksum += handle.Raw()->value;
+			}
+			create_destroy_duration += Profiler::Now() - begin;
+		}
+
+		const float64 num_operations = (float64)num_rounds * num_handles;
+
+		RefTimings timings = {};
+		timings.copy = copy_duration / num_operations;
+		timings.move = move_duration / num_operations;
+		timings.release = release_duration / num_operations;
+		timings.create_destroy = create_destroy_duration / num_operations;
+
+		return timings;
+	}
+
+	bool RunRefBenchmark(const BenchmarkOptions& options)
+	{
+		const uint32 num_rounds = 2000 * options.scale;
+
+		uint64 previous_checksum = 0;
+		uint64 ref_checksum = 0;
+		uint64 local_ref_checksum = 0;
+
+		RefTimings previous_timings = MeasureRef<PreviousRef<RefBenchmarkObject>>(num_rounds, [](uint64 value) {
+			return PreviousRef<RefBenchmarkObject>(&g_PersistentAllocator, value);
+		}, &previous_checksum);
+
+		RefTimings ref_timings = MeasureRef<Ref<RefBenchmarkObject>>(num_rounds, [](uint64 value) {
+			return CreateRef<RefBenchmarkObject>(&g_PersistentAllocator, value);
+		}, &ref_checksum);
+
+		RefTimings local_ref_timings = MeasureRef<LocalRef<RefBenchmarkObject>>(num_rounds, [](uint64 value) {
+			return CreateLocalRef<RefBenchmarkObject>(&g_PersistentAllocator, value);
+		}, &local_ref_checksum);
+
+		fmt::print("{} rounds of 1024 handles, ns per handle\n", num_rounds);
+		fmt::print("{:<28}{:>16}{:>16}{:>16}\n", "", "Previous Ref", "Ref", "LocalRef");
+		fmt::print("{:<28}{:>16}{:>16}{:>16}\n", "Handle size, bytes",
+			sizeof(PreviousRef<RefBenchmarkObject>), sizeof(Ref<RefBenchmarkObject>), sizeof(LocalRef<RefBenchmarkObject>));
+
+		auto print_row = [](std::string_view label, float64 previous, float64 ref, float64 local_ref) {
+			fmt::print("{:<28}{:>16.2f}{:>16.2f}{:>16.2f}\n", label, previous, ref, local_ref);
+		};
+
+		print_row("Copy", previous_timings.copy, ref_timings.copy, local_ref_timings.copy);
+		print_row("Move", previous_timings.move, ref_timings.move, local_ref_timings.move);
+		print_row("Release", previous_timings.release, ref_timings.release, local_ref_timings.release);
+		print_row("Create / destroy", previous_timings.create_destroy, ref_timings.create_destroy, local_ref_timings.create_destroy);
+
+		if (previous_checksum != ref_checksum || ref_checksum != local_ref_checksum) {
+			fmt::print("  objects reached through handles differ\n");
+			return false;
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,177 @@
+#include "Benchmark.h"
+
+#include <Foundation/Memory/TLSFVirtualMemoryBlock.h>
+
+#include <cmath>
+#include <map>
+#include <random>
+
+namespace Omni {
+
+	struct TLSFWorkload {
+		std::mt19937 random_engine;
+		std::vector<std::pair<uint32, uint32>> live_allocations; // offset - size rounded up to granularity
+
+		TLSFWorkload(uint32 seed)
+			: random_engine(seed)
+		{}
+
+		// Log-uniform sizes from 1 byte to 1 MB, like a mix of small uniform buffers and large vertex buffers
+		uint32 RandomSize() {
+			return (uint32)std::exp2(std::uniform_real_distribution<float64>(0.0, 20.0)(random_engine));
+		}
+
+		uint32 RandomAlignment() {
+			constexpr uint32 alignments[] = { 0, 16, 256, 4096, 65536 };
+			return alignments[std::uniform_int_distribution<uint32>(0, (uint32)std::size(alignments) - 1)(random_engine)];
+		}
+
+		bool ShouldAllocate(uint32 max_live_allocations) {
+			return live_allocations.empty() ||
+				(live_allocations.size() < max_live_allocations && std::uniform_int_distribution<uint32>(0, 9)(random_engine) < 6);
+		}
+
+		// Swaps a random live allocation to the back, so it can be popped
+		std::pair<uint32, uint32> PopRandomAllocation() {
+			uint64 index = std::uniform_int_distribution<uint64>(0, live_allocations.size() - 1)(random_engine);
+			std::swap(live_allocations[index], live_allocations.back());
+
+			std::pair<uint32, uint32> allocation = live_allocations.back();
+			live_allocations.pop_back();
+
+			return allocation;
+		}
+	};
+
+	/*
+	*	@brief Randomized allocate / free sequence checked against a shadow map of live ranges: every allocation must be
+	*	aligned, in bounds and not overlap others, used size must match, and freeing everything must coalesce back into one block
+	*/
+	static bool ValidateTLSF(uint32 seed, uint32 num_operations)
+	{
+		constexpr uint32 block_size = 256 * 1024 * 1024;
+		constexpr uint32 max_live_allocations = 2048;
+
+		TLSFVirtualMemoryBlock block(block_size);
+		TLSFWorkload workload(seed);
+
+		const uint32 granularity = block.GetGranularity();
+		std::map<uint32, uint32> live_ranges; // begin - end
+		uint64 used_size = 0;
+		uint64 num_failed_allocations = 0;
+
+		auto fail = [&](uint32 operation, std::string_view message) {
+			fmt::print("  seed {}, operation {}: {}\n", seed, operation, message);
+			return false;
+		};
+
+		for (uint32 operation = 0; operation < num_operations; operation++) {
+			if (workload.ShouldAllocate(max_live_allocations)) {
+				uint32 size = workload.RandomSize();
+				uint32 alignment = workload.RandomAlignment();
+				uint32 offset = block.Allocate(size, alignment);
+
+				if (offset == VirtualMemoryBlock::INVALID_OFFSET) {
+					num_failed_allocations++;
+					continue;
+				}
+
+				uint32 rounded_size = std::max(granularity, (size + granularity - 1) & ~(granularity - 1));
+
+				if (offset % std::max(alignment, granularity))
+					return fail(operation, "allocation is misaligned");
+
+				if ((uint64)offset + rounded_size > block_size)
+					return fail(operation, "allocation is out of bounds");
+
+				auto next = live_ranges.lower_bound(offset);
+				if (next != live_ranges.end() && next->first < offset + rounded_size)
+					return fail(operation, "allocation overlaps the next live allocation");
+
+				if (next != live_ranges.begin() && std::prev(next)->second > offset)
+					return fail(operation, "allocation overlaps the previous live allocation");
+
+				live_ranges.emplace(offset, offset + rounded_size);
+				workload.live_allocations.emplace_back(offset, rounded_size);
+				used_size += rounded_size;
+			}
+			else {
+				auto [offset, rounded_size] = workload.PopRandomAllocation();
+
+				block.Free(offset);
+				live_ranges.erase(offset);
+				used_size -= rounded_size;
+			}
+
+			if (block.GetUsedMemorySize() != used_size)
+				return fail(operation, "used memory size does not match live allocations");
+		}
+
+		while (!workload.live_allocations.empty())
+			block.Free(workload.PopRandomAllocation().first);
+
+		if (block.GetUsedMemorySize() || block.GetStats().num_live_allocations)
+			return fail(num_operations, "memory is still used after freeing all allocations");
+
+		if (block.GetLargestFreeBlockSize() != block_size)
+			return fail(num_operations, "free blocks were not coalesced after freeing all allocations");
+
+		if (num_failed_allocations)
+			fmt::print("  seed {}: {} of {} operations failed to allocate\n", seed, num_failed_allocations, num_operations);
+
+		return true;
+	}
+
+	bool RunTLSFBenchmark(const BenchmarkOptions& options)
+	{
+		constexpr uint32 num_seeds = 16;
+		const uint32 num_validation_operations = 200'000 * options.scale;
+
+		bool valid = true;
+		for (uint32 seed = 0; seed < num_seeds; seed++)
+			valid &= ValidateTLSF(seed, num_validation_operations);
+
+		fmt::print("Validation: {} seeds x {} operations {}\n", num_seeds, num_validation_operations, valid ? "passed" : "FAILED");
+
+		// Steady state churn with a fixed number of live allocations, every call is measured
+		const uint32 num_operations = 1'000'000 * options.scale;
+		constexpr uint32 num_live_allocations = 4096;
+
+		TLSFVirtualMemoryBlock block(1024 * 1024 * 1024);
+		TLSFWorkload workload(num_seeds);
+
+		std::vector<uint64> allocate_samples;
+		std::vector<uint64> free_samples;
+		allocate_samples.reserve(num_operations);
+		free_samples.reserve(num_operations);
+
+		for (uint32 i = 0; i < num_operations; i++) {
+			if (workload.live_allocations.size() >= num_live_allocations) {
+				uint32 offset = workload.PopRandomAllocation().first;
+
+				uint64 begin = Profiler::Now();
+				block.Free(offset);
+				free_samples.push_back(Profiler::Now() - begin);
+			}
+
+			uint32 size = workload.RandomSize();
+			uint32 alignment = workload.RandomAlignment();
+
+			uint64 begin = Profiler::Now();
+			uint32 offset = block.Allocate(size, alignment);
+			allocate_samples.push_back(Profiler::Now() - begin);
+
+			if (offset != VirtualMemoryBlock::INVALID_OFFSET)
+				workload.live_allocations.emplace_back(offset, size);
+		}
+
+		fmt::print("{} live allocations, {} operations, fragmentation {:.1f}%\n",
+			num_live_allocations, num_operations, 100.0f * block.GetStats().fragmentation);
+		PrintLatencyHeader();
+		PrintLatency("Allocate", ComputeLatencyStatistics(allocate_samples));
+		PrintLatency("Free", ComputeLatencyStatistics(free_samples));
+
+		return valid;
+	}
+
+}
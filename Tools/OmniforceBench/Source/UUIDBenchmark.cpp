@@ -0,0 +1,109 @@
+#include "Benchmark.h"
+
+#include <Foundation/Containers/FlatHashMap.h>
+
+#include <barrier>
+#include <thread>
+
+namespace Omni {
+
+	struct BulkCreationResult {
+		uint64 duration = 0;	// Of the slowest thread, in nanoseconds
+		bool valid = true;
+	};
+
+	using BulkCreateFunction = void (*)(uint32 num_entities, FlatHashMap<UUID, uint32>& entities);
+
+	/*
+	*	@brief Every thread creates `num_entities` UUIDs and registers them in its own UUID -> entity map,
+	*	the same bookkeeping `Scene::CreateEntity` does. UUIDs of all threads are then checked to be non-zero and unique
+	*/
+	static BulkCreationResult MeasureBulkCreation(uint32 num_threads, uint32 num_entities, BulkCreateFunction create)
+	{
+		std::vector<FlatHashMap<UUID, uint32>> thread_entities(num_threads);
+		std::vector<uint64> thread_durations(num_threads);
+		std::barrier start_barrier(num_threads);
+		std::vector<std::thread> threads;
+
+		for (uint32 thread_index = 0; thread_index < num_threads; thread_index++) {
+			threads.emplace_back([&, thread_index]() {
+				FlatHashMap<UUID, uint32>& entities = thread_entities[thread_index];
+
+				start_barrier.arrive_and_wait();
+
+				uint64 begin = Profiler::Now();
+				create(num_entities, entities);
+				thread_durations[thread_index] = Profiler::Now() - begin;
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		BulkCreationResult result = {};
+		result.duration = *std::max_element(thread_durations.begin(), thread_durations.end());
+
+		std::vector<uint64> ids;
+		ids.reserve((uint64)num_threads * num_entities);
+
+		for (const FlatHashMap<UUID, uint32>& entities : thread_entities) {
+			// Duplicate within a thread is silently merged by the map
+			result.valid &= entities.Size() == num_entities;
+
+			for (const auto& [id, entity] : entities)
+				ids.push_back(id.Get());
+		}
+
+		std::sort(ids.begin(), ids.end());
+		result.valid &= ids.empty() || ids.front() != 0;
+		result.valid &= std::adjacent_find(ids.begin(), ids.end()) == ids.end();
+
+		return result;
+	}
+
+	bool RunUUIDBenchmark(const BenchmarkOptions& options)
+	{
+		const uint32 num_entities = 1'000'000 * options.scale;
+
+		struct Method {
+			std::string_view label;
+			BulkCreateFunction create;
+		};
+
+		const Method methods[] = {
+			// How `UUID()` generated values before the counter-based generator
+			{ "mt19937_64 per UUID", [](uint32 num_entities, FlatHashMap<UUID, uint32>& entities) {
+				for (uint32 i = 0; i < num_entities; i++)
+					entities.Emplace(UUID(RandomEngine::Generate<uint64>()), i);
+			} },
+			{ "UUIDGenerator::Generate", [](uint32 num_entities, FlatHashMap<UUID, uint32>& entities) {
+				for (uint32 i = 0; i < num_entities; i++)
+					entities.Emplace(UUID(), i);
+			} },
+			{ "UUIDGenerator::Reserve", [](uint32 num_entities, FlatHashMap<UUID, uint32>& entities) {
+				UUIDRange range = UUIDGenerator::Reserve(num_entities);
+				for (uint32 i = 0; i < num_entities; i++)
+					entities.Emplace(UUID(range[i]), i);
+			} },
+		};
+
+		bool valid = true;
+
+		for (uint32 num_threads : { 1u, options.num_threads }) {
+			fmt::print("{} threads, {} entities per thread\n", num_threads, num_entities);
+			fmt::print("{:<28}{:>12}{:>16}\n", "", "Time ms", "M entities/s");
+
+			for (const Method& method : methods) {
+				BulkCreationResult result = MeasureBulkCreation(num_threads, num_entities, method.create);
+
+				fmt::print("{:<28}{:>12.2f}{:>16.2f}{}\n", method.label, result.duration / 1e6,
+					(float64)num_threads * num_entities / (result.duration / 1e3), result.valid ? "" : "  duplicate or zero UUIDs");
+
+				valid &= result.valid;
+			}
+		}
+
+		return valid;
+	}
+
+}
@@ -0,0 +1,297 @@
+#include "AssetCookTool.h"
+
+#include <Threading/JobSystem.h>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/fmt/fmt.h>
+#include <taskflow/taskflow.hpp>
+
+namespace Omni {
+
+	void AssetCookTool::Setup(const CookOptions& options)
+	{
+		m_Options = options;
+		m_NumJobs = options.num_jobs ? options.num_jobs : std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		// Engine messages below warning level are only useful when investigating a single asset
+		OMNIFORCE_INITIALIZE_LOG_SYSTEM(options.verbose ? Logger::Level::LEVEL_TRACE : Logger::Level::LEVEL_WARN);
+
+		// Background lane is sized by job budget, so it must be configured before job system is used.
+		// Tool has no frame work, so realtime lane is kept at a single worker
+		JobSystemSpecification job_system_spec = {};
+		job_system_spec.num_realtime_workers = 1;
+		job_system_spec.num_background_workers = m_NumJobs;
+		JobSystem::Configure(job_system_spec);
+
+		Profiler::Init();
+		AssetCooker::Init();
+	}
+
+	bool AssetCookTool::LoadManifests()
+	{
+		for (const std::filesystem::path& manifest_path : m_Options.manifests) {
+			if (!LoadManifest(manifest_path))
+				return false;
+		}
+
+		uint64 total_source_size = 0;
+		for (const CookItem& item : m_Items)
+			total_source_size += item.source_size;
+
+		fmt::print("Cooking {} assets ({:.1f} MB) from {} manifests with {} jobs\n",
+			m_Items.size(), total_source_size / (1024.0 * 1024.0), m_Options.manifests.size(), m_NumJobs);
+
+		return true;
+	}
+
+	bool AssetCookTool::LoadManifest(const std::filesystem::path& manifest_path)
+	{
+		std::ifstream manifest_file(manifest_path);
+
+		if (!manifest_file) {
+			fmt::print(stderr, "Failed to open manifest \"{}\"\n", manifest_path.string());
+			return false;
+		}
+
+		nlohmann::json manifest = nlohmann::json::parse(manifest_file, nullptr, false);
+
+		if (manifest.is_discarded() || !manifest.is_object() || !manifest.contains("assets") || !manifest["assets"].is_array()) {
+			fmt::print(stderr, "Manifest \"{}\" is malformed, it must be an object with \"assets\" array\n", manifest_path.string());
+			return false;
+		}
+
+		// nlohmann::json::value throws on type mismatch, so optional string fields are validated upfront
+		for (const char* field : { "source_root", "output" }) {
+			if (manifest.contains(field) && !manifest[field].is_string()) {
+				fmt::print(stderr, "Manifest \"{}\" is malformed, \"{}\" must be a string\n", manifest_path.string(), field);
+				return false;
+			}
+		}
+
+		// Paths are relative to the manifest, so manifests can be moved together with sources
+		std::filesystem::path manifest_directory = std::filesystem::absolute(manifest_path).parent_path();
+		std::filesystem::path source_root = (manifest_directory / manifest.value("source_root", std::string())).lexically_normal();
+		std::filesystem::path output_root = m_Options.output_directory.empty() ?
+			manifest_directory / manifest.value("output", std::string("Cooked")) :
+			std::filesystem::absolute(m_Options.output_directory);
+
+		for (const nlohmann::json& entry : manifest["assets"]) {
+			std::string source;
+			std::string output;
+
+			if (entry.is_string()) {
+				source = entry.get<std::string>();
+			}
+			else if (entry.is_object() && entry.contains("source") && entry["source"].is_string() &&
+				(!entry.contains("output") || entry["output"].is_string())) {
+				source = entry["source"].get<std::string>();
+				output = entry.value("output", std::string());
+			}
+			else {
+				fmt::print(stderr, "Invalid asset entry {} in manifest \"{}\"\n", entry.dump(), manifest_path.string());
+				return false;
+			}
+
+			CookItem item = {};
+			item.source = (source_root / source).lexically_normal();
+
+			std::string extension = item.source.extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+			// Models are parsed by glTF parser only
+			item.type = FileExtensionToAssetType(extension);
+			bool supported = item.type == AssetType::IMAGE_SRC || (item.type == AssetType::MESH_SRC && (extension == ".gltf" || extension == ".glb"));
+
+			if (!supported) {
+				fmt::print(stderr, "Asset source \"{}\" has unsupported type\n", item.source.string());
+				return false;
+			}
+
+			std::error_code error;
+			item.source_size = std::filesystem::file_size(item.source, error);
+
+			if (error) {
+				fmt::print(stderr, "Asset source \"{}\" can't be read: {}\n", item.source.string(), error.message());
+				return false;
+			}
+
+			// Output mirrors source layout, unless it is set explicitly. Sources outside of source root go to output root
+			std::filesystem::path relative_output = output;
+			if (relative_output.empty()) {
+				relative_output = item.source.lexically_relative(source_root);
+
+				if (relative_output.empty() || *relative_output.begin() == "..")
+					relative_output = item.source.filename();
+
+				if (item.type == AssetType::MESH_SRC)
+					relative_output.replace_extension();
+			}
+
+			item.output = output_root / relative_output;
+
+			if (item.type == AssetType::IMAGE_SRC)
+				item.output.replace_extension(".oft");
+
+			std::filesystem::create_directories(item.type == AssetType::IMAGE_SRC ? item.output.parent_path() : item.output, error);
+
+			if (error) {
+				fmt::print(stderr, "Failed to create output directory for \"{}\": {}\n", item.output.string(), error.message());
+				return false;
+			}
+
+			m_Items.push_back(std::move(item));
+		}
+
+		return true;
+	}
+
+	void AssetCookTool::Cook()
+	{
+		if (!m_Options.trace_path.empty())
+			Profiler::StartCapture();
+
+		// Every asset is a task, semaphore keeps number of assets in flight within job budget, so memory use is bounded.
+		// Stages of an asset are parallelized on the same lane, so a few large assets still occupy all workers
+		tf::Taskflow taskflow("Cook");
+		tf::Semaphore asset_budget(m_NumJobs);
+
+		for (CookItem& item : m_Items) {
+			taskflow.emplace([this, &item]() { CookAsset(item); })
+				.name(item.source.filename().string())
+				.acquire(asset_budget)
+				.release(asset_budget);
+		}
+
+		float64 weighted_utilization = 0.0;
+		float64 sampled_time = 0.0;
+
+		// Main thread is not a worker, so while it waits it drains profiler buffers, samples worker utilization and prints progress
+		auto tick = [&]() {
+			JobSystem::OnFrameEnd();
+			OMNIFORCE_PROFILE_FRAME();
+
+			JobFrameUtilization utilization = JobSystem::GetFrameUtilization();
+			weighted_utilization += utilization.lanes[(uint32)JobPriority::BACKGROUND].average_utilization * utilization.frame_time;
+			sampled_time += utilization.frame_time;
+		};
+
+		// Discards utilization accumulated before the cook
+		JobSystem::OnFrameEnd();
+
+		uint64 cook_begin = Profiler::Now();
+		uint64 last_progress_time = cook_begin;
+
+		tf::Future<void> cook_future = JobSystem::Run(taskflow, JobPriority::BACKGROUND);
+
+		while (cook_future.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+			tick();
+
+			uint64 now = Profiler::Now();
+			if (now - last_progress_time >= 5ull * 1000 * 1000 * 1000) {
+				fmt::print("{}/{} assets cooked, {:.0f} s elapsed\n", m_NumCookedAssets.load(), m_Items.size(), (now - cook_begin) * 1e-9);
+				last_progress_time = now;
+			}
+		}
+
+		m_CookTime = Profiler::Now() - cook_begin;
+		tick();
+
+		m_WorkerUtilization = sampled_time > 0.0 ? (float32)(weighted_utilization / sampled_time) : 0.0f;
+		m_NumFailedAssets = (uint32)std::count_if(m_Items.begin(), m_Items.end(), [](const CookItem& item) { return !item.succeeded; });
+
+		if (!m_Options.trace_path.empty()) {
+			Profiler::StopCapture();
+
+			if (Profiler::ExportChromeTrace(m_Options.trace_path))
+				fmt::print("Exported trace to \"{}\"\n", m_Options.trace_path.string());
+			else
+				fmt::print(stderr, "Failed to export trace to \"{}\"\n", m_Options.trace_path.string());
+		}
+	}
+
+	void AssetCookTool::CookAsset(CookItem& item)
+	{
+		uint64 begin = Profiler::Now();
+
+		item.succeeded = item.type == AssetType::IMAGE_SRC ?
+			AssetCooker::CookImage(item.source, item.output, &m_Statistics) :
+			AssetCooker::CookModel(item.source, item.output, &m_Statistics);
+
+		item.time = Profiler::Now() - begin;
+
+		if (!item.succeeded)
+			fmt::print(stderr, "Failed to cook \"{}\"\n", item.source.string());
+
+		m_NumCookedAssets.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void AssetCookTool::PrintReport() const
+	{
+		constexpr float64 ns_to_s = 1e-9;
+		constexpr float64 bytes_to_mb = 1.0 / (1024.0 * 1024.0);
+
+		uint64 total_source_size = 0;
+		for (const CookItem& item : m_Items)
+			total_source_size += item.source_size;
+
+		float64 cook_time = std::max(m_CookTime * ns_to_s, 1e-9);
+
+		fmt::print("\nCooked {} assets ({} failed) in {:.2f} s with {} jobs\n", m_Items.size() - m_NumFailedAssets, m_NumFailedAssets, cook_time, m_NumJobs);
+		fmt::print("Source data: {:.1f} MB, {:.1f} MB/s, {:.1f} assets/s\n", total_source_size * bytes_to_mb, total_source_size * bytes_to_mb / cook_time, m_Items.size() / cook_time);
+		fmt::print("Worker utilization: {:.1f}%\n\n", m_WorkerUtilization * 100.0f);
+
+		uint64 total_stage_time = 0;
+		for (uint32 i = 0; i < (uint32)AssetCookStage::COUNT; i++)
+			total_stage_time += m_Statistics.GetStage((AssetCookStage)i).time.load();
+
+		fmt::print("{:<22}{:>8}{:>12}{:>12}{:>10}{:>8}{:>10}\n", "Stage", "Items", "Input MB", "Output MB", "Time s", "Share", "MB/s");
+
+		for (uint32 i = 0; i < (uint32)AssetCookStage::COUNT; i++) {
+			const AssetCookStageStatistics& stage = m_Statistics.GetStage((AssetCookStage)i);
+
+			uint64 num_items = stage.num_items.load();
+			if (!num_items)
+				continue;
+
+			float64 input_size = stage.input_size.load() * bytes_to_mb;
+			float64 output_size = stage.output_size.load() * bytes_to_mb;
+			float64 time = stage.time.load() * ns_to_s;
+			float64 share = total_stage_time ? (float64)stage.time.load() / total_stage_time * 100.0 : 0.0;
+
+			fmt::print("{:<22}{:>8}{:>12.1f}{:>12.1f}{:>10.2f}{:>7.1f}%{:>10.1f}\n",
+				AssetCookStatistics::GetStageName((AssetCookStage)i), num_items, input_size, output_size, time, share, time > 0.0 ? input_size / time : 0.0);
+		}
+
+		fmt::print("\nStage time is summed over assets cooked at once, MB/s is input throughput of a single asset stream\n");
+
+		// Slowest assets are the ones which limit the cook when job budget is larger than number of remaining assets
+		std::vector<uint32> slowest_items(m_Items.size());
+		std::iota(slowest_items.begin(), slowest_items.end(), 0u);
+
+		uint32 num_slowest_items = std::min<uint32>(slowest_items.size(), 5);
+		std::partial_sort(slowest_items.begin(), slowest_items.begin() + num_slowest_items, slowest_items.end(), [this](uint32 lhs, uint32 rhs) {
+			return m_Items[lhs].time > m_Items[rhs].time;
+		});
+
+		if (num_slowest_items)
+			fmt::print("\nSlowest assets:\n");
+
+		for (uint32 i = 0; i < num_slowest_items; i++) {
+			const CookItem& item = m_Items[slowest_items[i]];
+			fmt::print("{:>10.2f} s  {}{}\n", item.time * ns_to_s, item.source.string(), item.succeeded ? "" : " (failed)");
+		}
+	}
+
+	void AssetCookTool::CleanUp()
+	{
+		JobSystem::WaitForAll();
+		Profiler::Shutdown();
+		Logger::Get()->Flush();
+	}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CookOptions.h"
+
+#include <Foundation/Common.h>
+#include <Asset/AssetCooker.h>
+
+#include <mutex>
+
+namespace Omni {
+
+	struct CookItem {
+		std::filesystem::path source;
+		std::filesystem::path output;	// File for images, directory for models
+		AssetType type = AssetType::UNKNOWN;
+		uint64 source_size = 0;
+		uint64 time = 0;				// Nanoseconds
+		bool succeeded = false;
+	};
+
+	/*
+	*	@brief Headless batch cooker. Runs renderer-independent asset pipelines of `AssetCooker` for all assets listed in
+	*	batch manifests. Assets are cooked on background lane, number of its workers and assets in flight are limited by job budget
+	*/
+	class AssetCookTool {
+	public:
+		void Setup(const CookOptions& options);
+		bool LoadManifests();
+		void Cook();
+		void PrintReport() const;
+		void CleanUp();
+
+		uint32 GetNumFailedAssets() const { return m_NumFailedAssets; }
+
+	private:
+		bool LoadManifest(const std::filesystem::path& manifest_path);
+		void CookAsset(CookItem& item);
+
+	private:
+		CookOptions m_Options;
+		uint32 m_NumJobs = 0;
+
+		std::vector<CookItem> m_Items;
+		AssetCookStatistics m_Statistics;
+
+		Atomic<uint32> m_NumCookedAssets = 0;
+		uint32 m_NumFailedAssets = 0;
+
+		uint64 m_CookTime = 0;				// Nanoseconds
+		float32 m_WorkerUtilization = 0.0f;	// Average utilization of background workers over the cook
+	};
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Foundation/Common.h>
+
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <spdlog/fmt/fmt.h>
+
+namespace Omni {
+
+	struct CookOptions {
+		std::vector<std::filesystem::path> manifests;
+		std::filesystem::path output_directory;	// Overrides output directory of manifests if not empty
+		std::filesystem::path trace_path;		// Chrome trace of the whole cook is exported if not empty
+		uint32 num_jobs = 0;					// Background workers and assets cooked at once, 0 to use all hardware threads but one
+		bool verbose = false;
+		bool help = false;
+	};
+
+	inline void PrintCookUsage()
+	{
+		// Printed as an argument, since manifest example contains braces
+		fmt::print("{}",
+			"Usage: OmniforceCook [options] <manifest.json>...\n"
+			"\n"
+			"Cooks image and glTF model sources listed in batch manifests into engine formats without a renderer.\n"
+			"\n"
+			"Options:\n"
+			"  -j, --jobs <count>    Number of worker threads and assets cooked at once\n"
+			"  -o, --output <dir>    Output directory, overrides \"output\" of manifests\n"
+			"  --trace <file>        Export CPU profile of the cook as Chrome trace\n"
+			"  -v, --verbose         Print engine log messages below warning level\n"
+			"  -h, --help            Print this message\n"
+			"\n"
+			"Manifest:\n"
+			"  {\n"
+			"    \"source_root\": \"Assets\",\n"
+			"    \"output\": \"Cooked\",\n"
+			"    \"assets\": [ \"Textures/Bricks.png\", { \"source\": \"Models/Sponza.gltf\", \"output\": \"Sponza\" } ]\n"
+			"  }\n"
+			"  Paths are relative to the manifest. Images are cooked to .oft files, every primitive of a model to an .ofm file.\n"
+		);
+	}
+
+	// Prints usage and returns nothing if arguments are invalid
+	inline std::optional<CookOptions> ParseCookOptions(int argc, char** argv)
+	{
+		CookOptions options = {};
+
+		for (int32 i = 1; i < argc; i++) {
+			std::string_view argument = argv[i];
+
+			// Options which take a value
+			bool has_value = i + 1 < argc;
+
+			if (argument == "-h" || argument == "--help") {
+				options.help = true;
+				return options;
+			}
+			else if (argument == "-v" || argument == "--verbose") {
+				options.verbose = true;
+			}
+			else if ((argument == "-j" || argument == "--jobs") && has_value) {
+				int32 num_jobs = std::atoi(argv[++i]);
+
+				if (num_jobs <= 0) {
+					fmt::print(stderr, "Invalid job count \"{}\"\n", argv[i]);
+					return std::nullopt;
+				}
+
+				options.num_jobs = (uint32)num_jobs;
+			}
+			else if ((argument == "-o" || argument == "--output") && has_value) {
+				options.output_directory = argv[++i];
+			}
+			else if (argument == "--trace" && has_value) {
+				options.trace_path = argv[++i];
+			}
+			else if (argument.starts_with("-")) {
+				fmt::print(stderr, "Unknown option or missing value \"{}\"\n\n", argument);
+				PrintCookUsage();
+				return std::nullopt;
+			}
+			else {
+				options.manifests.push_back(argument);
+			}
+		}
+
+		if (options.manifests.empty()) {
+			PrintCookUsage();
+			return std::nullopt;
+		}
+
+		return options;
+	}
+
+}
@@ -0,0 +1,30 @@
+#include "AssetCookTool.h"
+
+using namespace Omni;
+
+int main(int argc, char** argv)
+{
+	std::optional<CookOptions> options = ParseCookOptions(argc, argv);
+
+	if (!options)
+		return 2;
+
+	if (options->help) {
+		PrintCookUsage();
+		return 0;
+	}
+
+	AssetCookTool cook_tool;
+	cook_tool.Setup(*options);
+
+	if (!cook_tool.LoadManifests()) {
+		cook_tool.CleanUp();
+		return 1;
+	}
+
+	cook_tool.Cook();
+	cook_tool.PrintReport();
+	cook_tool.CleanUp();
+
+	return cook_tool.GetNumFailedAssets() ? 1 : 0;
+}